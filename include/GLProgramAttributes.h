@@ -12,6 +12,7 @@ struct GLProgramAttribute
     enum Index
     {
         Position = 0,
+        InstanceTransform = 4, // mat4, occupies the locations 4 to 7
         TexCoord = 8,
         Tangent = 9,
         Bitangent = 10,
@@ -144,6 +144,14 @@ public:
 
     // Returns a list of AAS files for the given map (absolute) map path
     virtual std::list<AasFileInfo> getAasFilesForMap(const std::string& mapPath) = 0;
+
+    // Loads the given AAS file. An up-to-date binary cache entry of the file
+    // is preferred over parsing the text file, after parsing the cache is refreshed.
+    // Returns an empty reference on failure. Safe to call from worker threads.
+    virtual IAasFilePtr loadAasFile(const AasFileInfo& info) = 0;
+
+    // The number of AAS files which have been served by the binary cache
+    virtual std::size_t getNumCacheHits() const = 0;
 };
 
 } // namespace
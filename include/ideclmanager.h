@@ -160,6 +160,11 @@ public:
     // All declaration references will stay intact, only their contents will be refreshed
     virtual void reloadDeclarations() = 0;
 
+    // The number of declaration files which have been loaded from the parse result cache
+    // (hits) or had to be parsed from their source (misses), accumulated over all parser runs
+    virtual std::size_t getNumCacheHits() const = 0;
+    virtual std::size_t getNumCacheMisses() const = 0;
+
     // Saves the given declaration to a physical declaration file. Depending on the original location
     // of the declaration the outcome will be different.
     //
@@ -71,6 +71,12 @@ public:
     // Returns the line spacing of this font
     virtual float getLineHeight() const = 0;
 
+    // Returns the distance from the baseline to the lowest glyph pixel (a negative value)
+    virtual float getDescender() const = 0;
+
+    // Returns the horizontal distance the pen moves when rendering the given string
+    virtual float getAdvance(const std::string& string) const = 0;
+
     /// \brief Renders \p string at the current raster-position of the current context.
     virtual void drawString(const std::string& string) = 0;
 };
@@ -372,6 +372,11 @@ public:
 	// Returns the GUI appearance type for the given GUI path
 	virtual GuiType getGuiType(const std::string& guiPath) = 0;
 
+	// Determines the appearance type of all known GUIs which haven't been
+	// classified yet. The files are parsed in parallel, which is much faster
+	// than calling getGuiType() for each GUI path.
+	virtual void determineGuiTypes() = 0;
+
 	// Reload the gui
 	virtual void reloadGui(const std::string& guiPath) = 0;
 
@@ -3,6 +3,8 @@
 #include "igl.h"
 #include "imodule.h"
 
+#include <vector>
+
 typedef unsigned char byte;
 
 class Texture;
@@ -90,6 +92,20 @@ public:
 };
 typedef std::shared_ptr<Image> ImagePtr;
 
+/// Reduced version of an image, suitable for previews
+struct ImageThumbnail
+{
+    /// Uncompressed image in GL_RGBA layout, empty if the image could not be loaded
+    ImagePtr image;
+
+    /// Dimensions of the full-size image this thumbnail has been created from
+    std::size_t sourceWidth = 0;
+    std::size_t sourceHeight = 0;
+
+    /// The file the image has been loaded from (for VFS requests including prefix and extension)
+    std::string sourceFile;
+};
+
 class ArchiveFile;
 
 /// Module responsible for loading images from VFS or disk filesystem
@@ -116,6 +132,47 @@ public:
      * Load an image from a filesystem path.
      */
     virtual ImagePtr imageFromFile(const std::string& filename) const = 0;
+
+    /**
+     * \brief
+     * Load a reduced version of the image at the given VFS path, the file is
+     * located in the same way as in imageFromVFS().
+     *
+     * Only as much of the file is decoded as is needed to produce an image
+     * whose larger side is not smaller than minSize (unless the image itself
+     * is smaller than that). For DDS files this means that the smallest
+     * sufficient mipmap level is decompressed, other formats are loaded and
+     * reduced by a power of two.
+     *
+     * This method is safe to be called from worker threads.
+     */
+    virtual ImageThumbnail thumbnailFromVFS(const std::string& vfsPath, std::size_t minSize) const = 0;
+
+    /**
+     * \brief
+     * Load a reduced version of the image at the given filesystem path,
+     * see thumbnailFromVFS().
+     */
+    virtual ImageThumbnail thumbnailFromFile(const std::string& filename, std::size_t minSize) const = 0;
+
+    /**
+     * \brief
+     * Load the images at the given VFS paths, each one located as in
+     * imageFromVFS(). The images are decoded concurrently, the result holds
+     * one entry per requested path in the same order (empty if the image
+     * could not be loaded).
+     *
+     * This method is safe to be called from worker threads.
+     */
+    virtual std::vector<ImagePtr> imagesFromVFS(const std::vector<std::string>& vfsPaths) const = 0;
+
+    /**
+     * \brief
+     * Load thumbnails of the images at the given VFS paths concurrently,
+     * see thumbnailFromVFS() and imagesFromVFS().
+     */
+    virtual std::vector<ImageThumbnail> thumbnailsFromVFS(const std::vector<std::string>& vfsPaths,
+        std::size_t minSize) const = 0;
 };
 
 const char* const MODULE_IMAGELOADER("ImageLoader");
@@ -1,9 +1,9 @@
 #pragma once
 
-#include <set>
 #include <string>
 #include <functional>
 #include "imodule.h"
+#include "scene/LayerList.h"
 #include <sigc++/signal.h>
 
 namespace scene
@@ -12,9 +12,6 @@ namespace scene
 class INode;
 typedef std::shared_ptr<INode> INodePtr;
 
-// A list of named layers
-typedef std::set<int> LayerList;
-
 /**
  * greebo: Interface of a Layered object.
  */
@@ -171,6 +168,35 @@ public:
 	 */
 	virtual bool updateNodeVisibility(const INodePtr& node) = 0;
 
+	/**
+	 * Called by the scene nodes when they're inserted into the scene of
+	 * this layer manager. The manager maintains an index of the members of
+	 * each layer, which is used to update only the affected nodes when
+	 * the visibility of a layer is changing.
+	 */
+	virtual void onNodeInserted(INode& node) = 0;
+
+	/**
+	 * Called by the scene nodes when they're removed from the scene,
+	 * drops the node from the member index.
+	 */
+	virtual void onNodeRemoved(INode& node) = 0;
+
+	/**
+	 * Called by nodes in this manager's scene after their set of layers
+	 * has been changed. The node is scheduled for a visibility update,
+	 * which happens on the next membership or visibility change event.
+	 *
+	 * @previousLayers: the layers the node has been a member of before.
+	 */
+	virtual void onNodeLayersChanged(INode& node, const LayerList& previousLayers) = 0;
+
+	/**
+	 * Invokes the given functor for each node in the scene being
+	 * a member of the given layer (child layers are not considered).
+	 */
+	virtual void foreachLayerMember(int layerID, const std::function<void(INode&)>& functor) = 0;
+
 	/**
 	 * greebo: Sets the selection status of the entire layer.
 	 *
@@ -43,6 +43,15 @@ namespace selection
 namespace scene
 {
 
+// see imaterialusageindex.h
+class IMaterialUsageIndex;
+
+// see ipendingevaluation.h
+class IPendingEvaluationQueue;
+
+// see scene/NodeArena.h
+class NodeArena;
+
 /**
  * greebo: A root node is the top level element of a map.
  * It also owns the namespace of the corresponding map.
@@ -92,6 +101,15 @@ public:
     // The UndoSystem of this map
     virtual IUndoSystem& getUndoSystem() = 0;
 
+    // The index keeping track of the materials used in this map
+    virtual IMaterialUsageIndex& getMaterialUsageIndex() = 0;
+
+    // The elements of this map waiting for their geometry to be evaluated
+    virtual IPendingEvaluationQueue& getPendingEvaluationQueue() = 0;
+
+    // The arena the nodes loaded or pasted into this map are allocated from (may be empty)
+    virtual const std::shared_ptr<NodeArena>& getNodeArena() const = 0;
+
     // Returns the render system of this map root (may be empty)
     virtual RenderSystemPtr getRenderSystem() const = 0;
 };
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include "inode.h"
+
+namespace scene
+{
+
+// The kind of map element a material is used by
+enum class MaterialUsageType
+{
+    Face = 0,
+    Patch = 1,
+    Model = 2,
+};
+
+/**
+ * Live index associating material names with the scene nodes using them.
+ *
+ * Brush faces and patches register their material when they are inserted
+ * into the scene and update their entry whenever their material is changed.
+ * Models register the materials of their currently active skin.
+ * This allows material queries to run without traversing the whole map.
+ *
+ * Each map root is owning its own index, see IMapRootNode::getMaterialUsageIndex().
+ */
+class IMaterialUsageIndex
+{
+public:
+    using Ptr = std::shared_ptr<IMaterialUsageIndex>;
+
+    virtual ~IMaterialUsageIndex() {}
+
+    /**
+     * Registers a single use of the given material by the given node.
+     * Brush faces are registered with their owning brush node, once per face.
+     */
+    virtual void addUsage(const std::string& material, MaterialUsageType type, INode& node) = 0;
+
+    // Removes a single use previously registered through addUsage()
+    virtual void removeUsage(const std::string& material, MaterialUsageType type, INode& node) = 0;
+
+    // Returns the number of uses of the given material (compared case-sensitively)
+    // by elements of the given type
+    virtual std::size_t getUsageCount(const std::string& material, MaterialUsageType type) const = 0;
+
+    // Invokes the functor once for each material in use, passing its exact spelling
+    virtual void foreachMaterial(const std::function<void(const std::string&)>& functor) const = 0;
+
+    /**
+     * Invokes the functor once for each node using the given material.
+     * Names are compared case-insensitively like the material system does,
+     * callers in need of an exact match will have to check the elements themselves.
+     * It's safe to change the materials of the visited nodes from within the functor.
+     */
+    virtual void foreachNodeUsingMaterial(const std::string& material,
+        const std::function<void(const INodePtr&)>& functor) const = 0;
+};
+
+}
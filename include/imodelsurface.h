@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 // Math/Vertex classes
 #include "render/MeshVertex.h"
 
@@ -67,6 +69,13 @@ public:
 
 	// Const access to the index array connecting the vertices.
 	virtual const std::vector<unsigned int>& getIndexArray() const = 0;
+
+	// Surfaces returning the same non-zero id are using the same vertex and index arrays
+	// (like copies of the same model). Zero means the arrays are not shared.
+	virtual std::uint64_t getGeometryId() const
+	{
+		return 0;
+	}
 };
 
 } // namespace
@@ -4,6 +4,7 @@
 #include <vector>
 #include "igl.h"
 #include "igeometrystore.h"
+#include "math/Matrix4.h"
 
 namespace render
 {
@@ -40,9 +41,18 @@ public:
     // Draws all geometry as defined by their store IDs in the given mode, no transforms (std::vector variant)
     virtual void submitInstancedGeometry(const std::vector<IGeometryStore::Slot>& slots, int numInstances, GLenum primitiveMode) = 0;
 
+    // Draws one instance of the given slot per transform in a single draw call. The transforms are
+    // passed to the active GLSL program through the per-instance attribute GLProgramAttribute::InstanceTransform,
+    // in addition to the object transform uniform (which should be set to identity)
+    virtual void submitInstancedGeometry(IGeometryStore::Slot slot, const std::vector<Matrix4>& transforms, GLenum primitiveMode) = 0;
+
     // Draws the geometry with a custom set of indices
     virtual void submitGeometryWithCustomIndices(IGeometryStore::Slot slot, GLenum primitiveMode,
         const std::vector<unsigned int>& indices) = 0;
+
+    // Returns the total number of draw calls issued by this renderer so far,
+    // the statistics of a render pass are the difference before and after the pass
+    virtual std::size_t getDrawCallCount() const = 0;
 };
 
 }
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+namespace scene
+{
+
+// The kind of lazily evaluated geometry a scene element is waiting for
+enum class PendingEvaluationType
+{
+    BrushBRep = 0,
+    PatchTesselation = 1,
+};
+
+// Base class of the scene elements which can be registered in an IPendingEvaluationQueue
+class IPendingEvaluation
+{
+public:
+    virtual ~IPendingEvaluation() {}
+};
+
+/**
+ * Collection of the scene elements with pending geometry updates,
+ * like brushes waiting for their b-rep to be rebuilt.
+ *
+ * Elements register themselves as soon as they become dirty and unregister
+ * when they're removed from the scene. The first element requested to evaluate
+ * its geometry takes all pending elements of the same type from the queue
+ * and processes them in one batch.
+ *
+ * Each map root is owning its own queue, see IMapRootNode::getPendingEvaluationQueue().
+ * The queue is not thread-safe, it's meant to be used from the main thread only.
+ */
+class IPendingEvaluationQueue
+{
+public:
+    virtual ~IPendingEvaluationQueue() {}
+
+    // Registers the given element, it is fine to add the same element more than once
+    virtual void add(PendingEvaluationType type, IPendingEvaluation& element) = 0;
+
+    // Removes the given element, does nothing if it's not registered
+    virtual void remove(PendingEvaluationType type, IPendingEvaluation& element) = 0;
+
+    // Removes all pending elements of the given type from this queue and returns them
+    virtual std::vector<IPendingEvaluation*> takeAll(PendingEvaluationType type) = 0;
+};
+
+}
@@ -234,6 +234,13 @@ public:
   virtual void TestTriangles(const VertexPointer& vertices, const IndexPointer& indices, SelectionIntersection& best) = 0;
   virtual void TestQuads(const VertexPointer& vertices, const IndexPointer& indices, SelectionIntersection& best) = 0;
   virtual void TestQuadStrip(const VertexPointer& vertices, const IndexPointer& indices, SelectionIntersection& best) = 0;
+
+  // Returns an independent copy of this test which can be used by another thread,
+  // or an empty pointer if this test doesn't support that.
+  virtual std::shared_ptr<SelectionTest> clone() const
+  {
+      return std::shared_ptr<SelectionTest>();
+  }
 };
 typedef std::shared_ptr<SelectionTest> SelectionTestPtr;
 
@@ -321,6 +328,27 @@ inline ComponentSelectionTestablePtr Node_getComponentSelectionTestable(const sc
 	return std::dynamic_pointer_cast<ComponentSelectionTestable>(node);
 }
 
+/**
+ * Implemented by nodes whose testSelect() and testSelectComponents() methods
+ * can be invoked from worker threads, concurrently with other nodes.
+ * Nodes not implementing this interface are always tested in the main thread.
+ */
+class ConcurrentSelectionTestable
+{
+public:
+    virtual ~ConcurrentSelectionTestable() {}
+
+    // Called in the main thread before the node is tested by a worker thread.
+    // Brings any lazily evaluated state (transforms, geometry) up to date, such
+    // that the selection tests themselves don't need to modify the node.
+    virtual void prepareConcurrentSelectionTest() = 0;
+};
+typedef std::shared_ptr<ConcurrentSelectionTestable> ConcurrentSelectionTestablePtr;
+
+inline ConcurrentSelectionTestablePtr Node_getConcurrentSelectionTestable(const scene::INodePtr& node) {
+	return std::dynamic_pointer_cast<ConcurrentSelectionTestable>(node);
+}
+
 class Plane3;
 typedef std::function<void (const Plane3&)> PlaneCallback;
 
@@ -78,6 +78,17 @@ public:
 
 constexpr const char* const MODULE_SOUNDMANAGER("SoundManager");
 
+/// Format and length of a sound file, as read from its headers.
+struct SoundFileInfo
+{
+    // Length in seconds
+    float duration = 0;
+
+    unsigned int channels = 0;
+    unsigned int sampleRate = 0;
+    unsigned int bitsPerSample = 0;
+};
+
 /// Sound manager interface.
 class ISoundManager :
     public RegisterableModule
@@ -116,6 +127,12 @@ public:
     // Will throw a std::out_of_range exception if the path cannot be resolved
     virtual float getSoundFileDuration(const std::string& vfsPath) = 0;
 
+    // Returns the format and duration of the given sound file, which are read
+    // from the file headers without decoding the audio data. The result is
+    // cached per archive entry, this method is safe to be called from worker threads.
+    // Will throw a std::out_of_range exception if the path cannot be resolved
+    virtual SoundFileInfo getSoundFileInfo(const std::string& vfsPath) = 0;
+
     // Reloads all sound shader definitions from the VFS
     virtual void reloadSounds() = 0;
 };
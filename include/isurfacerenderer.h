@@ -31,6 +31,13 @@ public:
 
     // Returns the indices to render the triangle primitives
     virtual const std::vector<unsigned int>& getIndices() = 0;
+
+    // Surfaces returning the same non-zero id are referencing the same vertex
+    // and index arrays, they can share their storage. Zero means not shared.
+    virtual std::uint64_t getGeometryId()
+    {
+        return 0;
+    }
 };
 
 /**
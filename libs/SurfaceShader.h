@@ -4,7 +4,9 @@
 #include <sigc++/connection.h>
 #include "debugging/debugging.h"
 #include "util/Noncopyable.h"
+#include "string/InternedString.h"
 #include "irender.h"
+#include "imaterialusageindex.h"
 #include "shaderlib.h"
 
 /**
@@ -18,8 +20,8 @@ class SurfaceShader :
 	public Shader::Observer
 {
 private:
-    // greebo: The name of the material
-    std::string _materialName;
+    // greebo: The name of the material, shared with all other surfaces using it
+    string::InternedString _materialName;
 
     RenderSystemPtr _renderSystem;
 
@@ -34,14 +36,27 @@ private:
 	std::function<void()> _callbackRealised;
 	std::function<void()> _callbackUnrealised;
 
+    // The material usage index this shader is registered in (if any)
+    scene::IMaterialUsageIndex* _usageIndex;
+    scene::MaterialUsageType _usageType;
+    scene::INode* _usageOwner;
+
 public:
     // Constructor. The renderSystem reference will be kept internally as reference
     // The SurfaceShader will try to de-reference it when capturing shaders.
     SurfaceShader(const std::string& materialName, const RenderSystemPtr& renderSystem = RenderSystemPtr()) :
+        SurfaceShader(string::InternedString(materialName), renderSystem)
+    {}
+
+    // Constructs a shader sharing the given interned material name, no table lookup involved
+    SurfaceShader(const string::InternedString& materialName, const RenderSystemPtr& renderSystem = RenderSystemPtr()) :
         _materialName(materialName),
         _renderSystem(renderSystem),
         _inUse(false),
-        _realised(false)
+        _realised(false),
+        _usageIndex(nullptr),
+        _usageType(scene::MaterialUsageType::Face),
+        _usageOwner(nullptr)
     {
         captureShader();
     }
@@ -78,6 +93,12 @@ public:
     * Get the material name.
     */
     const std::string& getMaterialName() const
+    {
+        return _materialName.str();
+    }
+
+    // The interned material name, can be compared to other handles without string comparisons
+    const string::InternedString& getMaterialHandle() const
     {
         return _materialName;
     }
@@ -87,17 +108,55 @@ public:
     * Set the material name.
     */
     void setMaterialName(const std::string& name)
+    {
+        setMaterialName(string::InternedString(name));
+    }
+
+    void setMaterialName(const string::InternedString& name)
     {
         // return, if the shader is the same as the currently used
-        if (shader_equal(_materialName, name)) return;
+        if (_materialName.equalsNoCase(name)) return;
 
         releaseShader();
 
+        if (_usageIndex)
+        {
+            _usageIndex->removeUsage(_materialName.str(), _usageType, *_usageOwner);
+            _usageIndex->addUsage(name.str(), _usageType, *_usageOwner);
+        }
+
         _materialName = name;
 
         captureShader();
     }
 
+    /**
+     * Registers the material of this shader with the given usage index,
+     * on behalf of the given owner node. Subsequent material changes
+     * will be reflected in the index until detachFromUsageIndex() is called.
+     */
+    void attachToUsageIndex(scene::IMaterialUsageIndex& index, scene::MaterialUsageType type, scene::INode& owner)
+    {
+        assert(!_usageIndex);
+
+        _usageIndex = &index;
+        _usageType = type;
+        _usageOwner = &owner;
+
+        _usageIndex->addUsage(_materialName.str(), _usageType, *_usageOwner);
+    }
+
+    // Removes the material of this shader from the usage index it has been attached to
+    void detachFromUsageIndex()
+    {
+        if (!_usageIndex) return;
+
+        _usageIndex->removeUsage(_materialName.str(), _usageType, *_usageOwner);
+
+        _usageIndex = nullptr;
+        _usageOwner = nullptr;
+    }
+
     /**
     * \brief
     * Return the Shader for rendering.
@@ -192,7 +251,7 @@ private:
         // Check if we have a rendersystem - can we capture already?
         if (_renderSystem)
         {
-            _glShader = _renderSystem->capture(_materialName);
+            _glShader = _renderSystem->capture(_materialName.str());
             assert(_glShader);
 
 			_glShader->attachObserver(*this);
@@ -6,6 +6,7 @@
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <algorithm>
 #include <fmt/format.h>
 
@@ -645,6 +646,93 @@ public:
 	}
 };
 
+/**
+ * Thread-safe cache of the tokens of #include'd files, to be shared by
+ * CodeTokenisers processing a set of files including the same headers.
+ * Each included file is read and split into tokens only once, while the
+ * preprocessor statements in it are still evaluated by every tokeniser,
+ * since their outcome depends on the macros defined by the including file.
+ *
+ * Entries are keyed by VFS path only, a cache instance must not be shared
+ * by tokenisers using different delimiters or operators.
+ */
+class CodeIncludeCache
+{
+public:
+    using Ptr = std::shared_ptr<CodeIncludeCache>;
+
+    struct IncludeFile
+    {
+        using Ptr = std::shared_ptr<const IncludeFile>;
+
+        // The file name as reported by the VFS
+        std::string name;
+
+        std::shared_ptr<const TokenSequenceTokeniser::Sequence> tokens;
+    };
+
+private:
+    std::mutex _lock;
+
+    // Files not found in the VFS are stored as empty pointers
+    std::map<std::string, IncludeFile::Ptr> _files;
+
+public:
+    // Returns the tokenised contents of the given VFS file, reading it
+    // if necessary. Returns an empty pointer if the file doesn't exist.
+    IncludeFile::Ptr get(const std::string& path, const char* delims,
+        const char* keptDelims, const std::vector<std::string>& operators)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            auto found = _files.find(path);
+
+            if (found != _files.end())
+            {
+                return found->second;
+            }
+        }
+
+        // Read the file without holding the lock. Other threads might be
+        // reading the same file at this point, the first one to finish wins.
+        auto includeFile = readFile(path, delims, keptDelims, operators);
+
+        std::lock_guard<std::mutex> lock(_lock);
+        return _files.emplace(path, includeFile).first->second;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _files.clear();
+    }
+
+private:
+    static IncludeFile::Ptr readFile(const std::string& path, const char* delims,
+        const char* keptDelims, const std::vector<std::string>& operators)
+    {
+        auto file = GlobalFileSystem().openTextFile(path);
+
+        if (!file)
+        {
+            return IncludeFile::Ptr();
+        }
+
+        std::istream stream(&file->getInputStream());
+        SingleCodeFileTokeniser tokeniser(stream, delims, keptDelims, operators);
+
+        auto tokens = std::make_shared<TokenSequenceTokeniser::Sequence>();
+
+        while (tokeniser.hasMoreTokens())
+        {
+            tokens->emplace_back(tokeniser.nextToken());
+        }
+
+        return std::make_shared<IncludeFile>(IncludeFile{ file->getName(), tokens });
+    }
+};
+
 /**
  * High-level tokeniser taking a specific VFS file as input.
  * It is able to handle preprocessor statements like #include
@@ -662,15 +750,27 @@ private:
 	{
         using Ptr = std::shared_ptr<ParseNode>;
 
+		// The file name as reported by the VFS
+		std::string name;
+
+		// Only set for nodes reading the file themselves
 		ArchiveTextFilePtr archive;
-		std::istream inputStream;
-		SingleCodeFileTokeniser tokeniser;
+		std::unique_ptr<std::istream> inputStream;
+
+		std::unique_ptr<DefTokeniser> tokeniser;
 
 		ParseNode(const ArchiveTextFilePtr& archive_,
 				const char* delims, const char* keptDelims, const std::vector<std::string>& operators) :
+			name(archive_->getName()),
 			archive(archive_),
-			inputStream(&archive->getInputStream()),
-			tokeniser(inputStream, delims, keptDelims, operators)
+			inputStream(std::make_unique<std::istream>(&archive->getInputStream())),
+			tokeniser(std::make_unique<SingleCodeFileTokeniser>(*inputStream, delims, keptDelims, operators))
+		{}
+
+		// Replays the tokens of a cached include file
+		ParseNode(const CodeIncludeCache::IncludeFile& includeFile) :
+			name(includeFile.name),
+			tokeniser(std::make_unique<TokenSequenceTokeniser>(includeFile.tokens))
 		{}
 	};
 
@@ -698,19 +798,25 @@ private:
     // The list of operators supported by this tokeniser
     std::vector<std::string> _operators;
 
+    // Optional cache for included files, can be empty
+    CodeIncludeCache::Ptr _includeCache;
+
 public:
     constexpr static const char* KEPT_DELIMS = "{}(),;";
 
     /**
      * Construct a CodeTokeniser with the given text file from the VFS.
+     * If an include cache is passed, #include'd files are retrieved from it.
      */
     CodeTokeniser(const ArchiveTextFilePtr& file,
                   const char* delims,
                   const char* keptDelims,
-                  const std::vector<const char*>& operators) :
+                  const std::vector<const char*>& operators,
+                  const CodeIncludeCache::Ptr& includeCache = CodeIncludeCache::Ptr()) :
         _delims(delims),
         _keptDelims(keptDelims),
-        _operators(operators.begin(), operators.end())
+        _operators(operators.begin(), operators.end()),
+        _includeCache(includeCache)
     {
 		_nodes.emplace_back(std::make_shared<ParseNode>(file, _delims, _keptDelims, _operators));
 		_curNode = _nodes.begin();
@@ -759,14 +865,14 @@ private:
 	{
 		while (_curNode != _nodes.end())
 		{
-			if (!(*_curNode)->tokeniser.hasMoreTokens())
+			if (!(*_curNode)->tokeniser->hasMoreTokens())
 			{
 				_fileStack.pop_back();
 				++_curNode;
 				continue;
 			}
 
-			std::string token = (*_curNode)->tokeniser.nextToken();
+			std::string token = (*_curNode)->tokeniser->nextToken();
 
 			// Don't treat #strNNNN as preprocessor tokens
 			if (!token.empty() &&
@@ -787,7 +893,7 @@ private:
 			if (found != _macros.end())
 			{
 				// Expand this macro, new tokens are acquired from the currently active tokeniser
-				auto expanded = expandMacro(found->second, [this]() { return (*_curNode)->tokeniser.nextToken(); });
+				auto expanded = expandMacro(found->second, [this]() { return (*_curNode)->tokeniser->nextToken(); });
 
 				if (!expanded.empty())
 				{
@@ -887,7 +993,7 @@ private:
             else
             {
                 rWarning() << "Macro expansion yields empty token list: " << *t <<
-                    " in " << (*_curNode)->archive->getName() << std::endl;
+                    " in " << (*_curNode)->name << std::endl;
             }
 		}
 
@@ -915,34 +1021,31 @@ private:
 	{
 		if (token == "#include")
 		{
-			auto includeFile = (*_curNode)->tokeniser.nextToken();
-			auto file = GlobalFileSystem().openTextFile(includeFile);
+			auto includeFile = (*_curNode)->tokeniser->nextToken();
+			auto node = openIncludeFile(includeFile);
 
-			if (file)
+			if (node)
 			{
 				// Catch infinite recursions
-				auto found = std::find(_fileStack.begin(), _fileStack.end(), file->getName());
+				auto found = std::find(_fileStack.begin(), _fileStack.end(), node->name);
 
 				if (found == _fileStack.end())
 				{
 					// Push a new parse node and switch
-					_fileStack.push_back(file->getName());
+					_fileStack.push_back(node->name);
 
-					_curNode = _nodes.insert(
-						_curNode,
-						std::make_shared<ParseNode>(file, _delims, _keptDelims, _operators)
-					);
+					_curNode = _nodes.insert(_curNode, node);
 				}
 				else
 				{
 					rError() << "Caught infinite loop on parsing #include token: "
-						<< includeFile << " in " << (*_curNode)->archive->getName() << std::endl;
+						<< includeFile << " in " << (*_curNode)->name << std::endl;
 				}
 			}
 			else
 			{
 				rWarning() << "Couldn't find include file: "
-					<< includeFile << " in " << (*_curNode)->archive->getName() << std::endl;
+					<< includeFile << " in " << (*_curNode)->name << std::endl;
 			}
 		}
 		else if (string::starts_with(token, "#define"))
@@ -951,12 +1054,12 @@ private:
 		}
 		else if (token == "#undef")
 		{
-			auto key = (*_curNode)->tokeniser.nextToken();
+			auto key = (*_curNode)->tokeniser->nextToken();
 			_macros.erase(key);
 		}
 		else if (token == "#ifdef")
 		{
-            auto key = (*_curNode)->tokeniser.nextToken();
+            auto key = (*_curNode)->tokeniser->nextToken();
             auto found = _macros.find(key);
 
 			if (found == _macros.end())
@@ -966,7 +1069,7 @@ private:
 		}
 		else if (token == "#ifndef")
 		{
-            auto found = _macros.find((*_curNode)->tokeniser.nextToken());
+            auto found = _macros.find((*_curNode)->tokeniser->nextToken());
 
 			if (found != _macros.end())
 			{
@@ -980,17 +1083,29 @@ private:
 		}
 		else if (token == "#if")
 		{
-			(*_curNode)->tokeniser.skipTokens(1);
+			(*_curNode)->tokeniser->skipTokens(1);
 		}
 	}
 
+	ParseNode::Ptr openIncludeFile(const std::string& includeFile)
+	{
+		if (_includeCache)
+		{
+			auto cached = _includeCache->get(includeFile, _delims, _keptDelims, _operators);
+			return cached ? std::make_shared<ParseNode>(*cached) : ParseNode::Ptr();
+		}
+
+		auto file = GlobalFileSystem().openTextFile(includeFile);
+		return file ? std::make_shared<ParseNode>(file, _delims, _keptDelims, _operators) : ParseNode::Ptr();
+	}
+
 	void parseMacro(const std::string& token)
 	{
 		std::string defineToken = token;
 
 		if (defineToken.length() <= 7)
 		{
-			rWarning() << "Invalid #define statement in " << (*_curNode)->archive->getName() << std::endl;
+			rWarning() << "Invalid #define statement in " << (*_curNode)->name << std::endl;
 			return;
 		}
 
@@ -1018,7 +1133,7 @@ private:
 
 		if (!result.second)
 		{
-			rWarning() << "Redefinition of " << name << " in " << (*_curNode)->archive->getName() << std::endl;
+			rWarning() << "Redefinition of " << name << " in " << (*_curNode)->name << std::endl;
 			result.first->second = Macro(name);
 		}
 
@@ -1069,13 +1184,13 @@ private:
 		// Not defined, skip everything until matching #endif
 		for (std::size_t level = 1; level > 0;)
 		{
-			if (!(*_curNode)->tokeniser.hasMoreTokens())
+			if (!(*_curNode)->tokeniser->hasMoreTokens())
 			{
 				rWarning() << "No matching #endif for #if(n)def in "
-					<< (*_curNode)->archive->getName() << std::endl;
+					<< (*_curNode)->name << std::endl;
 			}
 
-			auto token = (*_curNode)->tokeniser.nextToken();
+			auto token = (*_curNode)->tokeniser->nextToken();
 
 			if (token == "#endif")
 			{
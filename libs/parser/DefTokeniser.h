@@ -5,7 +5,9 @@
 #include <iterator>
 #include <iostream>
 #include <ios>
+#include <memory>
 #include <string>
+#include <vector>
 #include "string/tokeniser.h"
 
 namespace parser
@@ -610,4 +612,51 @@ public:
 	}
 };
 
+/**
+ * DefTokeniser replaying a sequence of tokens that has been extracted
+ * before. The sequence is shared, such that the same tokens can be
+ * replayed by several tokenisers without copying them.
+ */
+class TokenSequenceTokeniser :
+	public DefTokeniser
+{
+public:
+	using Sequence = std::vector<std::string>;
+
+private:
+	std::shared_ptr<const Sequence> _tokens;
+	Sequence::const_iterator _current;
+
+public:
+	TokenSequenceTokeniser(const std::shared_ptr<const Sequence>& tokens) :
+		_tokens(tokens),
+		_current(_tokens->begin())
+	{}
+
+	bool hasMoreTokens() const override
+	{
+		return _current != _tokens->end();
+	}
+
+	std::string nextToken() override
+	{
+		if (hasMoreTokens())
+		{
+			return *(_current++);
+		}
+
+		throw ParseException("TokenSequenceTokeniser: no more tokens");
+	}
+
+	std::string peek() const override
+	{
+		if (hasMoreTokens())
+		{
+			return *_current;
+		}
+
+		throw ParseException("TokenSequenceTokeniser: no more tokens");
+	}
+};
+
 } // namespace parser
@@ -18,8 +18,9 @@ private:
     };
 
 public:
-    GuiTokeniser(const ArchiveTextFilePtr& file) :
-        CodeTokeniser(file, WHITESPACE, KEPT_DELIMS, GUI_OPERATORS)
+    GuiTokeniser(const ArchiveTextFilePtr& file,
+                 const CodeIncludeCache::Ptr& includeCache = CodeIncludeCache::Ptr()) :
+        CodeTokeniser(file, WHITESPACE, KEPT_DELIMS, GUI_OPERATORS, includeCache)
     {}
 };
 
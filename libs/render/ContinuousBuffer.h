@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <stack>
 #include <limits>
@@ -289,9 +290,15 @@ public:
             auto handle = getHandle(transaction.slot);
             auto& otherSlot = other._slots[handle];
 
-            memcpy(_buffer.data() + otherSlot.Offset + transaction.offset,
-                other._buffer.data() + otherSlot.Offset + transaction.offset,
-                transaction.numChangedElements * sizeof(ElementType));
+            // The slot might have been released or merged after the transaction
+            // had been recorded, don't copy anything beyond the end of the buffer
+            auto start = otherSlot.Offset + transaction.offset;
+
+            if (start >= otherSize) continue;
+
+            auto numElements = std::min(transaction.numChangedElements, otherSize - start);
+
+            memcpy(_buffer.data() + start, other._buffer.data() + start, numElements * sizeof(ElementType));
 
             // Remember this slot to be synced to the GPU
             _unsyncedModifications.emplace_back(ModifiedMemoryChunk{
@@ -306,10 +313,12 @@ public:
         _emptySlots = other._emptySlots;
     }
 
-    // Copies the updated memory to the given buffer object
-    void syncModificationsToBufferObject(const IBufferObject::Ptr& buffer)
+    // Copies the updated memory to the given buffer object,
+    // returns the number of bytes that have been uploaded
+    std::size_t syncModificationsToBufferObject(const IBufferObject::Ptr& buffer)
     {
         auto currentBufferSize = _buffer.size() * sizeof(ElementType);
+        std::size_t uploadedBytes = 0;
 
         // On size change we upload everything
         if (_lastSyncedBufferSize != currentBufferSize)
@@ -320,9 +329,10 @@ public:
 
             // Re-upload everything
             buffer->bind();
-            buffer->setData(0, reinterpret_cast<unsigned char*>(_buffer.data()),
-                _buffer.size() * sizeof(ElementType));
+            buffer->setData(0, reinterpret_cast<unsigned char*>(_buffer.data()), currentBufferSize);
             buffer->unbind();
+
+            uploadedBytes = currentBufferSize;
         }
         else
         {
@@ -339,9 +349,9 @@ public:
 
                 // Prevent the slot from exceeding its boundaries
                 // It's possible that this is chunk has been modified before it has been freed
-                if (modifiedChunk.numElements > slot.Size)
+                if (modifiedChunk.offset + modifiedChunk.numElements > slot.Size)
                 {
-                    modifiedChunk.numElements = slot.Size;
+                    modifiedChunk.numElements = slot.Size > modifiedChunk.offset ? slot.Size - modifiedChunk.offset : 0;
                 }
 
                 minimumOffset = std::min(slot.Offset + modifiedChunk.offset, minimumOffset);
@@ -368,6 +378,8 @@ public:
                         buffer->setData((slot.Offset + modifiedChunk.offset) * sizeof(ElementType),
                             reinterpret_cast<unsigned char*>(_buffer.data() + slot.Offset + modifiedChunk.offset),
                             modifiedChunk.numElements * sizeof(ElementType));
+
+                        uploadedBytes += modifiedChunk.numElements * sizeof(ElementType);
                     }
                 }
                 else // copy everything in between minimum and maximum in one operation
@@ -375,6 +387,8 @@ public:
                     buffer->setData(minimumOffset * sizeof(ElementType),
                         reinterpret_cast<unsigned char*>(_buffer.data() + minimumOffset),
                         (maximumOffset - minimumOffset) * sizeof(ElementType));
+
+                    uploadedBytes += (maximumOffset - minimumOffset) * sizeof(ElementType);
                 }
 
                 buffer->unbind();
@@ -382,6 +396,8 @@ public:
         }
 
         _unsyncedModifications.clear();
+
+        return uploadedBytes;
     }
 
 private:
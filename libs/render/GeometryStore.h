@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 #include <limits>
+#include <algorithm>
+#include <chrono>
 #include "igeometrystore.h"
 #include "itextstream.h"
 #include "ContinuousBuffer.h"
@@ -17,6 +19,19 @@ public:
     // Slot ID handed out to client code
     using Slot = std::uint64_t;
 
+    // Upload and synchronisation figures of a single frame
+    struct FrameStatistics
+    {
+        // Time spent waiting for the GPU to release the frame buffer
+        std::chrono::microseconds stallTime = std::chrono::microseconds::zero();
+
+        // Number of sync objects waited on before writing to the frame buffer
+        std::size_t numSyncWaits = 0;
+
+        // Number of bytes transferred to the buffer objects
+        std::size_t uploadedBytes = 0;
+    };
+
 private:
     enum class SlotType
     {
@@ -24,7 +39,9 @@ private:
         IndexRemap = 1,
     };
 
-    static constexpr auto NumFrameBuffers = 1;
+    // The GPU may still be reading from the buffers of the previous frames,
+    // modifications are written to the next buffer and replayed on the others
+    static constexpr auto NumFrameBuffers = 3;
 
     // Represents the storage for a single frame
     struct FrameBuffer
@@ -47,10 +64,11 @@ private:
             indices.applyTransactions(other.indexTransactionLog, other.indices, GetIndexSlot);
         }
 
-        void syncToBufferObjects()
+        // Returns the number of uploaded bytes
+        std::size_t syncToBufferObjects()
         {
-            vertices.syncModificationsToBufferObject(vertexBufferObject);
-            indices.syncModificationsToBufferObject(indexBufferObject);
+            return vertices.syncModificationsToBufferObject(vertexBufferObject) +
+                indices.syncModificationsToBufferObject(indexBufferObject);
         }
 
         void recordVertexTransaction(Slot slot, std::size_t offset, std::size_t numChangedElements)
@@ -76,10 +94,23 @@ private:
 
     ISyncObjectProvider& _syncObjectProvider;
 
+    FrameStatistics _currentFrameStats;
+    FrameStatistics _lastFrameStats;
+
+    // Accumulated figures since construction
+    std::size_t _numFrames;
+    std::chrono::microseconds _totalStallTime;
+    std::chrono::microseconds _maxStallTime;
+    std::size_t _totalUploadedBytes;
+
 public:
     GeometryStore(ISyncObjectProvider& syncObjectProvider, IBufferObjectProvider& bufferObjectProvider) :
         _currentBuffer(0),
-        _syncObjectProvider(syncObjectProvider)
+        _syncObjectProvider(syncObjectProvider),
+        _numFrames(0),
+        _totalStallTime(0),
+        _maxStallTime(0),
+        _totalUploadedBytes(0)
     {
         _frameBuffers.resize(NumFrameBuffers);
 
@@ -97,11 +128,20 @@ public:
         _currentBuffer = (_currentBuffer + 1) % NumFrameBuffers;
         auto& current = getCurrentBuffer();
 
+        _currentFrameStats = FrameStatistics();
+
         // Wait for this buffer to become available
         if (current.syncObject)
         {
+            auto waitStart = std::chrono::steady_clock::now();
+
             current.syncObject->wait();
             current.syncObject.reset();
+
+            ++_currentFrameStats.numSyncWaits;
+
+            _currentFrameStats.stallTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - waitStart);
         }
 
         // Replay any modifications of all other buffers onto this one,
@@ -127,7 +167,7 @@ public:
     void syncToBufferObjects() override
     {
         auto& current = getCurrentBuffer();
-        current.syncToBufferObjects();
+        _currentFrameStats.uploadedBytes += current.syncToBufferObjects();
     }
 
     // Completes the currently writing frame, creates sync objects
@@ -135,6 +175,19 @@ public:
     {
         auto& current = getCurrentBuffer();
         current.syncObject = _syncObjectProvider.createSyncObject();
+
+        _lastFrameStats = _currentFrameStats;
+
+        ++_numFrames;
+        _totalStallTime += _lastFrameStats.stallTime;
+        _maxStallTime = std::max(_maxStallTime, _lastFrameStats.stallTime);
+        _totalUploadedBytes += _lastFrameStats.uploadedBytes;
+    }
+
+    // Returns the figures of the most recently finished frame
+    const FrameStatistics& getLastFrameStatistics() const
+    {
+        return _lastFrameStats;
     }
 
     Slot allocateSlot(std::size_t numVertices, std::size_t numIndices) override
@@ -306,6 +359,18 @@ public:
             auto logSize = _frameBuffers[i].vertexTransactionLog.capacity() + _frameBuffers[i].indexTransactionLog.capacity();
             rMessage() << "  Transaction Logs: " << string::getFormattedByteSize(logSize * sizeof(detail::BufferTransaction)) << std::endl;
         }
+
+        rMessage() << "-- Geometry Store Frame Statistics --" << std::endl;
+        rMessage() << "Frames: " << _numFrames << std::endl;
+        rMessage() << "Last Frame: stalled " << _lastFrameStats.stallTime.count() << " usec, uploaded "
+            << string::getFormattedByteSize(_lastFrameStats.uploadedBytes) << std::endl;
+
+        if (_numFrames > 0)
+        {
+            rMessage() << "Average: stalled " << (_totalStallTime.count() / _numFrames) << " usec, uploaded "
+                << string::getFormattedByteSize(_totalUploadedBytes / _numFrames) << std::endl;
+            rMessage() << "Maximum Stall: " << _maxStallTime.count() << " usec" << std::endl;
+        }
     }
 
 private:
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
+#include "irenderableobject.h"
+
+namespace render
+{
+
+/**
+ * Collects oriented objects grouped by the storage slot of their geometry,
+ * such that objects sharing their geometry can be drawn as instances.
+ *
+ * An object touched by several lights is submitted once per light,
+ * it is only drawn once all the same.
+ */
+class InstancedObjectCollection
+{
+private:
+    std::map<IGeometryStore::Slot, std::vector<IRenderableObject*>> _objectsBySlot;
+
+    // Reused between the slots
+    std::vector<Matrix4> _transforms;
+
+public:
+    void add(IRenderableObject& object)
+    {
+        _objectsBySlot[object.getStorageLocation()].push_back(&object);
+    }
+
+    bool empty() const
+    {
+        return _objectsBySlot.empty();
+    }
+
+    // Invokes the given functor for each slot, passing the transforms of the distinct objects using it
+    void foreachSlot(const std::function<void(IGeometryStore::Slot, const std::vector<Matrix4>&)>& functor)
+    {
+        for (auto& [slot, objects] : _objectsBySlot)
+        {
+            std::sort(objects.begin(), objects.end());
+            objects.erase(std::unique(objects.begin(), objects.end()), objects.end());
+
+            _transforms.clear();
+
+            for (auto* object : objects)
+            {
+                _transforms.push_back(object->getObjectTransform());
+            }
+
+            functor(slot, _transforms);
+        }
+    }
+
+    void clear()
+    {
+        _objectsBySlot.clear();
+    }
+};
+
+}
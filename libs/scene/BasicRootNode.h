@@ -7,6 +7,9 @@
 #include "iselectiongroup.h"
 #include "iselectionset.h"
 #include "Node.h"
+#include "MaterialUsageIndex.h"
+#include "PendingEvaluationQueue.h"
+#include "NodeArena.h"
 #include "inamespace.h"
 #include "UndoFileChangeTracker.h"
 #include "KeyValueStore.h"
@@ -30,6 +33,9 @@ private:
     selection::ISelectionSetManager::Ptr _selectionSetManager;
     ILayerManager::Ptr _layerManager;
     IUndoSystem::Ptr _undoSystem;
+    MaterialUsageIndex _materialUsageIndex;
+    PendingEvaluationQueue _pendingEvaluationQueue;
+    NodeArena::Ptr _nodeArena; // stays empty, nodes are taken from the system heap
     AABB _emptyAABB;
 
 public:
@@ -83,6 +89,21 @@ public:
         return *_undoSystem;
     }
 
+    IMaterialUsageIndex& getMaterialUsageIndex() override
+    {
+        return _materialUsageIndex;
+    }
+
+    IPendingEvaluationQueue& getPendingEvaluationQueue() override
+    {
+        return _pendingEvaluationQueue;
+    }
+
+    const NodeArena::Ptr& getNodeArena() const override
+    {
+        return _nodeArena;
+    }
+
     const AABB& localAABB() const override
     {
         return _emptyAABB;
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace scene
+{
+
+/**
+ * The set of layer IDs a node is a member of, stored as a bitset.
+ *
+ * The first 64 layer IDs are held inline, which covers virtually all maps
+ * without any heap allocation, higher IDs are stored in overflow words.
+ * Iteration visits the IDs in ascending order, like the std::set<int>
+ * this class is replacing. Negative IDs are not valid layer IDs and are ignored.
+ */
+class LayerList
+{
+private:
+    using Word = std::uint64_t;
+    static constexpr int BitsPerWord = 64;
+
+    // Layers 0..63
+    Word _bits;
+
+    // Layers 64 and above, trailing zero words are allowed
+    std::vector<Word> _overflowBits;
+
+public:
+    using value_type = int;
+    using size_type = std::size_t;
+
+    class const_iterator
+    {
+    private:
+        const LayerList* _list;
+        int _layerId;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        const_iterator(const LayerList* list, int layerId) :
+            _list(list),
+            _layerId(layerId)
+        {}
+
+        int operator*() const
+        {
+            return _layerId;
+        }
+
+        const_iterator& operator++()
+        {
+            _layerId = _list->findNext(_layerId + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return _layerId == other._layerId;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return _layerId != other._layerId;
+        }
+    };
+
+    using iterator = const_iterator;
+
+    LayerList() :
+        _bits(0)
+    {}
+
+    LayerList(std::initializer_list<int> layerIds) :
+        LayerList()
+    {
+        insert(layerIds.begin(), layerIds.end());
+    }
+
+    // Adds the given layer ID, returns true if it has not been present before
+    bool insert(int layerId)
+    {
+        if (layerId < 0) return false;
+
+        auto& word = getWordForWriting(layerId / BitsPerWord);
+        auto mask = Word(1) << (layerId % BitsPerWord);
+
+        if (word & mask) return false;
+
+        word |= mask;
+        return true;
+    }
+
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(*first);
+        }
+    }
+
+    // Removes the given layer ID, returns the number of removed elements (0 or 1)
+    size_type erase(int layerId)
+    {
+        if (!contains(layerId)) return 0;
+
+        auto index = layerId / BitsPerWord;
+        auto& word = index == 0 ? _bits : _overflowBits[index - 1];
+        word &= ~(Word(1) << (layerId % BitsPerWord));
+
+        return 1;
+    }
+
+    bool contains(int layerId) const
+    {
+        return layerId >= 0 && (getWord(layerId / BitsPerWord) & (Word(1) << (layerId % BitsPerWord))) != 0;
+    }
+
+    size_type count(int layerId) const
+    {
+        return contains(layerId) ? 1 : 0;
+    }
+
+    const_iterator find(int layerId) const
+    {
+        return contains(layerId) ? const_iterator(this, layerId) : end();
+    }
+
+    // Returns true if any layer ID is a member of both lists
+    bool intersects(const LayerList& other) const
+    {
+        if (_bits & other._bits) return true;
+
+        auto numWords = std::min(_overflowBits.size(), other._overflowBits.size());
+
+        for (std::size_t i = 0; i < numWords; ++i)
+        {
+            if (_overflowBits[i] & other._overflowBits[i]) return true;
+        }
+
+        return false;
+    }
+
+    bool empty() const
+    {
+        if (_bits != 0) return false;
+
+        for (auto word : _overflowBits)
+        {
+            if (word != 0) return false;
+        }
+
+        return true;
+    }
+
+    size_type size() const
+    {
+        auto result = std::bitset<BitsPerWord>(_bits).count();
+
+        for (auto word : _overflowBits)
+        {
+            result += std::bitset<BitsPerWord>(word).count();
+        }
+
+        return result;
+    }
+
+    void clear()
+    {
+        _bits = 0;
+        _overflowBits.clear();
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, findNext(0));
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, getEndId());
+    }
+
+    bool operator==(const LayerList& other) const
+    {
+        if (_bits != other._bits) return false;
+
+        auto numWords = std::max(_overflowBits.size(), other._overflowBits.size());
+
+        for (std::size_t i = 0; i < numWords; ++i)
+        {
+            if (getWord(i + 1) != other.getWord(i + 1)) return false;
+        }
+
+        return true;
+    }
+
+    bool operator!=(const LayerList& other) const
+    {
+        return !operator==(other);
+    }
+
+private:
+    Word getWord(std::size_t index) const
+    {
+        if (index == 0) return _bits;
+
+        return index <= _overflowBits.size() ? _overflowBits[index - 1] : 0;
+    }
+
+    Word& getWordForWriting(std::size_t index)
+    {
+        if (index == 0) return _bits;
+
+        if (index > _overflowBits.size())
+        {
+            _overflowBits.resize(index, 0);
+        }
+
+        return _overflowBits[index - 1];
+    }
+
+    // The ID one past the highest representable layer
+    int getEndId() const
+    {
+        return static_cast<int>((_overflowBits.size() + 1) * BitsPerWord);
+    }
+
+    // Returns the lowest member ID which is >= the given one, or the end ID
+    int findNext(int layerId) const
+    {
+        auto endId = getEndId();
+
+        while (layerId < endId)
+        {
+            auto index = static_cast<std::size_t>(layerId / BitsPerWord);
+
+            // Mask out the bits below the start position
+            auto word = getWord(index) & (~Word(0) << (layerId % BitsPerWord));
+
+            if (word != 0)
+            {
+                // The number of trailing zeros is the bit position of the lowest set bit
+                auto lowestBit = word & (~word + 1);
+                return static_cast<int>(index * BitsPerWord + std::bitset<BitsPerWord>(lowestBit - 1).count());
+            }
+
+            layerId = static_cast<int>((index + 1) * BitsPerWord);
+        }
+
+        return endId;
+    }
+};
+
+}
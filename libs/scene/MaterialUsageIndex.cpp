@@ -0,0 +1,106 @@
+#include "MaterialUsageIndex.h"
+
+#include <vector>
+#include "string/case_conv.h"
+
+namespace scene
+{
+
+void MaterialUsageIndex::addUsage(const std::string& material, MaterialUsageType type, INode& node)
+{
+    auto result = _usages.try_emplace(material);
+
+    if (result.second)
+    {
+        _spellings[string::to_lower_copy(material)].insert(material);
+    }
+
+    auto& usage = result.first->second;
+
+    ++usage.counts[static_cast<std::size_t>(type)];
+    ++usage.nodes[&node];
+}
+
+void MaterialUsageIndex::removeUsage(const std::string& material, MaterialUsageType type, INode& node)
+{
+    auto found = _usages.find(material);
+
+    if (found == _usages.end()) return;
+
+    auto& usage = found->second;
+    auto& count = usage.counts[static_cast<std::size_t>(type)];
+
+    if (count > 0)
+    {
+        --count;
+    }
+
+    auto nodeUsage = usage.nodes.find(&node);
+
+    if (nodeUsage != usage.nodes.end() && --nodeUsage->second == 0)
+    {
+        usage.nodes.erase(nodeUsage);
+    }
+
+    if (!usage.nodes.empty()) return;
+
+    // No more users left, remove this material from the index
+    auto spellings = _spellings.find(string::to_lower_copy(material));
+
+    if (spellings != _spellings.end())
+    {
+        spellings->second.erase(material);
+
+        if (spellings->second.empty())
+        {
+            _spellings.erase(spellings);
+        }
+    }
+
+    _usages.erase(found);
+}
+
+std::size_t MaterialUsageIndex::getUsageCount(const std::string& material, MaterialUsageType type) const
+{
+    auto found = _usages.find(material);
+
+    return found != _usages.end() ? found->second.counts[static_cast<std::size_t>(type)] : 0;
+}
+
+void MaterialUsageIndex::foreachMaterial(const std::function<void(const std::string&)>& functor) const
+{
+    for (const auto& [material, _] : _usages)
+    {
+        functor(material);
+    }
+}
+
+void MaterialUsageIndex::foreachNodeUsingMaterial(const std::string& material,
+    const std::function<void(const INodePtr&)>& functor) const
+{
+    auto spellings = _spellings.find(string::to_lower_copy(material));
+
+    if (spellings == _spellings.end()) return;
+
+    // Collect the nodes first, the functor is allowed to change materials
+    std::set<INode*> visited;
+    std::vector<INodePtr> nodes;
+
+    for (const auto& spelling : spellings->second)
+    {
+        for (const auto& [node, _] : _usages.at(spelling).nodes)
+        {
+            if (visited.insert(node).second)
+            {
+                nodes.emplace_back(node->getSelf());
+            }
+        }
+    }
+
+    for (const auto& node : nodes)
+    {
+        functor(node);
+    }
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <set>
+#include <unordered_map>
+#include "imaterialusageindex.h"
+
+namespace scene
+{
+
+/**
+ * Default implementation of the IMaterialUsageIndex interface,
+ * as used by the map root nodes.
+ */
+class MaterialUsageIndex final :
+    public IMaterialUsageIndex
+{
+private:
+    struct Usage
+    {
+        // Number of uses, indexed by MaterialUsageType
+        std::array<std::size_t, 3> counts = { 0, 0, 0 };
+
+        // Number of uses per node, brush nodes use a material once per face
+        std::unordered_map<INode*, std::size_t> nodes;
+    };
+
+    // Usage information, keyed by the exact material name
+    std::unordered_map<std::string, Usage> _usages;
+
+    // Maps lowercase material names to the spellings used as keys in _usages
+    std::unordered_map<std::string, std::set<std::string>> _spellings;
+
+public:
+    void addUsage(const std::string& material, MaterialUsageType type, INode& node) override;
+    void removeUsage(const std::string& material, MaterialUsageType type, INode& node) override;
+
+    std::size_t getUsageCount(const std::string& material, MaterialUsageType type) const override;
+
+    void foreachMaterial(const std::function<void(const std::string&)>& functor) const override;
+
+    void foreachNodeUsingMaterial(const std::string& material,
+        const std::function<void(const INodePtr&)>& functor) const override;
+};
+
+}
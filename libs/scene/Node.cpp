@@ -126,27 +126,40 @@ bool Node::excluded() const
 
 void Node::addToLayer(int layerId)
 {
-	_layers.insert(layerId);
+	auto previousLayers = _layers;
+
+	if (_layers.insert(layerId))
+	{
+		onLayersChanged(previousLayers);
+	}
 }
 
 void Node::moveToLayer(int layerId)
 {
+	auto previousLayers = _layers;
+
 	_layers.clear();
 	_layers.insert(layerId);
+
+	if (_layers != previousLayers)
+	{
+		onLayersChanged(previousLayers);
+	}
 }
 
 void Node::removeFromLayer(int layerId)
 {
-	// Look up the layer ID and remove it from the list
-	LayerList::iterator found = _layers.find(layerId);
-
-	if (found != _layers.end()) {
-		_layers.erase(found);
+	auto previousLayers = _layers;
 
+	// Remove the layer ID from the list
+	if (_layers.erase(layerId) > 0)
+	{
 		// greebo: Make sure that every node is at least member of layer 0
 		if (_layers.empty()) {
 			_layers.insert(0);
 		}
+
+		onLayersChanged(previousLayers);
 	}
 }
 
@@ -157,12 +170,28 @@ const LayerList& Node::getLayers() const
 
 void Node::assignToLayers(const LayerList& newLayers)
 {
-	if (!newLayers.empty())
+	if (!newLayers.empty() && newLayers != _layers)
     {
+		auto previousLayers = _layers;
         _layers = newLayers;
+
+		onLayersChanged(previousLayers);
     }
 }
 
+void Node::onLayersChanged(const LayerList& previousLayers)
+{
+	// Nodes outside the scene are indexed once they're inserted
+	if (!_instantiated) return;
+
+	auto rootNode = getRootNode();
+
+	if (rootNode)
+	{
+		rootNode->getLayerManager().onNodeLayersChanged(*this, previousLayers);
+	}
+}
+
 void Node::addChildNode(const INodePtr& node)
 {
 	// Add the node to the TraversableNodeSet, this triggers an
@@ -302,12 +331,22 @@ void Node::onInsertIntoScene(IMapRootNode& root)
     }
 
     connectUndoSystem(root.getUndoSystem());
+
+    if (getNodeType() != Type::MapRoot)
+    {
+        root.getLayerManager().onNodeInserted(*this);
+    }
 }
 
 void Node::onRemoveFromScene(IMapRootNode& root)
 {
     disconnectUndoSystem(root.getUndoSystem());
 
+    if (getNodeType() != Type::MapRoot)
+    {
+        root.getLayerManager().onNodeRemoved(*this);
+    }
+
     bool wasVisible = visible();
 
 	_instantiated = false;
@@ -229,6 +229,9 @@ private:
     void connectUndoSystem(IUndoSystem& undoSystem);
     void disconnectUndoSystem(IUndoSystem& undoSystem);
 
+    // Notifies the layer manager of the scene about a membership change
+    void onLayersChanged(const LayerList& previousLayers);
+
 	void evaluateBounds() const;
 	void evaluateChildBounds() const;
 	void evaluateTransform() const;
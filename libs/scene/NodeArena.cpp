@@ -0,0 +1,185 @@
+#include "NodeArena.h"
+
+#include <cassert>
+#include <new>
+
+namespace scene
+{
+
+namespace
+{
+    thread_local NodeArena::Ptr _currentArena;
+
+    constexpr std::size_t NumSizeClasses = NodeArena::MaxPooledSize / NodeArena::Granularity;
+
+    inline std::size_t getSizeClass(std::size_t size)
+    {
+        return (size + NodeArena::Granularity - 1) / NodeArena::Granularity - 1;
+    }
+
+    inline std::size_t getChunkSize(std::size_t size)
+    {
+        return (getSizeClass(size) + 1) * NodeArena::Granularity;
+    }
+
+    class HeapTimer
+    {
+    private:
+        std::chrono::nanoseconds& _total;
+        std::chrono::steady_clock::time_point _start;
+
+    public:
+        HeapTimer(std::chrono::nanoseconds& total) :
+            _total(total),
+            _start(std::chrono::steady_clock::now())
+        {}
+
+        ~HeapTimer()
+        {
+            _total += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - _start);
+        }
+    };
+}
+
+NodeArena::NodeArena() :
+    _cursor(nullptr),
+    _end(nullptr),
+    _freeLists(NumSizeClasses, nullptr)
+{}
+
+NodeArena::~NodeArena()
+{
+    // Every allocator refers to this arena, nothing can be alive anymore
+    assert(_stats.allocations == _stats.deallocations);
+
+    for (auto block : _blocks)
+    {
+        ::operator delete(block);
+    }
+}
+
+bool NodeArena::IsPooled(std::size_t size, std::size_t alignment)
+{
+    // Chunks are aligned like the blocks they are carved from
+    return size > 0 && size <= MaxPooledSize && alignment <= Granularity &&
+        alignment <= alignof(std::max_align_t);
+}
+
+void* NodeArena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    ++_stats.allocations;
+
+    if (!IsPooled(size, alignment))
+    {
+        ++_stats.largeAllocations;
+        _stats.bytesInUse += size;
+
+        HeapTimer timer(_stats.heapTime);
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+
+    auto sizeClass = getSizeClass(size);
+    auto chunkSize = getChunkSize(size);
+
+    _stats.bytesInUse += chunkSize;
+
+    // Re-use a previously freed chunk of the same size
+    auto& freeList = _freeLists[sizeClass];
+
+    if (freeList != nullptr)
+    {
+        auto chunk = freeList;
+        freeList = *static_cast<void**>(chunk);
+        return chunk;
+    }
+
+    if (static_cast<std::size_t>(_end - _cursor) < chunkSize)
+    {
+        // The rest of the current block is abandoned, it's smaller than a chunk
+        HeapTimer timer(_stats.heapTime);
+
+        auto block = static_cast<char*>(::operator new(BlockSize));
+        _blocks.push_back(block);
+        ++_stats.blocks;
+
+        _cursor = block;
+        _end = block + BlockSize;
+    }
+
+    auto chunk = _cursor;
+    _cursor += chunkSize;
+
+    return chunk;
+}
+
+void NodeArena::deallocate(void* pointer, std::size_t size, std::size_t alignment) noexcept
+{
+    if (pointer == nullptr) return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    ++_stats.deallocations;
+
+    if (!IsPooled(size, alignment))
+    {
+        _stats.bytesInUse -= size;
+        ::operator delete(pointer, std::align_val_t(alignment));
+        return;
+    }
+
+    _stats.bytesInUse -= getChunkSize(size);
+
+    // Push the chunk to the front of its free list
+    auto& freeList = _freeLists[getSizeClass(size)];
+
+    *static_cast<void**>(pointer) = freeList;
+    freeList = pointer;
+}
+
+NodeArena::Statistics NodeArena::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _stats;
+}
+
+const NodeArena::Ptr& NodeArena::GetCurrent()
+{
+    return _currentArena;
+}
+
+void* NodeArena::Allocate(const Ptr& arena, std::size_t size, std::size_t alignment)
+{
+    if (arena)
+    {
+        return arena->allocate(size, alignment);
+    }
+
+    return ::operator new(size, std::align_val_t(alignment));
+}
+
+void NodeArena::Deallocate(const Ptr& arena, void* pointer, std::size_t size, std::size_t alignment) noexcept
+{
+    if (arena)
+    {
+        arena->deallocate(pointer, size, alignment);
+        return;
+    }
+
+    ::operator delete(pointer, std::align_val_t(alignment));
+}
+
+NodeArena::Scope::Scope(const Ptr& arena) :
+    _previous(_currentArena)
+{
+    _currentArena = arena;
+}
+
+NodeArena::Scope::~Scope()
+{
+    _currentArena = _previous;
+}
+
+}
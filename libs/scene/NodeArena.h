@@ -0,0 +1,184 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace scene
+{
+
+/**
+ * Slab allocator for the nodes, faces and child lists created while
+ * loading or pasting a map.
+ *
+ * Memory is carved from large blocks. Freed chunks are kept in one free
+ * list per size class and handed out again, the blocks themselves are only
+ * returned to the system heap when the arena is destroyed. Every allocation
+ * made through a NodeArenaAllocator keeps a reference to the arena, so it
+ * lives until the last object allocated from it is gone - for a loaded map
+ * that is usually when its root node is destroyed.
+ *
+ * Objects larger than MaxPooledSize or with extended alignment are passed
+ * through to the system heap, but still counted in the statistics.
+ *
+ * The arena is safe to be used from several threads.
+ */
+class NodeArena
+{
+public:
+    using Ptr = std::shared_ptr<NodeArena>;
+
+    // Size of the blocks requested from the system heap
+    static constexpr std::size_t BlockSize = 256 * 1024;
+
+    // Chunk sizes are rounded up to a multiple of this value
+    static constexpr std::size_t Granularity = 16;
+
+    // Larger allocations are not pooled
+    static constexpr std::size_t MaxPooledSize = 4096;
+
+    struct Statistics
+    {
+        std::size_t allocations = 0;      // total number of allocations
+        std::size_t deallocations = 0;    // total number of deallocations
+        std::size_t bytesInUse = 0;       // bytes held by live allocations (rounded up)
+        std::size_t blocks = 0;           // number of blocks requested from the system heap
+        std::size_t largeAllocations = 0; // allocations passed through to the system heap
+
+        // Time spent in the system heap, acquiring blocks and large allocations
+        std::chrono::nanoseconds heapTime = std::chrono::nanoseconds::zero();
+
+        std::size_t getReservedBytes() const
+        {
+            return blocks * BlockSize;
+        }
+    };
+
+private:
+    mutable std::mutex _lock;
+
+    std::vector<void*> _blocks;
+
+    // The unused rest of the most recent block
+    char* _cursor;
+    char* _end;
+
+    // Heads of the singly linked free lists, one per size class
+    std::vector<void*> _freeLists;
+
+    Statistics _stats;
+
+public:
+    NodeArena();
+    ~NodeArena();
+
+    NodeArena(const NodeArena& other) = delete;
+    NodeArena& operator=(const NodeArena& other) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment);
+    void deallocate(void* pointer, std::size_t size, std::size_t alignment) noexcept;
+
+    Statistics getStatistics() const;
+
+    // Returns the arena new nodes of the calling thread are allocated from, can be empty
+    static const Ptr& GetCurrent();
+
+    // Allocates from the given arena, or from the system heap if it is empty
+    static void* Allocate(const Ptr& arena, std::size_t size, std::size_t alignment);
+    static void Deallocate(const Ptr& arena, void* pointer, std::size_t size, std::size_t alignment) noexcept;
+
+    /**
+     * Makes the given arena the current one of the calling thread for the lifetime
+     * of this object, e.g. while a map is parsed. Scopes can be nested.
+     */
+    class Scope
+    {
+    private:
+        Ptr _previous;
+
+    public:
+        Scope(const Ptr& arena);
+        ~Scope();
+
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+    };
+
+private:
+    static bool IsPooled(std::size_t size, std::size_t alignment);
+};
+
+/**
+ * Standard allocator drawing from a NodeArena. A default-constructed
+ * allocator binds to the current arena of the calling thread (see NodeArena::Scope),
+ * without a current arena it falls back to the system heap.
+ */
+template<typename T>
+class NodeArenaAllocator
+{
+private:
+    NodeArena::Ptr _arena;
+
+public:
+    using value_type = T;
+
+    NodeArenaAllocator() noexcept :
+        _arena(NodeArena::GetCurrent())
+    {}
+
+    explicit NodeArenaAllocator(const NodeArena::Ptr& arena) noexcept :
+        _arena(arena)
+    {}
+
+    template<typename U>
+    NodeArenaAllocator(const NodeArenaAllocator<U>& other) noexcept :
+        _arena(other.getArena())
+    {}
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(NodeArena::Allocate(_arena, count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept
+    {
+        NodeArena::Deallocate(_arena, pointer, count * sizeof(T), alignof(T));
+    }
+
+    const NodeArena::Ptr& getArena() const noexcept
+    {
+        return _arena;
+    }
+
+    template<typename U>
+    bool operator==(const NodeArenaAllocator<U>& other) const noexcept
+    {
+        return _arena == other.getArena();
+    }
+
+    template<typename U>
+    bool operator!=(const NodeArenaAllocator<U>& other) const noexcept
+    {
+        return _arena != other.getArena();
+    }
+};
+
+// Creates a shared object in the current arena of the calling thread
+// (object and control block in one chunk), or using std::make_shared if there is none.
+template<typename T, typename... Args>
+std::shared_ptr<T> makeArenaShared(Args&&... args)
+{
+    const auto& arena = NodeArena::GetCurrent();
+
+    if (!arena)
+    {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+
+    return std::allocate_shared<T>(NodeArenaAllocator<T>(arena), std::forward<Args>(args)...);
+}
+
+} // namespace
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ipendingevaluation.h"
+
+#include <array>
+#include <unordered_set>
+
+namespace scene
+{
+
+class PendingEvaluationQueue final :
+    public IPendingEvaluationQueue
+{
+private:
+    std::array<std::unordered_set<IPendingEvaluation*>, 2> _pending;
+
+public:
+    void add(PendingEvaluationType type, IPendingEvaluation& element) override
+    {
+        _pending[static_cast<std::size_t>(type)].insert(&element);
+    }
+
+    void remove(PendingEvaluationType type, IPendingEvaluation& element) override
+    {
+        _pending[static_cast<std::size_t>(type)].erase(&element);
+    }
+
+    std::vector<IPendingEvaluation*> takeAll(PendingEvaluationType type) override
+    {
+        auto& pending = _pending[static_cast<std::size_t>(type)];
+
+        std::vector<IPendingEvaluation*> elements(pending.begin(), pending.end());
+        pending.clear();
+
+        return elements;
+    }
+};
+
+}
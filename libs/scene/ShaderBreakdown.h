@@ -10,13 +10,16 @@
 #include "iparticles.h"
 #include "iparticlestage.h"
 #include "iscenegraph.h"
+#include "imap.h"
+#include "imaterialusageindex.h"
 
 namespace scene
 {
 
 /**
- * greebo: This object traverses the scenegraph on construction
- * counting all occurrences of each shader.
+ * greebo: This object collects the occurrences of each shader on construction.
+ * Face, patch and model counts are taken from the map's material usage index,
+ * only the particle nodes need to be located by traversing the scenegraph.
  */
 class ShaderBreakdown :
 	public scene::NodeVisitor
@@ -39,27 +42,30 @@ public:
 	ShaderBreakdown()
 	{
 		_map.clear();
-		GlobalSceneGraph().root()->traverseChildren(*this);
+
+		auto root = GlobalMapModule().getRoot();
+
+		if (!root) return;
+
+		const auto& index = root->getMaterialUsageIndex();
+
+		index.foreachMaterial([&](const std::string& material)
+		{
+			auto& counts = _map[material];
+
+			counts[OwnerType::Face] = index.getUsageCount(material, MaterialUsageType::Face);
+			counts[OwnerType::Patch] = index.getUsageCount(material, MaterialUsageType::Patch);
+			counts[OwnerType::Model] = index.getUsageCount(material, MaterialUsageType::Model);
+		});
+
+		root->traverseChildren(*this);
 	}
 
 	bool pre(const scene::INodePtr& node) override
 	{
-		// Check if this node is a patch
-		if (Node_isPatch(node))
+		// Primitives and models are covered by the material index
+		if (Node_isBrush(node) || Node_isPatch(node) || Node_isModel(node))
 		{
-			increaseShaderCount(Node_getIPatch(node)->getShader(), OwnerType::Patch);
-			return false;
-		}
-
-		if (Node_isBrush(node))
-        {
-			auto brush = Node_getIBrush(node);
-			
-			for (std::size_t i = 0; i < brush->getNumFaces(); ++i)
-            {
-                increaseShaderCount(brush->getFace(i).getShader(), OwnerType::Face);
-            }
-
 			return false;
 		}
 
@@ -84,25 +90,6 @@ public:
                 increaseShaderCount(material, OwnerType::Particle);
             }
 
-            return false;
-        }
-
-        if (Node_isModel(node))
-        {
-            auto modelNode = Node_getModel(node);
-
-            std::set<std::string> usedMaterials;
-
-            for (const auto& material : modelNode->getIModel().getActiveMaterials())
-            {
-                usedMaterials.insert(material);
-            }
-
-            for (const auto& material : usedMaterials)
-            {
-                increaseShaderCount(material, OwnerType::Model);
-            }
-
             return false;
         }
 
@@ -4,6 +4,7 @@
 #include "iundo.h"
 #include <list>
 #include "util/Noncopyable.h"
+#include "NodeArena.h"
 
 namespace scene
 {
@@ -25,7 +26,8 @@ class TraversableNodeSet final :
 	public sigc::trackable
 {
 public:
-	typedef std::list<INodePtr> NodeList;
+	// The list nodes are drawn from the arena current at construction time
+	typedef std::list<INodePtr, NodeArenaAllocator<INodePtr>> NodeList;
 
 private:
 	NodeList _children;
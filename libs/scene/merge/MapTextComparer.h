@@ -0,0 +1,437 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser/ParseException.h"
+#include "string/hash.h"
+
+namespace scene
+{
+
+namespace merge
+{
+
+/**
+ * Compares two maps in the brace-structured text format (like Doom 3 or
+ * Quake 4 maps) by reading their streams, without creating any scene nodes.
+ *
+ * Each entity block is reduced to a hash of its key values and the hashes
+ * of its primitive blocks, entities are matched by name (the worldspawn by
+ * its classname). This is much cheaper than loading both maps and running
+ * the GraphComparer, at the cost of only being able to tell which entities
+ * differ, not how. Formatting differences like whitespace or comments are
+ * ignored, differently formatted numbers are not.
+ *
+ * The Source is considered to be the "newer" map with the changes,
+ * the Base resembles the "older" map the Source is based on.
+ */
+class MapTextComparer
+{
+public:
+    struct EntityDifference
+    {
+        std::string entityName;
+
+        enum class Type
+        {
+            EntityAdded,    // entity is present in the source, but not in the base
+            EntityRemoved,  // entity is present in the base, but not in the source
+            EntityChanged,  // entity is present in both maps, but its contents differ
+        };
+
+        Type type;
+
+        // Only set for changed entities
+        bool keyValuesChanged = false;
+        std::size_t numPrimitivesAdded = 0;
+        std::size_t numPrimitivesRemoved = 0;
+    };
+
+    struct Result
+    {
+        std::size_t numSourceEntities = 0;
+        std::size_t numBaseEntities = 0;
+
+        // Differences sorted by entity name
+        std::vector<EntityDifference> differences;
+
+        bool hasDifferences() const
+        {
+            return !differences.empty();
+        }
+
+        std::size_t countDifferences(EntityDifference::Type type) const
+        {
+            return std::count_if(differences.begin(), differences.end(),
+                [&](const EntityDifference& difference) { return difference.type == type; });
+        }
+    };
+
+private:
+    struct EntityBlock
+    {
+        std::uint64_t keyValueHash = 0;
+
+        // Sorted, to ignore the order of the primitives
+        std::vector<std::uint64_t> primitiveHashes;
+
+        bool operator==(const EntityBlock& other) const
+        {
+            return keyValueHash == other.keyValueHash && primitiveHashes == other.primitiveHashes;
+        }
+    };
+
+    using EntityBlocks = std::map<std::string, EntityBlock>;
+
+    // Splits the stream into tokens, skipping whitespace and comments
+    class Scanner
+    {
+    private:
+        std::istreambuf_iterator<char> _cur;
+        std::istreambuf_iterator<char> _end;
+
+    public:
+        enum class TokenType
+        {
+            OpenBrace,
+            CloseBrace,
+            QuotedString,
+            Word,
+            EndOfStream,
+        };
+
+        Scanner(std::istream& stream) :
+            _cur(stream),
+            _end()
+        {}
+
+        // Reads the next token into the given string (quotes are stripped)
+        TokenType next(std::string& token)
+        {
+            token.clear();
+
+            while (_cur != _end)
+            {
+                auto c = *_cur;
+
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+                {
+                    ++_cur;
+                    continue;
+                }
+
+                if (c == '/')
+                {
+                    ++_cur;
+
+                    if (_cur != _end && *_cur == '/')
+                    {
+                        skipLine();
+                        continue;
+                    }
+
+                    if (_cur != _end && *_cur == '*')
+                    {
+                        skipBlockComment();
+                        continue;
+                    }
+
+                    token.push_back(c);
+                    readWord(token);
+                    return TokenType::Word;
+                }
+
+                ++_cur;
+
+                if (c == '{') return TokenType::OpenBrace;
+                if (c == '}') return TokenType::CloseBrace;
+
+                if (c == '"')
+                {
+                    readQuotedString(token);
+                    return TokenType::QuotedString;
+                }
+
+                token.push_back(c);
+                readWord(token);
+                return TokenType::Word;
+            }
+
+            return TokenType::EndOfStream;
+        }
+
+    private:
+        void skipLine()
+        {
+            while (_cur != _end && *_cur != '\n') ++_cur;
+        }
+
+        void skipBlockComment()
+        {
+            ++_cur; // the asterisk
+            char previous = 0;
+
+            while (_cur != _end)
+            {
+                auto c = *_cur++;
+                if (previous == '*' && c == '/') return;
+                previous = c;
+            }
+        }
+
+        void readQuotedString(std::string& token)
+        {
+            while (_cur != _end)
+            {
+                auto c = *_cur++;
+                if (c == '"') return;
+                token.push_back(c);
+            }
+
+            throw parser::ParseException("Unterminated quoted string in map");
+        }
+
+        void readWord(std::string& token)
+        {
+            while (_cur != _end)
+            {
+                auto c = *_cur;
+
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '{' || c == '}' || c == '"')
+                {
+                    return;
+                }
+
+                token.push_back(c);
+                ++_cur;
+            }
+        }
+    };
+
+public:
+    // Compares the two map streams, throws a parser::ParseException
+    // if any of them is not in the brace-structured text format
+    static Result Compare(std::istream& source, std::istream& base)
+    {
+        auto sourceEntities = ReadEntityBlocks(source);
+        auto baseEntities = ReadEntityBlocks(base);
+
+        Result result;
+        result.numSourceEntities = sourceEntities.size();
+        result.numBaseEntities = baseEntities.size();
+
+        // Both maps are sorted by name, walk them in parallel
+        auto s = sourceEntities.begin();
+        auto b = baseEntities.begin();
+
+        while (s != sourceEntities.end() || b != baseEntities.end())
+        {
+            if (b == baseEntities.end() || (s != sourceEntities.end() && s->first < b->first))
+            {
+                result.differences.emplace_back(EntityDifference{ s->first, EntityDifference::Type::EntityAdded });
+                ++s;
+            }
+            else if (s == sourceEntities.end() || b->first < s->first)
+            {
+                result.differences.emplace_back(EntityDifference{ b->first, EntityDifference::Type::EntityRemoved });
+                ++b;
+            }
+            else
+            {
+                if (!(s->second == b->second))
+                {
+                    result.differences.emplace_back(CreateChangedDifference(s->first, s->second, b->second));
+                }
+
+                ++s;
+                ++b;
+            }
+        }
+
+        return result;
+    }
+
+private:
+    static EntityDifference CreateChangedDifference(const std::string& name,
+        const EntityBlock& source, const EntityBlock& base)
+    {
+        EntityDifference difference{ name, EntityDifference::Type::EntityChanged };
+        difference.keyValuesChanged = source.keyValueHash != base.keyValueHash;
+
+        std::vector<std::uint64_t> delta;
+        std::set_difference(source.primitiveHashes.begin(), source.primitiveHashes.end(),
+            base.primitiveHashes.begin(), base.primitiveHashes.end(), std::back_inserter(delta));
+        difference.numPrimitivesAdded = delta.size();
+
+        delta.clear();
+        std::set_difference(base.primitiveHashes.begin(), base.primitiveHashes.end(),
+            source.primitiveHashes.begin(), source.primitiveHashes.end(), std::back_inserter(delta));
+        difference.numPrimitivesRemoved = delta.size();
+
+        return difference;
+    }
+
+    static EntityBlocks ReadEntityBlocks(std::istream& stream)
+    {
+        EntityBlocks entities;
+        Scanner scanner(stream);
+
+        std::string token;
+        std::size_t numUnnamedEntities = 0;
+
+        while (true)
+        {
+            auto type = scanner.next(token);
+
+            if (type == Scanner::TokenType::EndOfStream) break;
+
+            if (type == Scanner::TokenType::Word)
+            {
+                if (token.front() == '<')
+                {
+                    throw parser::ParseException("XML-based maps are not supported");
+                }
+
+                // Anything outside entity blocks is header information (like the map version)
+                continue;
+            }
+
+            if (type != Scanner::TokenType::OpenBrace)
+            {
+                throw parser::ParseException("Unexpected token outside entity block: " + token);
+            }
+
+            std::string name;
+            auto entity = ReadEntityBlock(scanner, token, name);
+
+            if (name.empty())
+            {
+                name = "<unnamed entity " + std::to_string(numUnnamedEntities++) + ">";
+            }
+
+            entities.emplace(std::move(name), std::move(entity));
+        }
+
+        return entities;
+    }
+
+    // Reads the entity block following an opening brace
+    static EntityBlock ReadEntityBlock(Scanner& scanner, std::string& token, std::string& name)
+    {
+        EntityBlock entity;
+        std::vector<std::pair<std::string, std::string>> keyValues;
+        std::string classname;
+
+        while (true)
+        {
+            auto type = scanner.next(token);
+
+            switch (type)
+            {
+            case Scanner::TokenType::CloseBrace:
+            {
+                // The key value order is not significant
+                std::sort(keyValues.begin(), keyValues.end());
+
+                auto hash = string::FNV1A_64_OFFSET_BASIS;
+
+                for (const auto& [key, value] : keyValues)
+                {
+                    hash = AddToHash(hash, key);
+                    hash = AddToHash(hash, value);
+                }
+
+                entity.keyValueHash = hash;
+                std::sort(entity.primitiveHashes.begin(), entity.primitiveHashes.end());
+
+                if (name.empty() && classname == "worldspawn")
+                {
+                    name = classname;
+                }
+
+                return entity;
+            }
+
+            case Scanner::TokenType::OpenBrace:
+                entity.primitiveHashes.push_back(ReadPrimitiveBlock(scanner, token));
+                break;
+
+            case Scanner::TokenType::QuotedString:
+            {
+                auto key = std::move(token);
+
+                if (scanner.next(token) != Scanner::TokenType::QuotedString)
+                {
+                    throw parser::ParseException("Expected a value for key " + key);
+                }
+
+                if (key == "name") name = token;
+                else if (key == "classname") classname = token;
+
+                keyValues.emplace_back(std::move(key), std::move(token));
+                token = std::string();
+                break;
+            }
+
+            default:
+                throw parser::ParseException("Unexpected token in entity block: " + token);
+            }
+        }
+    }
+
+    // Returns the hash of the primitive block following an opening brace
+    static std::uint64_t ReadPrimitiveBlock(Scanner& scanner, std::string& token)
+    {
+        auto hash = string::FNV1A_64_OFFSET_BASIS;
+        std::size_t depth = 1;
+
+        while (depth > 0)
+        {
+            auto type = scanner.next(token);
+
+            switch (type)
+            {
+            case Scanner::TokenType::OpenBrace:
+                ++depth;
+                hash = AddToHash(hash, '{');
+                break;
+            case Scanner::TokenType::CloseBrace:
+                --depth;
+                hash = AddToHash(hash, '}');
+                break;
+            case Scanner::TokenType::QuotedString:
+                hash = AddToHash(AddToHash(hash, '"'), token);
+                break;
+            case Scanner::TokenType::Word:
+                hash = AddToHash(hash, token);
+                break;
+            case Scanner::TokenType::EndOfStream:
+                throw parser::ParseException("Unexpected end of stream in primitive block");
+            }
+        }
+
+        return hash;
+    }
+
+    // Tokens are terminated by a zero byte, such that "a", "bc" and "ab", "c" differ
+    static std::uint64_t AddToHash(std::uint64_t hash, const std::string& token)
+    {
+        return string::fnv1a64(string::fnv1a64(token, hash), '\0');
+    }
+
+    static std::uint64_t AddToHash(std::uint64_t hash, char c)
+    {
+        return string::fnv1a64(hash, static_cast<unsigned char>(c));
+    }
+};
+
+}
+
+}
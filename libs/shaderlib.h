@@ -1,5 +1,6 @@
 #pragma once
 
+#include <set>
 #include "string/string.h"
 #include "character.h"
 #include "ishaders.h"
@@ -7,6 +8,8 @@
 #include "iundo.h"
 #include "ipatch.h"
 #include "iselection.h"
+#include "imap.h"
+#include "imaterialusageindex.h"
 #include "scene/Traverse.h"
 #include "gamelib.h"
 
@@ -92,6 +95,71 @@ public:
 	}
 };
 
+/**
+ * Walks down to the given brushes and patches, passing their visible faces
+ * and the patches to the ShaderReplacer. Hidden nodes are skipped along with
+ * their whole subgraph, like the selection walkers do, such that nothing
+ * below a hidden layer or a filtered entity is touched.
+ */
+class MaterialUserWalker :
+	public NodeVisitor
+{
+private:
+	ShaderReplacer& _replacer;
+
+	std::set<INode*> _candidates;
+
+	// The parents of the candidates, which the walker needs to descend into
+	std::set<INode*> _ancestors;
+
+public:
+	MaterialUserWalker(ShaderReplacer& replacer) :
+		_replacer(replacer)
+	{}
+
+	void addCandidate(const INodePtr& node)
+	{
+		_candidates.insert(node.get());
+
+		// Stop at the first parent known from another candidate, its own parents are known too
+		for (auto parent = node->getParent(); parent; parent = parent->getParent())
+		{
+			if (!_ancestors.insert(parent.get()).second) break;
+		}
+	}
+
+	bool pre(const INodePtr& node) override
+	{
+		if (!node->visible()) return false;
+
+		if (_candidates.count(node.get()) == 0)
+		{
+			return _ancestors.count(node.get()) > 0;
+		}
+
+		if (Node_isBrush(node))
+		{
+			auto* brush = Node_getIBrush(node);
+
+			for (std::size_t i = 0; i < brush->getNumFaces(); ++i)
+			{
+				auto& face = brush->getFace(i);
+
+				if (face.isVisible())
+				{
+					_replacer(face);
+				}
+			}
+		}
+		else if (Node_isPatch(node))
+		{
+			_replacer(*Node_getIPatch(node));
+		}
+
+		return false;
+	}
+};
+
 inline int findAndReplaceShader(const std::string& find, const std::string& replace, bool selectedOnly)
 {
 	std::string command("textureFindReplace");
@@ -110,10 +178,17 @@ inline int findAndReplaceShader(const std::string& find, const std::string& repl
 			GlobalSelectionSystem().foreachPatch(std::ref(replacer));
 		}
 	}
-	else
+	else if (auto root = GlobalMapModule().getRoot(); root)
 	{
-		scene::foreachVisibleFace(std::ref(replacer));
-		scene::foreachVisiblePatch(std::ref(replacer));
+		// Only descend towards the nodes known to be using the material
+		MaterialUserWalker walker(replacer);
+
+		root->getMaterialUsageIndex().foreachNodeUsingMaterial(find, [&](const scene::INodePtr& node)
+		{
+			walker.addCandidate(node);
+		});
+
+		root->traverseChildren(walker);
 	}
 
 	return replacer.getReplacedCount();
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <fmt/format.h>
+#include "itextstream.h"
+#include "os/fs.h"
+
+/**
+ * Helpers for the binary cache files DarkRadiant keeps next to its settings.
+ * A cache file starts with a four character magic and a version number,
+ * everything after that is up to the cache. The values are written in
+ * the native byte order, cache files are not meant to be shared between machines.
+ */
+namespace stream
+{
+
+namespace cache
+{
+
+template<typename ValueType>
+void writeValue(std::ostream& stream, ValueType value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Throws std::runtime_error if the stream runs out
+template<typename ValueType>
+ValueType readValue(std::istream& stream)
+{
+    ValueType value;
+    stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+
+    if (!stream)
+    {
+        throw std::runtime_error("Unexpected end of cache file");
+    }
+
+    return value;
+}
+
+// Writes the string prefixed by its 32 bit length
+inline void writeString(std::ostream& stream, const std::string& value)
+{
+    writeValue(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+}
+
+// Reads a string written by writeString(). To not allocate nonsense in case
+// of a corrupt file, lengths above the given maximum are refused.
+// Throws std::runtime_error on failure.
+inline std::string readString(std::istream& stream, std::uint32_t maxLength)
+{
+    auto length = readValue<std::uint32_t>(stream);
+
+    if (length > maxLength)
+    {
+        throw std::runtime_error("Invalid string length in cache file");
+    }
+
+    std::string value(length, '\0');
+    stream.read(value.data(), length);
+
+    if (!stream)
+    {
+        throw std::runtime_error("Unexpected end of cache file");
+    }
+
+    return value;
+}
+
+inline void writeHeader(std::ostream& stream, const char (&magic)[4], std::uint32_t version)
+{
+    stream.write(magic, sizeof(magic));
+    writeValue(stream, version);
+}
+
+// Returns false if the stream doesn't start with the given magic and version
+inline bool readHeader(std::istream& stream, const char (&magic)[4], std::uint32_t version)
+{
+    char fileMagic[4];
+    stream.read(fileMagic, sizeof(fileMagic));
+
+    std::uint32_t fileVersion = 0;
+    stream.read(reinterpret_cast<char*>(&fileVersion), sizeof(fileVersion));
+
+    return stream && std::memcmp(fileMagic, magic, sizeof(fileMagic)) == 0 && fileVersion == version;
+}
+
+/**
+ * Writes a cache file to a temporary file next to the target, which is
+ * moved over the target by commit(). Readers never see a partially written
+ * file, not even if the writer is interrupted or two writers race.
+ * The temporary file is removed if commit() is never reached.
+ */
+class Writer
+{
+private:
+    fs::path _targetPath;
+    fs::path _temporaryPath;
+    std::ofstream _stream;
+
+public:
+    Writer(const std::string& targetPath) :
+        _targetPath(targetPath),
+        _temporaryPath(getTemporaryPath(targetPath)),
+        _stream(_temporaryPath, std::ios::binary | std::ios::trunc)
+    {}
+
+    ~Writer()
+    {
+        if (_stream.is_open())
+        {
+            _stream.close();
+
+            std::error_code ec;
+            fs::remove(_temporaryPath, ec);
+        }
+    }
+
+    // False if the temporary file could not be opened
+    bool isOpen() const
+    {
+        return _stream.is_open();
+    }
+
+    std::ostream& getStream()
+    {
+        return _stream;
+    }
+
+    // Replaces the target file with the written contents, returns false on failure
+    bool commit()
+    {
+        _stream.close();
+
+        std::error_code ec;
+
+        if (_stream.fail())
+        {
+            fs::remove(_temporaryPath, ec);
+            return false;
+        }
+
+        fs::rename(_temporaryPath, _targetPath, ec);
+
+        if (ec)
+        {
+            rWarning() << "Cannot replace cache file " << _targetPath.string() << ": " << ec.message() << std::endl;
+            fs::remove(_temporaryPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    // Unique per thread and call, such that concurrent writers don't share a file
+    static std::string getTemporaryPath(const std::string& targetPath)
+    {
+        auto threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+        auto time = std::chrono::steady_clock::now().time_since_epoch().count();
+
+        return fmt::format("{0}.{1:x}{2:x}.tmp", targetPath, threadId, time);
+    }
+};
+
+}
+
+}
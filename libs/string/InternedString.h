@@ -0,0 +1,207 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "case_conv.h"
+
+namespace string
+{
+
+/**
+ * Handle to a string stored in a global intern table. Each distinct
+ * string is stored only once, handles are the size of a pointer and
+ * can be compared without looking at the characters.
+ *
+ * Every interned string keeps a link to its lowercase spelling, such that
+ * case-insensitive comparisons are a pointer comparison too.
+ *
+ * Interned strings are never released. The table is meant for bounded
+ * sets of strings like material names, which are shared by many objects.
+ * Note that each module binary has its own table, handles must not be
+ * passed across module boundaries.
+ */
+class InternedString
+{
+public:
+    struct Statistics
+    {
+        // Number of distinct strings in the table
+        std::size_t numStrings = 0;
+
+        // Heap memory occupied by the table, including its bookkeeping
+        std::size_t numBytes = 0;
+    };
+
+private:
+    struct Entry
+    {
+        std::string text;
+
+        // The entry of the lowercase spelling, points to itself if this is lowercase
+        const Entry* folded;
+    };
+
+    class Table
+    {
+    private:
+        std::mutex _lock;
+
+        // The keys are referencing the text of the owned entries
+        std::unordered_map<std::string_view, std::unique_ptr<Entry>> _entries;
+        std::size_t _numBytes = 0;
+
+    public:
+        const Entry* intern(const std::string& text)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            return insert(text);
+        }
+
+        const Entry* find(const std::string& text)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            auto found = _entries.find(text);
+            return found != _entries.end() ? found->second.get() : nullptr;
+        }
+
+        Statistics getStatistics()
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            // Estimate the per-node overhead of the map as key, value, next pointer and hash
+            return Statistics
+            {
+                _entries.size(),
+                _numBytes + _entries.bucket_count() * sizeof(void*) +
+                    _entries.size() * (sizeof(std::string_view) + sizeof(void*) * 2 + sizeof(std::size_t))
+            };
+        }
+
+    private:
+        const Entry* insert(const std::string& text)
+        {
+            auto found = _entries.find(text);
+
+            if (found != _entries.end())
+            {
+                return found->second.get();
+            }
+
+            auto lowercase = to_lower_copy(text);
+            auto folded = lowercase == text ? nullptr : insert(lowercase);
+
+            auto entry = std::make_unique<Entry>(Entry{ text, folded });
+            auto result = entry.get();
+
+            if (result->folded == nullptr)
+            {
+                result->folded = result;
+            }
+
+            _numBytes += sizeof(Entry) + GetHeapSize(result->text);
+            _entries.emplace(std::string_view(result->text), std::move(entry));
+
+            return result;
+        }
+    };
+
+    const Entry* _entry;
+
+    explicit InternedString(const Entry* entry) :
+        _entry(entry)
+    {}
+
+public:
+    // Constructs a handle to the empty string
+    InternedString() :
+        InternedString(GetEmptyEntry())
+    {}
+
+    // Interns the given string (if not already present) and returns a handle to it
+    explicit InternedString(const std::string& text) :
+        _entry(GetTable().intern(text))
+    {}
+
+    const std::string& str() const
+    {
+        return _entry->text;
+    }
+
+    bool empty() const
+    {
+        return _entry->text.empty();
+    }
+
+    // Case-sensitive comparison
+    bool operator==(const InternedString& other) const
+    {
+        return _entry == other._entry;
+    }
+
+    bool operator!=(const InternedString& other) const
+    {
+        return _entry != other._entry;
+    }
+
+    // Case-insensitive comparison
+    bool equalsNoCase(const InternedString& other) const
+    {
+        return _entry->folded == other._entry->folded;
+    }
+
+    /**
+     * Looks up the handle of the given string without adding it to the table.
+     * If the exact spelling is unknown, the handle of the lowercase spelling is
+     * returned, which is only suitable for case-insensitive comparisons.
+     * Returns false if the string has never been interned in any spelling,
+     * no existing handle can be equal to it then.
+     */
+    static bool Find(const std::string& text, InternedString& result)
+    {
+        auto& table = GetTable();
+
+        auto entry = table.find(text);
+
+        if (entry == nullptr)
+        {
+            // An unknown spelling might still be equal to an existing string case-insensitively
+            entry = table.find(to_lower_copy(text));
+
+            if (entry == nullptr) return false;
+        }
+
+        result = InternedString(entry);
+        return true;
+    }
+
+    static Statistics GetStatistics()
+    {
+        return GetTable().getStatistics();
+    }
+
+    // Returns the heap memory allocated by the given string, zero for short strings stored inline
+    static std::size_t GetHeapSize(const std::string& text)
+    {
+        static const auto inlineCapacity = std::string().capacity();
+        return text.capacity() > inlineCapacity ? text.capacity() + 1 : 0;
+    }
+
+private:
+    static Table& GetTable()
+    {
+        static Table _table;
+        return _table;
+    }
+
+    static const Entry* GetEmptyEntry()
+    {
+        static const Entry* _empty = GetTable().intern(std::string());
+        return _empty;
+    }
+};
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace string
+{
+
+/**
+ * 64 bit FNV-1a hash. Unlike std::hash the result is the same on every
+ * platform and in every session, which makes it suitable for file names
+ * and keys of persisted caches.
+ */
+constexpr std::uint64_t FNV1A_64_OFFSET_BASIS = 14695981039346656037ull;
+constexpr std::uint64_t FNV1A_64_PRIME = 1099511628211ull;
+
+// Adds a single byte to the given hash
+inline std::uint64_t fnv1a64(std::uint64_t hash, unsigned char byte)
+{
+    hash ^= byte;
+    hash *= FNV1A_64_PRIME;
+    return hash;
+}
+
+// Adds the given bytes to the hash, starting a new one by default
+inline std::uint64_t fnv1a64(const void* data, std::size_t length, std::uint64_t hash = FNV1A_64_OFFSET_BASIS)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        hash = fnv1a64(hash, bytes[i]);
+    }
+
+    return hash;
+}
+
+inline std::uint64_t fnv1a64(const std::string& value, std::uint64_t hash = FNV1A_64_OFFSET_BASIS)
+{
+    return fnv1a64(value.data(), value.size(), hash);
+}
+
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+
+namespace detail
+{
+
+/**
+ * Persistent set of worker threads executing the chunks handed out by
+ * parallelForChunks(). The threads are started on first use and live
+ * until the pool is destroyed at program (or module) shutdown.
+ */
+class ParallelForPool
+{
+private:
+    std::mutex _lock;
+    std::condition_variable _tasksAvailable;
+    std::deque<std::function<void()>> _tasks;
+    std::vector<std::thread> _threads;
+    bool _shutdown;
+
+    // Set on the pool workers, and on any thread while it processes chunks
+    static bool& IsInsideLoopFlag()
+    {
+        static thread_local bool isInsideLoop = false;
+        return isInsideLoop;
+    }
+
+public:
+    ParallelForPool(std::size_t numThreads) :
+        _shutdown(false)
+    {
+        for (std::size_t i = 0; i < numThreads; ++i)
+        {
+            _threads.emplace_back([this]() { run(); });
+        }
+    }
+
+    ~ParallelForPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _shutdown = true;
+        }
+
+        _tasksAvailable.notify_all();
+
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    std::size_t getNumThreads() const
+    {
+        return _threads.size();
+    }
+
+    void push(std::function<void()>&& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _tasks.emplace_back(std::move(task));
+        }
+
+        _tasksAvailable.notify_one();
+    }
+
+    // Returns true if the calling thread is processing a chunk of a parallel loop
+    static bool IsInsideParallelLoop()
+    {
+        return IsInsideLoopFlag();
+    }
+
+    // Marks the calling thread as processing chunks for the lifetime of this object
+    class LoopScope
+    {
+    private:
+        bool _previous;
+
+    public:
+        LoopScope() :
+            _previous(IsInsideLoopFlag())
+        {
+            IsInsideLoopFlag() = true;
+        }
+
+        ~LoopScope()
+        {
+            IsInsideLoopFlag() = _previous;
+        }
+    };
+
+    static ParallelForPool& Instance()
+    {
+        static ParallelForPool _instance(std::max<std::size_t>(std::thread::hardware_concurrency(), 1));
+        return _instance;
+    }
+
+private:
+    void run()
+    {
+        IsInsideLoopFlag() = true;
+
+        while (true)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                _tasksAvailable.wait(lock, [this]() { return _shutdown || !_tasks.empty(); });
+
+                if (_tasks.empty()) return; // shutting down
+
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+};
+
+}
+
+/**
+ * Splits the index range [0..count) into contiguous chunks and invokes
+ * the given functor once per chunk, passing the [begin, end) pair of the chunk.
+ * The chunks are processed by a persistent pool of worker threads, the calling
+ * thread is processing chunks as well until none are left.
+ *
+ * Ranges smaller than twice the given minimum chunk size are processed
+ * in the calling thread, without involving any workers. Calls made from within
+ * a chunk (i.e. nested parallel loops, on a pool worker or on the calling thread
+ * of the outer loop) are processed inline too, only the outermost loop is spread
+ * across the pool.
+ *
+ * This call blocks until all chunks have been processed. The first exception
+ * thrown by a chunk is re-thrown in the calling thread.
+ */
+inline void parallelForChunks(std::size_t count, std::size_t minChunkSize,
+    const std::function<void(std::size_t, std::size_t)>& processChunk)
+{
+    if (count == 0) return;
+
+    minChunkSize = std::max<std::size_t>(minChunkSize, 1);
+
+    if (detail::ParallelForPool::IsInsideParallelLoop())
+    {
+        processChunk(0, count);
+        return;
+    }
+
+    auto& pool = detail::ParallelForPool::Instance();
+
+    auto numChunks = std::min(pool.getNumThreads(), count / minChunkSize);
+
+    if (numChunks <= 1)
+    {
+        processChunk(0, count);
+        return;
+    }
+
+    auto chunkSize = (count + numChunks - 1) / numChunks;
+    numChunks = (count + chunkSize - 1) / chunkSize;
+
+    // Shared with the pool tasks, which might only get to run after this call returned
+    struct State
+    {
+        const std::function<void(std::size_t, std::size_t)>* processChunk;
+        std::size_t count;
+        std::size_t chunkSize;
+        std::size_t numChunks;
+
+        std::atomic<std::size_t> nextChunk{ 0 };
+
+        std::mutex lock;
+        std::condition_variable finished;
+        std::size_t numChunksDone = 0;
+        std::exception_ptr exception;
+
+        // Claims and processes chunks until none are left
+        void processChunks()
+        {
+            while (true)
+            {
+                auto chunk = nextChunk.fetch_add(1);
+
+                if (chunk >= numChunks) return;
+
+                std::exception_ptr chunkException;
+
+                try
+                {
+                    auto begin = chunk * chunkSize;
+                    (*processChunk)(begin, std::min(begin + chunkSize, count));
+                }
+                catch (...)
+                {
+                    chunkException = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> guard(lock);
+
+                if (chunkException && !exception)
+                {
+                    exception = chunkException;
+                }
+
+                if (++numChunksDone == numChunks)
+                {
+                    finished.notify_all();
+                }
+            }
+        }
+    };
+
+    auto state = std::make_shared<State>();
+    state->processChunk = &processChunk;
+    state->count = count;
+    state->chunkSize = chunkSize;
+    state->numChunks = numChunks;
+
+    for (std::size_t i = 1; i < numChunks; ++i)
+    {
+        pool.push([state]() { state->processChunks(); });
+    }
+
+    {
+        detail::ParallelForPool::LoopScope loopScope;
+        state->processChunks();
+    }
+
+    std::unique_lock<std::mutex> lock(state->lock);
+    state->finished.wait(lock, [&]() { return state->numChunksDone == state->numChunks; });
+
+    if (state->exception)
+    {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+/**
+ * Invokes the given functor for each index in [0..count), spreading
+ * the work across the available hardware threads.
+ * See parallelForChunks() for details.
+ */
+inline void parallelFor(std::size_t count, std::size_t minChunkSize,
+    const std::function<void(std::size_t)>& processItem)
+{
+    parallelForChunks(count, minChunkSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (auto i = begin; i < end; ++i)
+        {
+            processItem(i);
+        }
+    });
+}
+
+}
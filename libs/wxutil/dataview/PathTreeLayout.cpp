@@ -0,0 +1,227 @@
+#include "PathTreeLayout.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include "string/hash.h"
+#include "string/string.h"
+#include "util/ParallelFor.h"
+
+namespace wxutil
+{
+
+namespace
+{
+    // Sorting the children of a few hundred folders is worth a worker
+    constexpr std::size_t MIN_FOLDERS_PER_WORKER = 256;
+
+    struct LayoutBuilder
+    {
+        std::vector<PathTreeLayout::Node> nodes;
+        std::unordered_map<std::string, std::size_t> nodeIndices;
+
+        // Same recursion as VFSTreePopulator::addRecursive(), adding
+        // the missing parent folders first. Returns the node index.
+        std::size_t insert(const std::string& path, std::size_t pathIndex, bool isFolder)
+        {
+            auto existing = nodeIndices.find(path);
+
+            if (existing != nodeIndices.end())
+            {
+                return existing->second;
+            }
+
+            auto slashPos = path.rfind('/');
+
+            auto parent = slashPos != std::string::npos ?
+                insert(path.substr(0, slashPos), PathTreeLayout::NoIndex, true) : PathTreeLayout::NoIndex;
+
+            nodes.push_back(PathTreeLayout::Node
+            {
+                path,
+                slashPos != std::string::npos ? path.substr(slashPos + 1) : path,
+                parent,
+                isFolder ? PathTreeLayout::NoIndex : pathIndex,
+                isFolder
+            });
+
+            nodeIndices.emplace(path, nodes.size() - 1);
+
+            return nodes.size() - 1;
+        }
+    };
+}
+
+PathTreeLayout::Ptr PathTreeLayout::Build(const std::vector<std::string>& paths,
+    const FolderCompareFunction& folderCompare)
+{
+    LayoutBuilder builder;
+
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        builder.insert(paths[i], i, false);
+    }
+
+    const auto& nodes = builder.nodes;
+
+    // Collect the children of each node, the last list holds the top-level nodes
+    auto rootIndex = nodes.size();
+    std::vector<std::vector<std::size_t>> children(nodes.size() + 1);
+
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        children[nodes[i].parent != NoIndex ? nodes[i].parent : rootIndex].push_back(i);
+    }
+
+    std::vector<std::size_t> parentsToSort;
+
+    for (std::size_t i = 0; i < children.size(); ++i)
+    {
+        if (children[i].size() > 1)
+        {
+            parentsToSort.push_back(i);
+        }
+    }
+
+    // The sibling lists are independent of each other
+    util::parallelFor(parentsToSort.size(), MIN_FOLDERS_PER_WORKER, [&](std::size_t i)
+    {
+        auto& siblings = children[parentsToSort[i]];
+
+        std::sort(siblings.begin(), siblings.end(), [&](std::size_t a, std::size_t b)
+        {
+            const auto& nodeA = nodes[a];
+            const auto& nodeB = nodes[b];
+
+            // Folders sort before any other items
+            if (nodeA.isFolder != nodeB.isFolder)
+            {
+                return nodeA.isFolder;
+            }
+
+            if (nodeA.isFolder && folderCompare)
+            {
+                auto customResult = folderCompare(nodeA, nodeB);
+
+                if (customResult != 0)
+                {
+                    return customResult < 0;
+                }
+            }
+
+            auto result = string::icmp(nodeA.leafName.c_str(), nodeB.leafName.c_str());
+
+            if (result != 0)
+            {
+                return result < 0;
+            }
+
+            // Names only differing in case: keep the result independent of the input order
+            result = nodeA.leafName.compare(nodeB.leafName);
+
+            return result != 0 ? result < 0 : a < b;
+        });
+    });
+
+    // Flatten the tree in depth-first order
+    auto layout = std::make_shared<PathTreeLayout>();
+    layout->_nodes.reserve(nodes.size());
+
+    std::vector<std::size_t> newIndices(nodes.size(), NoIndex);
+    std::vector<std::size_t> stack(children[rootIndex].rbegin(), children[rootIndex].rend());
+
+    while (!stack.empty())
+    {
+        auto index = stack.back();
+        stack.pop_back();
+
+        const auto& node = nodes[index];
+
+        newIndices[index] = layout->_nodes.size();
+        layout->_nodes.push_back(node);
+        layout->_nodes.back().parent = node.parent != NoIndex ? newIndices[node.parent] : NoIndex;
+
+        stack.insert(stack.end(), children[index].rbegin(), children[index].rend());
+    }
+
+    return layout;
+}
+
+const std::vector<PathTreeLayout::Node>& PathTreeLayout::GetNodes() const
+{
+    return _nodes;
+}
+
+void PathTreeLayout::Populate(const TreeModel::Ptr& model, const ColumnPopulationCallback& populateRow,
+    const wxDataViewItem& topLevel) const
+{
+    std::vector<wxDataViewItem> items(_nodes.size());
+
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+    {
+        const auto& node = _nodes[i];
+
+        auto row = model->AddItemUnderParent(node.parent != NoIndex ? items[node.parent] : topLevel);
+
+        populateRow(row, node);
+
+        items[i] = row.getItem();
+    }
+}
+
+std::uint64_t PathTreeLayout::GetFingerprint(const std::vector<std::string>& paths, const std::string& salt)
+{
+    auto hash = string::FNV1A_64_OFFSET_BASIS;
+
+    auto addString = [&](const std::string& value)
+    {
+        // Zero separator, such that "a", "bc" and "ab", "c" differ
+        hash = string::fnv1a64(string::fnv1a64(value, hash), '\0');
+    };
+
+    addString(salt);
+
+    for (const auto& path : paths)
+    {
+        addString(path);
+    }
+
+    return hash;
+}
+
+PathTreeLayout::Ptr PathTreeLayoutCache::Get(std::uint64_t fingerprint)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    for (auto i = _layouts.begin(); i != _layouts.end(); ++i)
+    {
+        if (i->first == fingerprint)
+        {
+            // Move it to the front
+            _layouts.splice(_layouts.begin(), _layouts, i);
+            return _layouts.front().second;
+        }
+    }
+
+    return PathTreeLayout::Ptr();
+}
+
+void PathTreeLayoutCache::Set(std::uint64_t fingerprint, const PathTreeLayout::Ptr& layout)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    _layouts.remove_if([&](const auto& pair) { return pair.first == fingerprint; });
+    _layouts.emplace_front(fingerprint, layout);
+
+    while (_layouts.size() > Capacity)
+    {
+        _layouts.pop_back();
+    }
+}
+
+void PathTreeLayoutCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _layouts.clear();
+}
+
+}
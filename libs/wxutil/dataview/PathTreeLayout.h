@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "TreeModel.h"
+
+namespace wxutil
+{
+
+/**
+ * Plain representation of the tree a VFSTreePopulator would build from
+ * a list of slash-separated paths, with the children of every node sorted
+ * like TreeModel::SortModelFoldersFirst() does: folders first, then
+ * case-insensitively by leaf name.
+ *
+ * Building the layout doesn't touch any wx objects, the sorting is spread
+ * across worker threads. Since the result only depends on the input paths,
+ * it can be shared between populators (see PathTreeLayoutCache).
+ * Populate() creates the rows in their final order, so the model doesn't
+ * need to be sorted afterwards.
+ */
+class PathTreeLayout
+{
+public:
+    using Ptr = std::shared_ptr<const PathTreeLayout>;
+
+    static constexpr std::size_t NoIndex = std::numeric_limits<std::size_t>::max();
+
+    struct Node
+    {
+        std::string path;       // full path of this node
+        std::string leafName;   // the part after the rightmost slash
+        std::size_t parent;     // index of the parent node, NoIndex for top-level nodes
+        std::size_t pathIndex;  // index of the path passed to Build(), NoIndex for intermediate folders
+        bool isFolder;
+    };
+
+    // Optional comparison of two folders: returns a negative value if a
+    // sorts before b, a positive value for the opposite, 0 to compare the names
+    using FolderCompareFunction = std::function<int(const Node& a, const Node& b)>;
+
+    // Invoked for every created row, the callback needs to invoke row.SendItemAdded()
+    using ColumnPopulationCallback = std::function<void(TreeModel::Row& row, const Node& node)>;
+
+private:
+    // Depth-first order, every parent is listed before its children
+    std::vector<Node> _nodes;
+
+public:
+    // Builds the layout from the given paths. Paths occurring more than once
+    // are only inserted once, the first occurrence wins.
+    static Ptr Build(const std::vector<std::string>& paths,
+        const FolderCompareFunction& folderCompare = FolderCompareFunction());
+
+    const std::vector<Node>& GetNodes() const;
+
+    // Creates the rows of all nodes below the given top-level item
+    void Populate(const TreeModel::Ptr& model, const ColumnPopulationCallback& populateRow,
+        const wxDataViewItem& topLevel = wxDataViewItem()) const;
+
+    // Returns a hash of the given paths (and the salt distinguishing the folder
+    // comparison in use), identifying the layout built from them
+    static std::uint64_t GetFingerprint(const std::vector<std::string>& paths, const std::string& salt);
+};
+
+/**
+ * Keeps the most recently built layouts, keyed by the fingerprint of the paths
+ * they have been built from. Safe to be used by several populator threads.
+ */
+class PathTreeLayoutCache
+{
+private:
+    static constexpr std::size_t Capacity = 8;
+
+    std::mutex _lock;
+
+    // Most recently used first
+    std::list<std::pair<std::uint64_t, PathTreeLayout::Ptr>> _layouts;
+
+public:
+    // Returns the cached layout with the given fingerprint, or an empty pointer
+    PathTreeLayout::Ptr Get(std::uint64_t fingerprint);
+
+    void Set(std::uint64_t fingerprint, const PathTreeLayout::Ptr& layout);
+
+    void Clear();
+};
+
+}
@@ -36,6 +36,53 @@ wxEvent* ResourceTreeView::PopulationFinishedEvent::Clone() const
 wxDEFINE_EVENT(EV_TREEVIEW_POPULATION_FINISHED, ResourceTreeView::PopulationFinishedEvent);
 wxDEFINE_EVENT(EV_TREEVIEW_FILTERTEXT_CLEARED, wxCommandEvent);
 
+// Attached to the tree store before the filter's notifier, such that the
+// search index and the visible items are up to date when the filter asks for them
+class ResourceTreeView::TreeStoreObserver :
+    public wxDataViewModelNotifier
+{
+private:
+    ResourceTreeView& _owner;
+
+public:
+    TreeStoreObserver(ResourceTreeView& owner) :
+        _owner(owner)
+    {}
+
+    bool ItemAdded(const wxDataViewItem& parent, const wxDataViewItem& item) override
+    {
+        _owner.OnTreeStoreItemChanged(item);
+        return true;
+    }
+
+    bool ItemDeleted(const wxDataViewItem& parent, const wxDataViewItem& item) override
+    {
+        _owner.OnTreeStoreItemDeleted(parent, item);
+        return true;
+    }
+
+    bool ItemChanged(const wxDataViewItem& item) override
+    {
+        _owner.OnTreeStoreItemChanged(item);
+        return true;
+    }
+
+    bool ValueChanged(const wxDataViewItem& item, unsigned int col) override
+    {
+        _owner.OnTreeStoreItemChanged(item);
+        return true;
+    }
+
+    bool Cleared() override
+    {
+        _owner.OnTreeStoreCleared();
+        return true;
+    }
+
+    void Resort() override
+    {}
+};
+
 ResourceTreeView::ResourceTreeView(wxWindow* parent, const ResourceTreeView::Columns& columns, long style) :
     ResourceTreeView(parent, TreeModel::Ptr(), columns, style)
 {}
@@ -50,7 +97,10 @@ ResourceTreeView::ResourceTreeView(wxWindow* parent, const TreeModel::Ptr& model
     _columnToSelectAfterPopulation(nullptr),
     _setFavouritesRecursively(true),
     _declPathColumn(_columns.fullName),
-    _favouriteKeyColumn(_columns.fullName)
+    _favouriteKeyColumn(_columns.fullName),
+    _searchIndexIsValid(false),
+    _visibleItemsAreValid(false),
+    _treeStoreObserver(nullptr)
 {
     _treeStore = model;
 
@@ -78,6 +128,8 @@ ResourceTreeView::~ResourceTreeView()
         _populator->EnsureStopped();
         _populator.reset();
     }
+
+    StopObservingTreeStore();
 }
 
 const TreeModel::Ptr& ResourceTreeView::GetTreeModel()
@@ -94,6 +146,7 @@ void ResourceTreeView::SetTreeModel(const TreeModel::Ptr& model)
     {
         _treeModelFilter = TreeModelFilter::Ptr();
         AssociateModel(nullptr);
+        StopObservingTreeStore();
         return;
     }
 
@@ -102,6 +155,12 @@ void ResourceTreeView::SetTreeModel(const TreeModel::Ptr& model)
 
 void ResourceTreeView::SetupTreeModelFilter()
 {
+    // The observer needs to be notified before the filter
+    ObserveTreeStore();
+
+    // The view mode might have changed
+    InvalidateTreeVisibility();
+
     // Set up the filter
     _treeModelFilter.reset(new TreeModelFilter(_treeStore));
 
@@ -221,7 +280,7 @@ bool ResourceTreeView::SetFilterText(const wxString& filterText)
     {
         TreeModel::Row row(item, *GetModel());
 
-        if (!_filterText.empty() && !TreeModel::RowContainsString(row, _filterText, _colsToSearch, true))
+        if (!_filterText.empty() && !RowMatchesFilterText(row))
         {
             // The selected row is not relevant anymore
             return JumpToFirstFilterMatch();
@@ -238,6 +297,8 @@ bool ResourceTreeView::SetFilterText(const wxString& filterText)
 
 void ResourceTreeView::UpdateTreeVisibility()
 {
+    InvalidateTreeVisibility();
+
     if (_treeModelFilter)
     {
 #if defined(__WXGTK__) && !wxCHECK_VERSION(3, 0, 5)
@@ -252,11 +313,23 @@ void ResourceTreeView::UpdateTreeVisibility()
     }
 }
 
+void ResourceTreeView::InvalidateTreeVisibility()
+{
+    _visibleItems.clear();
+    _visibleItemsAreValid = false;
+}
+
 bool ResourceTreeView::JumpToFirstFilterMatch()
 {
     if (_filterText.empty() || !_treeModelFilter) return false;
 
-    auto item = _treeModelFilter->FindNextString(_filterText, _colsToSearch);
+    EnsureVisibleItems();
+
+    // Walk the store in display order, using the index instead of the column values
+    auto item = _treeStore->FindItem([&](const TreeModel::Row& row)
+    {
+        return _visibleItems.count(row.getItem().GetID()) > 0 && RowMatchesFilterText(row);
+    });
 
     if (item.IsOk())
     {
@@ -624,33 +697,161 @@ bool ResourceTreeView::IsFavouriteSelected()
 
 bool ResourceTreeView::IsTreeModelRowOrAnyChildVisible(TreeModel::Row& row)
 {
-    // Test the node itself
-    if (IsTreeModelRowVisible(row))
+    // The recursive evaluation is done once for the whole tree
+    // and then kept up to date by the tree store observer
+    EnsureVisibleItems();
+
+    return _visibleItems.count(row.getItem().GetID()) > 0;
+}
+
+void ResourceTreeView::EnsureVisibleItems()
+{
+    if (_visibleItemsAreValid || !_treeStore) return;
+
+    _visibleItems.clear();
+
+    wxDataViewItemArray children;
+    _treeStore->GetChildren(_treeStore->GetRoot(), children);
+
+    for (const wxDataViewItem& child : children)
     {
-        return true; // node is visible
+        CollectVisibleItems(child);
     }
 
-    // The node itself is invisible, but it might still be visible
-    // if any of the child nodes is visible, dive into it
+    _visibleItemsAreValid = true;
+}
+
+bool ResourceTreeView::CollectVisibleItems(const wxDataViewItem& item)
+{
+    // Every child needs to be visited to have its own visibility recorded
+    bool anyChildVisible = false;
+
     wxDataViewItemArray children;
-    _treeStore->GetChildren(row.getItem(), children);
+    _treeStore->GetChildren(item, children);
 
     for (const wxDataViewItem& child : children)
     {
-        wxutil::TreeModel::Row childRow(child, *_treeStore);
+        if (CollectVisibleItems(child))
+        {
+            anyChildVisible = true;
+        }
+    }
+
+    TreeModel::Row row(item, *_treeStore);
+
+    // A node is visible if it passes the test itself,
+    // or if any of its child nodes is visible
+    if (anyChildVisible || IsTreeModelRowVisible(row))
+    {
+        _visibleItems.insert(item.GetID());
+        return true;
+    }
 
-        // Check the child node (recursively)
-        if (IsTreeModelRowOrAnyChildVisible(childRow))
+    return false;
+}
+
+bool ResourceTreeView::HasVisibleChild(const wxDataViewItem& item)
+{
+    wxDataViewItemArray children;
+    _treeStore->GetChildren(item, children);
+
+    for (const wxDataViewItem& child : children)
+    {
+        if (_visibleItems.count(child.GetID()) > 0)
         {
-            return true; // found a visible child, this is enough
+            return true;
         }
     }
 
-    // Either we don't have any children, or 
-    // all child nodes are invisible, so this node is invisible too
     return false;
 }
 
+void ResourceTreeView::UpdateVisibleItems(const wxDataViewItem& item)
+{
+    if (!_visibleItemsAreValid) return; // will be evaluated on demand
+
+    for (auto current = item; current.IsOk(); current = _treeStore->GetParent(current))
+    {
+        TreeModel::Row row(current, *_treeStore);
+
+        bool isVisible = IsTreeModelRowVisible(row) || HasVisibleChild(current);
+        bool wasVisible = _visibleItems.count(current.GetID()) > 0;
+
+        // The parents don't need to be touched if this node didn't change
+        if (isVisible == wasVisible && current != item) break;
+
+        if (isVisible)
+        {
+            _visibleItems.insert(current.GetID());
+        }
+        else
+        {
+            _visibleItems.erase(current.GetID());
+        }
+    }
+}
+
+void ResourceTreeView::ObserveTreeStore()
+{
+    if (_observedTreeStore == _treeStore) return;
+
+    StopObservingTreeStore();
+
+    if (!_treeStore) return;
+
+    // The model takes ownership of the notifier
+    _treeStoreObserver = new TreeStoreObserver(*this);
+    _treeStore->AddNotifier(_treeStoreObserver);
+    _observedTreeStore = _treeStore;
+}
+
+void ResourceTreeView::StopObservingTreeStore()
+{
+    if (_observedTreeStore)
+    {
+        // Deletes the observer
+        _observedTreeStore->RemoveNotifier(_treeStoreObserver);
+    }
+
+    _treeStoreObserver = nullptr;
+    _observedTreeStore.reset();
+
+    OnTreeStoreCleared();
+}
+
+void ResourceTreeView::OnTreeStoreItemChanged(const wxDataViewItem& item)
+{
+    if (_searchIndexIsValid)
+    {
+        _searchIndex[item.GetID()] = GetSearchText(TreeModel::Row(item, *_treeStore));
+    }
+
+    UpdateVisibleItems(item);
+}
+
+void ResourceTreeView::OnTreeStoreItemDeleted(const wxDataViewItem& parent, const wxDataViewItem& item)
+{
+    _searchIndex.erase(item.GetID());
+
+    if (!_visibleItemsAreValid) return;
+
+    // The item might still be listed as child of its parent
+    _visibleItems.erase(item.GetID());
+
+    if (parent.IsOk())
+    {
+        UpdateVisibleItems(parent);
+    }
+}
+
+void ResourceTreeView::OnTreeStoreCleared()
+{
+    _searchIndex.clear();
+    _searchIndexIsValid = false;
+
+    InvalidateTreeVisibility();
+}
+
 bool ResourceTreeView::IsTreeModelRowVisible(wxutil::TreeModel::Row& row)
 {
     // Check view mode
@@ -665,7 +866,47 @@ bool ResourceTreeView::IsTreeModelRowVisible(wxutil::TreeModel::Row& row)
 
 bool ResourceTreeView::IsTreeModelRowFiltered(wxutil::TreeModel::Row& row)
 {
-    return !_filterText.empty() && !TreeModel::RowContainsString(row, _filterText, _colsToSearch, true);
+    return !_filterText.empty() && !RowMatchesFilterText(row);
+}
+
+bool ResourceTreeView::RowMatchesFilterText(const TreeModel::Row& row)
+{
+    if (!_searchIndexIsValid)
+    {
+        // Lower-case all searched values once instead of on every keystroke
+        _searchIndex.clear();
+
+        _treeStore->ForeachNode([&](TreeModel::Row& node)
+        {
+            _searchIndex.emplace(node.getItem().GetID(), GetSearchText(node));
+        });
+
+        _searchIndexIsValid = true;
+    }
+
+    auto entry = _searchIndex.find(row.getItem().GetID());
+
+    if (entry == _searchIndex.end())
+    {
+        // Not reported by the store (yet), evaluate the columns directly
+        return TreeModel::RowContainsString(row, _filterText, _colsToSearch, true);
+    }
+
+    return entry->second.Contains(_filterText);
+}
+
+wxString ResourceTreeView::GetSearchText(const TreeModel::Row& row)
+{
+    wxString searchText;
+
+    // Separate the values, such that the filter text cannot span two columns
+    for (const auto& column : _colsToSearch)
+    {
+        searchText += row[column].getString().Lower();
+        searchText += '\n';
+    }
+
+    return searchText;
 }
 
 bool ResourceTreeView::IsTreeModelRowVisibleByViewMode(wxutil::TreeModel::Row& row)
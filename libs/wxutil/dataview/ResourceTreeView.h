@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
 #include "idecltypes.h"
 #include "TreeView.h"
 #include "TreeModel.h"
@@ -94,6 +96,20 @@ private:
 
     wxString _filterText;
 
+    // Lowercase copies of the searched column values, keyed by item ID.
+    // Built on first use, then kept up to date by the TreeStoreObserver.
+    std::unordered_map<void*, wxString> _searchIndex;
+    bool _searchIndexIsValid;
+
+    // The items passing the visibility test, either themselves or by any of their children
+    std::unordered_set<void*> _visibleItems;
+    bool _visibleItemsAreValid;
+
+    // Updates the search index and the visible items when the tree store changes
+    class TreeStoreObserver;
+    TreeStoreObserver* _treeStoreObserver; // owned by the observed store
+    TreeModel::Ptr _observedTreeStore;
+
     // The column that is hosting the declaration path (used by e.g. "copy to clipboard")
     TreeModel::Column _declPathColumn;
     TreeModel::Column _favouriteKeyColumn;
@@ -175,6 +191,11 @@ protected:
 
     virtual void UpdateTreeVisibility();
 
+    // Forgets about the visibility of all items, to be called by subclasses
+    // when the result of IsTreeModelRowVisible() changes for other reasons than
+    // the filter text, the tree mode or the tree contents
+    void InvalidateTreeVisibility();
+
     // Get the resource path for the given item. Determines the availabilty
     // and functionality of the "Copy resource path" context menu item
     // The default implementation returns the value of the "fullName" column.
@@ -194,6 +215,23 @@ private:
     // Returns true if the given row is filtered by an active filter text
     bool IsTreeModelRowFiltered(wxutil::TreeModel::Row& row);
 
+    // Returns true if any of the searched columns contains the filter text
+    bool RowMatchesFilterText(const TreeModel::Row& row);
+
+    wxString GetSearchText(const TreeModel::Row& row);
+    void ObserveTreeStore();
+    void StopObservingTreeStore();
+    void EnsureVisibleItems();
+    bool CollectVisibleItems(const wxDataViewItem& item);
+    bool HasVisibleChild(const wxDataViewItem& item);
+
+    // Re-evaluates the given item and its parents after a change
+    void UpdateVisibleItems(const wxDataViewItem& item);
+
+    void OnTreeStoreItemChanged(const wxDataViewItem& item);
+    void OnTreeStoreItemDeleted(const wxDataViewItem& parent, const wxDataViewItem& item);
+    void OnTreeStoreCleared();
+
     void _onContextMenu(wxDataViewEvent& ev);
     void _onTreeStorePopulationProgress(TreeModel::PopulationProgressEvent& ev);
     void _onTreeStorePopulationFinished(TreeModel::PopulationFinishedEvent& ev);
@@ -6,12 +6,14 @@
 #include "../Bitmap.h"
 #include "../Icon.h"
 #include "DeclarationTreeView.h"
+#include "PathTreeLayout.h"
 #include "ThreadedResourceTreePopulator.h"
 #include "TreeViewItemStyle.h"
 #include "VFSTreePopulator.h"
 #include "os/path.h"
 #include "string/replace.h"
 #include "string/split.h"
+#include "util/ParallelFor.h"
 
 namespace wxutil
 {
@@ -27,6 +29,9 @@ private:
     static constexpr const char* const DEFAULT_DECL_ICON = "decl.png";
     static constexpr const char* const DEFAULT_FOLDER_ICON = "folder16.png";
 
+    // Path generation is cheap, only split large declaration sets across workers
+    static constexpr std::size_t MIN_PATHS_PER_WORKER = 4096;
+
     decl::Type _type;
     const DeclarationTreeView::Columns& _columns;
 
@@ -35,6 +40,9 @@ private:
     Icon _folderIcon;
     Icon _declIcon;
 
+    // Set once the rows have been inserted in their final order
+    bool _modelIsSorted;
+
 public:
     ThreadedDeclarationTreePopulator(decl::Type type, const DeclarationTreeView::Columns& columns) :
         ThreadedDeclarationTreePopulator(type, columns, DEFAULT_DECL_ICON, DEFAULT_FOLDER_ICON)
@@ -51,7 +59,8 @@ public:
         _type(type),
         _columns(columns),
         _declIcon(GetLocalBitmap(declIcon)),
-        _folderIcon(GetLocalBitmap(folderIcon))
+        _folderIcon(GetLocalBitmap(folderIcon)),
+        _modelIsSorted(false)
     {
         // Assemble the set of favourites for the given declaration type
         _favourites = GlobalFavouritesManager().getFavourites(decl::getTypeName(type));
@@ -66,7 +75,8 @@ public:
     // Subclasses should override the default implementation (without calling the base) if not suitable
     void PopulateModel(const TreeModel::Ptr& model) override
     {
-        VFSTreePopulator populator(model);
+        std::vector<std::string> modNames;
+        std::vector<std::string> declNames;
 
         GlobalDeclarationManager().foreachDeclaration(_type, [&](const decl::IDeclaration::Ptr& decl)
         {
@@ -77,24 +87,33 @@ public:
                 return; // skip hidden declarations
             }
 
-            auto fullPath = GenerateFullDeclPath(decl);
+            modNames.emplace_back(decl->getModName());
+            declNames.emplace_back(decl->getDeclName());
+        });
 
-            // Sort the decl into the tree and set the values
-            populator.addPath(fullPath, [&](TreeModel::Row& row,
-                const std::string& path, const std::string& leafName, bool isFolder)
-            {
-                AssignValuesToRow(row, path, isFolder ? path : decl->getDeclName(), leafName, isFolder);
-            });
+        // Every worker writes to its own range of paths, the order stays the same
+        std::vector<std::string> paths(declNames.size());
+
+        util::parallelFor(paths.size(), MIN_PATHS_PER_WORKER, [&](std::size_t i)
+        {
+            paths[i] = GenerateFullDeclPath(modNames[i], declNames[i]);
         });
+
+        PopulateFromPaths(model, paths, declNames);
     }
 
     // Generates the full path the given declaration should be sorted into.
     static std::string GenerateFullDeclPath(const decl::IDeclaration::Ptr& decl)
+    {
+        return GenerateFullDeclPath(decl->getModName(), decl->getDeclName());
+    }
+
+    static std::string GenerateFullDeclPath(const std::string& modName, const std::string& declName)
     {
         // Some names contain backslashes, sort them in the tree by replacing the backslashes
-        auto nameForwardSlashes = os::standardPath(decl->getDeclName());
+        auto nameForwardSlashes = os::standardPath(declName);
 
-        return decl->getModName() + "/" + nameForwardSlashes;
+        return modName + "/" + nameForwardSlashes;
     }
 
     // Add the given named decl to the tree (assuming it was not present before)
@@ -186,6 +205,11 @@ protected:
     // Default sorting behaviour is to sort the tree alphabetically with folders on top
     void SortModel(const TreeModel::Ptr& model) override
     {
+        if (_modelIsSorted)
+        {
+            return; // populated from a layout, nothing to do
+        }
+
         SortModel(model, wxDataViewItem());
     }
 
@@ -194,6 +218,56 @@ protected:
         model->SortModelFoldersFirst(startItem, _columns.leafName, _columns.isFolder);
     }
 
+    // Layouts shared by all declaration populators: as long as the declarations
+    // don't change, re-opening a chooser doesn't need to build the tree again
+    static PathTreeLayoutCache& GetLayoutCache()
+    {
+        static PathTreeLayoutCache _layoutCache;
+        return _layoutCache;
+    }
+
+    // Returns the (possibly cached) layout of the given paths. The salt needs to
+    // be unique for each folder compare function, which is invoked by several threads.
+    PathTreeLayout::Ptr GetPathTreeLayout(const std::vector<std::string>& paths,
+        const std::string& salt = std::string(),
+        const PathTreeLayout::FolderCompareFunction& folderCompare = PathTreeLayout::FolderCompareFunction())
+    {
+        auto fingerprint = PathTreeLayout::GetFingerprint(paths, salt);
+        auto layout = GetLayoutCache().Get(fingerprint);
+
+        if (!layout)
+        {
+            layout = PathTreeLayout::Build(paths, folderCompare);
+            GetLayoutCache().Set(fingerprint, layout);
+        }
+
+        ThrowIfCancellationRequested();
+
+        return layout;
+    }
+
+    // Creates the rows of the given layout in their final order, SortModel() will leave them alone
+    void PopulateFromLayout(const TreeModel::Ptr& model, const PathTreeLayout& layout,
+        const PathTreeLayout::ColumnPopulationCallback& populateRow)
+    {
+        layout.Populate(model, populateRow);
+        _modelIsSorted = true;
+    }
+
+    // Sorts the declarations into the tree at the given paths, the declNames
+    // list the declaration of each path and are assigned to the leaf rows
+    void PopulateFromPaths(const TreeModel::Ptr& model, const std::vector<std::string>& paths,
+        const std::vector<std::string>& declNames)
+    {
+        auto layout = GetPathTreeLayout(paths);
+
+        PopulateFromLayout(model, *layout, [&](TreeModel::Row& row, const PathTreeLayout::Node& node)
+        {
+            AssignValuesToRow(row, node.path, node.isFolder ? node.path : declNames[node.pathIndex],
+                node.leafName, node.isFolder);
+        });
+    }
+
     /**
      * Populates the given row with values matching for a certain declaration or folder
      *
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <set>
 
 namespace wxutil
 {
@@ -267,6 +269,49 @@ int TreeModel::RemoveItemsRecursively(const wxDataViewItem& parent, const std::f
 	return deleteCount;
 }
 
+int TreeModel::RemoveItems(const wxDataViewItemArray& items)
+{
+	std::map<Node*, wxDataViewItemArray> itemsByParent;
+
+	for (const auto& item : items)
+	{
+		if (!item.IsOk()) continue;
+
+		Node* node = static_cast<Node*>(item.GetID());
+
+		if (node->parent == nullptr) continue; // cannot remove the root node
+
+		itemsByParent[node->parent].push_back(item);
+	}
+
+	int deleteCount = 0;
+
+	for (auto& [parentNode, itemsToDelete] : itemsByParent)
+	{
+		// Notify before the nodes are gone, see RemoveItemsRecursively
+		ItemsDeleted(parentNode->item, itemsToDelete);
+
+		std::set<Node*> nodesToDelete;
+
+		for (const auto& item : itemsToDelete)
+		{
+			nodesToDelete.insert(static_cast<Node*>(item.GetID()));
+		}
+
+		// Remove all of them in a single pass over the children
+		auto& children = parentNode->children;
+		auto newEnd = std::remove_if(children.begin(), children.end(), [&](const NodePtr& child)
+		{
+			return nodesToDelete.count(child.get()) > 0;
+		});
+
+		deleteCount += static_cast<int>(children.end() - newEnd);
+		children.erase(newEnd, children.end());
+	}
+
+	return deleteCount;
+}
+
 TreeModel::Row TreeModel::GetRootItem()
 {
 	return Row(GetRoot(), *this);
@@ -405,6 +405,10 @@ public:
 	// Remove all items matching the predicate, returns the number of deleted items
 	int RemoveItems(const std::function<bool (const Row&)>& predicate);
 
+	// Removes the given items, sending one notification per parent item.
+	// Returns the number of deleted items
+	int RemoveItems(const wxDataViewItemArray& items);
+
 	// Returns a Row reference to the topmost element
 	Row GetRootItem();
 
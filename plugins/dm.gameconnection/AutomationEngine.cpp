@@ -14,7 +14,6 @@ namespace gameconn
 namespace
 {
     const char* const DEFAULT_HOST = "localhost";
-    const int DEFAULT_PORT = 3879;
 
     inline std::string seqnoPreamble(std::size_t seq) {
         return fmt::format("seqno {0}\n", seq);
@@ -47,7 +46,7 @@ bool AutomationEngine::hasLostConnection() const
     return _connection && !_connection->isAlive();
 }
 
-bool AutomationEngine::connect()
+bool AutomationEngine::connect(int port)
 {
     if (isAlive())
         return true;    //already connected
@@ -58,7 +57,7 @@ bool AutomationEngine::connect()
     if (
         !connection->Initialize() ||
         !connection->SetNonblocking() ||
-        !connection->Open(DEFAULT_HOST, DEFAULT_PORT))
+        !connection->Open(DEFAULT_HOST, port))
     {
         return false;
     }
@@ -17,6 +17,9 @@ public:
     DisconnectException() : std::runtime_error("Game connection lost") {}
 };
 
+// The port TDM automation is listening on by default.
+static const int DEFAULT_AUTOMATION_PORT = 3879;
+
 // Bitmask with all tag bits set.
 static const int TAGMASK_ALL = -1;
 
@@ -44,9 +47,9 @@ public:
     ~AutomationEngine();
 
 
-    // Connect to TDM instance if not connected yet.
+    // Connect to TDM instance (listening on the given local port) if not connected yet.
     // Returns false if failed to connect, true on success.
-    bool connect();
+    bool connect(int port = DEFAULT_AUTOMATION_PORT);
     // Disconnect from TDM instance if connected.
     // If force = false, then it waits until all pending requests are finished.
     // If force = true, then all pending requests are dropped, no blocking for sure.
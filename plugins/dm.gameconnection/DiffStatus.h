@@ -1,6 +1,9 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <cassert>
+#include <cstdlib>
 
 namespace gameconn
 {
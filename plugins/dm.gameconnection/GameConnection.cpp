@@ -4,6 +4,7 @@
 #include "AutomationEngine.h"
 
 #include "i18n.h"
+#include "itextstream.h"
 #include "igame.h"
 #include "icameraview.h"
 #include "inode.h"
@@ -43,6 +44,8 @@ namespace
     constexpr int TAG_CAMERA = 6;
     //multistep procedure for TDM game start/restart
     constexpr int TAG_RESTART = 7;
+    //batched map updates in "always update map" mode, executed asynchronously
+    constexpr int TAG_UPDATEMAP = 8;
 
     inline std::string messagePreamble(const std::string& type) {
         return fmt::format("message \"{}\"\n", type);
@@ -57,10 +60,14 @@ namespace
     }
 }
 
-GameConnection::GameConnection()
-{
-    _engine.reset(new AutomationEngine());
-}
+std::string saveMapDiff(const DiffEntityStatuses& entityStatuses);
+
+GameConnection::GameConnection() :
+    _engine(new AutomationEngine()),
+    _mapUpdater(*_engine, _mapObserver, TAG_UPDATEMAP, [](const DiffEntityStatuses& changes) {
+        return actionPreamble("reloadmap-diff") + "content:\n" + saveMapDiff(changes);
+    })
+{}
 
 std::string GameConnection::executeGenericRequest(const std::string& request)
 {
@@ -70,11 +77,8 @@ std::string GameConnection::executeGenericRequest(const std::string& request)
 
 bool GameConnection::sendAnyPendingAsync()
 {
-    if (_mapObserver.getChanges().size() && _updateMapAlways) {
-        //note: this is blocking
-        doUpdateMap();
+    if (sendPendingMapUpdate())
         return true;
-    }
     return sendPendingCameraUpdate();
 }
 
@@ -775,23 +779,26 @@ std::string saveMapDiff(const DiffEntityStatuses& entityStatuses)
     return outStream.str();
 }
 
+bool GameConnection::sendPendingMapUpdate()
+{
+    if (!_updateMapAlways)
+        return false;
+
+    return _mapUpdater.sendPendingAsync();
+}
+
+const GameConnection::MapUpdateStatistics& GameConnection::getMapUpdateStatistics() const
+{
+    return _mapUpdater.getStatistics();
+}
+
 void GameConnection::doUpdateMap()
 {
     try {
         if (!_engine->isAlive())
             return; //no connection, don't even try
 
-        // Get map diff
-        std::string diff = saveMapDiff(_mapObserver.getChanges());
-        if (diff.empty()) {
-            return; //TODO: fail
-        }
-
-        std::string response = executeGenericRequest(actionPreamble("reloadmap-diff") + "content:\n" + diff);
-        if (response.find("HotReload: SUCCESS") != std::string::npos) {
-            //success: clear current diff, so that we don't reapply it next time
-            _mapObserver.clear();
-        }
+        _mapUpdater.sendPendingBlocking();
     }
     catch (const DisconnectException&) {
         //disconnected: will be handled during next think
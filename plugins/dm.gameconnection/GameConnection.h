@@ -5,6 +5,7 @@
 #include "ui/ieventmanager.h"
 
 #include "MapObserver.h"
+#include "MapUpdater.h"
 
 #include <sigc++/connection.h>
 #include <wx/timer.h>
@@ -72,12 +73,18 @@ public:
     // or b) since the observer was enabled; are sent as a diff.
     // The game applies the diff on top of its current map state and hot reloads entities.
     void doUpdateMap();
-    // Enable/disable mode: doUpdateMap after every entity change.
+    // Enable/disable mode: update map after every entity change.
     // Note: the update is postponed to next think, so that mass changes go as one diff.
+    // Unlike doUpdateMap, these updates are sent asynchronously: changes made
+    // while an update is in flight are combined and go with the next one.
     void setAlwaysUpdateMapEnabled(bool on);
     // Returns true iff the mode for update map after every change is enabled.
     bool isAlwaysUpdateMapEnabled() const;
 
+    // Statistics about "update map" requests since the module was started.
+    using MapUpdateStatistics = MapUpdater::Statistics;
+    const MapUpdateStatistics& getMapUpdateStatistics() const;
+
     // Toggle game pause status: pause if it is live / unpause if it is paused.
     // Note: there is no way to learn if game is paused right now.
     void togglePauseGame();
@@ -118,6 +125,8 @@ private:
 
     // Observes over changes to map data (mainly spawnargs of entities).
     MapObserver _mapObserver;
+    // Sends the changes collected by the observer to the game.
+    MapUpdater _mapUpdater;
     // True when "setAutoReloadMapEnabled" is enabled.
     bool _autoReloadMap = false;
     // True when "setAlwaysUpdateMapEnabled" is enabled.
@@ -165,6 +174,9 @@ private:
     void updateCamera();
     // Send request for camera update, which is pending yet.
     bool sendPendingCameraUpdate();
+
+    // Send pending map changes asynchronously, unless an update is already in flight.
+    bool sendPendingMapUpdate();
     // Enable notarget/god/noclip to allow player to fly around without problems.
     void enableGhostMode();
 
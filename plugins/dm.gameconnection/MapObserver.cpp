@@ -139,7 +139,7 @@ void MapObserver::setEnabled(bool enable) {
             disableEntityObservers(entityNodes);
         }
         assert(_entityObservers.empty());
-        _entityChanges.clear();
+        clear();
     }
 }
 
@@ -149,6 +149,8 @@ bool MapObserver::isEnabled() const {
 
 void MapObserver::clear() {
     _entityChanges.clear();
+    _changesInFlight.clear();
+    _updateInProgress = false;
 }
 
 MapObserver::~MapObserver() {
@@ -164,4 +166,37 @@ const DiffEntityStatuses& MapObserver::getChanges() const {
     return _entityChanges;
 }
 
+bool MapObserver::hasPendingChanges() const {
+    return !_entityChanges.empty();
+}
+
+const DiffEntityStatuses& MapObserver::beginUpdate() {
+    assert(!_updateInProgress);
+    _changesInFlight.clear();
+    _changesInFlight.swap(_entityChanges);
+    _updateInProgress = true;
+    return _changesInFlight;
+}
+
+bool MapObserver::isUpdateInProgress() const {
+    return _updateInProgress;
+}
+
+void MapObserver::finishUpdate(bool success) {
+    if (!_updateInProgress)
+        return;     //cleared in the meantime
+
+    if (!success) {
+        //the in-flight changes happened before the pending ones
+        for (const auto& pNS : _entityChanges) {
+            DiffStatus& status = _changesInFlight[pNS.first];
+            status = status.combine(pNS.second);
+        }
+        _entityChanges.swap(_changesInFlight);
+    }
+
+    _changesInFlight.clear();
+    _updateInProgress = false;
+}
+
 }
@@ -25,12 +25,28 @@ public:
     bool isEnabled() const;
 
     //consider all pending changed "applied" right now
-    //(clears list of pending changes)
+    //(clears list of pending changes, including the ones being sent)
     void clear();
 
     //returns pending entity change since last clear (or since enabled)
+    //changes which are currently being sent are not included
     const DiffEntityStatuses& getChanges() const;
 
+    //returns true if there are changes which are not being sent yet
+    bool hasPendingChanges() const;
+
+    //moves all pending changes into the in-flight batch and returns it
+    //repeated edits of the same entity have already been combined at this point
+    //must not be called while another batch is in flight
+    const DiffEntityStatuses& beginUpdate();
+
+    //returns true iff a batch returned by beginUpdate has not been finished yet
+    bool isUpdateInProgress() const;
+
+    //finishes the in-flight batch: on success, its changes are considered "applied"
+    //on failure, they are put back in front of the changes recorded in the meantime
+    void finishUpdate(bool success);
+
 private:
     //receives events about entity changes
     void entityUpdated(const std::string& name, const DiffStatus& diff);
@@ -44,6 +60,9 @@ private:
     std::map<IEntityNode*, Entity::Observer*> _entityObservers;		//note: values owned
     //set of entities with changes since last clear
     DiffEntityStatuses _entityChanges;
+    //changes which are currently being sent to the game
+    DiffEntityStatuses _changesInFlight;
+    bool _updateInProgress = false;
 
     //internal classes can call private methods
     friend class MapObserver_EntityObserver;
@@ -0,0 +1,101 @@
+#include "MapUpdater.h"
+#include "MapObserver.h"
+#include "AutomationEngine.h"
+
+#include "itextstream.h"
+
+#include <fmt/format.h>
+
+namespace gameconn
+{
+
+MapUpdater::MapUpdater(AutomationEngine& engine, MapObserver& observer, int tag, const RequestWriter& writeRequest) :
+    _engine(engine),
+    _observer(observer),
+    _tag(tag),
+    _writeRequest(writeRequest)
+{}
+
+std::string MapUpdater::beginUpdate(std::size_t& numEntities)
+{
+    //all changes recorded so far go in one diff
+    //note: repeated edits of an entity are already combined into one entry by the observer
+    const DiffEntityStatuses& changes = _observer.beginUpdate();
+    numEntities = changes.size();
+
+    return _writeRequest(changes);
+}
+
+void MapUpdater::finishUpdate(const std::string& response, std::size_t numEntities, std::size_t numBytes,
+                              std::chrono::steady_clock::time_point startTime)
+{
+    bool success = response.find("HotReload: SUCCESS") != std::string::npos;
+    //success: the diff is applied, so that we don't reapply it next time
+    //failure: the diff is merged back into pending changes and retried with the next update
+    _observer.finishUpdate(success);
+
+    double roundTripMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    _stats.numUpdates++;
+    if (!success)
+        _stats.numFailedUpdates++;
+    _stats.lastNumEntities = numEntities;
+    _stats.lastBytes = numBytes;
+    _stats.totalBytes += numBytes;
+    _stats.lastRoundTripMs = roundTripMs;
+    _stats.totalRoundTripMs += roundTripMs;
+
+    rDebug() << fmt::format(
+        "[GameConnection] Map update {}: {} entities, {} bytes, {:.1f} ms (average {:.1f} ms)",
+        success ? "applied" : "failed", numEntities, numBytes,
+        roundTripMs, _stats.totalRoundTripMs / _stats.numUpdates
+    ) << std::endl;
+}
+
+bool MapUpdater::sendPendingAsync()
+{
+    //at most one update is in flight, all changes made meanwhile go into the next one
+    if (!_observer.hasPendingChanges() || _observer.isUpdateInProgress())
+        return false;
+
+    std::size_t numEntities = 0;
+    std::string request = beginUpdate(numEntities);
+    std::size_t numBytes = request.size();
+    auto startTime = std::chrono::steady_clock::now();
+
+    _engine.executeRequestAsync(_tag, request, [this, numEntities, numBytes, startTime](int seqno) {
+        finishUpdate(_engine.getResponse(seqno), numEntities, numBytes, startTime);
+    });
+    return true;
+}
+
+void MapUpdater::sendPendingBlocking()
+{
+    //let async update finish first, so that its changes are not sent twice
+    _engine.waitForTags(1 << _tag);
+    if (!_observer.hasPendingChanges())
+        return; //nothing to send
+
+    std::size_t numEntities = 0;
+    std::string request = beginUpdate(numEntities);
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::string response;
+    try {
+        response = _engine.executeRequestBlocking(_tag, request);
+    }
+    catch (const DisconnectException&) {
+        //keep the changes for the next attempt
+        _observer.finishUpdate(false);
+        throw;
+    }
+
+    finishUpdate(response, numEntities, request.size(), startTime);
+}
+
+const MapUpdater::Statistics& MapUpdater::getStatistics() const
+{
+    return _stats;
+}
+
+}
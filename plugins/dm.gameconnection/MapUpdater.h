@@ -0,0 +1,69 @@
+#pragma once
+
+#include "DiffStatus.h"
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace gameconn
+{
+
+class AutomationEngine;
+class MapObserver;
+
+/**
+ * Private for GameConnection class: do not use directly!
+ * Sends the changes collected by MapObserver to the game for "update map" / "hot reload" feature.
+ * At most one update is in flight at a time: changes made meanwhile are combined and go with the next one.
+ * Updates which the game fails to apply are merged back into pending changes and retried.
+ */
+class MapUpdater
+{
+public:
+    // Converts a set of changed entities into request text (including the action preamble).
+    using RequestWriter = std::function<std::string(const DiffEntityStatuses&)>;
+
+    // Statistics about "update map" requests since the updater was created.
+    struct Statistics {
+        // Number of finished update requests (successful or not).
+        std::size_t numUpdates = 0;
+        // Number of update requests which the game has not applied.
+        std::size_t numFailedUpdates = 0;
+        // Number of entities and request size of the last update.
+        std::size_t lastNumEntities = 0;
+        std::size_t lastBytes = 0;
+        std::size_t totalBytes = 0;
+        // Time between sending the last update and receiving its response.
+        double lastRoundTripMs = 0;
+        double totalRoundTripMs = 0;
+    };
+
+    // Requests are sent via given engine with given tag.
+    MapUpdater(AutomationEngine& engine, MapObserver& observer, int tag, const RequestWriter& writeRequest);
+
+    // Send pending changes asynchronously, unless there are none or an update is already in flight.
+    // Returns true iff a request has been sent.
+    bool sendPendingAsync();
+    // Send pending changes and wait for the game to respond (waits for in-flight update first).
+    // Throws DisconnectException if connection is missing or lost, changes are kept pending then.
+    void sendPendingBlocking();
+
+    const Statistics& getStatistics() const;
+
+private:
+    // Moves pending changes in flight and returns the request text with their diff.
+    std::string beginUpdate(std::size_t& numEntities);
+    // Finishes the in-flight update given the game's response, updates statistics.
+    void finishUpdate(const std::string& response, std::size_t numEntities, std::size_t numBytes,
+                      std::chrono::steady_clock::time_point startTime);
+
+    AutomationEngine& _engine;
+    MapObserver& _observer;
+    int _tag;
+    RequestWriter _writeRequest;
+    // Gathered over all map updates.
+    Statistics _stats;
+};
+
+}
@@ -36,7 +36,11 @@ public:
 		_count(0),
 		_numGuis(GlobalGuiManager().getNumGuis()),
 		_evLimiter(50)
-	{}
+	{
+		// Classify all GUIs up front, this parses the files in parallel
+		_progress.setText(_("Parsing Guis"));
+		GlobalGuiManager().determineGuiTypes();
+	}
 
 	void visit(const std::string& guiPath, const gui::GuiType& guiType)
 	{
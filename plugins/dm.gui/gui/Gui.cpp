@@ -41,6 +41,16 @@ GuiPtr Gui::createFromTokens(parser::DefTokeniser& tokeniser)
 	return gui;
 }
 
+void Gui::ensureWindowDefsParsed()
+{
+	auto desktop = std::dynamic_pointer_cast<GuiWindowDef>(_desktop);
+
+	if (desktop)
+	{
+		desktop->ensureParsed();
+	}
+}
+
 void Gui::setStateString(const std::string& key, const std::string& value)
 {
 	_state[key] = value;
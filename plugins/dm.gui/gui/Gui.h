@@ -60,6 +60,11 @@ public:
 	// Called by the GuiRenderer to re-compile text VBOs, etc.
 	void pepareRendering() override;
 
+	// Constructs the properties and scripts of all windowDefs. A GUI created
+	// from tokens only knows the names and hierarchy of its windowDefs at first.
+	// Throws parser::ParseException on syntax errors.
+	void ensureWindowDefsParsed();
+
 	// Takes the given token stream and attempts to construct a GUI object from it
 	// Returns NULL on failure
 	static GuiPtr createFromTokens(parser::DefTokeniser& tokeniser);
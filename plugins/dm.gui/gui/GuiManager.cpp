@@ -4,14 +4,22 @@
 #include "ifilesystem.h"
 #include "itextstream.h"
 #include "parser/GuiTokeniser.h"
+#include "util/ParallelFor.h"
 
 #include "Gui.h"
 
 namespace gui
 {
 
+namespace
+{
+    // Number of GUI files per thread when classifying them in parallel
+    constexpr std::size_t PARALLEL_GUI_MIN_FILES = 8;
+}
+
 GuiManager::GuiManager() :
-    _guiLoader(std::bind(&GuiManager::findGuis, this))
+    _guiLoader(std::bind(&GuiManager::findGuis, this)),
+    _includeCache(std::make_shared<parser::CodeIncludeCache>())
 {}
 
 void GuiManager::registerGui(const std::string& guiPath)
@@ -45,14 +53,16 @@ void GuiManager::reloadGui(const std::string& guiPath)
 
 GuiType GuiManager::getGuiType(const std::string& guiPath)
 {
-	// Get the GUI (will load the file if necessary)
-	GuiPtr gui = std::static_pointer_cast<Gui>(getGui(guiPath));
+    ensureGuisLoaded();
 
 	GuiInfoMap::iterator found = _guis.find(guiPath);
 
-	if (found == _guis.end())
+	// Load the file if necessary, the windowDef names are enough to
+	// determine the type, their contents are not parsed here
+	if (found == _guis.end() || found->second.type == NOT_LOADED_YET)
 	{
-		return FILE_NOT_FOUND;
+		loadGui(guiPath);
+		found = _guis.find(guiPath);
 	}
 
 	// Gui Info found, determine readable type if necessary
@@ -64,6 +74,37 @@ GuiType GuiManager::getGuiType(const std::string& guiPath)
 	return found->second.type;
 }
 
+void GuiManager::determineGuiTypes()
+{
+    ensureGuisLoaded();
+
+    // Collect the GUIs to classify, the map itself is not modified below
+    std::vector<GuiInfoMap::value_type*> pending;
+
+    for (auto& pair : _guis)
+    {
+        if (pair.second.type == NOT_LOADED_YET || pair.second.type == UNDETERMINED)
+        {
+            pending.push_back(&pair);
+        }
+    }
+
+    util::parallelFor(pending.size(), PARALLEL_GUI_MIN_FILES, [&](std::size_t i)
+    {
+        auto& [guiPath, info] = *pending[i];
+
+        if (info.type == NOT_LOADED_YET)
+        {
+            parseGui(guiPath, info);
+        }
+
+        if (info.type == UNDETERMINED)
+        {
+            info.type = determineGuiType(info.gui);
+        }
+    });
+}
+
 GuiType GuiManager::determineGuiType(const GuiPtr& gui)
 {
 	if (gui)
@@ -117,6 +158,7 @@ void GuiManager::clear()
     _guiLoader.reset();
 	_guis.clear();
 	_errorList.clear();
+	_includeCache->clear();
 }
 
 IGuiPtr GuiManager::getGui(const std::string& guiPath)
@@ -125,20 +167,16 @@ IGuiPtr GuiManager::getGui(const std::string& guiPath)
 
 	GuiInfoMap::iterator i = _guis.find(guiPath);
 
-	// Path existent?
-	if (i != _guis.end())
+	// Load the GUI if it's not buffered or not attempted yet
+	if (i == _guis.end() || i->second.type == NOT_LOADED_YET)
 	{
-		// Found in the map, load if not yet attempted
-		if (i->second.type == NOT_LOADED_YET)
-		{
-			loadGui(guiPath);
-		}
-
-		return i->second.gui;
+		loadGui(guiPath);
+		i = _guis.find(guiPath);
 	}
 
-	// GUI not buffered, try to load afresh
-	return loadGui(guiPath);
+	ensureWindowDefsParsed(guiPath, i->second);
+
+	return i->second.gui;
 }
 
 void GuiManager::ensureGuisLoaded()
@@ -157,41 +195,66 @@ GuiPtr GuiManager::loadGui(const std::string& guiPath)
 
 	GuiInfo& info = result.first->second;
 
+	parseGui(guiPath, info);
+
+	return info.gui;
+}
+
+void GuiManager::parseGui(const std::string& guiPath, GuiInfo& info)
+{
+	info.gui.reset();
+
 	ArchiveTextFilePtr file = GlobalFileSystem().openTextFile(guiPath);
 
 	if (file == NULL)
 	{
-		std::string errMSG = "Could not open file: " + guiPath + "\n";
-
-		_errorList.push_back(errMSG);
-		rError() << errMSG;
+		reportError("Could not open file: " + guiPath + "\n");
 
 		info.type = FILE_NOT_FOUND;
-
-		return GuiPtr();
+		return;
 	}
 
 	// Construct a Code Tokeniser, which is able to handle #includes
 	try
 	{
-		parser::GuiTokeniser tokeniser(file);
+		parser::GuiTokeniser tokeniser(file, _includeCache);
 
 		info.gui = Gui::createFromTokens(tokeniser);
 		info.type = UNDETERMINED;
+	}
+	catch (parser::ParseException& p)
+	{
+		reportError("Error while parsing " + guiPath + ": " + p.what() + "\n");
 
-		return info.gui;
+		info.type = IMPORT_FAILURE;
+	}
+}
+
+void GuiManager::ensureWindowDefsParsed(const std::string& guiPath, GuiInfo& info)
+{
+	if (!info.gui) return;
+
+	try
+	{
+		info.gui->ensureWindowDefsParsed();
 	}
 	catch (parser::ParseException& p)
 	{
-		std::string errMSG = "Error while parsing " + guiPath + ": " + p.what() + "\n";
-		_errorList.push_back(errMSG);
-		rError() << errMSG;
+		reportError("Error while parsing " + guiPath + ": " + p.what() + "\n");
 
+		info.gui.reset();
 		info.type = IMPORT_FAILURE;
-		return GuiPtr();
 	}
 }
 
+void GuiManager::reportError(const std::string& message)
+{
+	std::lock_guard<std::mutex> lock(_errorListLock);
+
+	_errorList.push_back(message);
+	rError() << message;
+}
+
 const std::string& GuiManager::getName() const
 {
 	static std::string _name(MODULE_GUIMANAGER);
@@ -3,9 +3,11 @@
 #include "igui.h"
 #include "util/Noncopyable.h"
 #include <map>
+#include <mutex>
 #include "ifilesystem.h"
 #include "string/string.h"
 #include "parser/ThreadedDefLoader.h"
+#include "parser/CodeTokeniser.h"
 
 namespace gui
 {
@@ -52,8 +54,12 @@ private:
 
     parser::ThreadedDefLoader<void> _guiLoader;
 
+	// Tokens of the files #include'd by the GUIs, shared by all parsers
+	parser::CodeIncludeCache::Ptr _includeCache;
+
 	// A List of all the errors occuring lastly.
 	StringList _errorList;
+	std::mutex _errorListLock;
 
 public:
 	GuiManager();
@@ -71,6 +77,8 @@ public:
 	// Returns the GUI appearance type for the given GUI path
 	GuiType getGuiType(const std::string& guiPath) override;
 
+	void determineGuiTypes() override;
+
 	// Reload the gui
 	void reloadGui(const std::string& guiPath) override;
 
@@ -99,6 +107,16 @@ private:
 
 	GuiPtr loadGui(const std::string& guiPath);
 
+	// Parses the given file into the info structure, safe to be called
+	// concurrently for different GUIs. The windowDefs are set up only
+	// with their names and children, see Gui::ensureWindowDefsParsed()
+	void parseGui(const std::string& guiPath, GuiInfo& info);
+
+	// Completes the windowDefs of the given GUI before it is handed out
+	void ensureWindowDefsParsed(const std::string& guiPath, GuiInfo& info);
+
+	void reportError(const std::string& message);
+
     // Used by findGuis()
     void registerGui(const std::string& guiPath);
 };
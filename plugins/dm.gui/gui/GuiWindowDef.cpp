@@ -173,6 +173,75 @@ void GuiWindowDef::constructFromTokens(parser::DefTokeniser& tokeniser)
 
 	tokeniser.assertNextToken("{");
 
+	// Only the child windowDefs are constructed right away, which is enough to
+	// classify the GUI. Everything else is stored for parsing in ensureParsed().
+	_pendingTokens = std::make_shared<std::vector<std::string>>();
+
+	// The nesting level of the blocks within this windowDef
+	std::size_t level = 0;
+
+	while (tokeniser.hasMoreTokens())
+	{
+		std::string token = tokeniser.nextToken();
+
+		if (level == 0)
+		{
+			if (token == "}")
+			{
+				break;
+			}
+
+			auto keyword = string::to_lower_copy(token);
+
+			if (keyword == "windowdef" || keyword == "indowdef") // yes, there's a syntax error in the TDM GUI
+			{
+				// Child windowdef
+				GuiWindowDefPtr window(new GuiWindowDef(_owner));
+				window->constructFromTokens(tokeniser);
+
+				addWindow(window);
+				continue;
+			}
+		}
+
+		if (token == "{")
+		{
+			level++;
+		}
+		else if (token == "}")
+		{
+			level--;
+		}
+
+		_pendingTokens->emplace_back(std::move(token));
+	}
+}
+
+void GuiWindowDef::ensureParsed()
+{
+	if (_pendingTokens)
+	{
+		parser::TokenSequenceTokeniser tokeniser(_pendingTokens);
+
+		// Don't attempt to parse this a second time, even if it fails
+		_pendingTokens.reset();
+
+		parseBody(tokeniser);
+	}
+
+	for (const auto& child : children)
+	{
+		auto window = std::dynamic_pointer_cast<GuiWindowDef>(child);
+
+		if (window)
+		{
+			window->ensureParsed();
+		}
+	}
+}
+
+void GuiWindowDef::parseBody(parser::DefTokeniser& tokeniser)
+{
 	while (tokeniser.hasMoreTokens())
 	{
 		std::string token = tokeniser.nextToken();
@@ -279,14 +348,6 @@ void GuiWindowDef::constructFromTokens(parser::DefTokeniser& tokeniser)
 		{
 			menugui.setValue(parseBool(tokeniser));
 		}
-		else if (token == "windowdef" || token == "indowdef") // yes, there's a syntax error in the TDM GUI
-		{
-			// Child windowdef
-			GuiWindowDefPtr window(new GuiWindowDef(_owner));
-			window->constructFromTokens(tokeniser);
-
-			addWindow(window);
-		}
 		else if (token == "ontime")
 		{
 			std::string timeStr = tokeniser.nextToken();
@@ -429,10 +490,6 @@ void GuiWindowDef::constructFromTokens(parser::DefTokeniser& tokeniser)
         {
             tokeniser.nextToken(); // value
         }
-		else if (token == "}")
-		{
-			break;
-		}
 		else
 		{
 			rWarning() << "Unknown token encountered in GUI: " << token << std::endl;
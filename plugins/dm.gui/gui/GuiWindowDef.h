@@ -41,6 +41,10 @@ private:
 	typedef std::multimap<std::size_t, GuiScriptPtr> TimedEventMap;
 	TimedEventMap _timedEvents;
 
+	// The tokens of this windowDef's block (without the child windowDefs)
+	// which have not been parsed yet, empty once ensureParsed() has been called
+	std::shared_ptr<std::vector<std::string>> _pendingTokens;
+
 public:
 	// Default constructor
 	GuiWindowDef(IGui& owner);
@@ -48,8 +52,15 @@ public:
 	// Returns the GUI
 	IGui& getGui() const override;
 
+	// Sets up the name and the child windowDefs from the given token stream,
+	// the remaining tokens are stored and parsed by ensureParsed()
 	void constructFromTokens(parser::DefTokeniser& tokeniser);
 
+	// Constructs the properties, expressions and scripts of this windowDef
+	// and its children, unless this has been done before.
+	// Throws parser::ParseException on syntax errors.
+	void ensureParsed();
+
 	void addWindow(const IGuiWindowDefPtr& window) override;
 
 	// Recursively looks for a named child windowDef
@@ -83,6 +94,9 @@ public:
 	std::shared_ptr<IGuiExpression<bool>> parseBool(parser::DefTokeniser& tokeniser);
 
 	GuiExpressionPtr getExpression(parser::DefTokeniser& tokeniser);
+
+private:
+	void parseBody(parser::DefTokeniser& tokeniser);
 };
 
 
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __APPLE__
+#include <OpenAL/al.h>
+#else
+#include <AL/al.h>
+#endif
+
+namespace sound
+{
+
+/**
+ * Hands the PCM data of a sound file decoded by a worker thread
+ * over to the SoundPlayer, one chunk at a time. The first chunk is
+ * kept small such that playback can start right away.
+ *
+ * The producer and consumer methods are safe to be called from
+ * different threads.
+ */
+class DecodedSoundBuffer
+{
+public:
+    using Ptr = std::shared_ptr<DecodedSoundBuffer>;
+
+    // Size of the first decoded chunk in bytes
+    static constexpr std::size_t FirstChunkSize = 16384;
+
+    // Size of all subsequent chunks in bytes
+    static constexpr std::size_t ChunkSize = 65536;
+
+private:
+    mutable std::mutex _lock;
+
+    ALenum _format = 0;
+    ALsizei _frequency = 0;
+    bool _hasFormat = false;
+
+    std::deque<std::vector<char>> _chunks;
+    std::size_t _numChunksAdded = 0;
+    bool _finished = false;
+
+    std::atomic<bool> _cancelled{ false };
+
+public:
+    // Producer side: to be called before the first chunk is added
+    void setFormat(ALenum format, ALsizei frequency)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        _format = format;
+        _frequency = frequency;
+        _hasFormat = true;
+    }
+
+    // Producer side: returns the size the next chunk should have
+    std::size_t getNextChunkSize() const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _numChunksAdded == 0 ? FirstChunkSize : ChunkSize;
+    }
+
+    // Producer side: appends a chunk of decoded data.
+    // Returns false if the playback has been cancelled and decoding should stop.
+    bool addChunk(std::vector<char>&& chunk)
+    {
+        if (_cancelled) return false;
+
+        if (!chunk.empty())
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            _chunks.emplace_back(std::move(chunk));
+            ++_numChunksAdded;
+        }
+
+        return !_cancelled;
+    }
+
+    // Producer side: signals that no more chunks are going to be added
+    void setFinished()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _finished = true;
+    }
+
+    // Consumer side: asks the producer to stop decoding
+    void cancel()
+    {
+        _cancelled = true;
+    }
+
+    bool isCancelled() const
+    {
+        return _cancelled;
+    }
+
+    // Consumer side: returns false if the format is not known yet
+    bool getFormat(ALenum& format, ALsizei& frequency) const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        format = _format;
+        frequency = _frequency;
+
+        return _hasFormat;
+    }
+
+    // Consumer side: moves the chunks decoded so far to the given vector.
+    // Returns true if decoding has finished and all chunks have been taken.
+    bool takeChunks(std::vector<std::vector<char>>& chunks)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        for (auto& chunk : _chunks)
+        {
+            chunks.emplace_back(std::move(chunk));
+        }
+
+        _chunks.clear();
+
+        return _finished;
+    }
+};
+
+}
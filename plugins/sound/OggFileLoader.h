@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 #ifdef __APPLE__
@@ -12,14 +14,19 @@
 #include <fmt/format.h>
 
 #include "iarchive.h"
+#include "ifilesystem.h"
+#include "idatastream.h"
+#include "isound.h"
+#include "itextstream.h"
 #include "stream/ScopedArchiveBuffer.h"
 #include "OggFileStream.h"
+#include "DecodedSoundBuffer.h"
 
 namespace sound
 {
 
 /**
- * greebo: Loader class creating an AL buffer from an OGG file.
+ * greebo: Loader class reading and decoding OGG files.
  */
 class OggFileLoader
 {
@@ -63,25 +70,189 @@ private:
             ov_clear(&_oggFile);
         }
     };
+    // An OGG page is at most 27 header bytes plus 255 segments of 255 bytes each
+    static constexpr std::size_t MaxPageSize = 27 + 255 + 255 * 255;
+
+    static constexpr std::size_t PageHeaderSize = 27;
+
+    static std::uint32_t ReadUInt32(const unsigned char* data)
+    {
+        return static_cast<std::uint32_t>(data[0]) | static_cast<std::uint32_t>(data[1]) << 8 |
+            static_cast<std::uint32_t>(data[2]) << 16 | static_cast<std::uint32_t>(data[3]) << 24;
+    }
+
+    static std::int64_t ReadInt64(const unsigned char* data)
+    {
+        return static_cast<std::int64_t>(
+            static_cast<std::uint64_t>(ReadUInt32(data)) | static_cast<std::uint64_t>(ReadUInt32(data + 4)) << 32);
+    }
+
+    static bool IsPageHeader(const std::vector<unsigned char>& data, std::size_t offset)
+    {
+        return offset + PageHeaderSize <= data.size() &&
+            data[offset] == 'O' && data[offset + 1] == 'g' && data[offset + 2] == 'g' && data[offset + 3] == 'S' &&
+            data[offset + 4] == 0; // stream structure version
+    }
+
+    // Appends up to numBytes from the stream to the given vector, returns the number of bytes read
+    static std::size_t ReadBytes(InputStream& stream, std::vector<unsigned char>& data, std::size_t numBytes)
+    {
+        auto offset = data.size();
+        data.resize(offset + numBytes);
+
+        std::size_t totalRead = 0;
+
+        while (totalRead < numBytes)
+        {
+            auto bytesRead = stream.read(data.data() + offset + totalRead, numBytes - totalRead);
+
+            if (bytesRead == 0) break;
+
+            totalRead += bytesRead;
+        }
+
+        data.resize(offset + totalRead);
+        return totalRead;
+    }
+
+    // Returns the last MaxPageSize bytes of the file, the stream is expected to be positioned after the given head
+    static std::vector<unsigned char> ReadTail(ArchiveFile& vfsFile, const std::vector<unsigned char>& head)
+    {
+        auto fileSize = vfsFile.size();
+
+        if (fileSize <= head.size())
+        {
+            return head;
+        }
+
+        auto& stream = vfsFile.getInputStream();
+        auto tailSize = std::min(fileSize, MaxPageSize);
+        std::vector<unsigned char> tail;
+
+        if (auto seekable = dynamic_cast<SeekableInputStream*>(&stream); seekable != nullptr)
+        {
+            seekable->seek(fileSize - tailSize);
+            ReadBytes(stream, tail, tailSize);
+            return tail;
+        }
+
+        // Compressed or stored archive entries cannot seek, read through the file
+        // and keep the trailing bytes (this doesn't decode anything though)
+        tail = head;
+
+        while (ReadBytes(stream, tail, MaxPageSize) > 0)
+        {
+            if (tail.size() > 2 * MaxPageSize)
+            {
+                tail.erase(tail.begin(), tail.end() - tailSize);
+            }
+        }
+
+        if (tail.size() > tailSize)
+        {
+            tail.erase(tail.begin(), tail.end() - tailSize);
+        }
+
+        return tail;
+    }
+
+    // Determines the file info by opening the file through libvorbisfile,
+    // which handles chained files, but needs to scan the whole file to do so.
+    // The stream of the given file has been read already, it is opened once more.
+    static SoundFileInfo GetInfoFromVorbisFile(const ArchiveFile& vfsFile)
+    {
+        auto reopenedFile = GlobalFileSystem().openFile(vfsFile.getName());
+
+        if (!reopenedFile)
+        {
+            throw std::runtime_error("Could not reopen OGG file " + vfsFile.getName());
+        }
+
+        FileWrapper file(*reopenedFile);
+
+        vorbis_info* vorbisInfo = ov_info(file.getHandle(), -1);
+
+        SoundFileInfo info;
+        info.duration = static_cast<float>(ov_time_total(file.getHandle(), -1));
+        info.channels = static_cast<unsigned int>(vorbisInfo->channels);
+        info.sampleRate = static_cast<unsigned int>(vorbisInfo->rate);
+        info.bitsPerSample = 16;
+
+        return info;
+    }
+
 public:
     /**
-     * greebo: Determines the OGG file length in seconds.
+     * Reads channel count, sample rate and length of the given OGG file,
+     * without decoding any audio data. The format is taken from the vorbis
+     * identification header in the first page, the length is derived from the
+     * granule position of the last page. Chained files (consisting of several
+     * logical streams) are handed to libvorbisfile.
+     *
      * @throws: std::runtime_error if an error occurs.
      */
-    static float GetDuration(ArchiveFile& vfsFile)
+    static SoundFileInfo GetInfo(ArchiveFile& vfsFile)
     {
-        FileWrapper file(vfsFile);
+        // The first page holds nothing but the 30 bytes of the identification header
+        std::vector<unsigned char> head;
+        ReadBytes(vfsFile.getInputStream(), head, std::min(vfsFile.size(), MaxPageSize));
+
+        if (!IsPageHeader(head, 0))
+        {
+            throw std::runtime_error("No OGG file");
+        }
+
+        auto serial = ReadUInt32(head.data() + 14);
+        auto packetStart = PageHeaderSize + head[26];
 
-        return static_cast<float>(ov_time_total(file.getHandle(), -1));
+        if (packetStart + 16 > head.size() || head[packetStart] != 1 ||
+            std::string(reinterpret_cast<const char*>(head.data() + packetStart + 1), 6) != "vorbis")
+        {
+            throw std::runtime_error("No vorbis identification header");
+        }
+
+        SoundFileInfo info;
+        info.channels = head[packetStart + 11];
+        info.sampleRate = ReadUInt32(head.data() + packetStart + 12);
+        info.bitsPerSample = 16;
+
+        if (info.channels == 0 || info.sampleRate == 0)
+        {
+            throw std::runtime_error("Invalid vorbis identification header");
+        }
+
+        auto tail = ReadTail(vfsFile, head);
+
+        // Search the last page a packet is finished on (these have a granule position other than -1)
+        for (auto offset = tail.size(); offset-- > 0;)
+        {
+            if (!IsPageHeader(tail, offset)) continue;
+
+            auto granulePosition = ReadInt64(tail.data() + offset + 6);
+
+            if (granulePosition == -1) continue;
+
+            if (ReadUInt32(tail.data() + offset + 14) != serial)
+            {
+                // Chained file, let libvorbisfile figure it out
+                return GetInfoFromVorbisFile(vfsFile);
+            }
+
+            info.duration = static_cast<float>(static_cast<double>(granulePosition) / info.sampleRate);
+            return info;
+        }
+
+        return GetInfoFromVorbisFile(vfsFile);
     }
 
     /**
-     * greebo: Loads an OGG file from the given stream into OpenAL,
-     * returns the openAL buffer handle.
+     * Decodes the given OGG file to 16 bit PCM data, which is handed to the
+     * given buffer chunk by chunk, until the end of the file is reached or
+     * the playback has been cancelled.
      *
      * @throws: std::runtime_error if an error occurs.
      */
-    static ALuint LoadFromFile(ArchiveFile& vfsFile)
+    static void Decode(ArchiveFile& vfsFile, DecodedSoundBuffer& buffer)
     {
         FileWrapper file(vfsFile);
 
@@ -91,14 +262,13 @@ public:
         // Check the number of channels
         ALenum format = (vorbisInfo->channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
 
-        // Get the sample Rate
-        ALsizei freq = static_cast<ALsizei>(vorbisInfo->rate);
+        buffer.setFormat(format, static_cast<ALsizei>(vorbisInfo->rate));
 
         long bytes;
         char smallBuffer[4096];
 
-        std::vector<char> largeBuffer;
-        largeBuffer.reserve(vfsFile.size() * 2);
+        std::vector<char> chunk;
+        chunk.reserve(buffer.getNextChunkSize());
 
         do
         {
@@ -114,26 +284,26 @@ public:
             {
                 rError() << "Error decoding OGG: OV_EBADLINK.\n";
             }
-            else
+            else if (bytes > 0)
             {
-                // Stuff this into the variable-sized buffer
-                largeBuffer.insert(largeBuffer.end(), smallBuffer, smallBuffer + bytes);
+                chunk.insert(chunk.end(), smallBuffer, smallBuffer + bytes);
+
+                // Hand over the chunk as soon as it is full
+                if (chunk.size() >= buffer.getNextChunkSize())
+                {
+                    if (!buffer.addChunk(std::move(chunk)))
+                    {
+                        return; // cancelled
+                    }
+
+                    chunk = std::vector<char>();
+                    chunk.reserve(buffer.getNextChunkSize());
+                }
             }
         } 
         while (bytes > 0);
 
-        ALuint bufferNum = 0;
-        // Allocate a new buffer
-        alGenBuffers(1, &bufferNum);
-
-        // Upload sound data to buffer
-        alBufferData(bufferNum,
-            format,
-            largeBuffer.data(),
-            static_cast<ALsizei>(largeBuffer.size()),
-            freq);
-
-        return bufferNum;
+        buffer.addChunk(std::move(chunk));
     }
 };
 
@@ -9,6 +9,7 @@
 #include "string/case_conv.h"
 
 #include <algorithm>
+#include <tuple>
 #include "itextstream.h"
 
 #include "WavFileLoader.h"
@@ -48,6 +49,23 @@ ArchiveFilePtr openSoundFile(const std::string& fileName)
     return GlobalFileSystem().openFile(os::replaceExtension(fileName, ".wav"));
 }
 
+// Looks up the given file without opening it, trying the same extensions as openSoundFile()
+vfs::FileInfo findSoundFile(const std::string& fileName)
+{
+    for (const auto& candidate : { fileName,
+        os::replaceExtension(fileName, ".ogg"), os::replaceExtension(fileName, ".wav") })
+    {
+        auto fileInfo = GlobalFileSystem().getFileInfo(candidate);
+
+        if (!fileInfo.isEmpty())
+        {
+            return fileInfo;
+        }
+    }
+
+    return vfs::FileInfo();
+}
+
 }
 
 SoundManager::SoundManager()
@@ -79,7 +97,7 @@ bool SoundManager::playSound(const std::string& fileName, bool loopSound)
 
 	if (file && _soundPlayer)
 	{
-		_soundPlayer->play(*file, loopSound);
+		_soundPlayer->play(file, loopSound);
 		return true;
 	}
 
@@ -146,34 +164,80 @@ void SoundManager::initialiseModule(const IApplicationContext& ctx)
     );
 }
 
+bool SoundManager::SoundFileKey::operator<(const SoundFileKey& other) const
+{
+    return std::tie(path, archivePath, size, modificationTime) <
+        std::tie(other.path, other.archivePath, other.size, other.modificationTime);
+}
+
 float SoundManager::getSoundFileDuration(const std::string& vfsPath)
 {
-    auto file = openSoundFile(vfsPath);
+    return getSoundFileInfo(vfsPath).duration;
+}
 
-    if (!file)
+SoundFileInfo SoundManager::getSoundFileInfo(const std::string& vfsPath)
+{
+    auto fileInfo = findSoundFile(vfsPath);
+
+    if (fileInfo.isEmpty())
     {
         throw std::out_of_range("Could not resolve sound file " + vfsPath);
     }
 
-    auto extension = string::to_lower_copy(os::getExtension(file->getName()));
+    SoundFileKey key;
+    key.path = fileInfo.fullPath();
+    key.archivePath = fileInfo.getArchivePath();
+    key.size = fileInfo.getSize();
+
+    // Files in archives are considered unchanged as long as the archive is
+    std::error_code ec;
+    auto time = fs::last_write_time(fileInfo.getIsPhysicalFile() ? key.archivePath + key.path : key.archivePath, ec);
+    key.modificationTime = ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+
+    {
+        std::lock_guard<std::mutex> lock(_fileInfoLock);
+
+        auto existing = _fileInfos.find(key);
+
+        if (existing != _fileInfos.end())
+        {
+            return existing->second;
+        }
+    }
+
+    auto file = GlobalFileSystem().openFile(key.path);
+
+    if (!file)
+    {
+        throw std::out_of_range("Could not open sound file " + key.path);
+    }
+
+    SoundFileInfo info;
+    auto extension = string::to_lower_copy(os::getExtension(key.path));
 
     try
     {
         if (extension == "wav")
         {
-            return WavFileLoader::GetDuration(file->getInputStream());
+            info = WavFileLoader::GetInfo(file->getInputStream());
         }
         else if (extension == "ogg")
         {
-            return OggFileLoader::GetDuration(*file);
+            info = OggFileLoader::GetInfo(*file);
         }
     }
     catch (const std::runtime_error& ex)
     {
-        rError() << "Error determining sound file duration " << ex.what() << std::endl;
+        rError() << "Error reading sound file info " << ex.what() << std::endl;
+
+        // Don't remember the failure, the next query will try again
+        return info;
     }
 
-    return 0.0f;
+    std::lock_guard<std::mutex> lock(_fileInfoLock);
+    _fileInfos.emplace(key, info);
+
+    return info;
 }
 
 void SoundManager::reloadSounds()
@@ -6,6 +6,10 @@
 #include "isound.h"
 #include "icommandsystem.h"
 
+#include <cstdint>
+#include <map>
+#include <mutex>
+
 namespace sound
 {
 
@@ -21,6 +25,21 @@ private:
 
     sigc::signal<void> _sigSoundShadersReloaded;
 
+    // Identifies the archive entry a sound file has been resolved to
+    struct SoundFileKey
+    {
+        std::string path;
+        std::string archivePath;
+        std::size_t size;
+        std::int64_t modificationTime;
+
+        bool operator<(const SoundFileKey& other) const;
+    };
+
+    // Header info of the sound files queried so far
+    std::mutex _fileInfoLock;
+    std::map<SoundFileKey, SoundFileInfo> _fileInfos;
+
 public:
 	SoundManager();
 
@@ -32,6 +51,7 @@ public:
 	void stopSound() override;
     void reloadSounds() override;
     float getSoundFileDuration(const std::string& vfsPath) override;
+    SoundFileInfo getSoundFileInfo(const std::string& vfsPath) override;
 
 	// RegisterableModule implementation
 	const std::string& getName() const override;
@@ -1,8 +1,8 @@
 #include "SoundPlayer.h"
 
-#include <vorbis/vorbisfile.h>
 #include <iostream>
 #include <vector>
+#include "itextstream.h"
 #include "string/case_conv.h"
 
 #include "os/path.h"
@@ -23,12 +23,21 @@
 namespace sound
 {
 
+namespace
+{
+	// Interval of the timer queueing the decoded data, a chunk lasts a lot longer than this
+	constexpr int STREAMING_INTERVAL_MSEC = 50;
+}
+
 // Constructor
 SoundPlayer::SoundPlayer() :
 	_initialised(false),
 	_context(NULL),
-	_buffer(0),
-	_source(0)
+	_source(0),
+	_loop(false),
+	_decodingFinished(false),
+	_loopingEnabled(false),
+	_playbackStarted(false)
 {
 	// Disable the timer, to make sure
 	_timer.Connect(wxEVT_TIMER, wxTimerEventHandler(SoundPlayer::onTimerIntervalReached), NULL, this);
@@ -93,40 +102,137 @@ SoundPlayer::~SoundPlayer() {
 
 void SoundPlayer::onTimerIntervalReached(wxTimerEvent& ev)
 {
-	// Check for active source and buffer
-	if (_source != 0 && _buffer != 0)
+	// Check for active source
+	if (_source == 0)
+	{
+		_timer.Stop();
+		return;
+	}
+
+	queueDecodedChunks();
+
+	// Take the buffers the source is done with off the queue
+	ALint processed = 0;
+	alGetSourcei(_source, AL_BUFFERS_PROCESSED, &processed);
+
+	for (ALint i = 0; i < processed; ++i)
+	{
+		ALuint buffer = 0;
+		alSourceUnqueueBuffers(_source, 1, &buffer);
+
+		if (_loop)
+		{
+			_playedBuffers.push_back(buffer);
+		}
+	}
+
+	if (_loop && _decodingFinished && !_loopingEnabled)
+	{
+		// Put the whole sound into the queue again (rotated by the part played so far)
+		// and let the AL loop over it from here on, no more buffers get processed then
+		if (!_playedBuffers.empty())
+		{
+			alSourceQueueBuffers(_source, static_cast<ALsizei>(_playedBuffers.size()), _playedBuffers.data());
+			_playedBuffers.clear();
+		}
+
+		alSourcei(_source, AL_LOOPING, AL_TRUE);
+		_loopingEnabled = true;
+	}
+
+	ALint queued = 0;
+	alGetSourcei(_source, AL_BUFFERS_QUEUED, &queued);
+
+	ALint state;
+	// Query the state of the source
+	alGetSourcei(_source, AL_SOURCE_STATE, &state);
+
+	if (state == AL_PLAYING)
 	{
-		ALint state;
-		// Query the state of the source
-		alGetSourcei(_source, AL_SOURCE_STATE, &state);
+		return;
+	}
+
+	if (queued > 0)
+	{
+		if (!_playbackStarted)
+		{
+			// greebo: Wait 10 msec. to fix a problem with buffers not being played
+			// maybe the AL needs time to push the data?
+			usleep(10000);
+			_playbackStarted = true;
+		}
+
+		// Start the playback, or resume it if the decoder couldn't keep up
+		alSourcePlay(_source);
+	}
+	else if (_decodingFinished)
+	{
+		// Erase the buffers, this stops the timer too
+		clearBuffer();
+	}
+}
+
+void SoundPlayer::queueDecodedChunks()
+{
+	if (!_decodedSound) return;
+
+	std::vector<std::vector<char>> chunks;
+	auto finished = _decodedSound->takeChunks(chunks);
+
+	ALenum format;
+	ALsizei frequency;
 
-		if (state == AL_STOPPED)
+	if (!chunks.empty() && _decodedSound->getFormat(format, frequency))
+	{
+		for (const auto& chunk : chunks)
 		{
-			// Erase the buffer
-			clearBuffer();
+			ALuint buffer = 0;
+			alGenBuffers(1, &buffer);
+			alBufferData(buffer, format, chunk.data(), static_cast<ALsizei>(chunk.size()), frequency);
 
-			// Disable the timer to stop calling this function
-			_timer.Stop();
+			alSourceQueueBuffers(_source, 1, &buffer);
+			_buffers.push_back(buffer);
 		}
 	}
+
+	if (finished)
+	{
+		_decodingFinished = true;
+		_decodedSound.reset();
+	}
 }
 
 void SoundPlayer::clearBuffer()
 {
-	// Check if there is an active buffer
+	// Let the decoder stop working on the previous sound
+	if (_decodedSound)
+	{
+		_decodedSound->cancel();
+		_decodedSound.reset();
+	}
+
+	_decoder.clearPendingTasks();
+
+	// Check if there is an active source
 	if (_source != 0) {
-		// Stop playing
+		// Stop playing, this marks all buffers as processed
 		alSourceStop(_source);
+		alSourcei(_source, AL_BUFFER, 0);
 		alDeleteSources(1, &_source);
 		_source = 0;
+	}
 
-		if (_buffer != 0) {
-			// Free the buffer
-			alDeleteBuffers(1, &_buffer);
-			_buffer = 0;
-		}
+	if (!_buffers.empty()) {
+		// Free the buffers
+		alDeleteBuffers(static_cast<ALsizei>(_buffers.size()), _buffers.data());
+		_buffers.clear();
 	}
 
+	_playedBuffers.clear();
+	_decodingFinished = false;
+	_loopingEnabled = false;
+	_playbackStarted = false;
+
 	_timer.Stop();
 }
 
@@ -135,7 +241,7 @@ void SoundPlayer::stop()
 	clearBuffer();
 }
 
-void SoundPlayer::play(ArchiveFile& file, bool loopSound) 
+void SoundPlayer::play(const ArchiveFilePtr& file, bool loopSound)
 {
 	// If we're not initialised yet, do it now
 	if (!_initialised) 
@@ -146,68 +252,46 @@ void SoundPlayer::play(ArchiveFile& file, bool loopSound)
 	// Stop any previous playback operations, that might be still active
 	clearBuffer();
 
-	// Retrieve the extension
-	std::string ext = os::getExtension(file.getName());
-
-	if (string::to_lower_copy(ext) == "ogg")
-	{
-		createBufferDataFromOgg(file);
-	}
-	else 
-	{
-		createBufferDataFromWav(file);
-	}
-
-	if (_buffer != 0) 
-	{
-		alGenSources(1, &_source);
+	auto sound = std::make_shared<DecodedSoundBuffer>();
 
-		// Assign the buffer to the source and play it
-		alSourcei(_source, AL_BUFFER, _buffer);
+	_decodedSound = sound;
+	_loop = loopSound;
 
-		// Set the looping flag
-		alSourcei(_source, AL_LOOPING, loopSound ? AL_TRUE : AL_FALSE);
+	_decoder.enqueue([file, sound]() { decode(file, sound); });
 
-		// greebo: Wait 10 msec. to fix a problem with buffers not being played
-		// maybe the AL needs time to push the data?
-		usleep(10000);
+	alGenSources(1, &_source);
 
-		alSourcePlay(_source);
+	// Looping is enabled once all buffers have been queued
+	alSourcei(_source, AL_LOOPING, AL_FALSE);
 
-		// Enable the periodic buffer check, this destructs the buffer
-		// as soon as the playback has finished
-		_timer.Start(200);
-	}
+	// Enable the periodic check, this queues the decoded data, starts
+	// the playback and destructs the buffers as soon as it has finished
+	_timer.Start(STREAMING_INTERVAL_MSEC);
 }
 
-void SoundPlayer::createBufferDataFromWav(ArchiveFile& file)
+void SoundPlayer::decode(const ArchiveFilePtr& file, const DecodedSoundBuffer::Ptr& sound)
 {
-	// Must be a wave file
+	// Retrieve the extension
+	auto ext = string::to_lower_copy(os::getExtension(file->getName()));
+
 	try
 	{
-		// Create an AL sound buffer directly from the buffer in memory
-		_buffer = WavFileLoader::LoadFromStream(file.getInputStream());
+		if (ext == "ogg")
+		{
+			OggFileLoader::Decode(*file, *sound);
+		}
+		else
+		{
+			// Must be a wave file
+			WavFileLoader::Decode(file->getInputStream(), *sound);
+		}
 	}
-	catch (std::runtime_error& e)
+	catch (const std::runtime_error& e)
 	{
-		rError() << "SoundPlayer: Error opening WAV file: " << e.what() << std::endl;
-		_buffer = 0;
+		rError() << "SoundPlayer: Error decoding " << file->getName() << ": " << e.what() << std::endl;
 	}
-}
 
-void SoundPlayer::createBufferDataFromOgg(ArchiveFile& file)
-{
-    // Must be an OGG file
-    try
-    {
-        // Create an AL sound buffer directly from the buffer in memory
-        _buffer = OggFileLoader::LoadFromFile(file);
-    }
-    catch (std::runtime_error & e)
-    {
-        rError() << "SoundPlayer: Error opening OGG file: " << e.what() << std::endl;
-        _buffer = 0;
-    }
+	sound->setFinished();
 }
 
 } // namespace sound
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #ifdef __APPLE__
 #include <OpenAL/al.h>
@@ -12,7 +13,9 @@
 
 #include <wx/timer.h>
 
-class ArchiveFile;
+#include "iarchive.h"
+#include "SequentialTaskQueue.h"
+#include "DecodedSoundBuffer.h"
 
 namespace sound {
 
@@ -25,16 +28,34 @@ protected:
 
 	ALCcontext* _context;
 
-	// The buffer containing the currently played audio data
-	ALuint _buffer;
-
-	// The source playing the buffer
+	// The source playing the queued buffers
 	ALuint _source;
 
-	// The timer object to check whether the sound is done playing
-	// to destroy the buffer afterwards
+	bool _loop;
+
+	// The data decoded by the worker, which is moved into AL buffers by the timer
+	DecodedSoundBuffer::Ptr _decodedSound;
+	bool _decodingFinished;
+
+	// Set once the source loops over the fully queued sound
+	bool _loopingEnabled;
+
+	// Has the source been started before
+	bool _playbackStarted;
+
+	// All buffers created for the current sound
+	std::vector<ALuint> _buffers;
+
+	// Buffers already played by a looping source, queued again once decoding has finished
+	std::vector<ALuint> _playedBuffers;
+
+	// The timer object streaming the decoded data to the source, and checking
+	// whether the sound is done playing to destroy the buffers afterwards
 	wxTimer _timer;
 
+	// Decodes the sound files, declared last such that it is stopped first
+	util::SequentialTaskQueue _decoder;
+
 public:
 	// Constructor
 	SoundPlayer();
@@ -45,9 +66,10 @@ public:
 	virtual ~SoundPlayer();
 
 	/** greebo: Call this with the ArchiveFile object containing
-	 * 			the file to be played.
+	 * 			the file to be played. The file is decoded in the
+	 * 			background, playback starts with the first decoded chunk.
 	 */
-	virtual void play(ArchiveFile& file, bool loopSound);
+	virtual void play(const ArchiveFilePtr& file, bool loopSound);
 
 	/** greebo: Stops the playback immediately.
 	 */
@@ -60,11 +82,15 @@ protected:
 	// Clears the buffer, stops playing
 	void clearBuffer();
 
-	// This is called periodically to check whether the buffer can be cleared
+	// This is called periodically to queue the decoded data
+	// and to check whether the buffers can be cleared
 	void onTimerIntervalReached(wxTimerEvent& ev);
 
-	void createBufferDataFromOgg(ArchiveFile& file);
-	void createBufferDataFromWav(ArchiveFile& file);
+	// Moves the chunks decoded so far into buffers queued on the source
+	void queueDecodedChunks();
+
+	// Runs on the decoder thread
+	static void decode(const ArchiveFilePtr& file, const DecodedSoundBuffer::Ptr& sound);
 };
 
 } // namespace sound
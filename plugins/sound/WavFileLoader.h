@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
 #include "idatastream.h"
+#include "isound.h"
+#include "DecodedSoundBuffer.h"
 
 #ifdef __APPLE__
 #include <OpenAL/al.h>
@@ -14,7 +18,7 @@ class InputStream;
 namespace sound {
 
 /**
- * greebo: Loader class creating an AL buffer from a WAV file.
+ * greebo: Loader class reading WAV files.
  *
  * Modeled after the one used by the Ogre3D people, found it posted
  * somewhere on the net.
@@ -47,7 +51,7 @@ private:
             }
             else
             {
-                return  bps == 8 ? AL_FORMAT_STEREO16 : AL_FORMAT_STEREO16;
+                return bps == 8 ? AL_FORMAT_STEREO8 : AL_FORMAT_STEREO16;
             }
         }
     };
@@ -56,10 +60,10 @@ private:
 
 public:
     /**
-     * greebo: Determines the WAV file length in seconds.
+     * Reads the format and length of a WAV file from its headers.
      * @throws: std::runtime_error if an error occurs.
      */
-    static float GetDuration(InputStream& stream)
+    static SoundFileInfo GetInfo(InputStream& stream)
     {
         FileInfo info;
         ParseFileInfo(stream, info);
@@ -70,20 +74,32 @@ public:
         unsigned int remainingSize = 0;
         stream.read(reinterpret_cast<byte*>(&remainingSize), sizeof(remainingSize));
 
+        if (info.channels == 0 || info.freq == 0 || info.bps < 8)
+        {
+            throw std::runtime_error("Invalid 'fmt ' chunk.");
+        }
+
         // Calculate how many samples we have in the payload, then calculate the duration
         auto numSamples = remainingSize / (info.bps >> 3);
         auto numSamplesPerChannel = numSamples / info.channels;
 
-        return static_cast<float>(numSamplesPerChannel) / info.freq;
+        SoundFileInfo result;
+        result.duration = static_cast<float>(numSamplesPerChannel) / info.freq;
+        result.channels = info.channels;
+        result.sampleRate = info.freq;
+        result.bitsPerSample = info.bps;
+
+        return result;
     }
 
 	/**
-	 * greebo: Loads a WAV file from a stream into OpenAL,
-     * returns the openAL buffer handle.
+	 * Reads the PCM data of a WAV file from the given stream, which is handed
+	 * to the given buffer chunk by chunk, until the end of the data is reached
+	 * or the playback has been cancelled.
 	 *
 	 * @throws: std::runtime_error if an error occurs.
 	 */
-	static ALuint LoadFromStream(InputStream& stream)
+	static void Decode(InputStream& stream, DecodedSoundBuffer& buffer)
     {
         FileInfo info;
         ParseFileInfo(stream, info);
@@ -94,15 +110,28 @@ public:
 		unsigned int remainingSize = 0;
 		stream.read(reinterpret_cast<byte*>(&remainingSize), sizeof(remainingSize));
 
-		ALuint bufferNum = 0;
-		alGenBuffers(1, &bufferNum);
+        buffer.setFormat(info.getAlFormat(), static_cast<ALsizei>(info.freq));
+
+        // Keep the chunks aligned to whole sample frames
+        std::size_t frameSize = std::max<std::size_t>(info.channels * (info.bps >> 3), 1);
 
-        std::vector<byte> data(remainingSize);
-        stream.read(data.data(), remainingSize);
+        while (remainingSize > 0)
+        {
+            auto chunkSize = std::min<std::size_t>(buffer.getNextChunkSize() / frameSize * frameSize, remainingSize);
 
-		alBufferData(bufferNum, info.getAlFormat(), data.data(), static_cast<ALsizei>(remainingSize), info.freq);
+            std::vector<char> chunk(chunkSize);
+            auto bytesRead = stream.read(reinterpret_cast<byte*>(chunk.data()), chunkSize);
 
-		return bufferNum;
+            if (bytesRead == 0) break; // truncated file
+
+            chunk.resize(bytesRead);
+            remainingSize -= static_cast<unsigned int>(bytesRead);
+
+            if (!buffer.addChunk(std::move(chunk)))
+            {
+                return; // cancelled
+            }
+        }
 	}
 
 private:
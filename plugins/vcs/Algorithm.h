@@ -9,7 +9,9 @@
 #include "GitModule.h"
 #include "Commit.h"
 #include "Diff.h"
+#include "Tree.h"
 #include "VersionControlLib.h"
+#include "scene/merge/MapTextComparer.h"
 #include "command/ExecutionFailure.h"
 #include "wxutil/dialog/MessageBox.h"
 #include "ui/CommitDialog.h"
@@ -54,6 +56,62 @@ struct RemoteStatus
     RequiredMergeStrategy strategy;
 };
 
+inline std::shared_ptr<Tree> getTreeOfReference(const std::shared_ptr<Repository>& repository, const Reference& reference)
+{
+    git_oid oid;
+    auto error = git_reference_name_to_id(&oid, repository->_get(), reference.getName().c_str());
+    GitException::ThrowOnError(error);
+
+    return repository->getTreeByRevision(Reference::OidToString(&oid));
+}
+
+/**
+ * Compares the two map streams on the text level and returns a short summary
+ * of the differing entities. No map is loaded for this, which makes it suitable
+ * for status checks. Returns an empty string if the map format is not supported.
+ */
+inline std::string getMapChangeSummary(std::istream& sourceMap, std::istream& baseMap)
+{
+    using scene::merge::MapTextComparer;
+
+    try
+    {
+        auto result = MapTextComparer::Compare(sourceMap, baseMap);
+
+        return fmt::format(_("Entities added: {0}, removed: {1}, changed: {2}"),
+            result.countDifferences(MapTextComparer::EntityDifference::Type::EntityAdded),
+            result.countDifferences(MapTextComparer::EntityDifference::Type::EntityRemoved),
+            result.countDifferences(MapTextComparer::EntityDifference::Type::EntityChanged));
+    }
+    catch (const parser::ParseException& ex)
+    {
+        rMessage() << "Cannot compare map files: " << ex.what() << std::endl;
+        return std::string();
+    }
+}
+
+// Summarises the changes to the given map file between the two trees
+inline std::string getMapChangeSummary(const std::shared_ptr<Repository>& repository, 
+    Tree& sourceTree, Tree& baseTree, const std::string& mapPath)
+{
+    try
+    {
+        auto sourceFile = sourceTree.openTextFile(mapPath, *repository);
+        auto baseFile = baseTree.openTextFile(mapPath, *repository);
+
+        std::istream sourceStream(&sourceFile->getInputStream());
+        std::istream baseStream(&baseFile->getInputStream());
+
+        return getMapChangeSummary(sourceStream, baseStream);
+    }
+    catch (const GitException& ex)
+    {
+        // The map might not be present in one of the trees
+        rMessage() << "Cannot compare map files: " << ex.what() << std::endl;
+        return std::string();
+    }
+}
+
 inline RemoteStatus analyseRemoteStatus(const std::shared_ptr<Repository>& repository)
 {
     auto mapPath = repository->getRepositoryRelativePath(GlobalMapModule().getMapName());
@@ -129,6 +187,36 @@ inline RemoteStatus analyseRemoteStatus(const std::shared_ptr<Repository>& repos
         RequiredMergeStrategy::MergeMap };
 }
 
+// Summarises the changes the upstream branch made to the loaded map since the merge base.
+// Returns an empty string if there are none. This reads both versions of the map file,
+// it is meant to be called from a worker thread.
+inline std::string getIncomingMapChanges(const std::shared_ptr<Repository>& repository)
+{
+    try
+    {
+        auto mapPath = repository->getRepositoryRelativePath(GlobalMapModule().getMapName());
+        auto head = repository->getHead();
+        auto upstream = head ? head->getUpstream() : Reference::Ptr();
+
+        if (mapPath.empty() || !upstream) return std::string();
+
+        auto mergeBase = repository->findMergeBase(*head, *upstream);
+
+        if (!repository->getDiff(*upstream, *mergeBase)->containsFile(mapPath))
+        {
+            return std::string();
+        }
+
+        return getMapChangeSummary(repository,
+            *getTreeOfReference(repository, *upstream), *mergeBase->getTree(), mapPath);
+    }
+    catch (const GitException& ex)
+    {
+        rMessage() << "Cannot determine incoming map changes: " << ex.what() << std::endl;
+        return std::string();
+    }
+}
+
 inline std::string getInfoFilePath(const std::string& mapPath)
 {
     auto format = GlobalMapFormatManager().getMapFormatForFilename(mapPath);
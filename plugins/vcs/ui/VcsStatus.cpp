@@ -6,6 +6,7 @@
 #include "ui/imainframe.h"
 #include "imapformat.h"
 
+#include <fstream>
 #include <wx/sizer.h>
 #include <wx/bmpbuttn.h>
 #include <sigc++/functors/mem_fun.h>
@@ -327,6 +328,7 @@ void VcsStatus::performFetch(std::shared_ptr<git::Repository> repository)
     }
 
     analyseRemoteStatus(repository);
+    setIncomingMapChanges(git::getIncomingMapChanges(repository));
 
     _taskInProgress = false;
 }
@@ -436,6 +438,15 @@ void VcsStatus::setRemoteStatus(const git::RemoteStatus& status)
     });
 }
 
+void VcsStatus::setIncomingMapChanges(const std::string& summary)
+{
+    GlobalUserInterface().dispatch([this, summary]()
+    {
+        _remoteStatus->SetToolTip(summary.empty() ? wxString() :
+            wxString(_("Incoming map changes: ") + summary));
+    });
+}
+
 void VcsStatus::performMapFileStatusCheck(std::shared_ptr<git::Repository> repository)
 {
     try
@@ -451,6 +462,30 @@ void VcsStatus::performMapFileStatusCheck(std::shared_ptr<git::Repository> repos
         if (repository->fileHasUncommittedChanges(relativePath))
         {
             setMapFileStatus(_("Map saved, pending commit"));
+
+            // Compare the saved map against the committed one, without loading it
+            auto head = repository->getHead();
+            std::ifstream mapStream(GlobalMapModule().getMapName(), std::ios::binary);
+
+            if (head && mapStream)
+            {
+                try
+                {
+                    auto committedFile = git::getTreeOfReference(repository, *head)->openTextFile(relativePath, *repository);
+                    std::istream committedStream(&committedFile->getInputStream());
+
+                    auto summary = git::getMapChangeSummary(mapStream, committedStream);
+
+                    if (!summary.empty())
+                    {
+                        setMapFileStatus(fmt::format(_("Map saved, pending commit ({0})"), summary));
+                    }
+                }
+                catch (const git::GitException&)
+                {
+                    // The map is not part of the HEAD commit yet
+                }
+            }
         }
         else if (repository->fileIsIndexed(relativePath))
         {
@@ -465,6 +500,9 @@ void VcsStatus::performMapFileStatusCheck(std::shared_ptr<git::Repository> repos
     {
         setMapFileStatus(std::string("ERROR: ") + ex.what());
     }
+
+    // The loaded or saved map might differ from the one the upstream branch changed
+    setIncomingMapChanges(git::getIncomingMapChanges(repository));
 }
 
 }
@@ -68,6 +68,7 @@ private:
     void onMapEvent(IMap::MapEvent ev);
     void setMapFileStatus(const std::string& status);
     void setRemoteStatus(const git::RemoteStatus& status);
+    void setIncomingMapChanges(const std::string& summary);
     void analyseRemoteStatus(std::shared_ptr<git::Repository> repository);
 
     std::string getRepositoryRelativePath(const std::string& path, const std::shared_ptr<git::Repository>& repository);
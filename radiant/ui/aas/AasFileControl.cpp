@@ -1,9 +1,8 @@
 #include "AasFileControl.h"
 
 #include "i18n.h"
-#include "iarchive.h"
 #include "ui/imainframe.h"
-#include "ifilesystem.h"
+#include "ui/iuserinterface.h"
 
 #include <wx/event.h>
 #include <wx/button.h>
@@ -12,6 +11,8 @@
 #include <wx/sizer.h>
 #include "wxutil/Bitmap.h"
 #include <memory>
+#include <thread>
+#include <fmt/format.h>
 
 namespace ui
 {
@@ -21,7 +22,9 @@ AasFileControl::AasFileControl(wxWindow* parent, const map::AasFileInfo& info) :
     _refreshButton(nullptr),
     _buttonHBox(nullptr),
     _updateActive(nullptr),
-    _info(info)
+    _info(info),
+    _loading(false),
+    _destroyed(std::make_shared<bool>(false))
 {
     // Create the main toggle
 	_toggle = new wxToggleButton(parent, wxID_ANY, info.type.fileExtension);
@@ -41,6 +44,9 @@ AasFileControl::AasFileControl(wxWindow* parent, const map::AasFileInfo& info) :
 
 AasFileControl::~AasFileControl()
 {
+    // Any pending completion callback must not touch this instance
+    *_destroyed = true;
+
     // Detach before destruction
     if (_toggle->GetValue())
     {
@@ -61,30 +67,50 @@ wxToggleButton* AasFileControl::getToggle()
 
 void AasFileControl::update()
 {
-
+    // Show the loading state on the toggle while the file is parsed
+    _toggle->SetLabel(_loading ?
+        fmt::format(_("{0} (loading...)"), _info.type.fileExtension) : _info.type.fileExtension);
+    _refreshButton->Enable(!_loading);
 }
 
 void AasFileControl::ensureAasFileLoaded()
 {
-    if (_aasFile) return;
+    if (_aasFile || _loading) return;
 
-    ArchiveTextFilePtr file = GlobalFileSystem().openTextFileInAbsolutePath(_info.absolutePath);
+    _loading = true;
 
-    if (file)
+    // Not waited for: closing the control or changing the map must not block on the parser,
+    // a result arriving after destruction is dropped
+    std::thread([info = _info, destroyed = _destroyed, this]()
     {
-        std::istream stream(&file->getInputStream());
-        map::IAasFileLoaderPtr loader = GlobalAasFileManager().getLoaderForStream(stream);
+        auto aasFile = GlobalAasFileManager().loadAasFile(info);
 
-        if (loader && loader->canLoad(stream))
+        // Hand the result over to the UI thread
+        GlobalUserInterface().dispatch([aasFile, destroyed, this]()
         {
-            stream.seekg(0, std::ios_base::beg);
+            if (!*destroyed)
+            {
+                onAasFileLoaded(aasFile);
+            }
+        });
+    }).detach();
+
+    update();
+}
 
-            _aasFile = loader->loadFromStream(stream);
+void AasFileControl::onAasFileLoaded(const map::IAasFilePtr& aasFile)
+{
+    _loading = false;
+    _aasFile = aasFile;
 
-            // Construct a renderable to attach to the rendersystem
-            _renderable.setAasFile(_aasFile);
-        }
+    if (_toggle->GetValue())
+    {
+        // Construct a renderable to attach to the rendersystem
+        _renderable.setAasFile(_aasFile);
+        GlobalMainFrame().updateAllWindows();
     }
+
+    update();
 }
 
 void AasFileControl::onToggle(wxCommandEvent& ev)
@@ -93,6 +119,7 @@ void AasFileControl::onToggle(wxCommandEvent& ev)
     {
         ensureAasFileLoaded();
 
+        // The renderable stays empty until the file has been loaded
         _renderable.setAasFile(_aasFile);
         GlobalRenderSystem().attachRenderable(_renderable);
     }
@@ -108,17 +135,14 @@ void AasFileControl::onToggle(wxCommandEvent& ev)
 
 void AasFileControl::onRefresh(wxCommandEvent& ev)
 {
-    // Detach renderable
+    if (_loading) return;
+
     _aasFile.reset();
     _renderable.clear();
 
     if (_toggle->GetValue())
     {
-		GlobalRenderSystem().detachRenderable(_renderable);
-
         ensureAasFileLoaded();
-
-        GlobalRenderSystem().attachRenderable(_renderable);
     }
 }
 
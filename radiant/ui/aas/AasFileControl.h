@@ -37,6 +37,12 @@ private:
     // The AAS file reference (can be empty)
     map::IAasFilePtr _aasFile;
 
+    // True while the file is loaded in the background
+    bool _loading;
+
+    // Shared with the loader's completion callback, set to true on destruction
+    std::shared_ptr<bool> _destroyed;
+
     // The renderable that is attached to the rendersystem when active
     map::RenderableAasFile _renderable;
 
@@ -53,7 +59,9 @@ public:
 	void update();
 
 private:
+    // Starts loading the AAS file in the background, unless it's loaded or loading already
     void ensureAasFileLoaded();
+    void onAasFileLoaded(const map::IAasFilePtr& aasFile);
 
 	void onToggle(wxCommandEvent& ev);
 	void onRefresh(wxCommandEvent& ev);
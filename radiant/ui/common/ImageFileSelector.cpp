@@ -30,6 +30,7 @@ public:
     void SetVisibleTextureTypes(int typesToShow)
     {
         _textureTypesToShow = typesToShow;
+        InvalidateTreeVisibility();
     }
 
 protected:
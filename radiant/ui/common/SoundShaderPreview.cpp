@@ -289,8 +289,9 @@ void SoundShaderPreview::loadFileDurationAsync(const std::string& soundFile)
 
             if (duration < 0)
             {
-                // Duration still unknown, run the query
-                duration = GlobalSoundManager().getSoundFileDuration(soundFile);
+                // Duration still unknown, run the query (the sound manager reads
+                // this from the file headers and keeps it for later previews)
+                duration = GlobalSoundManager().getSoundFileInfo(soundFile).duration;
 
                 // Store the duration in the local cache
                 std::lock_guard<std::mutex> lock(_durationsLock);
@@ -5,7 +5,6 @@
 #include "SoundShaderPreview.h"
 
 #include "wxutil/dataview/ThreadedDeclarationTreePopulator.h"
-#include "wxutil/dataview/VFSTreePopulator.h"
 
 #include "debugging/ScopedDebugTimer.h"
 #include "os/path.h"
@@ -34,8 +33,9 @@ public:
     {
         ScopedDebugTimer timer("ThreadedSoundShaderLoader::run()");
 
-        wxutil::VFSTreePopulator populator(model);
-        
+        std::vector<std::string> paths;
+        std::vector<std::string> declNames;
+
         // Visit all sound shaders and collect them for later insertion
         GlobalSoundManager().forEachShader([&](const ISoundShader::Ptr& shader)
         {
@@ -49,17 +49,15 @@ public:
             // Some shaders contain backslashes, sort them in the tree by replacing the backslashes
             auto shaderNameForwardSlashes = os::standardPath(shader->getDeclName());
 
-            auto fullPath = !displayFolder.empty() ?
+            paths.emplace_back(!displayFolder.empty() ?
                 shader->getModName() + "/" + displayFolder + "/" + shaderNameForwardSlashes :
-                shader->getModName() + "/" + shaderNameForwardSlashes;
-
-            // Sort the shader into the tree and set the values
-            populator.addPath(fullPath, [&](wxutil::TreeModel::Row& row, 
-                const std::string& path, const std::string& leafName, bool isFolder)
-            {
-                AssignValuesToRow(row, path, isFolder ? path : shader->getDeclName(), leafName, isFolder);
-            });
+                shader->getModName() + "/" + shaderNameForwardSlashes);
+
+            declNames.emplace_back(shader->getDeclName());
         });
+
+        // Sort the shaders into the tree and set the values
+        PopulateFromPaths(model, paths, declNames);
     }
 };
 
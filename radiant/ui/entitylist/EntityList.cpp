@@ -29,6 +29,7 @@ namespace
 
 EntityList::EntityList(wxWindow* parent) :
     DockablePanel(parent),
+	_treeModel([this]() { requestIdleCallback(); }),
 	_callbackActive(false)
 {
 	populateWindow();
@@ -43,6 +44,8 @@ EntityList::~EntityList()
     {
         _treeView->Unbind(wxEVT_DATAVIEW_SELECTION_CHANGED, &EntityList::onSelection, this);
         _treeView->Unbind(wxEVT_DATAVIEW_ITEM_EXPANDED, &EntityList::onRowExpand, this);
+        _treeView->Unbind(wxEVT_DATAVIEW_ITEM_EXPANDING, &EntityList::onRowExpanding, this);
+        _treeView->Unbind(wxEVT_DATAVIEW_ITEM_COLLAPSED, &EntityList::onRowCollapsed, this);
     }
 
     if (panelIsActive())
@@ -124,6 +127,8 @@ void EntityList::populateWindow()
 
 	_treeView->Bind(wxEVT_DATAVIEW_SELECTION_CHANGED, &EntityList::onSelection, this);
 	_treeView->Bind(wxEVT_DATAVIEW_ITEM_EXPANDED, &EntityList::onRowExpand, this);
+	_treeView->Bind(wxEVT_DATAVIEW_ITEM_EXPANDING, &EntityList::onRowExpanding, this);
+	_treeView->Bind(wxEVT_DATAVIEW_ITEM_COLLAPSED, &EntityList::onRowCollapsed, this);
 
 	// Update the toggle item status according to the registry
 
@@ -211,6 +216,32 @@ void EntityList::onRowExpand(wxDataViewEvent& ev)
     updateSelectionStatus();
 }
 
+void EntityList::onRowExpanding(wxDataViewEvent& ev)
+{
+    auto rootNode = _treeModel.find(GlobalSceneGraph().root());
+
+    if (!rootNode || rootNode->getIter() != ev.GetItem()) return;
+
+    // Create the entity rows right before they become visible
+    util::ScopedBoolLock lock(_callbackActive);
+    wxWindowUpdateLocker freezer(_treeView);
+
+    _treeModel.setEntityBranchExpanded(true);
+}
+
+void EntityList::onRowCollapsed(wxDataViewEvent& ev)
+{
+    auto rootNode = _treeModel.find(GlobalSceneGraph().root());
+
+    if (!rootNode || rootNode->getIter() != ev.GetItem()) return;
+
+    // Hidden entity rows are dropped, the model keeps the lookup entries
+    util::ScopedBoolLock lock(_callbackActive);
+    wxWindowUpdateLocker freezer(_treeView);
+
+    _treeModel.setEntityBranchExpanded(false);
+}
+
 void EntityList::onVisibleOnlyToggle(wxCommandEvent& ev)
 {
     _treeModel.setConsiderVisibleNodesOnly(_visibleOnly->GetValue());
@@ -225,12 +256,27 @@ void EntityList::expandRootNode()
 
 	if (rootNode && !_treeView->IsExpanded(rootNode->getIter()))
 	{
+		_treeModel.setEntityBranchExpanded(true);
 		_treeView->Expand(rootNode->getIter());
 	}
 }
 
 void EntityList::onIdle()
 {
+    // Apply the scene changes collected since the last idle event in one go
+    bool sceneChanged = false;
+    {
+        util::ScopedBoolLock lock(_callbackActive);
+        wxWindowUpdateLocker freezer(_treeView);
+
+        sceneChanged = _treeModel.flushPendingChanges();
+    }
+
+    if (sceneChanged)
+    {
+        updateSelectionStatus();
+    }
+
     if (!_nodesToUpdate.empty())
     {
         for (const auto& weakNode : _nodesToUpdate)
@@ -285,7 +331,13 @@ void EntityList::onSelection(wxDataViewEvent& ev)
     {
         // Load the instance pointer from the columns
         wxutil::TreeModel::Row row(item, *_treeModel.getModel());
-        desiredSelection.insert(static_cast<scene::INode*>(row[_treeModel.getColumns().node].getPointer()));
+        auto node = static_cast<scene::INode*>(row[_treeModel.getColumns().node].getPointer());
+
+        // Placeholder rows and rows of erased nodes don't point to a node
+        if (node != nullptr)
+        {
+            desiredSelection.insert(node);
+        }
     }
 
     // Check the existing map selection to run a diff
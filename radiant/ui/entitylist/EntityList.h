@@ -75,6 +75,8 @@ private:
 	void onFilterConfigChanged();
 
 	void onRowExpand(wxDataViewEvent& ev);
+	void onRowExpanding(wxDataViewEvent& ev);
+	void onRowCollapsed(wxDataViewEvent& ev);
 
 	// Called when the user is updating the treeview selection
 	void onSelection(wxDataViewEvent& ev);
@@ -3,15 +3,20 @@
 #include "iselectable.h"
 #include "iselection.h"
 
+#include <algorithm>
+
 #include "GraphTreeModelPopulator.h"
 #include "debugging/ScenegraphUtils.h"
 
 namespace ui
 {
 
-GraphTreeModel::GraphTreeModel() :
+GraphTreeModel::GraphTreeModel(const std::function<void()>& onChangesQueued) :
 	_model(new wxutil::TreeModel(_columns)),
-	_visibleNodesOnly(false)
+	_visibleNodesOnly(false),
+	_changeSequence(0),
+	_onChangesQueued(onChangesQueued),
+	_entityBranchExpanded(false)
 {}
 
 GraphTreeModel::~GraphTreeModel()
@@ -36,10 +41,8 @@ const GraphTreeNode::Ptr& GraphTreeModel::insert(const scene::INodePtr& node)
 	// Insert this iterator below a possible parent iterator
 	auto parentIter = findParentIter(node);
 
-	wxutil::TreeModel::Row row = parentIter ? _model->AddItemUnderParent(parentIter) : _model->AddItem();
-
 	// Create a new GraphTreeNode
-	auto gtNode = std::make_shared<GraphTreeNode>(node, row.getItem());
+	auto gtNode = std::make_shared<GraphTreeNode>(node);
 
     // Assign root node member
     if (node->getNodeType() == scene::INode::Type::MapRoot)
@@ -47,15 +50,25 @@ const GraphTreeNode::Ptr& GraphTreeModel::insert(const scene::INodePtr& node)
         _mapRootNode = gtNode;
     }
 
-	// Fill in the values
-	row[_columns.node] = wxVariant(node.get());
-	row[_columns.name] = node->name();
+    // Entities below a collapsed map root don't get a row until it is expanded
+    bool createRowNow = node->getNodeType() != scene::INode::Type::Entity || _entityBranchExpanded;
 
-	row.SendItemAdded();
+    if (createRowNow)
+    {
+        gtNode->getIter() = createRow(parentIter, node);
+        _model->ItemAdded(parentIter, gtNode->getIter());
+    }
 
 	// Insert this iterator into the node map to facilitate lookups
+	const auto& result = _nodemap.emplace(node, gtNode).first->second;
+
+    if (!createRowNow)
+    {
+        updatePlaceholder();
+    }
+
 	// Return the GraphTreeNode reference
-	return _nodemap.emplace(node, gtNode).first->second;
+	return result;
 }
 
 void GraphTreeModel::erase(const scene::INodePtr& node)
@@ -65,16 +78,164 @@ void GraphTreeModel::erase(const scene::INodePtr& node)
 	if (found != _nodemap.end())
 	{
 		// Remove this from the model...
-		_model->RemoveItem(found->second->getIter());
+		if (found->second->getIter().IsOk())
+		{
+			_model->RemoveItem(found->second->getIter());
+		}
+
+        if (found->second == _mapRootNode)
+        {
+            _mapRootNode.reset();
+            _placeholderItem.Unset(); // removed along with the root row
+        }
 
 		// ...and from our lookup table
 		_nodemap.erase(found);
 
-        if (_mapRootNode && _mapRootNode->getNode() == node)
+        updatePlaceholder();
+	}
+}
+
+bool GraphTreeModel::flushPendingChanges()
+{
+    if (_pendingChanges.empty()) return false;
+
+    auto changes = std::move(_pendingChanges);
+    _pendingChanges.clear();
+
+    wxDataViewItemArray rowsToRemove;
+    std::vector<std::pair<std::size_t, scene::INodePtr>> nodesToInsert;
+    bool mapRootErased = false;
+
+    for (const auto& [weakNode, pending] : changes)
+    {
+        auto node = weakNode.lock();
+
+        // Nodes that have been removed again in the meantime are treated as erased
+        if (pending.change == Change::Erase || !node || !node->inScene())
         {
-            _mapRootNode.reset();
+            auto found = _nodemap.find(weakNode);
+
+            if (found == _nodemap.end()) continue;
+
+            if (found->second == _mapRootNode)
+            {
+                mapRootErased = true;
+            }
+            else if (found->second->getIter().IsOk())
+            {
+                rowsToRemove.push_back(found->second->getIter());
+            }
+
+            _nodemap.erase(found);
         }
-	}
+        else if (auto found = _nodemap.find(weakNode); found == _nodemap.end())
+        {
+            nodesToInsert.emplace_back(pending.sequence, node);
+        }
+        else if (found->second->getIter().IsOk())
+        {
+            // Erased and inserted again before this flush, the erasure cleared the row's node
+            wxutil::TreeModel::Row row(found->second->getIter(), *_model);
+            row[_columns.node] = wxVariant(node.get());
+            row[_columns.name] = node->name();
+            row.SendItemChanged();
+        }
+    }
+
+    if (mapRootErased)
+    {
+        // The entities of the old map are gone with their root, start over
+        clear();
+    }
+    else
+    {
+        _model->RemoveItems(rowsToRemove);
+    }
+
+    // Restore the order of arrival, which puts the map root before its entities
+    std::sort(nodesToInsert.begin(), nodesToInsert.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<GraphTreeNode::Ptr> newEntities;
+
+    for (const auto& [sequence, node] : nodesToInsert)
+    {
+        if (_nodemap.count(node) > 0) continue; // already added as parent of an entity
+
+        if (node->getNodeType() != scene::INode::Type::Entity)
+        {
+            insert(node);
+            continue;
+        }
+
+        if (!_mapRootNode)
+        {
+            if (!node->getParent()) continue;
+
+            insert(node->getParent());
+        }
+
+        auto gtNode = std::make_shared<GraphTreeNode>(node);
+        _nodemap.emplace(node, gtNode);
+        newEntities.push_back(gtNode);
+    }
+
+    if (_entityBranchExpanded)
+    {
+        addEntityRows(newEntities);
+    }
+
+    updatePlaceholder();
+
+    return true;
+}
+
+void GraphTreeModel::setEntityBranchExpanded(bool expanded)
+{
+    if (_entityBranchExpanded == expanded) return;
+
+    _entityBranchExpanded = expanded;
+
+    if (!_mapRootNode) return;
+
+    if (expanded)
+    {
+        std::vector<GraphTreeNode::Ptr> entities;
+        entities.reserve(_nodemap.size());
+
+        for (const auto& [_, gtNode] : _nodemap)
+        {
+            if (gtNode != _mapRootNode)
+            {
+                entities.push_back(gtNode);
+            }
+        }
+
+        // Add the rows before removing the placeholder, the branch must not run empty
+        addEntityRows(entities);
+        updatePlaceholder();
+
+        _model->SortModelByColumn(_columns.name);
+    }
+    else
+    {
+        wxDataViewItemArray rows;
+        rows.reserve(_nodemap.size());
+
+        for (const auto& [_, gtNode] : _nodemap)
+        {
+            if (gtNode != _mapRootNode && gtNode->getIter().IsOk())
+            {
+                rows.push_back(gtNode->getIter());
+                gtNode->getIter().Unset();
+            }
+        }
+
+        _model->RemoveItems(rows);
+
+        updatePlaceholder();
+    }
 }
 
 const GraphTreeNode::Ptr& GraphTreeModel::find(const scene::INodePtr& node) const
@@ -89,6 +250,10 @@ void GraphTreeModel::clear()
 	_nodemap.clear();
 	_model->Clear();
     _mapRootNode.reset();
+    _placeholderItem.Unset();
+
+    // Whatever has been queued is covered by the next refresh
+    _pendingChanges.clear();
 }
 
 void GraphTreeModel::refresh()
@@ -100,15 +265,16 @@ void GraphTreeModel::refresh()
     _model = new wxutil::TreeModel(_columns);
 #endif
 
+    // The entity rows are created once the map root is expanded,
+    // sorting them is left to setEntityBranchExpanded()
+    _entityBranchExpanded = false;
+
     if (!GlobalSceneGraph().root()) return;
 
 	// Instantiate a scenegraph walker and visit every node in the graph
 	// The walker also clears the graph in its constructor
 	GraphTreeModelPopulator populator(*this, _visibleNodesOnly);
 	GlobalSceneGraph().root()->traverse(populator);
-
-    // Now sort the model once we have all nodes in the tree
-    _model->SortModelByColumn(_columns.name);
 }
 
 void GraphTreeModel::setConsiderVisibleNodesOnly(bool visibleOnly)
@@ -128,7 +294,7 @@ void GraphTreeModel::updateSelectionStatus(const NotifySelectionUpdateFunc& noti
 void GraphTreeModel::updateSelectionStatus(const scene::INodePtr& node,
     const NotifySelectionUpdateFunc& notifySelectionChanged)
 {
-    if (auto found = _nodemap.find(node); found != _nodemap.end())
+    if (auto found = _nodemap.find(node); found != _nodemap.end() && found->second->getIter().IsOk())
     {
         notifySelectionChanged(found->second->getIter(), Node_isSelected(node));
     }
@@ -156,6 +322,72 @@ wxDataViewItem GraphTreeModel::findParentIter(const scene::INodePtr& node)
     }
 }
 
+void GraphTreeModel::addEntityRows(const std::vector<GraphTreeNode::Ptr>& entities)
+{
+    if (entities.empty() || !_mapRootNode) return;
+
+    const auto& parentIter = _mapRootNode->getIter();
+
+    wxDataViewItemArray rows;
+    rows.reserve(entities.size());
+
+    for (const auto& gtNode : entities)
+    {
+        auto node = gtNode->getNode();
+
+        if (!node || gtNode->getIter().IsOk()) continue;
+
+        gtNode->getIter() = createRow(parentIter, node);
+        rows.push_back(gtNode->getIter());
+    }
+
+    _model->ItemsAdded(parentIter, rows);
+}
+
+void GraphTreeModel::updatePlaceholder()
+{
+    // A collapsed map root with entities needs a child row to show the expander
+    bool needed = !_entityBranchExpanded && _mapRootNode && _nodemap.size() > 1;
+
+    if (needed && !_placeholderItem.IsOk())
+    {
+        wxutil::TreeModel::Row row = _model->AddItemUnderParent(_mapRootNode->getIter());
+
+        row[_columns.node] = wxVariant(static_cast<void*>(nullptr));
+        row[_columns.name] = std::string();
+
+        _placeholderItem = row.getItem();
+        row.SendItemAdded();
+    }
+    else if (!needed && _placeholderItem.IsOk())
+    {
+        _model->RemoveItem(_placeholderItem);
+        _placeholderItem.Unset();
+    }
+}
+
+wxDataViewItem GraphTreeModel::createRow(const wxDataViewItem& parent, const scene::INodePtr& node)
+{
+    wxutil::TreeModel::Row row = parent.IsOk() ? _model->AddItemUnderParent(parent) : _model->AddItem();
+
+    row[_columns.node] = wxVariant(node.get());
+    row[_columns.name] = node->name();
+
+    return row.getItem();
+}
+
+void GraphTreeModel::queueChange(const scene::INodePtr& node, Change change)
+{
+    bool wasEmpty = _pendingChanges.empty();
+
+    _pendingChanges[node] = PendingChange{ change, _changeSequence++ };
+
+    if (wasEmpty && _onChangesQueued)
+    {
+        _onChangesQueued();
+    }
+}
+
 const GraphTreeModel::TreeColumns& GraphTreeModel::getColumns() const
 {
 	return _columns;
@@ -170,14 +402,22 @@ void GraphTreeModel::onSceneNodeInsert(const scene::INodePtr& node)
 {
     if (!NodeIsRelevant(node)) return;
 
-    insert(node); // wrap to the actual insert() method
+    queueChange(node, Change::Insert);
 }
 
 void GraphTreeModel::onSceneNodeErase(const scene::INodePtr& node)
 {
     if (!NodeIsRelevant(node)) return;
 
-    erase(node); // wrap to the actual erase() method
+    // The row must not point to the node anymore, it might be destroyed
+    // before the erasure is applied
+    if (auto found = _nodemap.find(node); found != _nodemap.end() && found->second->getIter().IsOk())
+    {
+        wxutil::TreeModel::Row row(found->second->getIter(), *_model);
+        row[_columns.node] = wxVariant(static_cast<void*>(nullptr));
+    }
+
+    queueChange(node, Change::Erase);
 }
 
 } // namespace
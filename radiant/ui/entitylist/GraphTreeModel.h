@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <map>
+#include <functional>
 #include "iscenegraph.h"
 #include "GraphTreeNode.h"
 
@@ -16,6 +17,12 @@ namespace ui
  *
  * The class provides basic routines to insert/remove scene::INodePtrs
  * into the model (the lookup should be performed fast).
+ *
+ * Scene changes are not applied right away: the notifications are collected
+ * (an insertion followed by an erasure of the same node cancels out) and
+ * applied in bulk by flushPendingChanges(). Rows are only created for nodes
+ * in the expanded branch of the tree, the entities below a collapsed map
+ * root are kept in the lookup table only.
  */
 class GraphTreeModel :
 	public scene::Graph::Observer
@@ -49,8 +56,34 @@ private:
 	// The flag whether to skip invisible items
 	bool _visibleNodesOnly;
 
+	enum class Change
+	{
+		Insert,
+		Erase,
+	};
+
+	struct PendingChange
+	{
+		Change change;
+		std::size_t sequence; // keeps the rows in the order the nodes arrived
+	};
+
+	// The last change reported for each node since the last flush
+	std::map<scene::INodeWeakPtr, PendingChange, std::owner_less<scene::INodeWeakPtr>> _pendingChanges;
+	std::size_t _changeSequence;
+
+	std::function<void()> _onChangesQueued;
+
+	// Whether the entity rows below the map root are present in the model
+	bool _entityBranchExpanded;
+
+	// Child row keeping a collapsed map root expandable while it has no entity rows
+	wxDataViewItem _placeholderItem;
+
 public:
-	GraphTreeModel();
+	// The given function is invoked when scene changes have been queued,
+	// the owner should call flushPendingChanges() at its next opportunity
+	GraphTreeModel(const std::function<void()>& onChangesQueued = std::function<void()>());
 	~GraphTreeModel() override;
 
 	// Inserts a node into the tree
@@ -58,6 +91,14 @@ public:
 	// Removes the given node from the tree
 	void erase(const scene::INodePtr& node);
 
+	// Applies the scene changes queued since the last call,
+	// returns true if there have been any
+	bool flushPendingChanges();
+
+	// Creates (or removes) the rows of all entities below the map root, to be called
+	// before the map root row is expanded and after it has been collapsed
+	void setEntityBranchExpanded(bool expanded);
+
 	// Tries to lookup the given node in the tree, can return an empty node
 	const GraphTreeNode::Ptr& find(const scene::INodePtr& node) const;
 
@@ -104,6 +145,16 @@ public:
 private:
 	// Tries to lookup the insert position for the given node
 	wxDataViewItem findParentIter(const scene::INodePtr& node);
+
+	// Creates the rows of the given entities, sending a single notification
+	void addEntityRows(const std::vector<GraphTreeNode::Ptr>& entities);
+
+	// Ensures the placeholder row is present if and only if it is needed
+	void updatePlaceholder();
+
+	wxDataViewItem createRow(const wxDataViewItem& parent, const scene::INodePtr& node);
+
+	void queueChange(const scene::INodePtr& node, Change change);
 };
 
 } // namespace ui
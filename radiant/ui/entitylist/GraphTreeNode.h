@@ -8,20 +8,21 @@ namespace ui
 
 /**
  * A structure representing a single scene node in the EntityList.
- * Holds a reference to the tree model's wxDataViewItem.
+ * Holds a reference to the tree model's wxDataViewItem, which is invalid
+ * as long as the node is in a collapsed branch of the tree.
  */
 class GraphTreeNode
 {
 private:
 	// A reference to the actual node
-	const scene::INodePtr& _node;
+	scene::INodeWeakPtr _node;
 
 	// The iterator pointing to the row in a wxutil::TreeModel
 	wxDataViewItem _iter;
 public:
     using Ptr = std::shared_ptr<GraphTreeNode>;
 
-    GraphTreeNode(const scene::INodePtr& node, const wxDataViewItem& iter) :
+    GraphTreeNode(const scene::INodePtr& node, const wxDataViewItem& iter = wxDataViewItem()) :
         _node(node),
         _iter(iter)
     {}
@@ -32,9 +33,10 @@ public:
 		return _iter;
 	}
 
-	const scene::INodePtr& getNode() const
+	// Returns the node, or an empty reference if it has been deleted
+	scene::INodePtr getNode() const
 	{
-		return _node;
+		return _node.lock();
 	}
 };
 
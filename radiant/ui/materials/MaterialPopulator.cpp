@@ -6,7 +6,6 @@
 
 #include "string/split.h"
 
-#include "wxutil/dataview/VFSTreePopulator.h"
 
 namespace ui
 {
@@ -129,30 +128,49 @@ void MaterialPopulator::PopulateModel(const wxutil::TreeModel::Ptr& model)
 {
     model->SetHasDefaultCompare(false);
 
-    wxutil::VFSTreePopulator populator(model);
-
     // Insert the "Other Materials" folder in any case
-    populator.addPath(_otherMaterialsPath, [&](wxutil::TreeModel::Row& row,
-        const std::string& path, const std::string& leafName, bool isFolder)
-    {
-        row[_columns.isOtherMaterialsFolder] = true;
-        AssignValuesToRow(row, path, path, path, true);
-    });
+    std::vector<std::string> paths{ _otherMaterialsPath };
+    std::vector<std::string> materialNames{ _otherMaterialsPath };
 
     GlobalMaterialManager().foreachShaderName([&](const std::string& name)
     {
         ThrowIfCancellationRequested();
 
         // Determine the folder this texture will be sorted into
-        auto texturePath = string::istarts_with(name, _texturePrefix) ?
-            name : _otherMaterialsPath + "/" + name;
+        paths.emplace_back(string::istarts_with(name, _texturePrefix) ?
+            name : _otherMaterialsPath + "/" + name);
+        materialNames.emplace_back(name);
+    });
+
+    // Special folder comparison: the "Other Materials" folder always comes last
+    auto layout = GetPathTreeLayout(paths, "MaterialPopulator/" + _otherMaterialsPath,
+        [otherMaterialsPath = _otherMaterialsPath](const wxutil::PathTreeLayout::Node& a, const wxutil::PathTreeLayout::Node& b)
+    {
+        if (a.path == otherMaterialsPath)
+        {
+            return +1;
+        }
 
-        populator.addPath(texturePath, [&](wxutil::TreeModel::Row& row,
-            const std::string& path, const std::string& leafName, bool isFolder)
+        if (b.path == otherMaterialsPath)
         {
-            row[_columns.isOtherMaterialsFolder] = false;
-            AssignValuesToRow(row, path, isFolder ? path : name, leafName, isFolder);
-        });
+            return -1;
+        }
+
+        return 0; // no special folders, return equal to continue the regular sort algorithm
+    });
+
+    PopulateFromLayout(model, *layout, [&](wxutil::TreeModel::Row& row, const wxutil::PathTreeLayout::Node& node)
+    {
+        if (node.path == _otherMaterialsPath)
+        {
+            row[_columns.isOtherMaterialsFolder] = true;
+            AssignValuesToRow(row, node.path, node.path, node.path, true);
+            return;
+        }
+
+        row[_columns.isOtherMaterialsFolder] = false;
+        AssignValuesToRow(row, node.path, node.isFolder ? node.path : materialNames[node.pathIndex],
+            node.leafName, node.isFolder);
     });
 }
 
@@ -183,8 +201,8 @@ void MaterialPopulator::InsertTexture(const wxutil::TreeModel::Ptr& model,
 
 void MaterialPopulator::SortModel(const wxutil::TreeModel::Ptr& model)
 {
-    // Sort the model while we're still in the worker thread
-    SortModel(model, wxDataViewItem());
+    // PopulateModel() inserts the rows in their final order, including the
+    // "Other Materials" folder, nothing left to do here
 }
 
 void MaterialPopulator::SortModel(const wxutil::TreeModel::Ptr& model, const wxDataViewItem& startItem)
@@ -10,7 +10,6 @@
 #include "string/predicate.h"
 
 #include "../common/TexturePreviewCombo.h"
-#include "wxutil/dataview/VFSTreePopulator.h"
 #include "wxutil/dataview/ThreadedDeclarationTreePopulator.h"
 
 namespace ui
@@ -60,13 +59,14 @@ public:
 protected:
     void PopulateModel(const wxutil::TreeModel::Ptr& model) override
     {
-        wxutil::VFSTreePopulator populator(model);
+        // The material names are the paths in the tree
+        std::vector<std::string> materialNames;
 
         GlobalMaterialManager().foreachShaderName([&](const std::string& materialName)
         {
             if (_prefixes.empty()) // no filter?
             {
-                AddMaterial(populator, materialName);
+                materialNames.push_back(materialName);
                 return;
             }
 
@@ -74,20 +74,13 @@ protected:
             {
                 if (string::istarts_with(materialName, prefix))
                 {
-                    AddMaterial(populator, materialName);
+                    materialNames.push_back(materialName);
                     break; // don't consider any further prefixes
                 }
             }
         });
-    }
 
-    void AddMaterial(wxutil::VFSTreePopulator& populator, const std::string& materialName)
-    {
-        populator.addPath(materialName, [&](wxutil::TreeModel::Row& row,
-            const std::string& path, const std::string& leafName, bool isFolder)
-        {
-            AssignValuesToRow(row, path, path, leafName, isFolder);
-        });
+        PopulateFromPaths(model, materialNames, materialNames);
     }
 };
 
@@ -9,6 +9,7 @@
 #include "ishaderclipboard.h"
 #include "icommandsystem.h"
 #include "ipreferencesystem.h"
+#include "ideclmanager.h"
 #include "module/StaticModule.h"
 
 namespace ui
@@ -80,6 +81,11 @@ void TextureBrowserManager::updateAllWindows()
     }
 }
 
+const TextureThumbnailCache::Ptr& TextureBrowserManager::getThumbnailCache()
+{
+    return _thumbnailCache;
+}
+
 void TextureBrowserManager::registerPreferencePage()
 {
     // Add a page to the given group
@@ -119,6 +125,7 @@ const StringSet& TextureBrowserManager::getDependencies() const
         _dependencies.insert(MODULE_COMMANDSYSTEM);
         _dependencies.insert(MODULE_SHADERCLIPBOARD);
         _dependencies.insert(MODULE_USERINTERFACE);
+        _dependencies.insert(MODULE_DECLMANAGER);
     }
 
     return _dependencies;
@@ -133,6 +140,13 @@ void TextureBrowserManager::initialiseModule(const IApplicationContext& ctx)
 
     registerPreferencePage();
 
+    _thumbnailCache = std::make_shared<TextureThumbnailCache>(ctx.getCacheDataPath() + "thumbnails/");
+
+    // Thumbnails need to be created again when the editor images might have changed
+    _materialsReloadedConn = GlobalDeclarationManager().signal_DeclsReloaded(decl::Type::Material).connect(
+        sigc::mem_fun(*_thumbnailCache, &TextureThumbnailCache::clear)
+    );
+
     _shaderClipboardConn = GlobalShaderClipboard().signal_sourceChanged().connect(
         sigc::mem_fun(this, &TextureBrowserManager::onShaderClipboardSourceChanged)
     );
@@ -154,6 +168,10 @@ void TextureBrowserManager::shutdownModule()
 {
     GlobalUserInterface().unregisterControl(UserControl::TextureBrowser);
     _shaderClipboardConn.disconnect();
+    _materialsReloadedConn.disconnect();
+
+    // Waits for the thumbnails currently being loaded
+    _thumbnailCache.reset();
 }
 
 void TextureBrowserManager::onShaderClipboardSourceChanged()
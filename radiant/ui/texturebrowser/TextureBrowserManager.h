@@ -3,6 +3,7 @@
 #include <set>
 #include <sigc++/connection.h>
 #include "imodule.h"
+#include "TextureThumbnailCache.h"
 
 namespace ui
 {
@@ -28,6 +29,10 @@ class TextureBrowserManager :
 private:
     std::set<TextureBrowserPanel*> _browsers;
     sigc::connection _shaderClipboardConn;
+    sigc::connection _materialsReloadedConn;
+
+    // Thumbnails shared by all texture browsers
+    TextureThumbnailCache::Ptr _thumbnailCache;
 
 public:
     TextureBrowserManager();
@@ -42,6 +47,8 @@ public:
     // Sends an queueUpdate() call to all registered browsers
     void updateAllWindows();
 
+    const TextureThumbnailCache::Ptr& getThumbnailCache();
+
     static TextureBrowserManager& Instance();
 
     // RegisterableModule
@@ -66,21 +66,45 @@ public:
 
     void render(bool drawName)
     {
-        TexturePtr texture = material->getEditorImage();
-        if (!texture) return;
-
         // Is this texture visible?
         if ((position.y() - size.y() - FONT_HEIGHT() < _owner.getOriginY()) &&
             (position.y() > _owner.getOriginY() - _owner.getViewportHeight()))
         {
             drawBorder();
-            drawTextureQuad(texture->getGLTexNum());
+            drawImage();
             if (drawName)
                 drawTextureName();
         }
     }
 
 private:
+    void drawImage()
+    {
+        // Thumbnails are used as long as the tile is not larger than their cell
+        if (size.x() <= TextureThumbnailCache::CellSize && size.y() <= TextureThumbnailCache::CellSize)
+        {
+            TextureThumbnailCache::Thumbnail thumbnail;
+
+            switch (_owner._thumbnails->get(material, thumbnail))
+            {
+            case TextureThumbnailCache::Status::Ready:
+                drawTextureQuad(thumbnail.textureNumber, thumbnail.s0, thumbnail.t0, thumbnail.s1, thumbnail.t1);
+                return;
+
+            case TextureThumbnailCache::Status::Pending:
+                return; // drawn as soon as it has been loaded
+
+            case TextureThumbnailCache::Status::Unavailable:
+                break;
+            }
+        }
+
+        if (auto texture = material->getEditorImage(); texture)
+        {
+            drawTextureQuad(texture->getGLTexNum(), 0, 0, 1, 1);
+        }
+    }
+
     void drawBorder()
     {
         // borders rules:
@@ -153,20 +177,20 @@ private:
         }
     }
 
-    void drawTextureQuad(GLuint num)
+    void drawTextureQuad(GLuint num, float s0, float t0, float s1, float t1)
     {
         glBindTexture(GL_TEXTURE_2D, num);
         debug::assertNoGlErrors();
         glColor3f(1, 1, 1);
 
         glBegin(GL_QUADS);
-        glTexCoord2i(0, 0);
+        glTexCoord2f(s0, t0);
         glVertex2i(position.x(), position.y() - FONT_HEIGHT());
-        glTexCoord2i(1, 0);
+        glTexCoord2f(s1, t0);
         glVertex2i(position.x() + size.x(), position.y() - FONT_HEIGHT());
-        glTexCoord2i(1, 1);
+        glTexCoord2f(s1, t1);
         glVertex2i(position.x() + size.x(), position.y() - FONT_HEIGHT() - size.y());
-        glTexCoord2i(0, 1);
+        glTexCoord2f(s0, t1);
         glVertex2i(position.x(), position.y() - FONT_HEIGHT() - size.y());
         glEnd();
     }
@@ -217,8 +241,14 @@ TextureThumbnailBrowser::TextureThumbnailBrowser(wxWindow* parent, bool showTool
     _useUniformScale(registry::getValue<bool>(RKEY_TEXTURE_USE_UNIFORM_SCALE)),
     _uniformTextureSize(registry::getValue<int>(RKEY_TEXTURE_UNIFORM_SIZE)),
     _maxNameLength(registry::getValue<int>(RKEY_TEXTURE_MAX_NAME_LENGTH)),
-    _updateNeeded(true)
+    _updateNeeded(true),
+    _thumbnails(TextureBrowserManager::Instance().getThumbnailCache()),
+    _hasProvisionalTiles(false)
 {
+    _thumbnails->signal_thumbnailsLoaded().connect(
+        sigc::mem_fun(this, &TextureThumbnailBrowser::onThumbnailsLoaded)
+    );
+
     observeKey(RKEY_TEXTURE_UNIFORM_SIZE);
     observeKey(RKEY_TEXTURE_USE_UNIFORM_SCALE);
     observeKey(RKEY_TEXTURE_SCALE);
@@ -420,14 +450,14 @@ void TextureThumbnailBrowser::keyChanged()
 }
 
 // Return the display width of a texture in the texture browser
-int TextureThumbnailBrowser::getTextureWidth(const Texture& tex) const
+int TextureThumbnailBrowser::getTextureWidth(const Vector2i& imageSize) const
 {
     if (!_useUniformScale)
     {
         // Don't use uniform scale
-        return static_cast<int>(tex.getWidth() * (static_cast<float>(_textureScale) / 100));
+        return static_cast<int>(imageSize.x() * (static_cast<float>(_textureScale) / 100));
     }
-    else if (tex.getWidth() >= tex.getHeight())
+    else if (imageSize.x() >= imageSize.y())
     {
         // Texture is square, or wider than it is tall
         return _uniformTextureSize;
@@ -436,19 +466,19 @@ int TextureThumbnailBrowser::getTextureWidth(const Texture& tex) const
     {
         // Otherwise, preserve the texture's aspect ratio
         return static_cast<int>(_uniformTextureSize *
-            (static_cast<float>(tex.getWidth()) / tex.getHeight())
+            (static_cast<float>(imageSize.x()) / imageSize.y())
         );
     }
 }
 
-int TextureThumbnailBrowser::getTextureHeight(const Texture& tex) const
+int TextureThumbnailBrowser::getTextureHeight(const Vector2i& imageSize) const
 {
     if (!_useUniformScale)
     {
         // Don't use uniform scale
-        return static_cast<int>(tex.getHeight() * (static_cast<float>(_textureScale) / 100));
+        return static_cast<int>(imageSize.y() * (static_cast<float>(_textureScale) / 100));
     }
-    else if (tex.getHeight() >= tex.getWidth())
+    else if (imageSize.y() >= imageSize.x())
     {
         // Texture is square, or taller than it is wide
         return _uniformTextureSize;
@@ -458,7 +488,7 @@ int TextureThumbnailBrowser::getTextureHeight(const Texture& tex) const
         // Otherwise, preserve the texture's aspect ratio
         return static_cast<int>(
             _uniformTextureSize
-            * (static_cast<float>(tex.getHeight()) / tex.getWidth())
+            * (static_cast<float>(imageSize.y()) / imageSize.x())
         );
     }
 }
@@ -519,12 +549,12 @@ TextureThumbnailBrowser::CurrentPosition::CurrentPosition()
 : origin(VIEWPORT_BORDER, -VIEWPORT_BORDER), rowAdvance(0)
 { }
 
-Vector2i TextureThumbnailBrowser::getNextPositionForTexture(const Texture& tex)
+Vector2i TextureThumbnailBrowser::getNextPositionForTexture(const Vector2i& tileSize)
 {
     auto& currentPos = *_currentPopulationPosition;
 
-    int nWidth = getTextureWidth(tex);
-    int nHeight = getTextureHeight(tex);
+    int nWidth = tileSize.x();
+    int nHeight = tileSize.y();
 
     // Wrap to the next row if there is not enough horizontal space for this
     // texture
@@ -606,11 +636,11 @@ void TextureThumbnailBrowser::createTileForMaterial(const MaterialPtr& material)
 
     tile.material = material;
 
-    Texture& texture = *tile.material->getEditorImage();
+    auto imageSize = getImageSizeForLayout(material);
 
-    tile.position = getNextPositionForTexture(texture);
-    tile.size.x() = getTextureWidth(texture);
-    tile.size.y() = getTextureHeight(texture);
+    tile.size.x() = getTextureWidth(imageSize);
+    tile.size.y() = getTextureHeight(imageSize);
+    tile.position = getNextPositionForTexture(tile.size);
 
     _entireSpaceHeight = std::max(
         _entireSpaceHeight,
@@ -618,6 +648,39 @@ void TextureThumbnailBrowser::createTileForMaterial(const MaterialPtr& material)
     );
 }
 
+Vector2i TextureThumbnailBrowser::getImageSizeForLayout(const MaterialPtr& material)
+{
+    Vector2i imageSize;
+
+    if (_thumbnails->getSourceSize(material, imageSize))
+    {
+        return imageSize;
+    }
+
+    // With uniform scale the tile will most likely be a square,
+    // don't realise the full texture just to find out
+    if (_useUniformScale && _thumbnails->isPending(material))
+    {
+        _hasProvisionalTiles = true;
+        return Vector2i(_uniformTextureSize, _uniformTextureSize);
+    }
+
+    auto texture = material->getEditorImage();
+
+    return Vector2i(static_cast<int>(texture->getWidth()), static_cast<int>(texture->getHeight()));
+}
+
+void TextureThumbnailBrowser::onThumbnailsLoaded()
+{
+    // The image sizes are now known, tiles of non-square images need to be laid out again
+    if (_hasProvisionalTiles)
+    {
+        queueUpdate();
+    }
+
+    queueDraw();
+}
+
 void TextureThumbnailBrowser::refreshTiles()
 {
     // During startup the openGL module might not have created the font yet
@@ -633,6 +696,7 @@ void TextureThumbnailBrowser::refreshTiles()
 
     _currentPopulationPosition = std::make_unique<CurrentPosition>();
     _entireSpaceHeight = 0;
+    _hasProvisionalTiles = false;
 
     populateTiles();
 
@@ -734,11 +798,16 @@ void TextureThumbnailBrowser::draw()
     glEnable (GL_TEXTURE_2D);
 	glPolygonMode (GL_FRONT_AND_BACK, GL_FILL);
 
+    _thumbnails->uploadLoadedThumbnails();
+
     for (const auto& tile : _tiles)
     {
         tile->render(_showNamesKey.get());
     }
 
+    // Load the thumbnails of all tiles that were visible but not available
+    _thumbnails->submitRequests();
+
 	debug::assertNoGlErrors();
 
     // reset the current texture
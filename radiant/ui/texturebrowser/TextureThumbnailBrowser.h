@@ -8,6 +8,7 @@
 
 #include "wxutil/DockablePanel.h"
 #include "wxutil/event/SingleIdleCallback.h"
+#include "TextureThumbnailCache.h"
 
 #include <optional>
 
@@ -102,6 +103,11 @@ class TextureThumbnailBrowser :
     // renderable items will be updated next round
     bool _updateNeeded;
 
+    TextureThumbnailCache::Ptr _thumbnails;
+
+    // True if some tiles have been laid out before their image size was known
+    bool _hasProvisionalTiles;
+
     // Data structure keeping track of the virtual position for the next texture to
     // be drawn in. Only the getNextPositionForTexture() method should access the values
     // in this structure.
@@ -160,13 +166,18 @@ private:
     // Repopulates the texture tiles
     void refreshTiles();
 
-    // Return the display width/height of a texture in the texture browser
-    int getTextureWidth(const Texture& tex) const;
-    int getTextureHeight(const Texture& tex) const;
+    // Return the display width/height of an image of the given size in the texture browser
+    int getTextureWidth(const Vector2i& imageSize) const;
+    int getTextureHeight(const Vector2i& imageSize) const;
 
-    // Get a new position for the given texture, and advance the CurrentPosition
+    // Get a new position for a tile of the given size, and advance the CurrentPosition
     // state object.
-    Vector2i getNextPositionForTexture(const Texture& texture);
+    Vector2i getNextPositionForTexture(const Vector2i& tileSize);
+
+    // Returns the size of the material's editor image used for the layout
+    Vector2i getImageSizeForLayout(const MaterialPtr& material);
+
+    void onThumbnailsLoaded();
 
     bool checkSeekInMediaBrowser(); // sensitivity check
     void onSeekInMediaBrowser();
@@ -0,0 +1,605 @@
+#include "TextureThumbnailCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <fmt/format.h>
+
+#include "iimage.h"
+#include "ifilesystem.h"
+#include "itextstream.h"
+#include "ui/iuserinterface.h"
+#include "os/dir.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "stream/BinaryCacheFile.h"
+#include "string/hash.h"
+#include "util/ParallelFor.h"
+#include "debugging/gl.h"
+
+namespace ui
+{
+
+namespace
+{
+    constexpr int PAGE_SIZE = 1024;
+    constexpr std::size_t CELLS_PER_ROW = PAGE_SIZE / TextureThumbnailCache::CellSize;
+    constexpr std::size_t CELLS_PER_PAGE = CELLS_PER_ROW * CELLS_PER_ROW;
+
+    // The atlas holds up to 1024 thumbnails (64 MB of texture memory)
+    constexpr std::size_t MAX_PAGES = 16;
+
+    constexpr std::size_t PARALLEL_THUMBNAIL_MIN_REQUESTS = 4;
+
+    const char CACHE_FILE_MAGIC[4] = { 'D', 'R', 'T', 'N' };
+    const std::uint32_t CACHE_FILE_VERSION = 1;
+
+    // Guards against allocating nonsense in case of a corrupt file
+    constexpr std::uint32_t MAX_STRING_LENGTH = 1u << 12;
+
+    // Follows the magic and version
+    struct CacheFileHeader
+    {
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t sourceWidth;
+        std::uint32_t sourceHeight;
+        std::uint64_t sourceSize;
+        std::int64_t sourceModificationTime;
+    };
+
+    // The state of the image file a thumbnail has been created from
+    struct SourceKey
+    {
+        std::string archivePath;
+        std::uint64_t size = 0;
+        std::int64_t modificationTime = 0;
+    };
+
+    bool getSourceKey(const std::string& sourceFile, SourceKey& key)
+    {
+        auto fileInfo = GlobalFileSystem().getFileInfo(sourceFile);
+
+        if (fileInfo.isEmpty()) return false;
+
+        key.archivePath = fileInfo.getArchivePath();
+        key.size = fileInfo.getSize();
+
+        // Files in archives are considered unchanged as long as the archive is
+        auto path = fileInfo.getIsPhysicalFile() ? key.archivePath + sourceFile : key.archivePath;
+
+        std::error_code ec;
+        auto time = fs::last_write_time(path, ec);
+        key.modificationTime = ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+
+        return true;
+    }
+
+    // Scales the given RGBA pixels down to fit into a thumbnail cell, preserving the aspect ratio.
+    // Each target pixel is the average of the source pixels it covers.
+    image::RGBAImagePtr fitToCell(const image::RGBAPixel* pixels, std::size_t width, std::size_t height)
+    {
+        const std::size_t cellSize = TextureThumbnailCache::CellSize;
+
+        auto targetWidth = width;
+        auto targetHeight = height;
+
+        if (width > cellSize || height > cellSize)
+        {
+            targetWidth = width >= height ? cellSize : std::max<std::size_t>(cellSize * width / height, 1);
+            targetHeight = height >= width ? cellSize : std::max<std::size_t>(cellSize * height / width, 1);
+        }
+
+        auto result = std::make_shared<image::RGBAImage>(targetWidth, targetHeight);
+
+        for (std::size_t y = 0; y < targetHeight; ++y)
+        {
+            auto y0 = y * height / targetHeight;
+            auto y1 = std::max((y + 1) * height / targetHeight, y0 + 1);
+
+            for (std::size_t x = 0; x < targetWidth; ++x)
+            {
+                auto x0 = x * width / targetWidth;
+                auto x1 = std::max((x + 1) * width / targetWidth, x0 + 1);
+
+                std::size_t red = 0, green = 0, blue = 0, alpha = 0;
+
+                for (auto sy = y0; sy < y1; ++sy)
+                {
+                    for (auto sx = x0; sx < x1; ++sx)
+                    {
+                        const auto& pixel = pixels[sy * width + sx];
+                        red += pixel.red;
+                        green += pixel.green;
+                        blue += pixel.blue;
+                        alpha += pixel.alpha;
+                    }
+                }
+
+                auto count = (y1 - y0) * (x1 - x0);
+                auto& target = result->pixels[y * targetWidth + x];
+
+                target.red = static_cast<uint8_t>(red / count);
+                target.green = static_cast<uint8_t>(green / count);
+                target.blue = static_cast<uint8_t>(blue / count);
+                target.alpha = static_cast<uint8_t>(alpha / count);
+            }
+        }
+
+        return result;
+    }
+}
+
+TextureThumbnailCache::TextureThumbnailCache(const std::string& cachePath) :
+    _frame(0),
+    _cachePath(os::standardPathWithSlash(cachePath))
+{}
+
+std::string TextureThumbnailCache::getImagePath(const MaterialPtr& material)
+{
+    auto expression = material->getEditorImageExpression();
+
+    if (!expression)
+    {
+        // Same as the editor image: use the first layer that is no bump or specular map
+        material->foreachLayer([&](const IShaderLayer::Ptr& layer)
+        {
+            if (layer->getType() != IShaderLayer::BUMP && layer->getType() != IShaderLayer::SPECULAR &&
+                layer->getMapExpression())
+            {
+                expression = layer->getMapExpression();
+                return false;
+            }
+
+            return true;
+        });
+    }
+
+    if (!expression || expression->isCubeMap() ||
+        std::dynamic_pointer_cast<shaders::IVideoMapExpression>(expression) ||
+        std::dynamic_pointer_cast<shaders::ISoundMapExpression>(expression))
+    {
+        return {};
+    }
+
+    // Image programs like addnormals() need the full image pipeline
+    auto path = expression->getExpressionString();
+
+    return path.find('(') == std::string::npos ? path : std::string();
+}
+
+TextureThumbnailCache::Status TextureThumbnailCache::get(const MaterialPtr& material, Thumbnail& thumbnail)
+{
+    auto& slot = _slots[material->getName()];
+    auto imagePath = getImagePath(material);
+
+    // The editor image might have been changed in the material editor
+    if (slot.state != State::Unrequested && slot.imagePath != imagePath)
+    {
+        resetSlot(slot);
+    }
+
+    switch (slot.state)
+    {
+    case State::Unrequested:
+        slot.imagePath = imagePath;
+
+        if (imagePath.empty())
+        {
+            slot.state = State::Unavailable;
+            return Status::Unavailable;
+        }
+
+        slot.state = State::Queued;
+        _requests.push_back(Request{ material->getName(), imagePath });
+        return Status::Pending;
+
+    case State::Queued:
+        return Status::Pending;
+
+    case State::InAtlas:
+    {
+        slot.lastUsedFrame = _frame;
+        _leastRecentlyUsed.splice(_leastRecentlyUsed.begin(), _leastRecentlyUsed, slot.lruPosition);
+
+        auto cellIndex = slot.cell % CELLS_PER_PAGE;
+        auto cellX = static_cast<float>(cellIndex % CELLS_PER_ROW * CellSize);
+        auto cellY = static_cast<float>(cellIndex / CELLS_PER_ROW * CellSize);
+
+        // Sample the texel centres at the edges, to not pick up the neighbouring cells
+        thumbnail.textureNumber = _pages[slot.cell / CELLS_PER_PAGE];
+        thumbnail.s0 = (cellX + 0.5f) / PAGE_SIZE;
+        thumbnail.t0 = (cellY + 0.5f) / PAGE_SIZE;
+        thumbnail.s1 = (cellX + slot.size.x() - 0.5f) / PAGE_SIZE;
+        thumbnail.t1 = (cellY + slot.size.y() - 0.5f) / PAGE_SIZE;
+        return Status::Ready;
+    }
+
+    default:
+        return Status::Unavailable;
+    }
+}
+
+bool TextureThumbnailCache::getSourceSize(const MaterialPtr& material, Vector2i& size) const
+{
+    auto slot = _slots.find(material->getName());
+
+    if (slot == _slots.end() || slot->second.sourceSize.x() <= 0 || slot->second.sourceSize.y() <= 0)
+    {
+        return false;
+    }
+
+    size = slot->second.sourceSize;
+    return true;
+}
+
+bool TextureThumbnailCache::isPending(const MaterialPtr& material) const
+{
+    auto slot = _slots.find(material->getName());
+
+    if (slot == _slots.end() || slot->second.state == State::Unrequested)
+    {
+        return !getImagePath(material).empty();
+    }
+
+    return slot->second.state == State::Queued;
+}
+
+void TextureThumbnailCache::resetSlot(Slot& slot)
+{
+    if (slot.state == State::InAtlas)
+    {
+        _freeCells.push_back(slot.cell);
+        _leastRecentlyUsed.erase(slot.lruPosition);
+    }
+
+    slot = Slot();
+}
+
+bool TextureThumbnailCache::allocateCell(std::size_t& cell)
+{
+    if (_freeCells.empty() && _pages.size() < MAX_PAGES)
+    {
+        GLuint textureNumber = 0;
+        glGenTextures(1, &textureNumber);
+        glBindTexture(GL_TEXTURE_2D, textureNumber);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, PAGE_SIZE, PAGE_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+        // Hand out the cells of the new page in ascending order
+        auto firstCell = _pages.size() * CELLS_PER_PAGE;
+        _pages.push_back(textureNumber);
+
+        for (auto i = CELLS_PER_PAGE; i > 0; --i)
+        {
+            _freeCells.push_back(firstCell + i - 1);
+        }
+    }
+
+    if (!_freeCells.empty())
+    {
+        cell = _freeCells.back();
+        _freeCells.pop_back();
+        return true;
+    }
+
+    if (_leastRecentlyUsed.empty()) return false;
+
+    // Take over the cell of the least recently drawn thumbnail,
+    // unless that one has still been visible in the previous frame
+    auto& victim = _slots[_leastRecentlyUsed.back()];
+
+    if (victim.lastUsedFrame + 1 >= _frame) return false;
+
+    cell = victim.cell;
+    _leastRecentlyUsed.pop_back();
+
+    // The image size is kept for the layout, the thumbnail will be read from disk again when needed
+    auto sourceSize = victim.sourceSize;
+    victim = Slot();
+    victim.sourceSize = sourceSize;
+
+    return true;
+}
+
+void TextureThumbnailCache::uploadToCell(std::size_t cell, const image::RGBAImage& pixels)
+{
+    auto cellIndex = cell % CELLS_PER_PAGE;
+
+    glBindTexture(GL_TEXTURE_2D, _pages[cell / CELLS_PER_PAGE]);
+
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0,
+        static_cast<GLint>(cellIndex % CELLS_PER_ROW * CellSize),
+        static_cast<GLint>(cellIndex / CELLS_PER_ROW * CellSize),
+        static_cast<GLsizei>(pixels.getWidth()), static_cast<GLsizei>(pixels.getHeight()),
+        GL_RGBA, GL_UNSIGNED_BYTE, pixels.getPixels());
+
+    glPopClientAttrib();
+}
+
+void TextureThumbnailCache::uploadLoadedThumbnails()
+{
+    ++_frame;
+
+    std::vector<LoadResult> results;
+
+    {
+        std::lock_guard<std::mutex> lock(_resultLock);
+        results.swap(_results);
+    }
+
+    // Thumbnails that did not fit before are retried after the new ones,
+    // cells might have been freed or become evictable in the meantime
+    auto numNewResults = results.size();
+    std::move(_deferredResults.begin(), _deferredResults.end(), std::back_inserter(results));
+    _deferredResults.clear();
+
+    if (results.empty()) return;
+
+    bool newResultsDeferred = false;
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        auto& result = results[i];
+
+        auto found = _slots.find(result.materialName);
+
+        // Discard results for requests that have been reset in the meantime
+        if (found == _slots.end() || found->second.state != State::Queued ||
+            found->second.imagePath != result.imagePath)
+        {
+            continue;
+        }
+
+        auto& slot = found->second;
+        slot.sourceSize = result.sourceSize;
+
+        std::size_t cell = 0;
+
+        // Only images that failed to load fall back to the editor image
+        if (!result.pixels)
+        {
+            slot.state = State::Unavailable;
+            continue;
+        }
+
+        // The atlas is full of thumbnails drawn in the previous frame, keep this one pending
+        if (!allocateCell(cell))
+        {
+            newResultsDeferred |= i < numNewResults;
+            _deferredResults.push_back(std::move(result));
+            continue;
+        }
+
+        uploadToCell(cell, *result.pixels);
+
+        slot.state = State::InAtlas;
+        slot.cell = cell;
+        slot.size = Vector2i(static_cast<int>(result.pixels->getWidth()), static_cast<int>(result.pixels->getHeight()));
+        slot.lastUsedFrame = _frame;
+
+        _leastRecentlyUsed.push_front(result.materialName);
+        slot.lruPosition = _leastRecentlyUsed.begin();
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    debug::assertNoGlErrors();
+
+    // Request another frame, to retry once the previously visible thumbnails can be evicted.
+    // Retries failing again are not doing this, they are waiting for the view to change.
+    if (newResultsDeferred)
+    {
+        notifyThumbnailsLoaded();
+    }
+}
+
+void TextureThumbnailCache::submitRequests()
+{
+    if (_requests.empty()) return;
+
+    auto batch = std::make_shared<std::vector<Request>>(std::move(_requests));
+    _requests.clear();
+
+    // The queue is processing the most recent batch first,
+    // which is the one closest to what is visible right now
+    _loader.enqueue([this, batch]() { loadBatch(*batch); });
+}
+
+void TextureThumbnailCache::clear()
+{
+    _slots.clear();
+    _leastRecentlyUsed.clear();
+    _requests.clear();
+    _deferredResults.clear();
+
+    _loader.clearPendingTasks();
+
+    // The atlas pages are kept and reused from scratch
+    _freeCells.clear();
+
+    for (auto cell = _pages.size() * CELLS_PER_PAGE; cell > 0; --cell)
+    {
+        _freeCells.push_back(cell - 1);
+    }
+}
+
+sigc::signal<void>& TextureThumbnailCache::signal_thumbnailsLoaded()
+{
+    return _sigThumbnailsLoaded;
+}
+
+void TextureThumbnailCache::loadBatch(const std::vector<Request>& batch)
+{
+    std::vector<LoadResult> results;
+    results.reserve(batch.size());
+
+    for (const auto& request : batch)
+    {
+        results.push_back(LoadResult{ request.materialName, request.imagePath, image::RGBAImagePtr(), Vector2i(0, 0) });
+    }
+
+    // Look into the cache folder first
+    std::vector<char> cached(batch.size(), 0);
+
+    util::parallelFor(batch.size(), PARALLEL_THUMBNAIL_MIN_REQUESTS, [&](std::size_t i)
+    {
+        cached[i] = readCacheFile(batch[i], results[i]);
+    });
+
+    // Decode the remaining images in one batch
+    std::vector<std::size_t> missing;
+    std::vector<std::string> imagePaths;
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        if (cached[i]) continue;
+
+        missing.push_back(i);
+        imagePaths.push_back(batch[i].imagePath);
+    }
+
+    auto thumbnails = GlobalImageLoader().thumbnailsFromVFS(imagePaths, CellSize);
+
+    util::parallelFor(missing.size(), PARALLEL_THUMBNAIL_MIN_REQUESTS, [&](std::size_t m)
+    {
+        const auto& thumbnail = thumbnails[m];
+        auto& result = results[missing[m]];
+
+        if (!thumbnail.image) return;
+
+        result.pixels = fitToCell(reinterpret_cast<const image::RGBAPixel*>(thumbnail.image->getPixels()),
+            thumbnail.image->getWidth(), thumbnail.image->getHeight());
+        result.sourceSize = Vector2i(static_cast<int>(thumbnail.sourceWidth), static_cast<int>(thumbnail.sourceHeight));
+
+        writeCacheFile(batch[missing[m]], thumbnail.sourceFile, result);
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(_resultLock);
+        std::move(results.begin(), results.end(), std::back_inserter(_results));
+    }
+
+    notifyThumbnailsLoaded();
+}
+
+void TextureThumbnailCache::notifyThumbnailsLoaded()
+{
+    GlobalUserInterface().dispatch([weakSelf = weak_from_this()]()
+    {
+        if (auto self = weakSelf.lock())
+        {
+            self->_sigThumbnailsLoaded.emit();
+        }
+    });
+}
+
+std::string TextureThumbnailCache::getCacheFilePath(const Request& request) const
+{
+    return fmt::format("{0}{1:016x}.bin", _cachePath, string::fnv1a64(request.materialName + "\n" + request.imagePath));
+}
+
+bool TextureThumbnailCache::readCacheFile(const Request& request, LoadResult& result) const
+{
+    if (_cachePath.empty()) return false;
+
+    std::ifstream stream(getCacheFilePath(request), std::ios::binary);
+
+    if (!stream || !stream::cache::readHeader(stream, CACHE_FILE_MAGIC, CACHE_FILE_VERSION)) return false;
+
+    CacheFileHeader header;
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!stream ||
+        header.width == 0 || header.width > CellSize ||
+        header.height == 0 || header.height > CellSize)
+    {
+        return false; // corrupt file
+    }
+
+    std::string key, sourceFile, archivePath;
+
+    try
+    {
+        key = stream::cache::readString(stream, MAX_STRING_LENGTH);
+        sourceFile = stream::cache::readString(stream, MAX_STRING_LENGTH);
+        archivePath = stream::cache::readString(stream, MAX_STRING_LENGTH);
+    }
+    catch (const std::runtime_error&)
+    {
+        return false; // corrupt file
+    }
+
+    if (key != request.materialName + "\n" + request.imagePath)
+    {
+        return false; // hash collision
+    }
+
+    // Check that the image file is unchanged
+    SourceKey sourceKey;
+
+    if (!getSourceKey(sourceFile, sourceKey) ||
+        sourceKey.archivePath != archivePath ||
+        sourceKey.size != header.sourceSize ||
+        sourceKey.modificationTime != header.sourceModificationTime)
+    {
+        return false;
+    }
+
+    auto pixels = std::make_shared<image::RGBAImage>(header.width, header.height);
+    stream.read(reinterpret_cast<char*>(pixels->getPixels()), header.width * header.height * sizeof(image::RGBAPixel));
+
+    if (!stream) return false;
+
+    result.pixels = pixels;
+    result.sourceSize = Vector2i(static_cast<int>(header.sourceWidth), static_cast<int>(header.sourceHeight));
+
+    return true;
+}
+
+void TextureThumbnailCache::writeCacheFile(const Request& request, const std::string& sourceFile, const LoadResult& result) const
+{
+    SourceKey sourceKey;
+
+    if (_cachePath.empty() || !getSourceKey(sourceFile, sourceKey) || !os::makeDirectory(_cachePath))
+    {
+        return;
+    }
+
+    auto cacheFilePath = getCacheFilePath(request);
+    stream::cache::Writer writer(cacheFilePath);
+
+    if (!writer.isOpen())
+    {
+        rWarning() << "Cannot write thumbnail cache file " << cacheFilePath << std::endl;
+        return;
+    }
+
+    auto& stream = writer.getStream();
+
+    CacheFileHeader header;
+    header.width = static_cast<std::uint32_t>(result.pixels->getWidth());
+    header.height = static_cast<std::uint32_t>(result.pixels->getHeight());
+    header.sourceWidth = static_cast<std::uint32_t>(result.sourceSize.x());
+    header.sourceHeight = static_cast<std::uint32_t>(result.sourceSize.y());
+    header.sourceSize = sourceKey.size;
+    header.sourceModificationTime = sourceKey.modificationTime;
+
+    stream::cache::writeHeader(stream, CACHE_FILE_MAGIC, CACHE_FILE_VERSION);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream::cache::writeString(stream, request.materialName + "\n" + request.imagePath);
+    stream::cache::writeString(stream, sourceFile);
+    stream::cache::writeString(stream, sourceKey.archivePath);
+    stream.write(reinterpret_cast<const char*>(result.pixels->getPixels()),
+        header.width * header.height * sizeof(image::RGBAPixel));
+
+    writer.commit();
+}
+
+}
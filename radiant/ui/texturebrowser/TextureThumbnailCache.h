@@ -0,0 +1,172 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sigc++/signal.h>
+
+#include "igl.h"
+#include "ishaders.h"
+#include "math/Vector2.h"
+#include "RGBAImage.h"
+#include "SequentialTaskQueue.h"
+
+namespace ui
+{
+
+/**
+ * Shared store of the material thumbnails drawn by the texture browsers.
+ *
+ * Thumbnails are decoded on worker threads from the smallest sufficient
+ * level of the editor image, and packed into atlas textures divided into
+ * equally sized cells. The atlas has a fixed capacity, cells are recycled
+ * in least-recently-used order. Decoded thumbnails are written to the cache
+ * folder (one file per material, keyed by the material name and its editor
+ * image), such that evicted or previously seen thumbnails are read back
+ * without touching the image files again.
+ *
+ * Apart from the worker tasks, all methods need to be called from the UI
+ * thread, the ones touching the atlas with the shared GL context being current.
+ */
+class TextureThumbnailCache :
+    public std::enable_shared_from_this<TextureThumbnailCache>
+{
+public:
+    using Ptr = std::shared_ptr<TextureThumbnailCache>;
+
+    // Thumbnails are fitted into square cells of this size
+    static constexpr int CellSize = 128;
+
+    // Location of a thumbnail in the atlas
+    struct Thumbnail
+    {
+        GLuint textureNumber;
+        float s0, t0, s1, t1;
+    };
+
+    enum class Status
+    {
+        Pending,     // still loading, nothing to draw yet
+        Ready,       // the thumbnail is in the atlas
+        Unavailable, // the editor image of this material cannot be thumbnailed
+    };
+
+private:
+    enum class State
+    {
+        Unrequested,
+        Queued,
+        InAtlas,
+        Unavailable,
+    };
+
+    struct Slot
+    {
+        State state = State::Unrequested;
+
+        // The image path this slot has been requested for
+        std::string imagePath;
+
+        Vector2i sourceSize = Vector2i(0, 0);
+
+        // Atlas cell and the used size in pixels (InAtlas only)
+        std::size_t cell = 0;
+        Vector2i size = Vector2i(0, 0);
+        std::size_t lastUsedFrame = 0;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    // Keyed by material name
+    std::map<std::string, Slot> _slots;
+
+    // Materials occupying an atlas cell, most recently drawn first
+    std::list<std::string> _leastRecentlyUsed;
+
+    std::vector<GLuint> _pages;
+    std::vector<std::size_t> _freeCells;
+
+    std::size_t _frame;
+
+    struct Request
+    {
+        std::string materialName;
+        std::string imagePath;
+    };
+
+    struct LoadResult
+    {
+        std::string materialName;
+        std::string imagePath;
+        image::RGBAImagePtr pixels; // empty if loading failed
+        Vector2i sourceSize;
+    };
+
+    // Requests collected while drawing, submitted as one batch afterwards
+    std::vector<Request> _requests;
+
+    std::mutex _resultLock;
+    std::vector<LoadResult> _results;
+
+    // Loaded thumbnails waiting for an atlas cell to become available
+    std::vector<LoadResult> _deferredResults;
+
+    std::string _cachePath;
+
+    sigc::signal<void> _sigThumbnailsLoaded;
+
+    // Declared last, such that a running batch is finished before anything else is destroyed
+    util::SequentialTaskQueue _loader;
+
+public:
+    TextureThumbnailCache(const std::string& cachePath);
+
+    // Returns the atlas location of the given material's thumbnail, which
+    // is requested if necessary. Materials reported as unavailable should be
+    // drawn using their editor image.
+    Status get(const MaterialPtr& material, Thumbnail& thumbnail);
+
+    // Returns true if the image size of the given material is already known
+    bool getSourceSize(const MaterialPtr& material, Vector2i& size) const;
+
+    // Returns true if the thumbnail of the given material is still to be loaded
+    bool isPending(const MaterialPtr& material) const;
+
+    // Moves the thumbnails finished by the workers into the atlas, to be
+    // called before drawing. Thumbnails not fitting into the full atlas stay
+    // pending and are retried with the next call.
+    void uploadLoadedThumbnails();
+
+    // Hands the thumbnails requested since the last call to the workers,
+    // to be called after drawing
+    void submitRequests();
+
+    // Forgets about all thumbnails, e.g. after the materials have been reloaded
+    void clear();
+
+    // Emitted (on the UI thread) when a batch of requested thumbnails has been loaded
+    sigc::signal<void>& signal_thumbnailsLoaded();
+
+private:
+    // Returns the image path the thumbnail of this material is created from,
+    // or an empty string if the editor image is not a plain image file
+    static std::string getImagePath(const MaterialPtr& material);
+
+    void resetSlot(Slot& slot);
+    bool allocateCell(std::size_t& cell);
+    void uploadToCell(std::size_t cell, const image::RGBAImage& pixels);
+
+    // Emits the loaded signal on the UI thread, can be called from the workers
+    void notifyThumbnailsLoaded();
+
+    // Runs on the workers
+    void loadBatch(const std::vector<Request>& batch);
+
+    std::string getCacheFilePath(const Request& request) const;
+    bool readCacheFile(const Request& request, LoadResult& result) const;
+    void writeCacheFile(const Request& request, const std::string& sourceFile, const LoadResult& result) const;
+};
+
+}
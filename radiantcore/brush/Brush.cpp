@@ -10,7 +10,10 @@
 #include "Face.h"
 #include "FixedWinding.h"
 #include "math/Ray.h"
+#include "scene/NodeArena.h"
+#include "util/ParallelFor.h"
 
+#include <algorithm>
 #include <functional>
 
 namespace {
@@ -33,13 +36,26 @@ namespace {
     {
         return std::max(std::max(extents[0], extents[1]), extents[2]);
     }
+
+    // Batches smaller than this are not worth spreading across threads
+    constexpr std::size_t PARALLEL_BREP_MIN_BRUSHES = 64;
+
+    // Brushes differ a lot in their number of faces, smaller chunks balance the load
+    constexpr std::size_t PARALLEL_BREP_BRUSHES_PER_CHUNK = 16;
+
+    // Scratch buffers of the winding clipper, one pair per thread
+    // such that they don't need to be allocated for every face
+    thread_local FixedWinding _clipBuffers[2];
 }
 
 Brush::Brush(BrushNode& owner) :
     _owner(owner),
     _undoStateSaver(nullptr),
+    _materialUsageIndex(nullptr),
+    _pendingEvaluationQueue(nullptr),
     m_planeChanged(false),
     m_transformChanged(false),
+    _windingsClipped(false),
 	_detailFlag(Structural)
 {
     // Make some space for a few faces
@@ -50,8 +66,11 @@ Brush::Brush(BrushNode& owner) :
 Brush::Brush(BrushNode& owner, const Brush& other) :
     _owner(owner),
     _undoStateSaver(nullptr),
+    _materialUsageIndex(nullptr),
+    _pendingEvaluationQueue(nullptr),
     m_planeChanged(false),
     m_transformChanged(false),
+    _windingsClipped(false),
 	_detailFlag(Structural)
 {
     copy(other);
@@ -60,6 +79,11 @@ Brush::Brush(BrushNode& owner, const Brush& other) :
 Brush::~Brush()
 {
     ASSERT_MESSAGE(m_observers.empty(), "Brush::~Brush: observers still attached");
+
+    if (_pendingEvaluationQueue != nullptr)
+    {
+        _pendingEvaluationQueue->remove(scene::PendingEvaluationType::BrushBRep, *this);
+    }
 }
 
 BrushNode& Brush::getBrushNode()
@@ -83,7 +107,7 @@ IFace& Brush::addFace(const Plane3& plane)
 {
     // Allocate a new Face
     undoSave();
-    push_back(FacePtr(new Face(*this, plane)));
+    push_back(scene::makeArenaShared<Face>(*this, plane));
 
     return *m_faces.back();
 }
@@ -92,7 +116,7 @@ IFace& Brush::addFace(const Plane3& plane, const Matrix3& textureProjection, con
 {
     // Allocate a new Face
     undoSave();
-    push_back(FacePtr(new Face(*this, plane, textureProjection, material)));
+    push_back(scene::makeArenaShared<Face>(*this, plane, textureProjection, material));
 
     return *m_faces.back();
 }
@@ -156,6 +180,73 @@ void Brush::disconnectUndoSystem(IUndoSystem& undoSystem)
     undoSystem.releaseStateSaver(*this);
 }
 
+void Brush::connectMaterialUsageIndex(scene::IMaterialUsageIndex& index)
+{
+    assert(_materialUsageIndex == nullptr);
+
+    _materialUsageIndex = &index;
+
+    forEachFace([&](Face& face)
+    {
+        face.getFaceShader().attachToUsageIndex(index, scene::MaterialUsageType::Face, _owner);
+    });
+}
+
+void Brush::disconnectMaterialUsageIndex()
+{
+    assert(_materialUsageIndex != nullptr);
+
+    forEachFace([&](Face& face) { face.getFaceShader().detachFromUsageIndex(); });
+
+    _materialUsageIndex = nullptr;
+}
+
+void Brush::connectPendingEvaluationQueue(scene::IPendingEvaluationQueue& queue)
+{
+    assert(_pendingEvaluationQueue == nullptr);
+
+    _pendingEvaluationQueue = &queue;
+
+    if (m_planeChanged)
+    {
+        queue.add(scene::PendingEvaluationType::BrushBRep, *this);
+    }
+}
+
+void Brush::disconnectPendingEvaluationQueue()
+{
+    assert(_pendingEvaluationQueue != nullptr);
+
+    _pendingEvaluationQueue->remove(scene::PendingEvaluationType::BrushBRep, *this);
+    _pendingEvaluationQueue = nullptr;
+}
+
+void Brush::connectFace(Face& face)
+{
+    if (_undoStateSaver)
+    {
+        face.connectUndoSystem(_undoStateSaver->getUndoSystem());
+    }
+
+    if (_materialUsageIndex)
+    {
+        face.getFaceShader().attachToUsageIndex(*_materialUsageIndex, scene::MaterialUsageType::Face, _owner);
+    }
+}
+
+void Brush::disconnectFace(Face& face)
+{
+    if (_materialUsageIndex)
+    {
+        face.getFaceShader().detachFromUsageIndex();
+    }
+
+    if (_undoStateSaver)
+    {
+        face.disconnectUndoSystem(_undoStateSaver->getUndoSystem());
+    }
+}
+
 void Brush::setShader(const std::string& newShader) {
     undoSave();
 
@@ -165,9 +256,16 @@ void Brush::setShader(const std::string& newShader) {
 }
 
 bool Brush::hasShader(const std::string& name) {
+    // A name that has never been interned can't be used by any face
+    string::InternedString handle;
+
+    if (!string::InternedString::Find(name, handle)) {
+        return false;
+    }
+
     // Traverse the faces
     for (Faces::const_iterator i = m_faces.begin(); i != m_faces.end(); ++i) {
-        if (shader_equal((*i)->getShader(), name)) {
+        if ((*i)->getFaceShader().getMaterialHandle().equalsNoCase(handle)) {
             return true;
         }
     }
@@ -191,6 +289,18 @@ bool Brush::hasVisibleMaterial() const
     return false;
 }
 
+std::size_t Brush::getMemoryUsage() const
+{
+    return m_faces.capacity() * sizeof(FacePtr) +
+        _faceCentroidPoints.capacity() * sizeof(Vector3) +
+        _uniqueVertexPoints.capacity() * sizeof(Vector3) +
+        _uniqueEdgePoints.capacity() * sizeof(Vector3) +
+        m_select_vertices.capacity() * sizeof(SelectableVertex) +
+        m_select_edges.capacity() * sizeof(SelectableEdge) +
+        _edgeIndices.capacity() * sizeof(EdgeRenderIndices) +
+        _edgeFaces.capacity() * sizeof(EdgeFaces);
+}
+
 void Brush::updateFaceVisibility()
 {
     _owner.updateFaceVisibility();
@@ -231,12 +341,70 @@ BrushSplitType Brush::classifyPlane(const Plane3& plane) const
 }
 
 void Brush::evaluateBRep() const {
-    if(m_planeChanged) {
+    if (!m_planeChanged) return;
+
+    // Process all brushes of this scene waiting for evaluation in one go, this one included
+    if (_pendingEvaluationQueue != nullptr)
+    {
+        evaluatePendingBReps(*_pendingEvaluationQueue);
+    }
+
+    // The batch might have been evaluated by another call further up the stack
+    if (m_planeChanged) {
         m_planeChanged = false;
         const_cast<Brush*>(this)->buildBRep();
     }
 }
 
+void Brush::evaluatePendingBReps(scene::IPendingEvaluationQueue& queue)
+{
+    std::vector<Brush*> batch;
+
+    for (auto* element : queue.takeAll(scene::PendingEvaluationType::BrushBRep))
+    {
+        batch.push_back(static_cast<Brush*>(element));
+    }
+
+    if (batch.empty()) return;
+
+    // Transforms need to be applied to the face planes first,
+    // this involves the brush nodes and is not safe to do in parallel
+    for (auto* brush : batch)
+    {
+        brush->evaluateTransform();
+    }
+
+    // Drop the ones that got evaluated on their own in the meantime
+    batch.erase(std::remove_if(batch.begin(), batch.end(),
+        [](Brush* brush) { return !brush->m_planeChanged; }), batch.end());
+
+    // Clipping the windings is the expensive part, it only touches the brush itself
+    if (batch.size() >= PARALLEL_BREP_MIN_BRUSHES)
+    {
+        util::parallelFor(batch.size(), PARALLEL_BREP_BRUSHES_PER_CHUNK, [&](std::size_t i)
+        {
+            batch[i]->clipFaceWindings();
+        });
+    }
+    else
+    {
+        for (auto* brush : batch)
+        {
+            brush->clipFaceWindings();
+        }
+    }
+
+    // Connectivity and observer updates are running in this thread
+    for (auto* brush : batch)
+    {
+        if (brush->m_planeChanged)
+        {
+            brush->m_planeChanged = false;
+            brush->buildBRep();
+        }
+    }
+}
+
 void Brush::transformChanged() {
     m_transformChanged = true;
     onFacePlaneChanged();
@@ -346,7 +514,7 @@ FacePtr Brush::addFace(const Face& face) {
         return FacePtr();
     }
     undoSave();
-    push_back(FacePtr(new Face(*this, face)));
+    push_back(scene::makeArenaShared<Face>(*this, face));
     onFacePlaneChanged();
     return m_faces.back();
 }
@@ -357,7 +525,7 @@ FacePtr Brush::addPlane(const Vector3& p0, const Vector3& p1, const Vector3& p2,
         return FacePtr();
     }
     undoSave();
-    push_back(FacePtr(new Face(*this, p0, p1, p2, shader, projection)));
+    push_back(scene::makeArenaShared<Face>(*this, p0, p1, p2, shader, projection));
     onFacePlaneChanged();
     return m_faces.back();
 }
@@ -398,10 +566,7 @@ void Brush::reserve(std::size_t count) {
 void Brush::push_back(Faces::value_type face) {
     m_faces.push_back(face);
 
-    if (_undoStateSaver)
-    {
-        m_faces.back()->connectUndoSystem(_undoStateSaver->getUndoSystem());
-    }
+    connectFace(*m_faces.back());
 
     for (Observers::iterator i = m_observers.begin(); i != m_observers.end(); ++i) {
         (*i)->push_back(*face);
@@ -411,10 +576,7 @@ void Brush::push_back(Faces::value_type face) {
 
 void Brush::pop_back()
 {
-    if (_undoStateSaver)
-    {
-        m_faces.back()->disconnectUndoSystem(_undoStateSaver->getUndoSystem());
-    }
+    disconnectFace(*m_faces.back());
 
     m_faces.pop_back();
     for (Observers::iterator i = m_observers.begin(); i != m_observers.end(); ++i) {
@@ -425,10 +587,7 @@ void Brush::pop_back()
 
 void Brush::erase(std::size_t index)
 {
-    if (_undoStateSaver)
-    {
-        m_faces[index]->disconnectUndoSystem(_undoStateSaver->getUndoSystem());
-    }
+    disconnectFace(*m_faces[index]);
 
     m_faces.erase(m_faces.begin() + index);
     for (Observers::iterator i = m_observers.begin(); i != m_observers.end(); ++i) {
@@ -439,7 +598,13 @@ void Brush::erase(std::size_t index)
 
 void Brush::onFacePlaneChanged()
 {
+    if (!m_planeChanged && _pendingEvaluationQueue != nullptr)
+    {
+        _pendingEvaluationQueue->add(scene::PendingEvaluationType::BrushBRep, *this);
+    }
+
     m_planeChanged = true;
+    _windingsClipped = false;
     aabbChanged();
 }
 
@@ -468,10 +633,7 @@ void Brush::onFaceEvaluateTransform()
 void Brush::clear()
 {
     undoSave();
-    if (_undoStateSaver)
-    {
-        forEachFace([&](Face& face) { face.disconnectUndoSystem(_undoStateSaver->getUndoSystem()); });
-    }
+    forEachFace([&](Face& face) { disconnectFace(face); });
 
     m_faces.clear();
 
@@ -533,38 +695,60 @@ void Brush::removeRedundantFaces()
 }
 
 /// \brief Constructs \p winding from the intersection of \p plane with the other planes of the brush.
-void Brush::windingForClipPlane(Winding& winding, const Plane3& plane) const {
-    FixedWinding buffer[2];
+void Brush::windingForClipPlane(Winding& winding, const Plane3& plane) const
+{
+    clipWindingForPlane(plane).writeToWinding(winding);
+}
+
+FixedWinding& Brush::clipWindingForPlane(const Plane3& plane) const
+{
     bool swap = false;
 
     // get a poly that covers an effectively infinite area
-    buffer[swap].createInfinite(plane, m_maxWorldCoord + 1);
+    _clipBuffers[swap].clear();
+    _clipBuffers[swap].createInfinite(plane, m_maxWorldCoord + 1);
 
     // chop the poly by all of the other faces
+    for (std::size_t i = 0;  i < m_faces.size(); ++i)
     {
-        for (std::size_t i = 0;  i < m_faces.size(); ++i) {
-            const Face& clip = *m_faces[i];
+        const Face& clip = *m_faces[i];
 
-            if (clip.plane3() == plane
-                || !clip.plane3().isValid() || !plane_unique(i)
-                || plane == -clip.plane3())
-            {
-                continue;
-            }
+        if (clip.plane3() == plane
+            || !clip.plane3().isValid() || !plane_unique(i)
+            || plane == -clip.plane3())
+        {
+            continue;
+        }
 
-            buffer[!swap].clear();
+        _clipBuffers[!swap].clear();
 
-            {
-                // flip the plane, because we want to keep the back side
-                Plane3 clipPlane(-clip.plane3().normal(), -clip.plane3().dist());
-                buffer[swap].clip(plane, clipPlane, i, buffer[!swap]);
-            }
+        // flip the plane, because we want to keep the back side
+        Plane3 clipPlane(-clip.plane3().normal(), -clip.plane3().dist());
+        _clipBuffers[swap].clip(plane, clipPlane, i, _clipBuffers[!swap]);
+
+        swap = !swap;
+    }
 
-            swap = !swap;
+    return _clipBuffers[swap];
+}
+
+void Brush::clipFaceWindings()
+{
+    for (std::size_t i = 0; i < m_faces.size(); ++i)
+    {
+        auto& face = *m_faces[i];
+
+        if (!face.plane3().isValid() || !plane_unique(i))
+        {
+            face.getWinding().resize(0);
+        }
+        else
+        {
+            clipWindingForPlane(face.plane3()).writeToWinding(face.getWinding());
         }
     }
 
-    buffer[swap].writeToWinding(winding);
+    _windingsClipped = true;
 }
 
 /// \brief Makes this brush a deep-copy of the \p other.
@@ -1068,34 +1252,34 @@ bool Brush::isBounded() {
 
 bool Brush::buildWindings()
 {
+    // Windings might have been clipped already by a batched evaluation
+    if (!_windingsClipped)
+    {
+        clipFaceWindings();
+    }
+
+    _windingsClipped = false;
+
     m_aabb_local = AABB();
 
-    for (std::size_t i = 0;  i < m_faces.size(); ++i)
+    for (const auto& face : m_faces)
     {
-        auto& face = *m_faces[i];
+        const auto& winding = face->getWinding();
 
-        if (!face.plane3().isValid() || !plane_unique(i))
+        if (!winding.empty())
         {
-            face.getWinding().resize(0);
-        }
-        else
-        {
-            windingForClipPlane(face.getWinding(), face.plane3());
-
             // update brush bounds
-            const auto& winding = face.getWinding();
-
             for (const auto& vertex : winding)
-			{
+            {
                 m_aabb_local.includePoint(vertex.vertex);
             }
 
             // update texture coordinates
-            face.emitTextureCoordinates();
+            face->emitTextureCoordinates();
         }
 
         // greebo: Update the winding, now that it's constructed
-        face.updateWinding();
+        face->updateWinding();
     }
 
     bool degenerate = !isBounded();
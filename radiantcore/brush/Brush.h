@@ -1,6 +1,7 @@
 #pragma once
 
 #include "editable.h"
+#include "ipendingevaluation.h"
 
 #include "Face.h"
 #include "SelectableComponents.h"
@@ -13,6 +14,7 @@
 
 class IRenderableCollector;
 class Ray;
+class FixedWinding;
 
 /// \brief Returns true if 'self' takes priority when building brush b-rep.
 inline bool plane3_inside(const Plane3& self, const Plane3& other)
@@ -87,6 +89,7 @@ class Brush :
 	public Snappable,
 	public IUndoable,
 	public Translatable,
+	public scene::IPendingEvaluation,
 	public util::Noncopyable
 {
 private:
@@ -96,6 +99,12 @@ private:
 	Observers m_observers;
 	IUndoStateSaver* _undoStateSaver;
 
+	// The material usage index the faces are registered in while this brush is in the scene
+	scene::IMaterialUsageIndex* _materialUsageIndex;
+
+	// The queue this brush is registered in while it's in the scene and has pending plane changes
+	scene::IPendingEvaluationQueue* _pendingEvaluationQueue;
+
 	// state
 	Faces m_faces;
 	// ----
@@ -138,6 +147,8 @@ private:
 	mutable bool m_transformChanged; // transform evaluation required
 	// ----
 
+	bool _windingsClipped; // face windings have been clipped ahead of buildBRep()
+
 	DetailFlag _detailFlag;
 
 public:
@@ -190,6 +201,14 @@ public:
 	void connectUndoSystem(IUndoSystem& undoSystem);
 	void disconnectUndoSystem(IUndoSystem& undoSystem);
 
+	// Registers the materials of all faces (including the ones added later on) with the given index
+	void connectMaterialUsageIndex(scene::IMaterialUsageIndex& index);
+	void disconnectMaterialUsageIndex();
+
+	// Plane changes are registered with the given queue, to be evaluated along with the other pending brushes
+	void connectPendingEvaluationQueue(scene::IPendingEvaluationQueue& queue);
+	void disconnectPendingEvaluationQueue();
+
 	// Face observer callbacks
 	void onFacePlaneChanged();
 	void onFaceShaderChanged();
@@ -206,6 +225,10 @@ public:
 	// Returns TRUE if any face materials are visible
 	bool hasVisibleMaterial() const override;
 
+	// Returns the estimated memory of the face list and the cached b-rep data,
+	// not including the faces themselves or this object
+	std::size_t getMemoryUsage() const;
+
 	// Update call issued by the filter system
 	void updateFaceVisibility() override;
 
@@ -216,6 +239,14 @@ public:
 
 	void evaluateBRep() const override;
 
+	/**
+	 * Evaluates the b-rep of all brushes of the given queue with pending plane changes
+	 * in one batch. The face windings are clipped in parallel, the remaining steps are
+	 * run sequentially in the calling thread, which must be the main thread.
+	 * This is invoked by evaluateBRep() as soon as any dirty brush of the scene is requested.
+	 */
+	static void evaluatePendingBReps(scene::IPendingEvaluationQueue& queue);
+
     void transformChanged();
     void evaluateTransform();
 
@@ -307,6 +338,10 @@ public:
     const std::vector<Vector3>& getVertices(selection::ComponentSelectionMode mode) const;
 
 private:
+	// Connects a face to the undo system and the material usage index, if this brush is connected
+	void connectFace(Face& face);
+	void disconnectFace(Face& face);
+
 	void edge_push_back(FaceVertexId faceVertex);
 
 	void edge_clear();
@@ -336,6 +371,15 @@ private:
 	/// \brief Returns true if the brush is a finite volume. A brush without a finite volume extends past the maximum world bounds and is not valid.
 	bool isBounded();
 
+	/// \brief Clips the polygon windings of each face, without touching anything outside this brush. Safe to call from worker threads.
+	/// The result is written into the face windings directly. These are not moved into a shared vertex pool:
+	/// IWinding is a std::vector exposed through ibrush.h to the renderables, selection tests and scripts.
+	/// The windings keep their capacity, so clipping a brush again only allocates when a face gains vertices.
+	void clipFaceWindings();
+
+	/// \brief Clips a winding covering the whole plane by all other faces. The returned buffer is owned by the calling thread.
+	FixedWinding& clipWindingForPlane(const Plane3& plane) const;
+
 	/// \brief Constructs the polygon windings for each face of the brush. Also updates the brush bounding-box and face texture-coordinates.
 	bool buildWindings();
 
@@ -5,13 +5,17 @@
 
 #include "itextstream.h"
 #include "ifilter.h"
+#include "ipatch.h"
+#include "iscenegraph.h"
 #include "igame.h"
 #include "ilayer.h"
 #include "brush/BrushNode.h"
 #include "brush/BrushClipPlane.h"
 #include "brush/BrushVisit.h"
 #include "gamelib.h"
+#include "scene/NodeArena.h"
 #include "selectionlib.h"
+#include "string/InternedString.h"
 
 #include "registry/registry.h"
 #include "ipreferencesystem.h"
@@ -72,7 +76,7 @@ void BrushModuleImpl::toggleTextureLock() {
 
 scene::INodePtr BrushModuleImpl::createBrush()
 {
-	scene::INodePtr node = std::make_shared<BrushNode>();
+	scene::INodePtr node = scene::makeArenaShared<BrushNode>();
 
 	if (GlobalMapModule().getRoot())
 	{
@@ -152,6 +156,48 @@ void BrushModuleImpl::registerBrushCommands()
 
 	GlobalCommandSystem().addCommand("ResizeSelectedBrushesToBounds", selection::algorithm::resizeSelectedBrushesToBounds,
 		{ cmd::ARGTYPE_VECTOR3, cmd::ARGTYPE_VECTOR3, cmd::ARGTYPE_STRING });
+
+    GlobalCommandSystem().addCommand("PrintMaterialNameStats", [this](const cmd::ArgumentList&) { printMaterialNameStatistics(); });
+}
+
+void BrushModuleImpl::printMaterialNameStatistics()
+{
+    std::size_t numReferences = 0;
+    std::size_t stringHeapBytes = 0;
+
+    auto countReference = [&](const std::string& material)
+    {
+        ++numReferences;
+        stringHeapBytes += string::InternedString::GetHeapSize(material);
+    };
+
+    GlobalSceneGraph().foreachNode([&](const scene::INodePtr& node)
+    {
+        if (auto brush = Node_getIBrush(node); brush != nullptr)
+        {
+            for (std::size_t i = 0; i < brush->getNumFaces(); ++i)
+            {
+                countReference(brush->getFace(i).getShader());
+            }
+        }
+        else if (auto patch = Node_getIPatch(node); patch != nullptr)
+        {
+            countReference(patch->getShader());
+        }
+
+        return true;
+    });
+
+    auto stats = string::InternedString::GetStatistics();
+
+    // Every surface used to own a copy of its material name
+    auto bytesWithCopies = numReferences * sizeof(std::string) + stringHeapBytes;
+    auto bytesInterned = numReferences * sizeof(string::InternedString) + stats.numBytes;
+
+    rMessage() << "Material names: " << numReferences << " references to "
+        << stats.numStrings << " interned strings" << std::endl;
+    rMessage() << "  with per-surface copies: " << bytesWithCopies << " bytes" << std::endl;
+    rMessage() << "  interned: " << bytesInterned << " bytes (" << stats.numBytes << " bytes in the table)" << std::endl;
 }
 
 // -------------------------------------------------------------------------------------
@@ -27,6 +27,9 @@ private:
 
 	void registerBrushCommands();
 
+	// Logs the memory used by the material names of all faces and patches in the scene
+	void printMaterialNameStatistics();
+
 public:
 	// destructor
 	virtual ~BrushModuleImpl() {}
@@ -127,6 +127,13 @@ void BrushNode::testSelect(Selector& selector, SelectionTest& test)
 	}
 }
 
+void BrushNode::prepareConcurrentSelectionTest()
+{
+    // Evaluate the transform and the windings, the face and component instances are ready then
+    localToWorld();
+    _brush.evaluateBRep();
+}
+
 inline bool checkFaceInstancesForSelectedComponents(const FaceInstances& instances)
 {
     for (const auto& face :  instances)
@@ -289,6 +296,15 @@ IBrush& BrushNode::getIBrush() {
 	return _brush;
 }
 
+std::size_t BrushNode::getMemoryUsage() const
+{
+    return sizeof(BrushNode) + _brush.getMemoryUsage() +
+        _faceInstances.capacity() * sizeof(FaceInstance) +
+        _edgeInstances.capacity() * sizeof(EdgeInstance) +
+        _vertexInstances.capacity() * sizeof(brush::VertexInstance) +
+        _selectedPoints.capacity() * sizeof(Vector3);
+}
+
 void BrushNode::translate(const Vector3& translation)
 {
 	_brush.translate(translation);
@@ -301,6 +317,8 @@ scene::INodePtr BrushNode::clone() const {
 void BrushNode::onInsertIntoScene(scene::IMapRootNode& root)
 {
     _brush.connectUndoSystem(root.getUndoSystem());
+    _brush.connectMaterialUsageIndex(root.getMaterialUsageIndex());
+    _brush.connectPendingEvaluationQueue(root.getPendingEvaluationQueue());
 	GlobalCounters().getCounter(counterBrushes).increment();
 
     // Update the origin information needed for transformations
@@ -321,6 +339,8 @@ void BrushNode::onRemoveFromScene(scene::IMapRootNode& root)
 	setSelectedComponents(false, selection::ComponentSelectionMode::Face);
 
 	GlobalCounters().getCounter(counterBrushes).decrement();
+    _brush.disconnectPendingEvaluationQueue();
+    _brush.disconnectMaterialUsageIndex();
     _brush.disconnectUndoSystem(root.getUndoSystem());
     _renderableVertices.clear();
 
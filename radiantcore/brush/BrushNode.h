@@ -25,6 +25,7 @@ class BrushNode final :
 	public BrushObserver,
 	public SelectionTestable,
 	public ComponentSelectionTestable,
+	public ConcurrentSelectionTestable,
 	public ComponentEditable,
 	public ComponentSnappable,
 	public PlaneSelectable,
@@ -74,6 +75,9 @@ public:
 	Brush& getBrush() override;
 	IBrush& getIBrush() override;
 
+	// Returns the estimated memory occupied by this node and its brush, excluding the faces
+	std::size_t getMemoryUsage() const;
+
 	std::string name() const  override
     {
 		return "Brush";
@@ -96,6 +100,9 @@ public:
 	void invertSelectedComponents(selection::ComponentSelectionMode mode) override;
 	void testSelectComponents(Selector& selector, SelectionTest& test, selection::ComponentSelectionMode mode) override;
 
+	// ConcurrentSelectionTestable
+	void prepareConcurrentSelectionTest() override;
+
 	// override scene::Inode::onRemoveFromScene to deselect the child components
     void onInsertIntoScene(scene::IMapRootNode& root) override;
     void onRemoveFromScene(scene::IMapRootNode& root) override;
@@ -22,22 +22,25 @@ class Face::SavedState final :
 public:
     FacePlane::SavedState _planeState;
     TextureProjection _texdefState;
-    std::string _materialName;
+    string::InternedString _materialName;
 
     SavedState(const Face& face) :
         _planeState(face.getPlane()),
         _texdefState(face.getProjection()),
-        _materialName(face.getShader())
+        _materialName(face.getFaceShader().getMaterialHandle())
     {}
 };
 
+Face::Renderables::Renderables(const Winding& winding) :
+    solid(winding, false),
+    wireframe(winding, true)
+{}
+
 Face::Face(Brush& owner) :
     _owner(owner),
     _shader(texdef_name_default(), _owner.getBrushNode().getRenderSystem()),
     _undoStateSaver(nullptr),
-    _faceIsVisible(true),
-    _windingSurfaceSolid(m_winding, false),
-    _windingSurfaceWireframe(m_winding, true)
+    _faceIsVisible(true)
 {
     setupSurfaceShader();
 
@@ -60,9 +63,7 @@ Face::Face(
     _shader(shader, _owner.getBrushNode().getRenderSystem()),
     _texdef(projection),
     _undoStateSaver(nullptr),
-    _faceIsVisible(true),
-    _windingSurfaceSolid(m_winding, false),
-    _windingSurfaceWireframe(m_winding, true)
+    _faceIsVisible(true)
 {
     setupSurfaceShader();
     m_plane.initialiseFromPoints(p0, p1, p2);
@@ -74,9 +75,7 @@ Face::Face(Brush& owner, const Plane3& plane) :
     _owner(owner),
     _shader("", _owner.getBrushNode().getRenderSystem()),
     _undoStateSaver(nullptr),
-    _faceIsVisible(true),
-    _windingSurfaceSolid(m_winding, false),
-    _windingSurfaceWireframe(m_winding, true)
+    _faceIsVisible(true)
 {
     setupSurfaceShader();
     m_plane.setPlane(plane);
@@ -88,9 +87,7 @@ Face::Face(Brush& owner, const Plane3& plane, const Matrix3& textureProjection,
     _owner(owner),
     _shader(material, _owner.getBrushNode().getRenderSystem()),
     _undoStateSaver(nullptr),
-    _faceIsVisible(true),
-    _windingSurfaceSolid(m_winding, false),
-    _windingSurfaceWireframe(m_winding, true)
+    _faceIsVisible(true)
 {
     setupSurfaceShader();
     m_plane.setPlane(plane);
@@ -106,15 +103,18 @@ Face::Face(Brush& owner, const Face& other) :
     IUndoable(other),
     _owner(owner),
     m_plane(other.m_plane),
-    _shader(other._shader.getMaterialName(), _owner.getBrushNode().getRenderSystem()),
+    _shader(other._shader.getMaterialHandle(), _owner.getBrushNode().getRenderSystem()),
     _texdef(other.getProjection()),
     _undoStateSaver(nullptr),
-    _faceIsVisible(other._faceIsVisible),
-    _windingSurfaceSolid(m_winding, false),
-    _windingSurfaceWireframe(m_winding, true)
+    _faceIsVisible(other._faceIsVisible)
 {
     setupSurfaceShader();
-    planepts_assign(m_move_planepts, other.m_move_planepts);
+
+    if (other._movePlanePoints)
+    {
+        planepts_assign(getMovePlanePoints(), other._movePlanePoints->points);
+    }
+
     planeChanged();
 }
 
@@ -211,13 +211,13 @@ void Face::importState(const IUndoMementoPtr& data)
     auto state = std::static_pointer_cast<SavedState>(data);
 
     state->_planeState.exportState(getPlane());
-    setShader(state->_materialName);
+    _shader.setMaterialName(state->_materialName); // pass the handle on, no lookup by name
     _texdef = state->_texdefState;
 
     planeChanged();
     _owner.onFaceConnectivityChanged();
     texdefChanged();
-    _owner.onFaceShaderChanged();
+    shaderChanged();
 }
 
 void Face::flipWinding() {
@@ -229,7 +229,7 @@ bool Face::intersectVolume(const VolumeTest& volume) const
 {
     if (!m_winding.empty())
     {
-        const Plane3& plane = m_planeTransformed.getPlane();
+        const Plane3& plane = getTransformedPlane().getPlane();
         return volume.TestPlane(Plane3(plane.normal(), -plane.dist()));
     }
     else
@@ -286,12 +286,13 @@ void Face::transformTexDefLocked(const Matrix4& transform)
     vertices[2] = transform.transformPoint(vertices[2]);
 
     // Keep the texture coords, recalculate the texture projection
-    m_texdefTransformed.calculateFromPoints(vertices, texcoords, m_planeTransformed.getPlane().normal());
+    auto& state = getTransformedState();
+    state.texdef.calculateFromPoints(vertices, texcoords, state.plane.getPlane().normal());
 }
 
 void Face::translate(const Vector3& translation)
 {
-    m_planeTransformed.translate(translation);
+    getTransformedState().plane.translate(translation);
     
     if (GlobalBrush().textureLockEnabled() && m_winding.size() >= 3)
     {
@@ -305,7 +306,7 @@ void Face::translate(const Vector3& translation)
 void Face::transform(const Matrix4& transform)
 {
     // Transform the FacePlane using the given matrix (before the tex def is recalculated)
-    m_planeTransformed.transform(transform);
+    getTransformedState().plane.transform(transform);
 
     if (GlobalBrush().textureLockEnabled() && m_winding.size() >= 3)
     {
@@ -318,7 +319,7 @@ void Face::transform(const Matrix4& transform)
 
 void Face::assign_planepts(const PlanePoints planepts)
 {
-    m_planeTransformed.initialiseFromPoints(
+    getTransformedState().plane.initialiseFromPoints(
         planepts[0], planepts[1], planepts[2]
     );
     _owner.onFacePlaneChanged();
@@ -328,9 +329,13 @@ void Face::assign_planepts(const PlanePoints planepts)
 /// \brief Reverts the transformable state of the brush to identity.
 void Face::revertTransform()
 {
-    m_planeTransformed = m_plane;
-    planepts_assign(m_move_planeptsTransformed, m_move_planepts);
-    m_texdefTransformed = _texdef;
+    _transformed.reset();
+
+    if (_movePlanePoints)
+    {
+        planepts_assign(_movePlanePoints->transformed, _movePlanePoints->points);
+    }
+
     updateWinding();
     emitTextureCoordinates();
 }
@@ -338,22 +343,84 @@ void Face::revertTransform()
 void Face::freezeTransform()
 {
     undoSave();
-    m_plane = m_planeTransformed;
-    planepts_assign(m_move_planepts, m_move_planeptsTransformed);
-    _texdef = m_texdefTransformed;
+
+    if (_transformed)
+    {
+        m_plane = _transformed->plane;
+        _texdef = _transformed->texdef;
+        _transformed.reset();
+    }
+
+    if (_movePlanePoints)
+    {
+        planepts_assign(_movePlanePoints->points, _movePlanePoints->transformed);
+    }
+
     updateWinding();
 }
 
+const FacePlane& Face::getTransformedPlane() const
+{
+    return _transformed ? _transformed->plane : m_plane;
+}
+
+const TextureProjection& Face::getTransformedTexdef() const
+{
+    return _transformed ? _transformed->texdef : _texdef;
+}
+
+Face::TransformedState& Face::getTransformedState()
+{
+    if (!_transformed)
+    {
+        _transformed.reset(new TransformedState{ m_plane, _texdef });
+    }
+
+    return *_transformed;
+}
+
+PlanePoints& Face::getMovePlanePoints()
+{
+    if (!_movePlanePoints)
+    {
+        _movePlanePoints = std::make_unique<MovePlanePoints>();
+    }
+
+    return _movePlanePoints->points;
+}
+
+PlanePoints& Face::getMovePlanePointsTransformed()
+{
+    if (!_movePlanePoints)
+    {
+        _movePlanePoints = std::make_unique<MovePlanePoints>();
+    }
+
+    return _movePlanePoints->transformed;
+}
+
+void Face::releaseMovePlanePoints()
+{
+    _movePlanePoints.reset();
+}
+
 void Face::clearRenderables()
 {
-    _windingSurfaceSolid.clear();
-    _windingSurfaceWireframe.clear();
+    if (!_renderables) return;
+
+    _renderables->solid.clear();
+    _renderables->wireframe.clear();
+    _renderables.reset();
 }
 
 void Face::updateRenderables()
 {
-    _windingSurfaceSolid.queueUpdate();
-    _windingSurfaceWireframe.queueUpdate();
+    // Renderables allocated later on will be updated in any case
+    if (_renderables)
+    {
+        _renderables->solid.queueUpdate();
+        _renderables->wireframe.queueUpdate();
+    }
 
     _owner.onFaceNeedsRenderableUpdate();
 }
@@ -440,7 +507,10 @@ void Face::setShader(const std::string& name)
 
 void Face::revertTexdef()
 {
-    m_texdefTransformed = _texdef;
+    if (_transformed)
+    {
+        _transformed->texdef = _texdef;
+    }
 }
 
 void Face::texdefChanged()
@@ -574,20 +644,20 @@ void Face::applyShaderFromFace(const Face& other)
         auto edge = other.m_winding[edgeIndices.second].vertex - other.m_winding[edgeIndices.first].vertex;
 
         // Construct a vector that is orthogonal to the edge, pointing outwards
-        auto outwardsDirection = edge.cross(other.m_planeTransformed.getPlane().normal());
+        auto outwardsDirection = edge.cross(other.getTransformedPlane().getPlane().normal());
 
         // Pick a point outside face, placing that orthogonal vector on the edge center
         auto extrapolatedPoint = edgeCenter + outwardsDirection;
         auto extrapolationLength = outwardsDirection.getLength();
-        auto extrapolatedTexcoords = other.m_texdefTransformed.getTextureCoordsForVertex(
-            extrapolatedPoint, other.m_planeTransformed.getPlane().normal(), Matrix4::getIdentity()
+        auto extrapolatedTexcoords = other.getTransformedTexdef().getTextureCoordsForVertex(
+            extrapolatedPoint, other.getTransformedPlane().getPlane().normal(), Matrix4::getIdentity()
         );
 
         // Construct an edge vector on this target face, keeping the winding order
         edgeIndices = getEdgeIndexPair(sharedVertices[0].second, sharedVertices[1].second, m_winding.size());
 
         auto targetFaceEdge = m_winding[edgeIndices.second].vertex - m_winding[edgeIndices.first].vertex;
-        auto inwardsDirection = -targetFaceEdge.cross(m_planeTransformed.getPlane().normal()).getNormalised();
+        auto inwardsDirection = -targetFaceEdge.cross(getTransformedPlane().getPlane().normal()).getNormalised();
 
         // Calculate a point on this face plane, with the same distance from the edge center as on the source face
         auto pointOnThisFacePlane = edgeCenter + inwardsDirection * extrapolationLength;
@@ -609,7 +679,7 @@ void Face::applyShaderFromFace(const Face& other)
         };
 
         setTexDefFromPoints(vertices, texcoords);
-        _texdef = m_texdefTransformed; // freeze that matrix
+        _texdef = getTransformedTexdef(); // freeze that matrix
         return;
     }
     else
@@ -621,7 +691,7 @@ void Face::applyShaderFromFace(const Face& other)
 
 void Face::setTexDefFromPoints(const Vector3 points[3], const Vector2 uvs[3])
 {
-    m_texdefTransformed.calculateFromPoints(points, uvs, getPlane3().normal());
+    getTransformedState().texdef.calculateFromPoints(points, uvs, getPlane3().normal());
 
     emitTextureCoordinates();
 
@@ -672,7 +742,7 @@ void Face::alignTexture(AlignEdge align)
 
 void Face::emitTextureCoordinates() 
 {
-    m_texdefTransformed.emitTextureCoordinates(m_winding, m_planeTransformed.getPlane().normal(), Matrix4::getIdentity());
+    getTransformedTexdef().emitTextureCoordinates(m_winding, getTransformedPlane().getPlane().normal(), Matrix4::getIdentity());
 }
 
 void Face::applyDefaultTextureScale()
@@ -699,18 +769,28 @@ Winding& Face::getWinding() {
 
 render::RenderableWinding& Face::getWindingSurfaceSolid()
 {
-    return _windingSurfaceSolid;
+    if (!_renderables)
+    {
+        _renderables = std::make_unique<Renderables>(m_winding);
+    }
+
+    return _renderables->solid;
 }
 
 render::RenderableWinding& Face::getWindingSurfaceWireframe()
 {
-    return _windingSurfaceWireframe;
+    if (!_renderables)
+    {
+        _renderables = std::make_unique<Renderables>(m_winding);
+    }
+
+    return _renderables->wireframe;
 }
 
 const Plane3& Face::plane3() const
 {
     _owner.onFaceEvaluateTransform();
-    return m_planeTransformed.getPlane();
+    return getTransformedPlane().getPlane();
 }
 
 const Plane3& Face::getPlane3() const
@@ -755,6 +835,17 @@ bool Face::isVisible() const
     return _faceIsVisible;
 }
 
+std::size_t Face::getMemoryUsage() const
+{
+    auto size = sizeof(Face) + m_winding.capacity() * sizeof(WindingVertex);
+
+    if (_transformed) size += sizeof(TransformedState);
+    if (_movePlanePoints) size += sizeof(MovePlanePoints);
+    if (_renderables) size += sizeof(Renderables);
+
+    return size;
+}
+
 void Face::onBrushVisibilityChanged(bool visible)
 {
     if (!visible)
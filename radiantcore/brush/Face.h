@@ -33,22 +33,41 @@ private:
     // The structure which is saved to the undo stack
     class SavedState;
 
-public:
-	PlanePoints m_move_planepts;
-	PlanePoints m_move_planeptsTransformed;
+    // The plane and texdef of an ongoing transformation. This is only allocated
+    // while a manipulation is in progress, and discarded by freeze/revertTransform
+    struct TransformedState
+    {
+        FacePlane plane;
+        TextureProjection texdef;
+    };
+
+    // Plane points used to drag vertices and edges, allocated on component selection
+    struct MovePlanePoints
+    {
+        PlanePoints points;
+        PlanePoints transformed;
+    };
+
+    struct Renderables
+    {
+        render::RenderableWinding solid;
+        render::RenderableWinding wireframe;
+
+        Renderables(const Winding& winding);
+    };
 
-private:
 	// The parent brush
 	Brush& _owner;
 
 	FacePlane m_plane;
-	FacePlane m_planeTransformed;
 
     // Face shader, stores material name and GL shader object
 	SurfaceShader _shader;
 
 	TextureProjection _texdef;
-	TextureProjection m_texdefTransformed;
+
+	std::unique_ptr<TransformedState> _transformed;
+	std::unique_ptr<MovePlanePoints> _movePlanePoints;
 
 	Winding m_winding;
 	Vector3 m_centroid;
@@ -58,8 +77,8 @@ private:
 	// Cached visibility flag, queried during front end rendering
 	bool _faceIsVisible;
 
-    render::RenderableWinding _windingSurfaceSolid;
-    render::RenderableWinding _windingSurfaceWireframe;
+    // Allocated when the face is rendered for the first time, released when the brush is hidden
+    std::unique_ptr<Renderables> _renderables;
 
     sigc::signal<void> _sigDestroyed;
 
@@ -120,6 +139,13 @@ public:
 
 	void update_move_planepts_vertex(std::size_t index, PlanePoints planePoints);
 
+    // The plane points used by vertex and edge manipulation, allocated on first access
+    PlanePoints& getMovePlanePoints();
+    PlanePoints& getMovePlanePointsTransformed();
+
+    // Called when no more vertices or edges of this face are selected
+    void releaseMovePlanePoints();
+
 	void snapto(float snap);
 
 	void testSelect(SelectionTest& test, SelectionIntersection& best);
@@ -211,6 +237,9 @@ public:
 
 	bool isVisible() const override;
 
+    // Returns the estimated heap and object memory occupied by this face
+    std::size_t getMemoryUsage() const;
+
     // Called when the owning brush changes its visibility status
     void onBrushVisibilityChanged(bool visible);
 
@@ -224,6 +253,13 @@ public:
 private:
 	void realiseShader();
 
+    // Returns the transformed state, or the untransformed members if no transformation is running
+    const FacePlane& getTransformedPlane() const;
+    const TextureProjection& getTransformedTexdef() const;
+
+    // Returns the state of the ongoing transformation, starting one if necessary
+    TransformedState& getTransformedState();
+
 	// Connects surface shader signals and calls realiseShader() if possible
 	void setupSurfaceShader();
 
@@ -123,12 +123,14 @@ void FaceInstance::setSelected(selection::ComponentSelectionMode mode, bool sele
 
 			m_vertexSelection.clear();
 			m_selectableVertices.setSelected(false);
+			releaseUnusedMovePlanePoints();
 			break;
 		case selection::ComponentSelectionMode::Edge:
 			ASSERT_MESSAGE(!select, "select-all not supported");
 
 			m_edgeSelection.clear();
 			m_selectableEdges.setSelected(false);
+			releaseUnusedMovePlanePoints();
 			break;
 		default:
 			break;
@@ -219,21 +221,21 @@ void FaceInstance::transformComponents(const Matrix4& matrix) {
 	{
 		if (m_vertexSelection.size() == 1)
 		{
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getMovePlanePointsTransformed()[1] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[1]);
+			m_face->assign_planepts(m_face->getMovePlanePointsTransformed());
 		}
 		else if (m_vertexSelection.size() == 2)
 		{
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->m_move_planeptsTransformed[2] = matrix.transformPoint(m_face->m_move_planeptsTransformed[2]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getMovePlanePointsTransformed()[1] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[1]);
+			m_face->getMovePlanePointsTransformed()[2] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[2]);
+			m_face->assign_planepts(m_face->getMovePlanePointsTransformed());
 		}
 		else if (m_vertexSelection.size() >= 3)
 		{
-			m_face->m_move_planeptsTransformed[0] = matrix.transformPoint(m_face->m_move_planeptsTransformed[0]);
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->m_move_planeptsTransformed[2] = matrix.transformPoint(m_face->m_move_planeptsTransformed[2]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getMovePlanePointsTransformed()[0] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[0]);
+			m_face->getMovePlanePointsTransformed()[1] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[1]);
+			m_face->getMovePlanePointsTransformed()[2] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[2]);
+			m_face->assign_planepts(m_face->getMovePlanePointsTransformed());
 		}
 	}
 
@@ -241,16 +243,16 @@ void FaceInstance::transformComponents(const Matrix4& matrix) {
 	{
 		if (m_edgeSelection.size() == 1)
 		{
-			m_face->m_move_planeptsTransformed[0] = matrix.transformPoint(m_face->m_move_planeptsTransformed[0]);
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getMovePlanePointsTransformed()[0] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[0]);
+			m_face->getMovePlanePointsTransformed()[1] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[1]);
+			m_face->assign_planepts(m_face->getMovePlanePointsTransformed());
 		}
 		else if (m_edgeSelection.size() >= 2)
 		{
-			m_face->m_move_planeptsTransformed[0] = matrix.transformPoint(m_face->m_move_planeptsTransformed[0]);
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->m_move_planeptsTransformed[2] = matrix.transformPoint(m_face->m_move_planeptsTransformed[2]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getMovePlanePointsTransformed()[0] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[0]);
+			m_face->getMovePlanePointsTransformed()[1] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[1]);
+			m_face->getMovePlanePointsTransformed()[2] = matrix.transformPoint(m_face->getMovePlanePointsTransformed()[2]);
+			m_face->assign_planepts(m_face->getMovePlanePointsTransformed());
 		}
 	}
 }
@@ -265,26 +267,26 @@ void FaceInstance::snapComponents(float snap) {
 	}
 
 	if (selectedVertices()) {
-		m_face->m_move_planepts[0].snap(snap);
-		m_face->m_move_planepts[1].snap(snap);
-		m_face->m_move_planepts[2].snap(snap);
-		m_face->assign_planepts(m_face->m_move_planepts);
-		planepts_assign(m_face->m_move_planeptsTransformed, m_face->m_move_planepts);
+		m_face->getMovePlanePoints()[0].snap(snap);
+		m_face->getMovePlanePoints()[1].snap(snap);
+		m_face->getMovePlanePoints()[2].snap(snap);
+		m_face->assign_planepts(m_face->getMovePlanePoints());
+		planepts_assign(m_face->getMovePlanePointsTransformed(), m_face->getMovePlanePoints());
 		m_face->freezeTransform();
 	}
 
 	if (selectedEdges()) {
-		m_face->m_move_planepts[0].snap(snap);
-		m_face->m_move_planepts[1].snap(snap);
-		m_face->m_move_planepts[2].snap(snap);
-		m_face->assign_planepts(m_face->m_move_planepts);
-		planepts_assign(m_face->m_move_planeptsTransformed, m_face->m_move_planepts);
+		m_face->getMovePlanePoints()[0].snap(snap);
+		m_face->getMovePlanePoints()[1].snap(snap);
+		m_face->getMovePlanePoints()[2].snap(snap);
+		m_face->assign_planepts(m_face->getMovePlanePoints());
+		planepts_assign(m_face->getMovePlanePointsTransformed(), m_face->getMovePlanePoints());
 		m_face->freezeTransform();
 	}
 }
 
 void FaceInstance::update_move_planepts_vertex(std::size_t index) {
-	m_face->update_move_planepts_vertex(index, m_face->m_move_planepts);
+	m_face->update_move_planepts_vertex(index, m_face->getMovePlanePoints());
 }
 
 void FaceInstance::update_move_planepts_vertex2(std::size_t index, std::size_t other)
@@ -309,10 +311,10 @@ void FaceInstance::update_move_planepts_vertex2(std::size_t index, std::size_t o
 		"update_move_planepts_vertex2: error"
 	)
 
-	m_face->m_move_planepts[0] = m_face->getWinding()[opposite].vertex;
-	m_face->m_move_planepts[1] = m_face->getWinding()[index].vertex;
-	m_face->m_move_planepts[2] = m_face->getWinding()[other].vertex;
-	planepts_quantise(m_face->m_move_planepts, GRID_MIN); // winding points are very inaccurate
+	m_face->getMovePlanePoints()[0] = m_face->getWinding()[opposite].vertex;
+	m_face->getMovePlanePoints()[1] = m_face->getWinding()[index].vertex;
+	m_face->getMovePlanePoints()[2] = m_face->getWinding()[other].vertex;
+	planepts_quantise(m_face->getMovePlanePoints(), GRID_MIN); // winding points are very inaccurate
 }
 
 void FaceInstance::update_selection_vertex() {
@@ -363,10 +365,10 @@ void FaceInstance::update_move_planepts_edge(std::size_t index)
 
 	std::size_t adjacent = m_face->getWinding().next(index);
 	std::size_t opposite = m_face->getWinding().opposite(index);
-	m_face->m_move_planepts[0] = m_face->getWinding()[index].vertex;
-	m_face->m_move_planepts[1] = m_face->getWinding()[adjacent].vertex;
-	m_face->m_move_planepts[2] = m_face->getWinding()[opposite].vertex;
-	planepts_quantise(m_face->m_move_planepts, GRID_MIN); // winding points are very inaccurate
+	m_face->getMovePlanePoints()[0] = m_face->getWinding()[index].vertex;
+	m_face->getMovePlanePoints()[1] = m_face->getWinding()[adjacent].vertex;
+	m_face->getMovePlanePoints()[2] = m_face->getWinding()[opposite].vertex;
+	planepts_quantise(m_face->getMovePlanePoints(), GRID_MIN); // winding points are very inaccurate
 }
 
 void FaceInstance::update_selection_edge() {
@@ -413,6 +415,15 @@ void FaceInstance::connectivityChanged() {
 	m_selectableVertices.setSelected(false);
 	m_edgeSelection.clear();
 	m_selectableEdges.setSelected(false);
+	releaseUnusedMovePlanePoints();
+}
+
+void FaceInstance::releaseUnusedMovePlanePoints()
+{
+	if (m_vertexSelection.empty() && m_edgeSelection.empty())
+	{
+		m_face->releaseMovePlanePoints();
+	}
 }
 
 void FaceInstance::updateFaceVisibility()
@@ -31,6 +31,9 @@ private:
 
 	static FaceInstanceSet _selectedFaceInstances;
 
+	// Releases the face's component plane points once no vertex or edge is selected
+	void releaseUnusedMovePlanePoints();
+
 public:
 	FaceInstance(Face& face, const SelectionChangedSlot& observer);
 	FaceInstance(const FaceInstance& other);
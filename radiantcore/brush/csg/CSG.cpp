@@ -357,10 +357,8 @@ bool Brush_merge(Brush& brush, const BrushPtrVector& in, bool onlyshape) {
 				// face equals another face
 				if (face1.plane3() == face2.plane3()) {
 					// if the texture/shader references should be the same but are not
-					if (!onlyshape && !shader_equal(
-                            face1.getFaceShader().getMaterialName(),
-                            face2.getFaceShader().getMaterialName()
-                        ))
+					if (!onlyshape && !face1.getFaceShader().getMaterialHandle().equalsNoCase(
+                            face2.getFaceShader().getMaterialHandle()))
                     {
 						return false;
 					}
@@ -0,0 +1,182 @@
+#include "DeclarationCache.h"
+
+#include <fstream>
+#include <stdexcept>
+#include "itextstream.h"
+#include "os/dir.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "stream/BinaryCacheFile.h"
+
+namespace decl
+{
+
+namespace
+{
+    using stream::cache::readValue;
+    using stream::cache::writeValue;
+    using stream::cache::writeString;
+
+    const char CACHE_FILE_MAGIC[4] = { 'D', 'R', 'D', 'C' };
+    const std::uint32_t CACHE_FILE_VERSION = 1;
+
+    // Declaration blocks can be large, anything beyond is considered corrupt
+    constexpr std::uint32_t MAX_STRING_LENGTH = 1u << 28;
+
+    std::string readString(std::istream& stream)
+    {
+        return stream::cache::readString(stream, MAX_STRING_LENGTH);
+    }
+}
+
+DeclarationCache::DeclarationCache(const std::string& cacheFilePath) :
+    _cacheFilePath(cacheFilePath),
+    _numHits(0),
+    _numMisses(0),
+    _keysUpdated(false)
+{}
+
+void DeclarationCache::load()
+{
+    _cachedFiles.clear();
+
+    std::ifstream stream(_cacheFilePath, std::ios::binary);
+
+    if (!stream) return;
+
+    try
+    {
+        if (!stream::cache::readHeader(stream, CACHE_FILE_MAGIC, CACHE_FILE_VERSION))
+        {
+            return; // foreign or outdated cache file
+        }
+
+        auto numFiles = readValue<std::uint32_t>(stream);
+
+        for (std::uint32_t i = 0; i < numFiles; ++i)
+        {
+            auto vfsPath = readString(stream);
+
+            FileEntry entry;
+            entry.key.modName = readString(stream);
+            entry.key.archivePath = readString(stream);
+            entry.key.size = readValue<std::uint64_t>(stream);
+            entry.key.modificationTime = readValue<std::int64_t>(stream);
+            entry.key.contentHash = readValue<std::uint64_t>(stream);
+
+            auto numBlocks = readValue<std::uint32_t>(stream);
+            entry.blocks.reserve(numBlocks);
+
+            for (std::uint32_t b = 0; b < numBlocks; ++b)
+            {
+                auto& block = entry.blocks.emplace_back();
+                block.typeName = readString(stream);
+                block.name = readString(stream);
+                block.contents = readString(stream);
+            }
+
+            _cachedFiles.emplace(std::move(vfsPath), std::move(entry));
+        }
+    }
+    catch (const std::runtime_error& ex)
+    {
+        rWarning() << "Discarding declaration cache " << _cacheFilePath << ": " << ex.what() << std::endl;
+        _cachedFiles.clear();
+    }
+}
+
+const std::vector<DeclarationCache::Block>* DeclarationCache::find(const std::string& vfsPath, SourceKey& key,
+    const std::function<std::uint64_t()>& getContentHash)
+{
+    auto found = _cachedFiles.find(vfsPath);
+
+    if (found == _cachedFiles.end() || found->second.key.size != key.size ||
+        found->second.key.modName != key.modName || found->second.key.archivePath != key.archivePath)
+    {
+        ++_numMisses;
+        return nullptr;
+    }
+
+    const auto& cachedKey = found->second.key;
+
+    if (cachedKey.modificationTime == key.modificationTime)
+    {
+        key.contentHash = cachedKey.contentHash;
+    }
+    else
+    {
+        // Archives are not looked into, a changed timestamp invalidates all of their files
+        if (!getContentHash || (key.contentHash = getContentHash()) != cachedKey.contentHash)
+        {
+            ++_numMisses;
+            return nullptr;
+        }
+
+        _keysUpdated = true;
+    }
+
+    ++_numHits;
+    return &found->second.blocks;
+}
+
+void DeclarationCache::store(const std::string& vfsPath, const SourceKey& key, std::vector<Block> blocks)
+{
+    _visitedFiles[vfsPath] = FileEntry{ key, std::move(blocks) };
+}
+
+void DeclarationCache::save()
+{
+    // Nothing to do if every visited file has been served from the cache
+    if (_numMisses == 0 && !_keysUpdated && _visitedFiles.size() == _cachedFiles.size()) return;
+
+    if (!os::makeDirectory(os::getDirectory(_cacheFilePath)))
+    {
+        return;
+    }
+
+    stream::cache::Writer writer(_cacheFilePath);
+
+    if (!writer.isOpen())
+    {
+        rWarning() << "Cannot write declaration cache file " << _cacheFilePath << std::endl;
+        return;
+    }
+
+    auto& stream = writer.getStream();
+
+    stream::cache::writeHeader(stream, CACHE_FILE_MAGIC, CACHE_FILE_VERSION);
+    writeValue(stream, static_cast<std::uint32_t>(_visitedFiles.size()));
+
+    for (const auto& [vfsPath, entry] : _visitedFiles)
+    {
+        writeString(stream, vfsPath);
+        writeString(stream, entry.key.modName);
+        writeString(stream, entry.key.archivePath);
+        writeValue(stream, entry.key.size);
+        writeValue(stream, entry.key.modificationTime);
+        writeValue(stream, entry.key.contentHash);
+
+        writeValue(stream, static_cast<std::uint32_t>(entry.blocks.size()));
+
+        for (const auto& block : entry.blocks)
+        {
+            writeString(stream, block.typeName);
+            writeString(stream, block.name);
+            writeString(stream, block.contents);
+        }
+    }
+
+    writer.commit();
+}
+
+std::size_t DeclarationCache::getNumHits() const
+{
+    return _numHits;
+}
+
+std::size_t DeclarationCache::getNumMisses() const
+{
+    return _numMisses;
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace decl
+{
+
+/**
+ * Binary cache holding the raw declaration blocks of all files
+ * visited by a single DeclarationFolderParser, such that unchanged files
+ * don't need to be tokenised again in the next session.
+ *
+ * Each file entry is keyed on the state of its source: its size and the
+ * modification time of the physical file, or of the archive containing it.
+ * A physical file with unchanged size but a new modification time is compared
+ * by a hash of its contents, such that merely touched files are still served
+ * from the cache.
+ */
+class DeclarationCache
+{
+public:
+    struct SourceKey
+    {
+        std::string modName;
+        std::string archivePath;
+        std::uint64_t size = 0;
+        std::int64_t modificationTime = 0; // of the file, or of its archive
+        std::uint64_t contentHash = 0;     // physical files only
+    };
+
+    // Block data as returned by the syntax parser, the file info is not part of it
+    struct Block
+    {
+        std::string typeName;
+        std::string name;
+        std::string contents;
+    };
+
+private:
+    struct FileEntry
+    {
+        SourceKey key;
+        std::vector<Block> blocks;
+    };
+
+    std::string _cacheFilePath;
+
+    // Entries read from the cache file, keyed by the VFS path
+    std::map<std::string, FileEntry> _cachedFiles;
+
+    // Entries of the current session, to be written back
+    std::map<std::string, FileEntry> _visitedFiles;
+
+    std::size_t _numHits;
+    std::size_t _numMisses;
+
+    // True if hits have been found by their content hash, their keys need to be written back
+    bool _keysUpdated;
+
+public:
+    DeclarationCache(const std::string& cacheFilePath);
+
+    // Reads the cache file from disk, a missing or outdated file results in an empty cache
+    void load();
+
+    // Returns the cached blocks of the given file if its source is unchanged, or nullptr.
+    // If only the modification time differs, the given function is invoked to hash the
+    // contents (if it is set) and the result is stored in the key.
+    const std::vector<Block>* find(const std::string& vfsPath, SourceKey& key,
+        const std::function<std::uint64_t()>& getContentHash);
+
+    // Stores the blocks of a visited file, to be saved by the next save() call
+    void store(const std::string& vfsPath, const SourceKey& key, std::vector<Block> blocks);
+
+    // Writes all visited files to the cache file, unless nothing changed
+    void save();
+
+    std::size_t getNumHits() const;
+    std::size_t getNumMisses() const;
+};
+
+}
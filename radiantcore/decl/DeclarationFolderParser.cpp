@@ -1,7 +1,11 @@
 #include "DeclarationFolderParser.h"
 
+#include <sstream>
+#include <fmt/format.h>
 #include "DeclarationManager.h"
 #include "parser/DefBlockSyntaxParser.h"
+#include "os/fs.h"
+#include "string/hash.h"
 #include "string/trim.h"
 
 namespace decl
@@ -9,61 +13,197 @@ namespace decl
 
 namespace
 {
-    DeclarationBlockSyntax createBlock(const parser::DefBlockSyntax& block,
-        const vfs::FileInfo& fileInfo, const std::string& modName)
+    DeclarationCache::Block createBlock(const parser::DefBlockSyntax& block)
     {
-        DeclarationBlockSyntax syntax;
+        DeclarationCache::Block result;
 
         const auto& nameSyntax = block.getName();
         const auto& typeSyntax = block.getType();
 
-        syntax.typeName = typeSyntax ? typeSyntax->getToken().value : "";
-        syntax.name = nameSyntax ? nameSyntax->getToken().value : "";
-        syntax.contents = block.getBlockContents();
-        syntax.modName = modName;
-        syntax.fileInfo = fileInfo;
+        result.typeName = typeSyntax ? typeSyntax->getToken().value : "";
+        result.name = nameSyntax ? nameSyntax->getToken().value : "";
+        result.contents = block.getBlockContents();
 
-        return syntax;
+        return result;
+    }
+
+    std::vector<DeclarationCache::Block> parseBlocks(std::istream& stream)
+    {
+        // Parse the incoming stream into syntax blocks
+        parser::DefBlockSyntaxParser<std::istream> parser(stream);
+
+        auto syntaxTree = parser.parse();
+
+        std::vector<DeclarationCache::Block> blocks;
+
+        for (const auto& node : syntaxTree->getRoot()->getChildren())
+        {
+            if (node->getType() != parser::DefSyntaxNode::Type::DeclBlock)
+            {
+                continue;
+            }
+
+            blocks.emplace_back(createBlock(static_cast<const parser::DefBlockSyntax&>(*node)));
+        }
+
+        return blocks;
+    }
+
+    std::int64_t getModificationTime(const std::string& path)
+    {
+        std::error_code ec;
+        auto time = fs::last_write_time(path, ec);
+
+        return ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
     }
 }
 
 DeclarationFolderParser::DeclarationFolderParser(DeclarationManager& owner, Type declType, 
     const std::string& baseDir, const std::string& extension,
-    const std::map<std::string, Type, string::ILess>& typeMapping) :
+    const std::map<std::string, Type, string::ILess>& typeMapping,
+    const std::string& cachePath) :
     ThreadedDeclParser<void>(declType, baseDir, extension, 1),
     _owner(owner),
     _typeMapping(typeMapping),
     _defaultDeclType(declType)
-{}
+{
+    if (!cachePath.empty())
+    {
+        // One cache file per folder and extension, several parsers might be running at the same time
+        auto fileName = fmt::format("{0}.{1:016x}.bin", getTypeName(declType),
+            string::fnv1a64(baseDir + "*." + extension));
+
+        _cache = std::make_unique<DeclarationCache>(cachePath + fileName);
+    }
+}
+
+void DeclarationFolderParser::onBeginParsing()
+{
+    _parseStartTime = std::chrono::steady_clock::now();
+
+    if (_cache)
+    {
+        _cache->load();
+    }
+}
 
 void DeclarationFolderParser::parse(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir)
 {
-    // Parse the incoming stream into syntax blocks
-    parser::DefBlockSyntaxParser<std::istream> parser(stream);
+    if (!_cache)
+    {
+        for (const auto& block : parseBlocks(stream))
+        {
+            addBlock(block, fileInfo, modDir);
+        }
+
+        return;
+    }
 
-    auto syntaxTree = parser.parse();
+    DeclarationCache::SourceKey key;
+    key.modName = modDir;
+    key.archivePath = fileInfo.getArchivePath();
+    key.size = fileInfo.getSize();
 
-    for (const auto& node : syntaxTree->getRoot()->getChildren())
+    // Files in archives are considered unchanged as long as the archive is
+    bool isPhysicalFile = fileInfo.getIsPhysicalFile();
+    auto vfsPath = fileInfo.fullPath();
+    key.modificationTime = getModificationTime(isPhysicalFile ? key.archivePath + vfsPath : key.archivePath);
+
+    // Physical files are only read up front if their timestamp changed, or if they need to be parsed
+    std::string contents;
+    bool contentsRead = false;
+
+    auto readContents = [&]()
+    {
+        if (contentsRead) return;
+
+        contents.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        contentsRead = true;
+    };
+
+    std::function<std::uint64_t()> getContentHash;
+
+    if (isPhysicalFile)
     {
-        if (node->getType() != parser::DefSyntaxNode::Type::DeclBlock)
+        getContentHash = [&]()
         {
-            continue;
+            readContents();
+            return string::fnv1a64(contents);
+        };
+    }
+
+    if (auto cachedBlocks = _cache->find(vfsPath, key, getContentHash); cachedBlocks != nullptr)
+    {
+        for (const auto& block : *cachedBlocks)
+        {
+            addBlock(block, fileInfo, modDir);
         }
 
-        const auto& blockNode = static_cast<const parser::DefBlockSyntax&>(*node);
+        _cache->store(vfsPath, key, *cachedBlocks);
+        return;
+    }
+
+    std::vector<DeclarationCache::Block> blocks;
+
+    if (isPhysicalFile)
+    {
+        // The hash is kept, to tell whether a future timestamp change is a content change
+        // (find() has calculated it already if it has read the contents)
+        if (!contentsRead)
+        {
+            key.contentHash = getContentHash();
+        }
 
-        // Convert the incoming block to a DeclarationBlockSyntax
-        auto blockSyntax = createBlock(blockNode, fileInfo, modDir);
+        std::istringstream contentStream(contents);
+        blocks = parseBlocks(contentStream);
+    }
+    else
+    {
+        blocks = parseBlocks(stream);
+    }
 
-        // Move the block in the correct bucket
-        auto declType = determineBlockType(blockSyntax);
-        auto& blockList = _parsedBlocks.try_emplace(declType).first->second;
-        blockList.emplace_back(std::move(blockSyntax));
+    for (const auto& block : blocks)
+    {
+        addBlock(block, fileInfo, modDir);
     }
+
+    _cache->store(vfsPath, key, std::move(blocks));
+}
+
+void DeclarationFolderParser::addBlock(const DeclarationCache::Block& block,
+    const vfs::FileInfo& fileInfo, const std::string& modDir)
+{
+    // Convert the incoming block to a DeclarationBlockSyntax
+    DeclarationBlockSyntax syntax;
+
+    syntax.typeName = block.typeName;
+    syntax.name = block.name;
+    syntax.contents = block.contents;
+    syntax.modName = modDir;
+    syntax.fileInfo = fileInfo;
+
+    // Move the block in the correct bucket
+    auto declType = determineBlockType(syntax);
+    auto& blockList = _parsedBlocks.try_emplace(declType).first->second;
+    blockList.emplace_back(std::move(syntax));
 }
 
 void DeclarationFolderParser::onFinishParsing()
 {
+    if (_cache)
+    {
+        _cache->save();
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - _parseStartTime);
+
+        rMessage() << "[DeclParser] " << getTypeName(_defaultDeclType) << " files: " <<
+            _cache->getNumHits() << " loaded from cache, " << _cache->getNumMisses() <<
+            " parsed, took " << elapsed.count() << " msec" << std::endl;
+
+        _owner.onParserCacheUsed(_cache->getNumHits(), _cache->getNumMisses());
+    }
+
     // Submit all parsed declarations to the decl manager
     _owner.onParserFinished(_defaultDeclType, _parsedBlocks);
 }
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include "ideclmanager.h"
 #include "DeclarationFile.h"
+#include "DeclarationCache.h"
 
 #include "parser/ThreadedDeclParser.h"
 #include "string/string.h"
@@ -31,10 +34,17 @@ private:
     // The default type to assign to untyped blocks
     Type _defaultDeclType;
 
+    // Blocks of unchanged files are loaded from here, null if caching is disabled
+    std::unique_ptr<DeclarationCache> _cache;
+    std::chrono::steady_clock::time_point _parseStartTime;
+
 public:
+    // The cache path points to the folder the parse results are cached in,
+    // an empty string disables caching
     DeclarationFolderParser(DeclarationManager& owner, Type declType,
         const std::string& baseDir, const std::string& extension,
-        const std::map<std::string, Type, string::ILess>& typeMapping);
+        const std::map<std::string, Type, string::ILess>& typeMapping,
+        const std::string& cachePath = std::string());
 
     ~DeclarationFolderParser() override
     {
@@ -43,11 +53,13 @@ public:
     }
 
 protected:
+    void onBeginParsing() override;
     void parse(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir) override;
     void onFinishParsing() override;
 
 private:
     Type determineBlockType(const DeclarationBlockSyntax& block);
+    void addBlock(const DeclarationCache::Block& block, const vfs::FileInfo& fileInfo, const std::string& modDir);
 };
 
 }
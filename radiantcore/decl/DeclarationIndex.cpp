@@ -0,0 +1,265 @@
+#include "DeclarationIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include "string/hash.h"
+
+namespace decl
+{
+
+namespace
+{
+    constexpr std::size_t MinimumNumBuckets = 64;
+
+    inline char foldCase(char c)
+    {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    inline bool equalsNoCase(const std::string& a, const std::string& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+            [](char x, char y) { return foldCase(x) == foldCase(y); });
+    }
+}
+
+const DeclarationIndex::Entry DeclarationIndex::Tombstone{ 0, std::string(), IDeclaration::Ptr() };
+
+DeclarationIndex::Table::Table(std::size_t numBuckets) :
+    mask(numBuckets - 1),
+    buckets(new std::atomic<const Entry*>[numBuckets]),
+    numOccupied(0)
+{
+    for (std::size_t i = 0; i < numBuckets; ++i)
+    {
+        buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+DeclarationIndex::DeclarationIndex() :
+    _table(nullptr),
+    _epoch(0),
+    _activeReaders{ 0, 0 }
+{
+    clear();
+}
+
+IDeclaration::Ptr DeclarationIndex::find(const std::string& name) const
+{
+    auto hash = GetHash(name);
+
+    // Announce this reader before picking up the table, writers won't release
+    // objects retired in this epoch as long as we're active. Retry if the epoch
+    // changed in between, the writer might have missed us.
+    std::atomic<std::size_t>* activeReaders;
+
+    while (true)
+    {
+        auto epoch = _epoch.load();
+
+        activeReaders = &_activeReaders[epoch & 1];
+        activeReaders->fetch_add(1);
+
+        if (_epoch.load() == epoch) break;
+
+        activeReaders->fetch_sub(1);
+    }
+
+    IDeclaration::Ptr result;
+
+    if (auto entry = FindEntry(*_table.load(), name, hash); entry != nullptr)
+    {
+        result = entry->decl;
+    }
+
+    activeReaders->fetch_sub(1);
+
+    return result;
+}
+
+void DeclarationIndex::insert(const std::string& name, const IDeclaration::Ptr& decl)
+{
+    auto hash = GetHash(name);
+    auto entry = std::make_unique<Entry>(Entry{ hash, name, decl });
+
+    auto existing = FindBucket(*_currentTable, name, hash);
+
+    if (existing <= _currentTable->mask)
+    {
+        // Replace the entry, the previous one is retired
+        auto previous = _currentTable->buckets[existing].load();
+        _currentTable->buckets[existing].store(entry.get());
+
+        retireEntry(previous);
+        _entries.emplace(entry.get(), std::move(entry));
+
+        releaseRetiredObjects();
+        return;
+    }
+
+    // Keep the load factor below 50%, lookups rely on finding an empty bucket
+    if ((_currentTable->numOccupied + 1) * 2 > _currentTable->mask + 1)
+    {
+        rebuild(std::max(MinimumNumBuckets, (_entries.size() + 1) * 4));
+    }
+
+    auto& table = *_currentTable;
+
+    // Take the first free bucket or tombstone, the name is not in the table
+    for (auto i = static_cast<std::size_t>(hash & table.mask); ; i = (i + 1) & table.mask)
+    {
+        auto candidate = table.buckets[i].load();
+
+        if (candidate == nullptr || candidate == &Tombstone)
+        {
+            if (candidate == nullptr)
+            {
+                ++table.numOccupied;
+            }
+
+            table.buckets[i].store(entry.get());
+            break;
+        }
+    }
+
+    _entries.emplace(entry.get(), std::move(entry));
+
+    releaseRetiredObjects();
+}
+
+void DeclarationIndex::remove(const std::string& name)
+{
+    auto bucket = FindBucket(*_currentTable, name, GetHash(name));
+
+    if (bucket > _currentTable->mask) return;
+
+    auto previous = _currentTable->buckets[bucket].load();
+    _currentTable->buckets[bucket].store(&Tombstone);
+
+    retireEntry(previous);
+
+    releaseRetiredObjects();
+}
+
+void DeclarationIndex::clear()
+{
+    _currentTable = std::make_unique<Table>(MinimumNumBuckets);
+    _table.store(_currentTable.get());
+
+    _entries.clear();
+    _retired.clear();
+    _retiredInPreviousEpoch.clear();
+}
+
+std::uint64_t DeclarationIndex::GetHash(const std::string& name)
+{
+    // FNV-1a on the case-folded characters
+    auto hash = string::FNV1A_64_OFFSET_BASIS;
+
+    for (auto c : name)
+    {
+        hash = string::fnv1a64(hash, static_cast<unsigned char>(foldCase(c)));
+    }
+
+    return hash;
+}
+
+const DeclarationIndex::Entry* DeclarationIndex::FindEntry(const Table& table, const std::string& name, std::uint64_t hash)
+{
+    for (auto i = static_cast<std::size_t>(hash & table.mask); ; i = (i + 1) & table.mask)
+    {
+        auto entry = table.buckets[i].load();
+
+        if (entry == nullptr) return nullptr;
+
+        if (entry != &Tombstone && entry->hash == hash && equalsNoCase(entry->name, name))
+        {
+            return entry;
+        }
+    }
+}
+
+std::size_t DeclarationIndex::FindBucket(const Table& table, const std::string& name, std::uint64_t hash)
+{
+    for (auto i = static_cast<std::size_t>(hash & table.mask); ; i = (i + 1) & table.mask)
+    {
+        auto entry = table.buckets[i].load();
+
+        if (entry == nullptr) return table.mask + 1;
+
+        if (entry != &Tombstone && entry->hash == hash && equalsNoCase(entry->name, name))
+        {
+            return i;
+        }
+    }
+}
+
+void DeclarationIndex::rebuild(std::size_t numBuckets)
+{
+    // Round up to the next power of two
+    std::size_t size = MinimumNumBuckets;
+
+    while (size < numBuckets)
+    {
+        size <<= 1;
+    }
+
+    auto table = std::make_unique<Table>(size);
+
+    // The table is not published yet, no need to care about tombstones or readers
+    for (const auto& [_, entry] : _entries)
+    {
+        auto i = static_cast<std::size_t>(entry->hash & table->mask);
+
+        while (table->buckets[i].load(std::memory_order_relaxed) != nullptr)
+        {
+            i = (i + 1) & table->mask;
+        }
+
+        table->buckets[i].store(entry.get(), std::memory_order_relaxed);
+        ++table->numOccupied;
+    }
+
+    // Publish the new table, readers might still be probing the old one
+    _table.store(table.get());
+
+    _retired.tables.emplace_back(std::move(_currentTable));
+    _currentTable = std::move(table);
+}
+
+void DeclarationIndex::retireEntry(const Entry* entry)
+{
+    auto owned = _entries.find(entry);
+
+    _retired.entries.emplace_back(std::move(owned->second));
+    _entries.erase(owned);
+}
+
+void DeclarationIndex::releaseRetiredObjects()
+{
+    auto epoch = _epoch.load();
+
+    // The batch of the previous epoch can go once the readers that arrived
+    // before the epoch was changed have left
+    if (!_retiredInPreviousEpoch.empty())
+    {
+        if (_activeReaders[(epoch - 1) & 1].load() != 0) return;
+
+        _retiredInPreviousEpoch.clear();
+    }
+
+    if (_retired.empty()) return;
+
+    // The retired objects are unreachable from the published table, only readers
+    // registered in the current epoch could still see them. Move on to the next
+    // epoch, any reader arriving from now on is counted separately.
+    std::swap(_retired, _retiredInPreviousEpoch);
+    _epoch.store(epoch + 1);
+
+    if (_activeReaders[epoch & 1].load() == 0)
+    {
+        _retiredInPreviousEpoch.clear();
+    }
+}
+
+}
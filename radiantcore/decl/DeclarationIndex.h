@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ideclmanager.h"
+
+namespace decl
+{
+
+/**
+ * Read-mostly hash index of the declarations of a single type,
+ * keyed by their case-folded name.
+ *
+ * Lookups don't acquire any lock, they probe the currently published
+ * table which is never modified in a way that could invalidate a running
+ * lookup. Writers add entries to free buckets, mark removed entries with
+ * a tombstone and publish a rebuilt table once the current one is getting full.
+ *
+ * Replaced tables and removed entries are retired and released once all
+ * readers which might have seen them have left. Readers register with the
+ * counter of the epoch they arrived in. Writers collect the retired objects,
+ * then move on to the next epoch: the collected batch is released as soon
+ * as the counter of the previous epoch drops to zero, readers arriving later
+ * don't hold it back.
+ *
+ * Write access (insert, remove, clear) needs to be serialised by the caller.
+ */
+class DeclarationIndex
+{
+private:
+    struct Entry
+    {
+        std::uint64_t hash;
+        std::string name;
+        IDeclaration::Ptr decl;
+    };
+
+    struct Table
+    {
+        std::size_t mask;
+        std::unique_ptr<std::atomic<const Entry*>[]> buckets;
+
+        // Number of buckets occupied by entries or tombstones
+        std::size_t numOccupied;
+
+        Table(std::size_t numBuckets);
+    };
+
+    // Marks removed entries, lookups need to probe past them
+    static const Entry Tombstone;
+
+    std::atomic<const Table*> _table;
+
+    // Lookups register with the counter of the current epoch (even or odd)
+    std::atomic<std::size_t> _epoch;
+    mutable std::atomic<std::size_t> _activeReaders[2];
+
+    // Owning storage of the published table and the reachable entries, keyed by address
+    std::unique_ptr<Table> _currentTable;
+    std::unordered_map<const Entry*, std::unique_ptr<Entry>> _entries;
+
+    struct RetiredObjects
+    {
+        std::vector<std::unique_ptr<Table>> tables;
+        std::vector<std::unique_ptr<Entry>> entries;
+
+        bool empty() const
+        {
+            return tables.empty() && entries.empty();
+        }
+
+        void clear()
+        {
+            tables.clear();
+            entries.clear();
+        }
+    };
+
+    // Objects retired in the current epoch
+    RetiredObjects _retired;
+
+    // Objects retired in the previous epoch, waiting for its readers to leave
+    RetiredObjects _retiredInPreviousEpoch;
+
+public:
+    DeclarationIndex();
+
+    DeclarationIndex(const DeclarationIndex& other) = delete;
+    DeclarationIndex& operator=(const DeclarationIndex& other) = delete;
+
+    // Returns the declaration with the given name (case-insensitively), or an empty pointer
+    IDeclaration::Ptr find(const std::string& name) const;
+
+    // Associates the given name with the declaration, replacing any previous entry
+    void insert(const std::string& name, const IDeclaration::Ptr& decl);
+
+    // Removes the entry of the given name, if present
+    void remove(const std::string& name);
+
+    // Removes all entries, must not be called while lookups are running
+    void clear();
+
+private:
+    static std::uint64_t GetHash(const std::string& name);
+
+    // Returns the entry of the given name in the given table, or nullptr if not found
+    static const Entry* FindEntry(const Table& table, const std::string& name, std::uint64_t hash);
+
+    // Returns the bucket index holding the given name, or the table size if not found
+    static std::size_t FindBucket(const Table& table, const std::string& name, std::uint64_t hash);
+
+    void rebuild(std::size_t numBuckets);
+
+    // Moves the owned entry to the retired objects
+    void retireEntry(const Entry* entry);
+
+    void releaseRetiredObjects();
+};
+
+}
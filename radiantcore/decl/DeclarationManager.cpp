@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <future>
 #include <fstream>
 
@@ -68,8 +69,12 @@ void DeclarationManager::registerDeclFolder(Type defaultType, const std::string&
     std::lock_guard declLock(_declarationAndCreatorLock);
     auto& decls = _declarationsByType.try_emplace(defaultType, Declarations()).first->second;
 
+    // Lookups need to wait for this parser from now on
+    _parsersPending = true;
+
     // Start the parser thread
-    decls.parser = std::make_unique<DeclarationFolderParser>(*this, defaultType, vfsPath, extension, getTypenameMapping());
+    decls.parser = std::make_unique<DeclarationFolderParser>(*this, defaultType, vfsPath, extension,
+        getTypenameMapping(), _cachePath);
     decls.parser->start();
 }
 
@@ -89,6 +94,13 @@ std::map<std::string, Type, string::ILess> DeclarationManager::getTypenameMappin
 
 IDeclaration::Ptr DeclarationManager::findDeclaration(Type type, const std::string& name)
 {
+    // Try the lock-free path first
+    if (auto index = getDeclarationIndex(type); index != nullptr)
+    {
+        waitForTypedParsersToFinish();
+        return index->find(name);
+    }
+
     IDeclaration::Ptr returnValue;
 
     doWithDeclarationLock(type, [&](NamedDeclarations& decls)
@@ -106,6 +118,12 @@ IDeclaration::Ptr DeclarationManager::findDeclaration(Type type, const std::stri
 
 IDeclaration::Ptr DeclarationManager::findOrCreateDeclaration(Type type, const std::string& name)
 {
+    // Existing declarations can be looked up without locking
+    if (auto existing = findDeclaration(type, name); existing)
+    {
+        return existing;
+    }
+
     IDeclaration::Ptr returnValue;
 
     doWithDeclarationLock(type, [&](NamedDeclarations& decls)
@@ -173,6 +191,14 @@ void DeclarationManager::doWithDeclarationLock(Type type, const std::function<vo
     action(decls->second.decls);
 }
 
+DeclarationIndex* DeclarationManager::getDeclarationIndex(Type type)
+{
+    auto typeIndex = static_cast<std::size_t>(type);
+
+    // Undetermined and None are converted to very large numbers here
+    return typeIndex < NumIndexedTypes ? &_declarationIndices[typeIndex] : nullptr;
+}
+
 void DeclarationManager::reloadDeclarations()
 {
     // Don't allow reloadDecls to be run before the startup phase is complete
@@ -257,6 +283,9 @@ void DeclarationManager::reloadDeclarations()
 
 void DeclarationManager::waitForTypedParsersToFinish()
 {
+    // Once all parsers are done, there's no need to acquire any lock
+    if (!_parsersPending) return;
+
     {
         // Acquire the lock to modify the cleanup tasks list
         std::lock_guard declLock(_declarationAndCreatorLock);
@@ -287,6 +316,22 @@ void DeclarationManager::waitForTypedParsersToFinish()
 
     // Let all running tasks finish
     waitForCleanupTasksToFinish();
+
+    // Reset the flag unless a new parser has been started in the meantime
+    std::lock_guard declLock(_declarationAndCreatorLock);
+
+    auto parserRunning = std::any_of(_declarationsByType.begin(), _declarationsByType.end(),
+        [](const auto& pair) { return static_cast<bool>(pair.second.parser); });
+
+    auto cleanupRunning = std::any_of(_parserCleanupTasks.begin(), _parserCleanupTasks.end(), [](const auto& task)
+    {
+        return task && task->valid() && task->wait_for(std::chrono::milliseconds(0)) != std::future_status::ready;
+    });
+
+    if (!parserRunning && !cleanupRunning)
+    {
+        _parsersPending = false;
+    }
 }
 
 void DeclarationManager::waitForCleanupTasksToFinish()
@@ -363,7 +408,8 @@ void DeclarationManager::runParsersForAllFolders()
         for (const auto& folder : _registeredFolders)
         {
             auto& parser = parsers.emplace_back(
-                std::make_unique<DeclarationFolderParser>(*this, folder.defaultType, folder.folder, folder.extension, typeMapping)
+                std::make_unique<DeclarationFolderParser>(*this, folder.defaultType, folder.folder,
+                    folder.extension, typeMapping, _cachePath)
             );
             parser->start();
         }
@@ -399,6 +445,11 @@ void DeclarationManager::removeDeclaration(Type type, const std::string& name)
             syntax.fileInfo = vfs::FileInfo();
             decl->second->setBlockSyntax(syntax);
 
+            if (auto index = getDeclarationIndex(type); index != nullptr)
+            {
+                index->remove(decl->first);
+            }
+
             decls.erase(decl);
 
             signal_DeclRemoved().emit(type, name);
@@ -567,6 +618,12 @@ bool DeclarationManager::renameDeclaration(Type type, const std::string& oldName
 
         decl = decls.insert(std::move(extracted)).position;
 
+        if (auto index = getDeclarationIndex(type); index != nullptr)
+        {
+            index->remove(oldName);
+            index->insert(newName, decl->second);
+        }
+
         // Store the new in the decl itself
         decl->second->setDeclName(newName);
 
@@ -738,6 +795,22 @@ void DeclarationManager::emitDeclsReloadedSignal(Type type)
     signal_DeclsReloaded(type).emit();
 }
 
+std::size_t DeclarationManager::getNumCacheHits() const
+{
+    return _numCacheHits;
+}
+
+std::size_t DeclarationManager::getNumCacheMisses() const
+{
+    return _numCacheMisses;
+}
+
+void DeclarationManager::onParserCacheUsed(std::size_t numHits, std::size_t numMisses)
+{
+    _numCacheHits += numHits;
+    _numCacheMisses += numMisses;
+}
+
 void DeclarationManager::onParserFinished(Type parserType, ParseResult& parsedBlocks)
 {
     if (_reparseInProgress)
@@ -872,6 +945,11 @@ const IDeclaration::Ptr& DeclarationManager::createOrUpdateDeclaration(Type type
     {
         auto creator = _creatorsByType.at(type);
         existing = map.emplace(block.name, creator->createDeclaration(block.name)).first;
+
+        if (auto index = getDeclarationIndex(type); index != nullptr)
+        {
+            index->insert(block.name, existing->second);
+        }
     }
     else if (existing->second->getParseStamp() == _parseStamp)
     {
@@ -970,6 +1048,8 @@ void DeclarationManager::initialiseModule(const IApplicationContext& ctx)
     GlobalCommandSystem().addCommand("ReloadDecls",
         std::bind(&DeclarationManager::reloadDeclsCmd, this, std::placeholders::_1));
 
+    _cachePath = ctx.getCacheDataPath() + "decls/";
+
     // After the initial parsing, all decls will have a parseStamp of 0
     _parseStamp = 0;
     _reparseInProgress = false;
@@ -999,6 +1079,13 @@ void DeclarationManager::shutdownModule()
     _registeredFolders.clear();
     _unrecognisedBlocks.clear();
     _declarationsByType.clear();
+    _parsersPending = false;
+
+    for (auto& index : _declarationIndices)
+    {
+        index.clear();
+    }
+
     _creatorsByTypename.clear();
     _declsReloadingSignals.clear();
     _declsReloadedSignals.clear();
@@ -2,6 +2,8 @@
 
 #include "ideclmanager.h"
 #include "icommandsystem.h"
+#include <array>
+#include <atomic>
 #include <map>
 #include <vector>
 #include <memory>
@@ -10,6 +12,7 @@
 
 #include "DeclarationFile.h"
 #include "DeclarationFolderParser.h"
+#include "DeclarationIndex.h"
 
 namespace decl
 {
@@ -53,6 +56,14 @@ private:
     // One entry for each decl
     std::map<Type, Declarations> _declarationsByType;
 
+    // Lock-free lookup structures mirroring the decls in _declarationsByType,
+    // one for each type. Modifications require the _declarationAndCreatorLock.
+    static constexpr std::size_t NumIndexedTypes = static_cast<std::size_t>(Type::TestDecl2) + 1;
+    std::array<DeclarationIndex, NumIndexedTypes> _declarationIndices;
+
+    // True while any of the folder parsers might still be delivering results
+    std::atomic<bool> _parsersPending{ false };
+
     std::list<DeclarationBlockSyntax> _unrecognisedBlocks;
     std::recursive_mutex _unrecognisedBlockLock;
 
@@ -73,6 +84,11 @@ private:
 
     sigc::connection _vfsInitialisedConn;
 
+    // Folder the parsers are caching their results in
+    std::string _cachePath;
+    std::atomic<std::size_t> _numCacheHits{ 0 };
+    std::atomic<std::size_t> _numCacheMisses{ 0 };
+
     // Access allowed if the _declarationAndCreatorLock is owned
     std::vector<std::shared_ptr<std::shared_future<void>>> _parserCleanupTasks;
 
@@ -89,6 +105,8 @@ public:
     sigc::signal<void(Type, const std::string&)>& signal_DeclCreated() override;
     sigc::signal<void(Type, const std::string&)>& signal_DeclRemoved() override;
     void reloadDeclarations() override;
+    std::size_t getNumCacheHits() const override;
+    std::size_t getNumCacheMisses() const override;
     bool renameDeclaration(Type type, const std::string& oldName, const std::string& newName) override;
     void removeDeclaration(Type type, const std::string& name) override;
     void saveDeclaration(const IDeclaration::Ptr& decl) override;
@@ -101,6 +119,9 @@ public:
     // Invoked once a parser thread has finished
     void onParserFinished(Type parserType, ParseResult& parsedBlocks);
 
+    // Invoked by the parsers right before they finish, to accumulate the cache statistics
+    void onParserCacheUsed(std::size_t numHits, std::size_t numMisses);
+
 private:
     void processParseResult(Type parserType, ParseResult& parsedBlocks);
     void runParsersForAllFolders();
@@ -118,6 +139,9 @@ private:
     // Requires the creatorsMutex and the declarationMutex to be locked
     const IDeclaration::Ptr& createOrUpdateDeclaration(Type type, const DeclarationBlockSyntax& block);
     void doWithDeclarationLock(Type type, const std::function<void(NamedDeclarations&)>& action);
+
+    // Returns the lookup index for the given type, or nullptr if this type is not indexed
+    DeclarationIndex* getDeclarationIndex(Type type);
     void handleUnrecognisedBlocks();
     void reloadDeclsCmd(const cmd::ArgumentList& args);
 
@@ -4,6 +4,7 @@
 #include "../curve/CurveControlPointFunctors.h"
 
 #include "Translatable.h"
+#include "scene/NodeArena.h"
 
 namespace entity
 {
@@ -57,7 +58,7 @@ StaticGeometryNode::StaticGeometryNode(const StaticGeometryNode& other) :
 
 StaticGeometryNode::Ptr StaticGeometryNode::Create(const IEntityClassPtr& eclass)
 {
-	StaticGeometryNode::Ptr instance(new StaticGeometryNode(eclass));
+	auto instance = scene::makeArenaShared<StaticGeometryNode>(eclass);
 	instance->construct();
 
 	return instance;
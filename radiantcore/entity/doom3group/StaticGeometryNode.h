@@ -75,9 +75,11 @@ class StaticGeometryNode :
     RenderableCurveVertices _catmullRomVertices;
     RenderableVertex _renderableOriginVertex;
 
-private:
-	// Constructor
+public:
+	// Constructor, use Create() to get a fully constructed node
 	StaticGeometryNode(const IEntityClassPtr& eclass);
+
+private:
 	// Private copy constructor, is invoked by clone()
 	StaticGeometryNode(const StaticGeometryNode& other);
 
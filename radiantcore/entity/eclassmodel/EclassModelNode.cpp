@@ -1,6 +1,7 @@
 #include "EclassModelNode.h"
 
 #include <functional>
+#include "scene/NodeArena.h"
 
 namespace entity {
 
@@ -35,7 +36,7 @@ EclassModelNode::~EclassModelNode()
 
 EclassModelNodePtr EclassModelNode::Create(const IEntityClassPtr& eclass)
 {
-	EclassModelNodePtr instance(new EclassModelNode(eclass));
+	auto instance = scene::makeArenaShared<EclassModelNode>(eclass);
 	instance->construct();
 
 	return instance;
@@ -49,9 +49,11 @@ private:
 
     bool _noShadowsLit;
 
-private:
-	// Constructor
+public:
+	// Constructor, use Create() to get a fully constructed node
 	EclassModelNode(const IEntityClassPtr& eclass);
+
+private:
 	// Copy Constructor
 	EclassModelNode(const EclassModelNode& other);
 
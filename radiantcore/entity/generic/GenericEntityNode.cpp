@@ -2,6 +2,7 @@
 #include "../EntitySettings.h"
 
 #include "math/Frustum.h"
+#include "scene/NodeArena.h"
 
 namespace entity
 {
@@ -35,7 +36,7 @@ GenericEntityNode::GenericEntityNode(const GenericEntityNode& other) :
 
 std::shared_ptr<GenericEntityNode> GenericEntityNode::Create(const IEntityClassPtr& eclass)
 {
-	auto instance = std::make_shared<GenericEntityNode>(eclass);
+	auto instance = scene::makeArenaShared<GenericEntityNode>(eclass);
 	instance->construct();
 
 	return instance;
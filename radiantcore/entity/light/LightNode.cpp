@@ -7,6 +7,7 @@
 #include <functional>
 
 #include "registry/CachedKey.h"
+#include "scene/NodeArena.h"
 
 namespace entity {
 
@@ -57,7 +58,7 @@ LightNode::LightNode(const LightNode& other)
 
 LightNodePtr LightNode::Create(const IEntityClassPtr& eclass)
 {
-	LightNodePtr instance(new LightNode(eclass));
+	auto instance = scene::makeArenaShared<LightNode>(eclass);
 	instance->construct();
 
 	return instance;
@@ -15,6 +15,7 @@
 #include "os/path.h"
 #include "DirectoryArchiveFile.h"
 #include "module/StaticModule.h"
+#include "util/ParallelFor.h"
 
 namespace image
 {
@@ -23,6 +24,10 @@ namespace
 {
     // Registry key holding texture types
     const char* const GKEY_IMAGE_TYPES = "/filetypes/texture//extension";
+
+    // Decoding a single image is enough work to hand it to a pool worker of its own.
+    // The decoders' own parallel loops (e.g. DXT decompression) run inline on those workers.
+    constexpr std::size_t PARALLEL_DECODE_MIN_IMAGES = 1;
 }
 
 void ImageLoader::addLoaderToMap(const ImageTypeLoader::Ptr& loader)
@@ -53,8 +58,7 @@ ImageLoader::ImageLoader()
     addLoaderToMap(std::make_shared<DDSLoader>());
 }
 
-// Load image from VFS
-ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
+bool ImageLoader::findImageInVFS(const std::string& rawName, const FileFunctor& functor) const
 {
     // Replace backslashes with forward slashes and strip of
     // the file extension of the provided token, and store
@@ -87,42 +91,117 @@ ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
         {
 			// Try to invoke the imageloader with a reference to the
 			// ArchiveFile
-			return ldr.load(*file);
+			functor(ldr, *file, fullName);
+			return true;
 		}
 	}
 
     // File not found
-	return ImagePtr();
+	return false;
 }
 
-ImagePtr ImageLoader::imageFromFile(const std::string& filename) const
+bool ImageLoader::openImageFile(const std::string& filename, const FileFunctor& functor) const
 {
-    ImagePtr image;
-
     // Construct a DirectoryArchiveFile out of the filename
     auto file = std::make_shared<archive::DirectoryArchiveFile>(filename, filename);
 
-    if (!file->failed())
+    if (file->failed())
     {
-        const std::string ext = string::to_lower_copy(
-            os::getExtension(filename)
-        );
+        return false;
+    }
 
-        auto loaderIter = _loadersByExtension.find(ext);
-        if (loaderIter != _loadersByExtension.end())
-        {
-            image = loaderIter->second->load(*file);
-        }
-        else
-        {
-            rWarning() << "Doom3ImageLoader: no loader found for image "
-                       << filename << std::endl;
-        }
+    const std::string ext = string::to_lower_copy(
+        os::getExtension(filename)
+    );
+
+    auto loaderIter = _loadersByExtension.find(ext);
+    if (loaderIter == _loadersByExtension.end())
+    {
+        rWarning() << "Doom3ImageLoader: no loader found for image "
+                   << filename << std::endl;
+        return false;
     }
 
+    functor(*loaderIter->second, *file, filename);
+    return true;
+}
+
+// Load image from VFS
+ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
+{
+    ImagePtr image;
+
+    findImageInVFS(rawName, [&](const ImageTypeLoader& loader, ArchiveFile& file, const std::string&)
+    {
+        image = loader.load(file);
+    });
+
     return image;
 }
 
+ImagePtr ImageLoader::imageFromFile(const std::string& filename) const
+{
+    ImagePtr image;
+
+    openImageFile(filename, [&](const ImageTypeLoader& loader, ArchiveFile& file, const std::string&)
+    {
+        image = loader.load(file);
+    });
+
+    return image;
+}
+
+ImageThumbnail ImageLoader::thumbnailFromVFS(const std::string& rawName, std::size_t minSize) const
+{
+    ImageThumbnail thumbnail;
+
+    findImageInVFS(rawName, [&](const ImageTypeLoader& loader, ArchiveFile& file, const std::string& fullName)
+    {
+        thumbnail = loader.loadThumbnail(file, minSize);
+        thumbnail.sourceFile = fullName;
+    });
+
+    return thumbnail;
+}
+
+ImageThumbnail ImageLoader::thumbnailFromFile(const std::string& filename, std::size_t minSize) const
+{
+    ImageThumbnail thumbnail;
+
+    openImageFile(filename, [&](const ImageTypeLoader& loader, ArchiveFile& file, const std::string& fullName)
+    {
+        thumbnail = loader.loadThumbnail(file, minSize);
+        thumbnail.sourceFile = fullName;
+    });
+
+    return thumbnail;
+}
+
+std::vector<ImagePtr> ImageLoader::imagesFromVFS(const std::vector<std::string>& vfsPaths) const
+{
+    std::vector<ImagePtr> images(vfsPaths.size());
+
+    util::parallelFor(vfsPaths.size(), PARALLEL_DECODE_MIN_IMAGES, [&](std::size_t i)
+    {
+        images[i] = imageFromVFS(vfsPaths[i]);
+    });
+
+    return images;
+}
+
+std::vector<ImageThumbnail> ImageLoader::thumbnailsFromVFS(const std::vector<std::string>& vfsPaths,
+    std::size_t minSize) const
+{
+    std::vector<ImageThumbnail> thumbnails(vfsPaths.size());
+
+    util::parallelFor(vfsPaths.size(), PARALLEL_DECODE_MIN_IMAGES, [&](std::size_t i)
+    {
+        thumbnails[i] = thumbnailFromVFS(vfsPaths[i], minSize);
+    });
+
+    return thumbnails;
+}
+
 const std::string& ImageLoader::getName() const
 {
     static std::string _name(MODULE_IMAGELOADER);
@@ -4,6 +4,7 @@
 #include "ImageTypeLoader.h"
 
 #include <map>
+#include <functional>
 
 namespace image
 {
@@ -23,6 +24,15 @@ private:
 private:
     void addLoaderToMap(const ImageTypeLoader::Ptr& loader);
 
+    using FileFunctor = std::function<void(const ImageTypeLoader&, ArchiveFile&, const std::string&)>;
+
+    // Locates the image in the VFS trying all known extensions and invokes the functor
+    // with the matching loader, the opened file and its full name. Returns false if nothing was found.
+    bool findImageInVFS(const std::string& rawName, const FileFunctor& functor) const;
+
+    // Opens the given image file and invokes the functor if there is a loader for its type
+    bool openImageFile(const std::string& filename, const FileFunctor& functor) const;
+
 public:
 
     // Construct and initialise loaders
@@ -31,6 +41,11 @@ public:
     // ImageLoader implementation
     ImagePtr imageFromVFS(const std::string& vfsPath) const override;
 	ImagePtr imageFromFile(const std::string& filename) const override;
+    ImageThumbnail thumbnailFromVFS(const std::string& vfsPath, std::size_t minSize) const override;
+    ImageThumbnail thumbnailFromFile(const std::string& filename, std::size_t minSize) const override;
+    std::vector<ImagePtr> imagesFromVFS(const std::vector<std::string>& vfsPaths) const override;
+    std::vector<ImageThumbnail> thumbnailsFromVFS(const std::vector<std::string>& vfsPaths,
+        std::size_t minSize) const override;
 
     // RegisterableModule implementation
     const std::string& getName() const override;
@@ -0,0 +1,88 @@
+#include "ImageReduction.h"
+
+#include <algorithm>
+
+namespace image
+{
+
+std::size_t getReductionFactor(std::size_t width, std::size_t height, std::size_t minSize)
+{
+    auto largerSide = std::max(width, height);
+    std::size_t factor = 1;
+
+    while (minSize > 0 && largerSide / (factor * 2) >= minSize)
+    {
+        factor *= 2;
+    }
+
+    return factor;
+}
+
+RGBAImagePtr reduceImage(const RGBAPixel* pixels, std::size_t width, std::size_t height, std::size_t factor)
+{
+    auto targetWidth = std::max<std::size_t>(width / factor, 1);
+    auto targetHeight = std::max<std::size_t>(height / factor, 1);
+
+    auto result = std::make_shared<RGBAImage>(targetWidth, targetHeight);
+
+    for (std::size_t y = 0; y < targetHeight; ++y)
+    {
+        // Blocks are clamped to the source, in case a side is shorter than the factor
+        auto y0 = y * factor;
+        auto y1 = std::min(y0 + factor, height);
+
+        for (std::size_t x = 0; x < targetWidth; ++x)
+        {
+            auto x0 = x * factor;
+            auto x1 = std::min(x0 + factor, width);
+
+            std::size_t red = 0, green = 0, blue = 0, alpha = 0;
+
+            for (auto sy = y0; sy < y1; ++sy)
+            {
+                const auto* row = pixels + sy * width;
+
+                for (auto sx = x0; sx < x1; ++sx)
+                {
+                    red += row[sx].red;
+                    green += row[sx].green;
+                    blue += row[sx].blue;
+                    alpha += row[sx].alpha;
+                }
+            }
+
+            auto count = (y1 - y0) * (x1 - x0);
+            auto& target = result->pixels[y * targetWidth + x];
+
+            target.red = static_cast<uint8_t>(red / count);
+            target.green = static_cast<uint8_t>(green / count);
+            target.blue = static_cast<uint8_t>(blue / count);
+            target.alpha = static_cast<uint8_t>(alpha / count);
+        }
+    }
+
+    return result;
+}
+
+ImageThumbnail createThumbnail(const ImagePtr& image, std::size_t minSize)
+{
+    ImageThumbnail thumbnail;
+
+    if (!image || image->isPrecompressed() || image->getGLFormat() != GL_RGBA)
+    {
+        return thumbnail;
+    }
+
+    thumbnail.sourceWidth = image->getWidth();
+    thumbnail.sourceHeight = image->getHeight();
+
+    auto factor = getReductionFactor(thumbnail.sourceWidth, thumbnail.sourceHeight, minSize);
+
+    thumbnail.image = factor == 1 ? image : reduceImage(
+        reinterpret_cast<const RGBAPixel*>(image->getPixels()),
+        thumbnail.sourceWidth, thumbnail.sourceHeight, factor);
+
+    return thumbnail;
+}
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "iimage.h"
+#include "RGBAImage.h"
+
+namespace image
+{
+
+/**
+ * Returns the largest power-of-two factor the given dimensions can be divided by
+ * while keeping the larger side at or above minSize. Returns 1 for images
+ * which are already smaller than that.
+ */
+std::size_t getReductionFactor(std::size_t width, std::size_t height, std::size_t minSize);
+
+/**
+ * Returns a copy of the given RGBA pixels, reduced by the given power-of-two
+ * factor. Each target pixel is the average of the corresponding source block.
+ */
+RGBAImagePtr reduceImage(const RGBAPixel* pixels, std::size_t width, std::size_t height, std::size_t factor);
+
+/**
+ * Creates a thumbnail of the given uncompressed RGBA image, reduced such that
+ * its larger side is not smaller than minSize. Returns an empty thumbnail
+ * for images in any other format.
+ */
+ImageThumbnail createThumbnail(const ImagePtr& image, std::size_t minSize);
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "iimage.h"
+#include "ImageReduction.h"
 
 namespace image
 {
@@ -17,6 +18,18 @@ public:
 	 */
 	virtual ImagePtr load(ArchiveFile& file) const = 0;
 
+    /**
+     * \brief
+     * Load a reduced version of the image in the given file, whose larger
+     * side is not smaller than minSize. The default implementation loads the
+     * full image and reduces it, loaders able to decode smaller versions
+     * directly should override this.
+     */
+    virtual ImageThumbnail loadThumbnail(ArchiveFile& file, std::size_t minSize) const
+    {
+        return createThumbnail(load(file), minSize);
+    }
+
     typedef std::list<std::string> Extensions;
 
     /**
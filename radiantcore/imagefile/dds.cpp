@@ -210,27 +210,15 @@ static const std::map<int, GLenum> GL_FMT_FOR_BITDEPTH
     { 32, GL_BGRA }
 };
 
-DDSImagePtr LoadDDSFromStream(InputStream& stream)
+// Calculates the layout of all mipmaps of the given image, returns the total size in bytes
+std::size_t GetMipMapInfo(const DDSHeader& header, MipMapInfoList& mipMapInfo)
 {
-    // Load the header
-    typedef StreamBase::byte_type byteType;
-    DDSHeader header;
-    stream.read(reinterpret_cast<byteType*>(&header), sizeof(header));
-
-    // Reject any invalid DDS structure
-    if (!header.isValid())
-    {
-        rError() << "Invalid DDS header" << std::endl;
-        return {};
-    }
-
     // Extract basic metadata: width, height, format and mipmap count
     int width = header.getWidth(), height = header.getHeight();
     std::string compressionFormat = header.getCompressionFormat();
     int bitDepth = header.getRGBBits();
     std::size_t mipMapCount = header.getMipMapCount();
 
-    MipMapInfoList mipMapInfo;
     mipMapInfo.resize(mipMapCount);
 
     // Calculate the total memory requirements (greebo: DXT1 has 8 bytes per block)
@@ -267,6 +255,29 @@ DDSImagePtr LoadDDSFromStream(InputStream& stream)
         height = std::max(height/2, 1);
     }
 
+    return size;
+}
+
+DDSImagePtr LoadDDSFromStream(InputStream& stream)
+{
+    // Load the header
+    typedef StreamBase::byte_type byteType;
+    DDSHeader header;
+    stream.read(reinterpret_cast<byteType*>(&header), sizeof(header));
+
+    // Reject any invalid DDS structure
+    if (!header.isValid())
+    {
+        rError() << "Invalid DDS header" << std::endl;
+        return {};
+    }
+
+    std::string compressionFormat = header.getCompressionFormat();
+    int bitDepth = header.getRGBBits();
+
+    MipMapInfoList mipMapInfo;
+    auto size = GetMipMapInfo(header, mipMapInfo);
+
     // Allocate a new DDS image with that size
     DDSImagePtr image(new DDSImage(size));
 
@@ -299,6 +310,113 @@ DDSImagePtr LoadDDSFromStream(InputStream& stream)
     return image;
 }
 
+ImageThumbnail LoadDDSThumbnailFromStream(InputStream& stream, std::size_t minSize)
+{
+    typedef StreamBase::byte_type byteType;
+    DDSHeader header;
+    stream.read(reinterpret_cast<byteType*>(&header), sizeof(header));
+
+    if (!header.isValid())
+    {
+        return {};
+    }
+
+    std::string compressionFormat = header.getCompressionFormat();
+    int bitDepth = header.getRGBBits();
+    bool compressed = header.isCompressed();
+
+    // Only the colour formats can be decoded on the CPU
+    if (compressed ? compressionFormat != "DXT1" && compressionFormat != "DXT3" && compressionFormat != "DXT5" :
+        GL_FMT_FOR_BITDEPTH.count(bitDepth) == 0)
+    {
+        return {};
+    }
+
+    MipMapInfoList mipMapInfo;
+    GetMipMapInfo(header, mipMapInfo);
+
+    // The decompressor handles complete blocks only
+    auto canDecode = [&](const MipMapInfo& mipMap)
+    {
+        return !compressed || (mipMap.width % 4 == 0 && mipMap.height % 4 == 0);
+    };
+
+    // Pick the smallest decodable level which is still large enough
+    std::size_t level = 0;
+
+    for (std::size_t i = 1; i < mipMapInfo.size(); ++i)
+    {
+        if (std::max(mipMapInfo[i].width, mipMapInfo[i].height) < minSize) break;
+
+        if (canDecode(mipMapInfo[i]))
+        {
+            level = i;
+        }
+    }
+
+    const auto& mipMap = mipMapInfo[level];
+
+    if (!canDecode(mipMap))
+    {
+        return {};
+    }
+
+    // Skip the larger levels, then read the chosen one
+    std::vector<byteType> data(std::max<std::size_t>(mipMap.size, 1));
+
+    for (auto remaining = mipMap.offset; remaining > 0;)
+    {
+        auto bytesRead = stream.read(data.data(), std::min(remaining, data.size()));
+        if (bytesRead == 0) return {};
+        remaining -= bytesRead;
+    }
+
+    if (stream.read(data.data(), mipMap.size) != mipMap.size)
+    {
+        return {};
+    }
+
+    auto rgba = std::make_shared<RGBAImage>(mipMap.width, mipMap.height);
+
+    if (compressed)
+    {
+        // Let the decompressor work on the dimensions of this level
+        auto levelHeader = header;
+        levelHeader.width = static_cast<uint32_t>(mipMap.width);
+        levelHeader.height = static_cast<uint32_t>(mipMap.height);
+
+        if (DDSDecompress(&levelHeader, data.data(), rgba->getPixels()) != 0)
+        {
+            return {};
+        }
+    }
+    else
+    {
+        // Swizzle the BGR(A) layout
+        std::size_t bytesPerPixel = bitDepth / 8;
+        bool hasAlpha = bytesPerPixel == 4 && (header.pixelFormat.flags & DDPF_ALPHAPIXELS) != 0;
+        auto numPixels = mipMap.width * mipMap.height;
+
+        for (std::size_t i = 0; i < numPixels; ++i)
+        {
+            const auto* source = data.data() + i * bytesPerPixel;
+            auto& target = rgba->pixels[i];
+
+            target.red = source[2];
+            target.green = source[1];
+            target.blue = source[0];
+            target.alpha = hasAlpha ? source[3] : 255;
+        }
+    }
+
+    auto thumbnail = createThumbnail(rgba, minSize);
+
+    thumbnail.sourceWidth = header.getWidth();
+    thumbnail.sourceHeight = header.getHeight();
+
+    return thumbnail;
+}
+
 ImagePtr LoadDDS(ArchiveFile& file) {
     return LoadDDSFromStream(file.getInputStream());
 }
@@ -309,6 +427,11 @@ ImagePtr DDSLoader::load(ArchiveFile& file) const
     return LoadDDS(file);
 }
 
+ImageThumbnail DDSLoader::loadThumbnail(ArchiveFile& file, std::size_t minSize) const
+{
+    return LoadDDSThumbnailFromStream(file.getInputStream(), minSize);
+}
+
 ImageTypeLoader::Extensions DDSLoader::getExtensions() const
 {
     Extensions extensions;
@@ -13,6 +13,9 @@ public:
     // ImageTypeLoader implementation
 	ImagePtr load(ArchiveFile& file) const;
 
+    // Decompresses the smallest sufficient mipmap level only
+    ImageThumbnail loadThumbnail(ArchiveFile& file, std::size_t minSize) const override;
+
 	Extensions getExtensions() const;
 
 	/* greebo: Returns the prefix that is necessary to construct the
@@ -41,6 +41,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdio.h>
 #include <memory.h>
 
+#include "util/ParallelFor.h"
+
 /* endian tomfoolery */
 typedef union
 {
@@ -206,367 +208,211 @@ int DDSGetInfo(const DDSHeader* header, int *width, int *height, ddsPF_t *pf ) {
 	return 0;
 }
 
-/*
-DDSGetColorBlockColors()
-extracts colors from a dds color block
-*/
+namespace
+{
 
-static void DDSGetColorBlockColors( ddsColorBlock_t *block, ddsColor_t colors[ 4 ] ) {
-	unsigned short		word;
-
-
-	/* color 0 */
-	word = DDSShort( block->colors[ 0 ] );
-	colors[ 0 ].a = 0xff;
-
-	/* extract rgb bits */
-	colors[ 0 ].b = (unsigned char) word;
-	colors[ 0 ].b <<= 3;
-	colors[ 0 ].b |= (colors[ 0 ].b >> 5);
-	word >>= 5;
-	colors[ 0 ].g = (unsigned char) word;
-	colors[ 0 ].g <<= 2;
-	colors[ 0 ].g |= (colors[ 0 ].g >> 6);
-	word >>= 6;
-	colors[ 0 ].r = (unsigned char) word;
-	colors[ 0 ].r <<= 3;
-	colors[ 0 ].r |= (colors[ 0 ].r >> 5);
-
-	/* same for color 1 */
-	word = DDSShort( block->colors[ 1 ] );
-	colors[ 1 ].a = 0xff;
-
-	/* extract rgb bits */
-	colors[ 1 ].b = (unsigned char) word;
-	colors[ 1 ].b <<= 3;
-	colors[ 1 ].b |= (colors[ 1 ].b >> 5);
-	word >>= 5;
-	colors[ 1 ].g = (unsigned char) word;
-	colors[ 1 ].g <<= 2;
-	colors[ 1 ].g |= (colors[ 1 ].g >> 6);
-	word >>= 6;
-	colors[ 1 ].r = (unsigned char) word;
-	colors[ 1 ].r <<= 3;
-	colors[ 1 ].r |= (colors[ 1 ].r >> 5);
-
-	/* use this for all but the super-freak math method */
-	if( block->colors[ 0 ] > block->colors[ 1 ] ) {
-		/* four-color block: derive the other two colors.
-		   00 = color 0, 01 = color 1, 10 = color 2, 11 = color 3
-		   these two bit codes correspond to the 2-bit fields
-		   stored in the 64-bit block. */
-
-		word = ((unsigned short) colors[ 0 ].r * 2 + (unsigned short) colors[ 1 ].r ) / 3;
-		/* no +1 for rounding */
-		/* as bits have been shifted to 888 */
-		colors[ 2 ].r = (unsigned char) word;
-		word = ((unsigned short) colors[ 0 ].g * 2 + (unsigned short) colors[ 1 ].g) / 3;
-		colors[ 2 ].g = (unsigned char) word;
-		word = ((unsigned short) colors[ 0 ].b * 2 + (unsigned short) colors[ 1 ].b) / 3;
-		colors[ 2 ].b = (unsigned char) word;
-		colors[ 2 ].a = 0xff;
-
-		word = ((unsigned short) colors[ 0 ].r + (unsigned short) colors[ 1 ].r * 2) / 3;
-		colors[ 3 ].r = (unsigned char) word;
-		word = ((unsigned short) colors[ 0 ].g + (unsigned short) colors[ 1 ].g * 2) / 3;
-		colors[ 3 ].g = (unsigned char) word;
-		word = ((unsigned short) colors[ 0 ].b + (unsigned short) colors[ 1 ].b * 2) / 3;
-		colors[ 3 ].b = (unsigned char) word;
-		colors[ 3 ].a = 0xff;
-	}
-	else {
-		/* three-color block: derive the other color.
-		   00 = color 0, 01 = color 1, 10 = color 2,
-		   11 = transparent.
-		   These two bit codes correspond to the 2-bit fields
-		   stored in the 64-bit block */
-
-		word = ((unsigned short) colors[ 0 ].r + (unsigned short) colors[ 1 ].r) / 2;
-		colors[ 2 ].r = (unsigned char) word;
-		word = ((unsigned short) colors[ 0 ].g + (unsigned short) colors[ 1 ].g) / 2;
-		colors[ 2 ].g = (unsigned char) word;
-		word = ((unsigned short) colors[ 0 ].b + (unsigned short) colors[ 1 ].b) / 2;
-		colors[ 2 ].b = (unsigned char) word;
-		colors[ 2 ].a = 0xff;
+/* block rows (of 4 pixel lines each) below which decompression stays on the calling thread,
+   when called from within a parallel batch (e.g. ImageLoader::imagesFromVFS) it always does */
+constexpr std::size_t PARALLEL_DECOMPRESS_MIN_BLOCK_ROWS = 32;
 
-		/* random color to indicate alpha */
-		colors[ 3 ].r = 0x00;
-		colors[ 3 ].g = 0xff;
-		colors[ 3 ].b = 0xff;
-		colors[ 3 ].a = 0x00;
-	}
+/* how the first 8 bytes of a 16 byte block are interpreted */
+enum class DDSAlphaMode
+{
+	None,				/* dxt1: 8 byte blocks, colour block only */
+	Explicit,			/* dxt2/3: 4 bit alpha per pixel */
+	Interpolated,		/* dxt4/5: 3 bit indices into interpolated alphas */
+	InterpolatedRed,	/* rxgb: like dxt5, but the result goes into the red channel */
+};
+
+inline unsigned short DDSReadShort( const unsigned char* bytes ) {
+	unsigned short word;
+	memcpy( &word, bytes, sizeof( word ) );
+	return DDSShort( word );
 }
 
-
+/* packs the channels into a word with the memory layout of ddsColor_t */
+inline uint32_t DDSPackColor( unsigned int r, unsigned int g, unsigned int b, unsigned int a ) {
+	ddsColor_t color = { (unsigned char) r, (unsigned char) g, (unsigned char) b, (unsigned char) a };
+	uint32_t packed;
+	memcpy( &packed, &color, sizeof( packed ) );
+	return packed;
+}
 
 /*
-DDSDecodeColorBlock()
-decodes a dds color block
-fixme: make endian-safe
+DDSGetColorBlockColors()
+extracts the 4 colors from a dds color block (packed like ddsColor_t),
+returns the 2 bit indices of the 16 pixels, first pixel in the lowest bits
 */
 
-static void DDSDecodeColorBlock( unsigned int *pixel, ddsColorBlock_t *block, int width, unsigned int colors[ 4 ] ) {
-	int				r, n;
-	unsigned int	bits;
-	unsigned int	masks[] = { 3, 12, 3 << 4, 3 << 6 };	/* bit masks = 00000011, 00001100, 00110000, 11000000 */
-	int				shift[] = { 0, 2, 4, 6 };
-
-	/* r steps through lines in y */
-	for( r = 0; r < 4; r++, pixel += (width - 4) )	/* no width * 4 as unsigned int ptr inc will * 4 */
-	{
-		/* width * 4 bytes per pixel per line, each j dxtc row is 4 lines of pixels */
-
-		/* n steps through pixels */
-		for( n = 0; n < 4; n++ ) {
-			bits = block->row[ r ] & masks[ n ];
-			bits >>= shift[ n ];
-			*pixel = colors[bits];
-			pixel++;
-		}
-	}
-}
+inline uint32_t DDSGetColorBlockColors( const unsigned char* block, uint32_t colors[ 4 ] ) {
+	unsigned short	word0 = DDSReadShort( block );
+	unsigned short	word1 = DDSReadShort( block + 2 );
 
+	/* expand the 5:6:5 colors to 8 bits per channel */
+	unsigned int r0 = (word0 >> 11) & 0x1F, g0 = (word0 >> 5) & 0x3F, b0 = word0 & 0x1F;
+	unsigned int r1 = (word1 >> 11) & 0x1F, g1 = (word1 >> 5) & 0x3F, b1 = word1 & 0x1F;
 
+	r0 = (r0 << 3) | (r0 >> 2);	g0 = (g0 << 2) | (g0 >> 4);	b0 = (b0 << 3) | (b0 >> 2);
+	r1 = (r1 << 3) | (r1 >> 2);	g1 = (g1 << 2) | (g1 >> 4);	b1 = (b1 << 3) | (b1 >> 2);
 
-/*
-DDSDecodeAlphaExplicit()
-decodes a dds explicit alpha block
-*/
+	colors[ 0 ] = DDSPackColor( r0, g0, b0, 0xff );
+	colors[ 1 ] = DDSPackColor( r1, g1, b1, 0xff );
 
-static void DDSDecodeAlphaExplicit( unsigned int *pixel, ddsAlphaBlockExplicit_t *alphaBlock, int width, unsigned int alphaZero ) {
-	int				row, pix;
-	unsigned short	word;
-	ddsColor_t		color;
+	if( word0 > word1 ) {
+		/* four-color block: 00 = color 0, 01 = color 1, 10 = 2/3 c0 + 1/3 c1, 11 = 1/3 c0 + 2/3 c1 */
+		/* no +1 for rounding as bits have been shifted to 888 */
+		colors[ 2 ] = DDSPackColor( (r0 * 2 + r1) / 3, (g0 * 2 + g1) / 3, (b0 * 2 + b1) / 3, 0xff );
+		colors[ 3 ] = DDSPackColor( (r0 + r1 * 2) / 3, (g0 + g1 * 2) / 3, (b0 + b1 * 2) / 3, 0xff );
+	}
+	else {
+		/* three-color block: 00 = color 0, 01 = color 1, 10 = average, 11 = transparent */
+		colors[ 2 ] = DDSPackColor( (r0 + r1) / 2, (g0 + g1) / 2, (b0 + b1) / 2, 0xff );
 
+		/* random color to indicate alpha */
+		colors[ 3 ] = DDSPackColor( 0x00, 0xff, 0xff, 0x00 );
+	}
 
-	/* clear color */
-	color.r = 0;
-	color.g = 0;
-	color.b = 0;
+	/* one byte per row */
+	return (uint32_t) block[ 4 ] | ((uint32_t) block[ 5 ] << 8) |
+		((uint32_t) block[ 6 ] << 16) | ((uint32_t) block[ 7 ] << 24);
+}
 
-	/* walk rows */
-	for( row = 0; row < 4; row++, pixel += (width - 4) ) {
-		word = DDSShort( alphaBlock->row[ row ] );
+/*
+DDSGetExplicitAlphas()
+returns the 4 bit values of an explicit alpha block, first pixel in the lowest bits
+*/
 
-		/* walk pixels */
-		for( pix = 0; pix < 4; pix++ ) {
-			/* zero the alpha bits of image pixel */
-			*pixel &= alphaZero;
-			color.a = word & 0x000F;
-			color.a = color.a | (color.a << 4);
-			*pixel |= *((unsigned int*) &color);
-			word >>= 4;		/* move next bits to lowest 4 */
-			pixel++;		/* move to next pixel in the row */
+inline uint64_t DDSGetExplicitAlphas( const unsigned char* alphaBlock ) {
+	uint64_t values = 0;
 
-		}
+	for( int row = 0; row < 4; row++ ) {
+		values |= (uint64_t) DDSReadShort( alphaBlock + row * 2 ) << (16 * row);
 	}
-}
-
 
+	return values;
+}
 
 /*
-DDSDecodeAlpha3BitLinear()
-decodes interpolated alpha block
+DDSGetInterpolatedAlphas()
+derives the 8 values of an interpolated alpha block, multiplied by the given channel unit,
+returns the 3 bit indices of the 16 pixels (48 bits), first pixel in the lowest bits
 */
 
-static void DDSDecodeAlpha3BitLinear( unsigned int *pixel, ddsAlphaBlock3BitLinear_t *alphaBlock, int width, unsigned int alphaZero ) {
-
-	int					row, pix;
-	unsigned int		stuff;
-	unsigned char		bits[ 4 ][ 4 ];
-	unsigned short		alphas[ 8 ];
-	ddsColor_t			aColors[ 4 ][ 4 ];
+inline uint64_t DDSGetInterpolatedAlphas( const unsigned char* alphaBlock, uint32_t channelOne, uint32_t values[ 8 ] ) {
+	unsigned int a0 = alphaBlock[ 0 ];
+	unsigned int a1 = alphaBlock[ 1 ];
 
-
-	/* get initial alphas */
-	alphas[ 0 ] = alphaBlock->alpha0;
-	alphas[ 1 ] = alphaBlock->alpha1;
+	values[ 0 ] = a0;
+	values[ 1 ] = a1;
 
 	/* 8-alpha block */
-	if( alphas[ 0 ] > alphas[ 1 ] ) {
+	if( a0 > a1 ) {
 		/* 000 = alpha_0, 001 = alpha_1, others are interpolated */
-		alphas[ 2 ] = ( 6 * alphas[ 0 ] +     alphas[ 1 ]) / 7;	/* bit code 010 */
-		alphas[ 3 ] = ( 5 * alphas[ 0 ] + 2 * alphas[ 1 ]) / 7;	/* bit code 011 */
-		alphas[ 4 ] = ( 4 * alphas[ 0 ] + 3 * alphas[ 1 ]) / 7;	/* bit code 100 */
-		alphas[ 5 ] = ( 3 * alphas[ 0 ] + 4 * alphas[ 1 ]) / 7;	/* bit code 101 */
-		alphas[ 6 ] = ( 2 * alphas[ 0 ] + 5 * alphas[ 1 ]) / 7;	/* bit code 110 */
-		alphas[ 7 ] = (     alphas[ 0 ] + 6 * alphas[ 1 ]) / 7;	/* bit code 111 */
+		for( unsigned int i = 1; i < 7; i++ ) {
+			values[ i + 1 ] = ((7 - i) * a0 + i * a1) / 7;
+		}
 	}
 
 	/* 6-alpha block */
 	else {
-		/* 000 = alpha_0, 001 = alpha_1, others are interpolated */
-		alphas[ 2 ] = (4 * alphas[ 0 ] +     alphas[ 1 ]) / 5;	/* bit code 010 */
-		alphas[ 3 ] = (3 * alphas[ 0 ] + 2 * alphas[ 1 ]) / 5;	/* bit code 011 */
-		alphas[ 4 ] = (2 * alphas[ 0 ] + 3 * alphas[ 1 ]) / 5;	/* bit code 100 */
-		alphas[ 5 ] = (    alphas[ 0 ] + 4 * alphas[ 1 ]) / 5;	/* bit code 101 */
-		alphas[ 6 ] = 0;										/* bit code 110 */
-		alphas[ 7 ] = 255;										/* bit code 111 */
-	}
-
-	/* decode 3-bit fields into array of 16 bytes with same value */
-
-	/* first two rows of 4 pixels each */
-	stuff = *((unsigned int*) &(alphaBlock->stuff[ 0 ]));
-
-	bits[ 0 ][ 0 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 0 ][ 1 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 0 ][ 2 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 0 ][ 3 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 1 ][ 0 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 1 ][ 1 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 1 ][ 2 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 1 ][ 3 ] = (unsigned char) (stuff & 0x00000007);
-
-	/* last two rows */
-	stuff = *((unsigned int*) &(alphaBlock->stuff[ 3 ])); /* last 3 bytes */
-
-	bits[ 2 ][ 0 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 2 ][ 1 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 2 ][ 2 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 2 ][ 3 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 3 ][ 0 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 3 ][ 1 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 3 ][ 2 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 3 ][ 3 ] = (unsigned char) (stuff & 0x00000007);
-
-	/* decode the codes into alpha values */
-	for( row = 0; row < 4; row++ ) {
-		for( pix=0; pix < 4; pix++ ) {
-			aColors[ row ][ pix ].r = 0;
-			aColors[ row ][ pix ].g = 0;
-			aColors[ row ][ pix ].b = 0;
-			aColors[ row ][ pix ].a = (unsigned char) alphas[ bits[ row ][ pix ] ];
+		/* 000 = alpha_0, 001 = alpha_1, 110 = 0, 111 = 255, others are interpolated */
+		for( unsigned int i = 1; i < 5; i++ ) {
+			values[ i + 1 ] = ((5 - i) * a0 + i * a1) / 5;
 		}
-	}
 
-	/* write out alpha values to the image bits */
-	for( row = 0; row < 4; row++, pixel += width-4 ) {
-		for( pix = 0; pix < 4; pix++ ) {
-			/* zero the alpha bits of image pixel */
-			*pixel &= alphaZero;
-
-			/* or the bits into the prev. nulled alpha */
-			*pixel |= *((unsigned int*) &(aColors[ row ][ pix ]));
-			pixel++;
-		}
+		values[ 6 ] = 0;
+		values[ 7 ] = 255;
 	}
-}
-
-/** greebo: Decodes the alpha channel into the red channel for RXGB-encoded images
- */
-static void DDSDecodeRXGBAlpha3BitLinear( unsigned int *pixel, ddsAlphaBlock3BitLinear_t *alphaBlock, int width, unsigned int redZero ) {
-
-	int					row, pix;
-	unsigned int		stuff;
-	unsigned char		bits[ 4 ][ 4 ];
-	unsigned short		alphas[ 8 ];
-	ddsColor_t			aColors[ 4 ][ 4 ];
 
-
-	/* get initial alphas */
-	alphas[ 0 ] = alphaBlock->alpha0;
-	alphas[ 1 ] = alphaBlock->alpha1;
-
-	/* 8-alpha block */
-	if( alphas[ 0 ] > alphas[ 1 ] ) {
-		/* 000 = alpha_0, 001 = alpha_1, others are interpolated */
-		alphas[ 2 ] = ( 6 * alphas[ 0 ] +     alphas[ 1 ]) / 7;	/* bit code 010 */
-		alphas[ 3 ] = ( 5 * alphas[ 0 ] + 2 * alphas[ 1 ]) / 7;	/* bit code 011 */
-		alphas[ 4 ] = ( 4 * alphas[ 0 ] + 3 * alphas[ 1 ]) / 7;	/* bit code 100 */
-		alphas[ 5 ] = ( 3 * alphas[ 0 ] + 4 * alphas[ 1 ]) / 7;	/* bit code 101 */
-		alphas[ 6 ] = ( 2 * alphas[ 0 ] + 5 * alphas[ 1 ]) / 7;	/* bit code 110 */
-		alphas[ 7 ] = (     alphas[ 0 ] + 6 * alphas[ 1 ]) / 7;	/* bit code 111 */
+	/* move the values into the target channel */
+	for( int i = 0; i < 8; i++ ) {
+		values[ i ] *= channelOne;
 	}
 
-	/* 6-alpha block */
-	else {
-		/* 000 = alpha_0, 001 = alpha_1, others are interpolated */
-		alphas[ 2 ] = (4 * alphas[ 0 ] +     alphas[ 1 ]) / 5;	/* bit code 010 */
-		alphas[ 3 ] = (3 * alphas[ 0 ] + 2 * alphas[ 1 ]) / 5;	/* bit code 011 */
-		alphas[ 4 ] = (2 * alphas[ 0 ] + 3 * alphas[ 1 ]) / 5;	/* bit code 100 */
-		alphas[ 5 ] = (    alphas[ 0 ] + 4 * alphas[ 1 ]) / 5;	/* bit code 101 */
-		alphas[ 6 ] = 0;										/* bit code 110 */
-		alphas[ 7 ] = 255;										/* bit code 111 */
-	}
+	uint64_t indices = 0;
 
-	/* decode 3-bit fields into array of 16 bytes with same value */
-
-	/* first two rows of 4 pixels each */
-	stuff = *((unsigned int*) &(alphaBlock->stuff[ 0 ]));
-
-	bits[ 0 ][ 0 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 0 ][ 1 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 0 ][ 2 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 0 ][ 3 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 1 ][ 0 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 1 ][ 1 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 1 ][ 2 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 1 ][ 3 ] = (unsigned char) (stuff & 0x00000007);
-
-	/* last two rows */
-	stuff = *((unsigned int*) &(alphaBlock->stuff[ 3 ])); /* last 3 bytes */
-
-	bits[ 2 ][ 0 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 2 ][ 1 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 2 ][ 2 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 2 ][ 3 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 3 ][ 0 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 3 ][ 1 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 3 ][ 2 ] = (unsigned char) (stuff & 0x00000007);
-	stuff >>= 3;
-	bits[ 3 ][ 3 ] = (unsigned char) (stuff & 0x00000007);
-
-	/* decode the codes into red values */
-	for( row = 0; row < 4; row++ ) {
-		for( pix=0; pix < 4; pix++ ) {
-			aColors[ row ][ pix ].a = 0;
-			aColors[ row ][ pix ].g = 0;
-			aColors[ row ][ pix ].b = 0;
-			aColors[ row ][ pix ].r = (unsigned char) alphas[ bits[ row ][ pix ] ];
-		}
+	for( int i = 0; i < 6; i++ ) {
+		indices |= (uint64_t) alphaBlock[ 2 + i ] << (8 * i);
 	}
 
-	/* write out alpha values to the image bits */
-	for( row = 0; row < 4; row++, pixel += width-4 ) {
-		for( pix = 0; pix < 4; pix++ ) {
-			/* zero the red bits of image pixel */
-			*pixel &= redZero;
+	return indices;
+}
+
+/*
+DDSDecompressBlocks()
+decompresses a block-compressed texture: the palettes of each 4x4 block are set up once,
+then the pixels are looked up and written row by row. The rows of blocks are spread
+across the available cores.
+*/
 
-			/* or the bits into the prev. nulled red */
-			*pixel |= *((unsigned int*) &(aColors[ row ][ pix ]));
-			pixel++;
+template<DDSAlphaMode AlphaMode>
+int DDSDecompressBlocks( const unsigned char* buffer, int width, int height, unsigned char *pixels ) {
+	/* setup */
+	int xBlocks = width / 4;
+	int yBlocks = height / 4;
+
+	if( xBlocks <= 0 || yBlocks <= 0 )
+		return 0;
+
+	/* 8 bytes per colour block, plus 8 bytes for the alpha block which comes first */
+	constexpr std::size_t blockBytes = AlphaMode == DDSAlphaMode::None ? 8 : 16;
+	constexpr std::size_t colorOffset = blockBytes - 8;
+	std::size_t rowPitch = (std::size_t) width * 4;
+
+	/* the channel receiving the alpha block values, and the mask zeroing it */
+	const bool intoRed = AlphaMode == DDSAlphaMode::InterpolatedRed;
+	const uint32_t channelZero = intoRed ? DDSPackColor( 0x00, 0xff, 0xff, 0xff ) : DDSPackColor( 0xff, 0xff, 0xff, 0x00 );
+	const uint32_t channelOne = intoRed ? DDSPackColor( 1, 0, 0, 0 ) : DDSPackColor( 0, 0, 0, 1 );
+
+	/* captured by value, the pixel writes would force reloading anything referenced */
+	util::parallelForChunks( yBlocks, PARALLEL_DECOMPRESS_MIN_BLOCK_ROWS, [=]( std::size_t begin, std::size_t end ) {
+		uint32_t colors[ 4 ];
+		uint32_t alphas[ 8 ];
+		uint64_t alphaBits = 0;
+
+		/* walk y */
+		for( std::size_t y = begin; y < end; y++ ) {
+			const unsigned char* block = buffer + y * xBlocks * blockBytes;
+			unsigned char* blockPixels = pixels + y * 4 * rowPitch;
+
+			/* walk x */
+			for( int x = 0; x < xBlocks; x++, block += blockBytes, blockPixels += 16 ) {
+				uint32_t colorBits = DDSGetColorBlockColors( block + colorOffset, colors );
+
+				if constexpr( AlphaMode == DDSAlphaMode::Explicit ) {
+					alphaBits = DDSGetExplicitAlphas( block );
+				}
+				else if constexpr( AlphaMode != DDSAlphaMode::None ) {
+					alphaBits = DDSGetInterpolatedAlphas( block, channelOne, alphas );
+				}
+
+				for( int row = 0; row < 4; row++ ) {
+					unsigned char* rowPixels = blockPixels + row * rowPitch;
+
+					for( int pix = 0; pix < 4; pix++ ) {
+						int i = row * 4 + pix;
+						uint32_t pixel = colors[ (colorBits >> (2 * i)) & 3 ];
+
+						if constexpr( AlphaMode == DDSAlphaMode::Explicit ) {
+							/* 0x11 expands the 4 bits to 8 */
+							pixel = (pixel & channelZero) | ((uint32_t) ((alphaBits >> (4 * i)) & 0x0F) * 0x11 * channelOne);
+						}
+						else if constexpr( AlphaMode != DDSAlphaMode::None ) {
+							pixel = (pixel & channelZero) | alphas[ (alphaBits >> (3 * i)) & 7 ];
+						}
+
+						memcpy( rowPixels + pix * 4, &pixel, sizeof( pixel ) );
+					}
+				}
+			}
 		}
-	}
+	});
+
+	/* return ok */
+	return 0;
 }
 
+}
 
 /*
 DDSDecompressDXT1()
@@ -574,31 +420,7 @@ decompresses a dxt1 format texture
 */
 
 static int DDSDecompressDXT1( const unsigned char* buffer, int width, int height, unsigned char *pixels ) {
-	int				x, y, xBlocks, yBlocks;
-	unsigned int	*pixel;
-	ddsColorBlock_t	*block;
-	ddsColor_t		colors[ 4 ];
-
-
-	/* setup */
-	xBlocks = width / 4;
-	yBlocks = height / 4;
-
-	/* walk y */
-	for( y = 0; y < yBlocks; y++ ) {
-		/* 8 bytes per block */
-		block = (ddsColorBlock_t*) ((uintptr_t) buffer + y * xBlocks * 8);
-
-		/* walk x */
-		for( x = 0; x < xBlocks; x++, block++ ) {
-			DDSGetColorBlockColors( block, colors );
-			pixel = (unsigned int*) (pixels + x * 16 + (y * 4) * width * 4);
-			DDSDecodeColorBlock( pixel, block, width, (unsigned int*) colors );
-		}
-	}
-
-	/* return ok */
-	return 0;
+	return DDSDecompressBlocks<DDSAlphaMode::None>( buffer, width, height, pixels );
 }
 
 
@@ -609,49 +431,7 @@ decompresses a dxt3 format texture
 */
 
 static int DDSDecompressDXT3( const unsigned char* buffer, int width, int height, unsigned char *pixels ) {
-	int						x, y, xBlocks, yBlocks;
-	unsigned int			*pixel, alphaZero;
-	ddsColorBlock_t			*block;
-	ddsAlphaBlockExplicit_t	*alphaBlock;
-	ddsColor_t				colors[ 4 ];
-
-
-	/* setup */
-	xBlocks = width / 4;
-	yBlocks = height / 4;
-
-	/* create zero alpha */
-	colors[ 0 ].a = 0;
-	colors[ 0 ].r = 0xFF;
-	colors[ 0 ].g = 0xFF;
-	colors[ 0 ].b = 0xFF;
-	alphaZero = *((unsigned int*) &colors[ 0 ]);
-
-	/* walk y */
-	for( y = 0; y < yBlocks; y++ ) {
-		/* 8 bytes per block, 1 block for alpha, 1 block for color */
-		block = (ddsColorBlock_t*) ((uintptr_t) buffer + y * xBlocks * 16);
-
-		/* walk x */
-		for( x = 0; x < xBlocks; x++, block++ ) {
-			/* get alpha block */
-			alphaBlock = (ddsAlphaBlockExplicit_t*) block;
-
-			/* get color block */
-			block++;
-			DDSGetColorBlockColors( block, colors );
-
-			/* decode color block */
-			pixel = (unsigned int*) (pixels + x * 16 + (y * 4) * width * 4);
-			DDSDecodeColorBlock( pixel, block, width, (unsigned int*) colors );
-
-			/* overwrite alpha bits with alpha block */
-			DDSDecodeAlphaExplicit( pixel, alphaBlock, width, alphaZero );
-		}
-	}
-
-	/* return ok */
-	return 0;
+	return DDSDecompressBlocks<DDSAlphaMode::Explicit>( buffer, width, height, pixels );
 }
 
 
@@ -662,49 +442,7 @@ decompresses a dxt5 format texture
 */
 
 static int DDSDecompressDXT5( const unsigned char* buffer, int width, int height, unsigned char *pixels ) {
-	int							x, y, xBlocks, yBlocks;
-	unsigned int				*pixel, alphaZero;
-	ddsColorBlock_t				*block;
-	ddsAlphaBlock3BitLinear_t	*alphaBlock;
-	ddsColor_t					colors[ 4 ];
-
-
-	/* setup */
-	xBlocks = width / 4;
-	yBlocks = height / 4;
-
-	/* create zero alpha */
-	colors[ 0 ].a = 0;
-	colors[ 0 ].r = 0xFF;
-	colors[ 0 ].g = 0xFF;
-	colors[ 0 ].b = 0xFF;
-	alphaZero = *((unsigned int*) &colors[ 0 ]);
-
-	/* walk y */
-	for( y = 0; y < yBlocks; y++ ) {
-		/* 8 bytes per block, 1 block for alpha, 1 block for color */
-		block = (ddsColorBlock_t*) ((uintptr_t) buffer + y * xBlocks * 16);
-
-		/* walk x */
-		for( x = 0; x < xBlocks; x++, block++ ) {
-			/* get alpha block */
-			alphaBlock = (ddsAlphaBlock3BitLinear_t*) block;
-
-			/* get color block */
-			block++;
-			DDSGetColorBlockColors( block, colors );
-
-			/* decode color block */
-			pixel = (unsigned int*) (pixels + x * 16 + (y * 4) * width * 4);
-			DDSDecodeColorBlock( pixel, block, width, (unsigned int*) colors );
-
-			/* overwrite alpha bits with alpha block */
-			DDSDecodeAlpha3BitLinear( pixel, alphaBlock, width, alphaZero );
-		}
-	}
-
-	/* return ok */
-	return 0;
+	return DDSDecompressBlocks<DDSAlphaMode::Interpolated>( buffer, width, height, pixels );
 }
 
 
@@ -751,25 +489,8 @@ decompresses an argb 8888 format texture
 */
 
 static int DDSDecompressARGB8888( const unsigned char* buffer, int width, int height, unsigned char *pixels ) {
-	int							x, y;
-	const unsigned char		*in;
-	unsigned char *out;
-
-
-	/* setup */
-	in = buffer;
-	out = pixels;
-
-	/* walk y */
-	for( y = 0; y < height; y++ ) {
-		/* walk x */
-		for( x = 0; x < width; x++ ) {
-			*out++ = *in++;
-			*out++ = *in++;
-			*out++ = *in++;
-			*out++ = *in++;
-		}
-	}
+	/* the pixels are copied as they are */
+	memcpy( pixels, buffer, (std::size_t) width * height * 4 );
 
 	/* return ok */
 	return 0;
@@ -778,50 +499,7 @@ static int DDSDecompressARGB8888( const unsigned char* buffer, int width, int he
 /** greebo: This decompresses a DXT5 RXGB texture as used by the Doom3 engine.
  */
 static int DDSDecompressRXGB( const unsigned char* buffer, int width, int height, unsigned char *pixels ) {
-	int							x, y, xBlocks, yBlocks;
-	unsigned int				*pixel, redZero;
-	ddsColorBlock_t				*block;
-	ddsAlphaBlock3BitLinear_t	*alphaBlock;
-	ddsColor_t					colors[ 4 ];
-
-	/* setup */
-	xBlocks = width / 4;
-	yBlocks = height / 4;
-
-	/* create zero red */
-	colors[ 0 ].r = 0;
-	colors[ 0 ].a = 0xFF;
-	colors[ 0 ].g = 0xFF;
-	colors[ 0 ].b = 0xFF;
-	redZero = *((unsigned int*) &colors[ 0 ]);
-
-	/* walk y */
-	for( y = 0; y < yBlocks; y++ ) {
-		/* 8 bytes (64 bit) per block, 1 block for alpha, 1 block for color */
-		block = (ddsColorBlock_t*) ((uintptr_t) buffer + y * xBlocks * 16);
-
-		/* walk x */
-		for( x = 0; x < xBlocks; x++, block++ ) {
-			/* get alpha block */
-			alphaBlock = (ddsAlphaBlock3BitLinear_t*) block;
-
-			/* get color block */
-			block++;
-			// Decode the colour values from the 5:6:5 word and derive the c2 and c3 colours
-			// The result is stored in the <colors> variable
-			DDSGetColorBlockColors( block, colors );
-
-			/* decode color block */
-			pixel = (unsigned int*) (pixels + x * 16 + (y * 4) * width * 4);
-			DDSDecodeColorBlock( pixel, block, width, (unsigned int*) colors );
-
-			/* overwrite alpha bits with alpha block */
-			DDSDecodeRXGBAlpha3BitLinear( pixel, alphaBlock, width, redZero );
-		}
-	}
-
-	/* return ok */
-	return 0;
+	return DDSDecompressBlocks<DDSAlphaMode::InterpolatedRed>( buffer, width, height, pixels );
 }
 
 /*
@@ -289,4 +289,5 @@ struct ddsColor_t
 
 /* public functions */
 int DDSGetInfo( const DDSHeader* header, int *width, int *height, ddsPF_t *pf );
+/* decompresses into an RGBA buffer, the block rows of large images are decoded on several threads */
 int DDSDecompress( const DDSHeader* header, const unsigned char* buffer, unsigned char *pixels );
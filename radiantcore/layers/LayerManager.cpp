@@ -13,6 +13,7 @@
 
 #include <functional>
 #include <climits>
+#include <queue>
 #include <unordered_set>
 
 namespace scene
@@ -23,6 +24,54 @@ namespace
 	constexpr const char* const DEFAULT_LAYER_NAME = N_("Default");
 	constexpr int DEFAULT_LAYER = 0;
 	constexpr int NO_PARENT_ID = -1;
+
+	std::size_t getNodeDepth(const INode& node)
+	{
+		std::size_t depth = 0;
+
+		for (auto parent = node.getParent(); parent; parent = parent->getParent())
+		{
+			++depth;
+		}
+
+		return depth;
+	}
+
+	// Visits all members of a layer in a subgraph
+	class LayerMemberWalker :
+		public NodeVisitor
+	{
+	private:
+		int _layerId;
+		const std::function<void(INode&)>& _functor;
+
+	public:
+		LayerMemberWalker(int layerId, const std::function<void(INode&)>& functor) :
+			_layerId(layerId),
+			_functor(functor)
+		{}
+
+		bool pre(const INodePtr& node) override
+		{
+			if (node->getLayers().contains(_layerId))
+			{
+				_functor(*node);
+			}
+
+			return true;
+		}
+	};
+
+	// True if the given node or any of its ancestors below the root is invisible
+	bool nodeOrAncestorIsHidden(const INodePtr& node)
+	{
+		for (auto candidate = node; candidate && candidate->getParent(); candidate = candidate->getParent())
+		{
+			if (!candidate->visible()) return true;
+		}
+
+		return false;
+	}
 }
 
 LayerManager::LayerManager(INode& rootNode) :
@@ -105,8 +154,26 @@ void LayerManager::deleteLayer(const std::string& name)
     }
 
 	// Remove all nodes from this layer first, but don't de-select them yet
-	RemoveFromLayerWalker walker(layerID);
-	_rootNode.traverse(walker);
+	if (memberIndexIsActive())
+	{
+		// Work on a copy, removing the nodes is modifying the index
+		std::vector<INodePtr> members;
+
+		foreachLayerMember(layerID, [&](INode& node)
+		{
+			members.emplace_back(node.getSelf());
+		});
+
+		for (const auto& node : members)
+		{
+			node->removeFromLayer(layerID);
+		}
+	}
+	else
+	{
+		RemoveFromLayerWalker walker(layerID);
+		_rootNode.traverse(walker);
+	}
 
 	// Remove the layer
 	_layers.erase(layerID);
@@ -224,7 +291,8 @@ bool LayerManager::layerIsVisible(int layerID)
 
 void LayerManager::setLayerVisibility(int layerId, bool visible)
 {
-    auto layerVisibilityChanged = setLayerVisibilityRecursively(layerId, visible);
+    std::vector<int> changedLayers;
+    auto layerVisibilityChanged = setLayerVisibilityRecursively(layerId, visible, changedLayers);
 
 	if (!visible && !_layerVisibility.at(_activeLayer))
 	{
@@ -243,34 +311,203 @@ void LayerManager::setLayerVisibility(int layerId, bool visible)
     if (layerVisibilityChanged)
     {
 	    // Fire the visibility changed event
-	    onLayerVisibilityChanged();
+	    onLayerVisibilityChanged(changedLayers);
     }
 }
 
-bool LayerManager::setLayerVisibilityRecursively(int rootLayerId, bool visible)
+bool LayerManager::setLayerVisibilityRecursively(int rootLayerId, bool visible, std::vector<int>& changedLayers)
 {
-    bool visibilityChange = false;
-
     foreachLayerInHierarchy(rootLayerId, [&](int layerId)
     {
         if (layerId < 0 || layerId >= _layerVisibility.size()) return;
 
-        visibilityChange |= _layerVisibility.at(layerId) != visible;
-        _layerVisibility.at(layerId) = visible;
+        if (_layerVisibility.at(layerId) != visible)
+        {
+            _layerVisibility.at(layerId) = visible;
+            changedLayers.push_back(layerId);
+        }
     });
 
-    return visibilityChange;
+    return !changedLayers.empty();
 }
 
-void LayerManager::updateSceneGraphVisibility()
+void LayerManager::updateSceneGraphVisibility(const std::vector<int>& changedLayers)
 {
-	UpdateNodeVisibilityWalker walker(*this);
-	_rootNode.traverseChildren(walker);
+	if (!memberIndexIsActive())
+	{
+		// No index available, check every node
+		UpdateNodeVisibilityWalker walker(*this);
+		_rootNode.traverseChildren(walker);
+
+		SceneChangeNotify();
+		return;
+	}
+
+	// Only the members of the changed layers and the nodes with
+	// changed memberships can have a different visibility now
+	std::unordered_set<INode*> nodes;
+	nodes.swap(_nodesNeedingVisibilityUpdate);
+
+	for (auto layerId : changedLayers)
+	{
+		if (layerId >= 0 && layerId < static_cast<int>(_layerMembers.size()))
+		{
+			nodes.insert(_layerMembers[layerId].begin(), _layerMembers[layerId].end());
+		}
+	}
+
+	if (nodes.empty()) return;
+
+	updateNodeVisibilities(nodes);
 
 	// Redraw
 	SceneChangeNotify();
 }
 
+void LayerManager::updateNodeVisibilities(const std::unordered_set<INode*>& nodes)
+{
+	// Process the deepest nodes first, a parent is visible if any of its children is.
+	// This produces the same result as the UpdateNodeVisibilityWalker.
+	std::priority_queue<std::pair<std::size_t, INode*>> queue;
+	std::unordered_set<INode*> queuedNodes(nodes);
+
+	for (auto node : nodes)
+	{
+		queue.emplace(getNodeDepth(*node), node);
+	}
+
+	while (!queue.empty())
+	{
+		auto [depth, node] = queue.top();
+		queue.pop();
+
+		auto self = node->getSelf();
+		bool wasHidden = node->checkStateFlag(Node::eLayered);
+
+		// Check the node's own layers first, then look for any visible child
+		bool isVisible = updateNodeVisibility(self);
+
+		if (!isVisible)
+		{
+			node->foreachNode([&](const INodePtr& child)
+			{
+				isVisible = !child->checkStateFlag(Node::eLayered);
+				return !isVisible;
+			});
+
+			if (isVisible)
+			{
+				// Show the node, otherwise the parent would hide the visible children as well
+				node->disable(Node::eLayered);
+			}
+		}
+
+		if (!isVisible)
+		{
+			// Node is hidden by layers after update (and no children are visible), de-select
+			Node_setSelected(self, false);
+		}
+
+		if (wasHidden == isVisible)
+		{
+			// The visibility changed, the parent needs to be re-evaluated too
+			auto parent = node->getParent();
+
+			if (parent && parent.get() != &_rootNode && queuedNodes.insert(parent.get()).second)
+			{
+				queue.emplace(depth - 1, parent.get());
+			}
+		}
+	}
+}
+
+bool LayerManager::memberIndexIsActive() const
+{
+	return _rootNode.inScene();
+}
+
+void LayerManager::addToMemberIndex(INode& node, int layerID)
+{
+	if (layerID >= static_cast<int>(_layerMembers.size()))
+	{
+		_layerMembers.resize(layerID + 1);
+	}
+
+	_layerMembers[layerID].insert(&node);
+}
+
+void LayerManager::onNodeInserted(INode& node)
+{
+	for (auto layerId : node.getLayers())
+	{
+		addToMemberIndex(node, layerId);
+	}
+
+	_nodesNeedingVisibilityUpdate.insert(&node);
+}
+
+void LayerManager::onNodeRemoved(INode& node)
+{
+	for (auto layerId : node.getLayers())
+	{
+		if (layerId < static_cast<int>(_layerMembers.size()))
+		{
+			_layerMembers[layerId].erase(&node);
+		}
+	}
+
+	_nodesNeedingVisibilityUpdate.erase(&node);
+
+	// The parent might have been visible because of this node only.
+	// Children are removed before their parents, so the parent is still in the scene.
+	auto parent = node.getParent();
+
+	if (parent && parent.get() != &_rootNode && parent->inScene())
+	{
+		_nodesNeedingVisibilityUpdate.insert(parent.get());
+	}
+}
+
+void LayerManager::onNodeLayersChanged(INode& node, const LayerList& previousLayers)
+{
+	const auto& layers = node.getLayers();
+
+	for (auto layerId : previousLayers)
+	{
+		if (!layers.contains(layerId) && layerId < static_cast<int>(_layerMembers.size()))
+		{
+			_layerMembers[layerId].erase(&node);
+		}
+	}
+
+	for (auto layerId : layers)
+	{
+		if (!previousLayers.contains(layerId))
+		{
+			addToMemberIndex(node, layerId);
+		}
+	}
+
+	_nodesNeedingVisibilityUpdate.insert(&node);
+}
+
+void LayerManager::foreachLayerMember(int layerID, const std::function<void(INode&)>& functor)
+{
+	if (!memberIndexIsActive())
+	{
+		LayerMemberWalker walker(layerID, functor);
+		_rootNode.traverseChildren(walker);
+		return;
+	}
+
+	if (layerID < 0 || layerID >= static_cast<int>(_layerMembers.size())) return;
+
+	for (auto node : _layerMembers[layerID])
+	{
+		functor(*node);
+	}
+}
+
 void LayerManager::onLayersChanged()
 {
 	_layersChangedSignal.emit();
@@ -283,10 +520,10 @@ void LayerManager::onNodeMembershipChanged()
 	updateSceneGraphVisibility();
 }
 
-void LayerManager::onLayerVisibilityChanged()
+void LayerManager::onLayerVisibilityChanged(const std::vector<int>& changedLayers)
 {
-	// Update all nodes and views
-	updateSceneGraphVisibility();
+	// Update the affected nodes and views
+	updateSceneGraphVisibility(changedLayers);
 
 	// Update the UI
 	_layerVisibilityChangedSignal.emit();
@@ -394,8 +631,38 @@ void LayerManager::setSelected(int layerId, bool selected)
         layerIds.insert(childLayerId);
     });
 
-	SetLayerSelectedWalker walker(layerIds, selected);
-    _rootNode.traverseChildren(walker);
+    if (!memberIndexIsActive())
+    {
+        SetLayerSelectedWalker walker(layerIds, selected);
+        _rootNode.traverseChildren(walker);
+        return;
+    }
+
+    // Collect the members first, a node can be part of more than one affected layer
+    std::vector<INodePtr> members;
+    std::unordered_set<INode*> visitedNodes;
+
+    for (auto id : layerIds)
+    {
+        foreachLayerMember(id, [&](INode& node)
+        {
+            if (visitedNodes.insert(&node).second)
+            {
+                members.emplace_back(node.getSelf());
+            }
+        });
+    }
+
+    for (const auto& node : members)
+    {
+        // Skip hidden nodes when selecting, like the SetLayerSelectedWalker does
+        if (selected && nodeOrAncestorIsHidden(node)) continue;
+
+        // Skip the worldspawn
+        if (Node_isWorldspawn(node)) continue;
+
+        Node_setSelected(node, selected);
+    }
 }
 
 int LayerManager::getParentLayer(int layerId)
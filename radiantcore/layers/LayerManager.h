@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <map>
+#include <unordered_set>
 #include "ilayer.h"
 
 namespace scene 
@@ -27,6 +28,13 @@ private:
 	// The ID of the active layer
 	int _activeLayer;
 
+	// The scene nodes which are members of each layer, indexed by the layer ID.
+	// This index is maintained as long as the root node is part of the scene.
+	std::vector<std::unordered_set<INode*>> _layerMembers;
+
+	// Nodes which have been inserted or changed their layers since the last visibility update
+	std::unordered_set<INode*> _nodesNeedingVisibilityUpdate;
+
 	sigc::signal<void> _layersChangedSignal;
 	sigc::signal<void> _layerVisibilityChangedSignal;
 	sigc::signal<void> _layerHierarchyChangedSignal;
@@ -112,6 +120,11 @@ public:
 	// Selects/unselects an entire layer
 	void setSelected(int layerID, bool selected) override;
 
+	void onNodeInserted(INode& node) override;
+	void onNodeRemoved(INode& node) override;
+	void onNodeLayersChanged(INode& node, const LayerList& previousLayers) override;
+	void foreachLayerMember(int layerID, const std::function<void(INode&)>& functor) override;
+
     int getParentLayer(int layerId) override;
     void setParentLayer(int childLayerId, int parentLayerId) override;
     bool layerIsChildOf(int candidateLayerId, int parentLayerId) override;
@@ -124,8 +137,9 @@ public:
 private:
     // Recursively sets the visibility of the given layer and updates
     // the flags on the _layerVisibility vector.
+    // Layers which actually changed their visibility are added to the given vector.
     // Returns true if any flag changed, false if nothing changed.
-    bool setLayerVisibilityRecursively(int layerID, bool visible);
+    bool setLayerVisibilityRecursively(int layerID, bool visible, std::vector<int>& changedLayers);
 
     // Invokes the function object with each layer ID in the hierarchy, including the given root
     void foreachLayerInHierarchy(int rootLayerId, const std::function<void(int)>& functor);
@@ -133,14 +147,23 @@ private:
 	// Internal event emitter
 	void onLayersChanged();
 
-	// Internal event, updates the scenegraph
-	void onLayerVisibilityChanged();
+	// Internal event, updates the members of the given layers
+	void onLayerVisibilityChanged(const std::vector<int>& changedLayers);
 
 	// Internal event emitter
 	void onNodeMembershipChanged();
 
-	// Updates the visibility state of the entire scenegraph
-	void updateSceneGraphVisibility();
+	// Updates the visibility state of the members of the given layers
+	// and of all nodes which changed their membership since the last update
+	void updateSceneGraphVisibility(const std::vector<int>& changedLayers = {});
+
+	// Re-evaluates the given nodes bottom-up, propagating any change to their parents
+	void updateNodeVisibilities(const std::unordered_set<INode*>& nodes);
+
+	// True if the member index is maintained, i.e. the root node is part of the scene
+	bool memberIndexIsActive() const;
+
+	void addToMemberIndex(INode& node, int layerID);
 
 	// Returns the highest used layer Id
 	int getHighestLayerID() const;
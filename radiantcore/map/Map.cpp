@@ -38,6 +38,7 @@
 #include "map/algorithm/Export.h"
 #include "scene/Traverse.h"
 #include "map/algorithm/MapExporter.h"
+#include "map/algorithm/MemoryReport.h"
 #include "model/export/ModelExporter.h"
 #include "model/export/ModelScalePreserver.h"
 #include "messages/ScopedLongRunningOperation.h"
@@ -211,6 +212,8 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
     rMessage() << GlobalCounters().getCounter(counterPatches).get() << " patches\n";
     rMessage() << GlobalCounters().getCounter(counterEntities).get() << " entities\n";
 
+    algorithm::printNodeArenaStatistics(_resource->getRootNode());
+
     // Let the filtersystem update the filtered status of all instances
     GlobalFilterSystem().update();
 
@@ -1033,6 +1036,8 @@ void Map::registerCommands()
           cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL, // replace selection with model
           cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL }); // export lights as objects
 
+    GlobalCommandSystem().addCommand("PrintMapMemoryReport", algorithm::printMemoryReportCmd);
+
     // Add undo commands
     GlobalCommandSystem().addCommand("Undo", std::bind(&Map::undoCmd, this, std::placeholders::_1));
     GlobalCommandSystem().addCommand("Redo", std::bind(&Map::redoCmd, this, std::placeholders::_1));
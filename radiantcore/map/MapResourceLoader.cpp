@@ -20,6 +20,9 @@ RootNodePtr MapResourceLoader::load()
     // Create a new map root node
     auto root = std::make_shared<RootNode>("");
 
+    // Allocate the parsed nodes from the map's arena
+    scene::NodeArena::Scope arenaScope(root->getNodeArena());
+
     try
     {
         // Our importer taking care of scene insertion
@@ -6,7 +6,8 @@ namespace map
 {
 
 RootNode::RootNode(const std::string& name) :
-	_name(name)
+	_name(name),
+	_nodeArena(std::make_shared<scene::NodeArena>())
 {
 	// Apply root status to this node
 	setIsRoot(true);
@@ -78,6 +79,21 @@ IUndoSystem& RootNode::getUndoSystem()
     return *_undoSystem;
 }
 
+scene::IMaterialUsageIndex& RootNode::getMaterialUsageIndex()
+{
+    return _materialUsageIndex;
+}
+
+scene::IPendingEvaluationQueue& RootNode::getPendingEvaluationQueue()
+{
+    return _pendingEvaluationQueue;
+}
+
+const scene::NodeArena::Ptr& RootNode::getNodeArena() const
+{
+    return _nodeArena;
+}
+
 std::string RootNode::name() const 
 {
 	return _name;
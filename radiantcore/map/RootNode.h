@@ -10,6 +10,9 @@
 #include "UndoFileChangeTracker.h"
 #include "transformlib.h"
 #include "KeyValueStore.h"
+#include "scene/MaterialUsageIndex.h"
+#include "scene/PendingEvaluationQueue.h"
+#include "scene/NodeArena.h"
 #include "undo/UndoSystem.h"
 #include <sigc++/connection.h>
 
@@ -50,10 +53,17 @@ private:
 
     IUndoSystem::Ptr _undoSystem;
 
+    scene::MaterialUsageIndex _materialUsageIndex;
+
+    scene::PendingEvaluationQueue _pendingEvaluationQueue;
+
 	AABB _emptyAABB;
 
     sigc::connection _undoEventHandler;
 
+    // Nodes loaded or pasted into this map are allocated from this arena
+    scene::NodeArena::Ptr _nodeArena;
+
 public:
 	// Constructor, pass the name of the map to it
 	RootNode(const std::string& name);
@@ -69,6 +79,11 @@ public:
     selection::ISelectionSetManager& getSelectionSetManager() override;
     scene::ILayerManager& getLayerManager() override;
     IUndoSystem& getUndoSystem() override;
+    scene::IMaterialUsageIndex& getMaterialUsageIndex() override;
+    scene::IPendingEvaluationQueue& getPendingEvaluationQueue() override;
+
+    // The arena to make current while creating nodes for this map (see NodeArena::Scope)
+    const scene::NodeArena::Ptr& getNodeArena() const override;
 
 	// Renderable implementation (empty)
     void onPreRender(const VolumeTest& volume) override
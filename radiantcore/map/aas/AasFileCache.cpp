@@ -0,0 +1,140 @@
+#include "AasFileCache.h"
+
+#include <cstdint>
+#include <fstream>
+#include <fmt/format.h>
+#include "itextstream.h"
+#include "os/dir.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "stream/BinaryCacheFile.h"
+#include "string/hash.h"
+#include "Doom3AasFile.h"
+
+namespace map
+{
+
+namespace
+{
+    const char CACHE_FILE_MAGIC[4] = { 'D', 'R', 'A', 'S' };
+    const std::uint32_t CACHE_FILE_VERSION = 1;
+
+    struct SourceFileKey
+    {
+        std::uint64_t sourceSize;
+        std::int64_t sourceModificationTime;
+    };
+
+    // Fills in the size and modification time of the given source file
+    bool getSourceFileKey(const std::string& sourcePath, SourceFileKey& key)
+    {
+        std::error_code ec;
+
+        auto size = fs::file_size(sourcePath, ec);
+        if (ec) return false;
+
+        auto modificationTime = fs::last_write_time(sourcePath, ec);
+        if (ec) return false;
+
+        key.sourceSize = static_cast<std::uint64_t>(size);
+        key.sourceModificationTime = static_cast<std::int64_t>(modificationTime.time_since_epoch().count());
+
+        return true;
+    }
+}
+
+AasFileCache::AasFileCache() :
+    _numHits(0)
+{}
+
+void AasFileCache::setCachePath(const std::string& cachePath)
+{
+    _cachePath = os::standardPathWithSlash(cachePath);
+}
+
+std::string AasFileCache::getCacheFilePath(const std::string& sourcePath) const
+{
+    // Several maps can have AAS files with the same name, include a hash of the full path
+    auto pathHash = string::fnv1a64(os::standardPath(sourcePath));
+
+    return fmt::format("{0}{1}.{2:016x}.bin", _cachePath, fs::path(sourcePath).filename().string(), pathHash);
+}
+
+IAasFilePtr AasFileCache::load(const std::string& sourcePath) const
+{
+    if (_cachePath.empty()) return IAasFilePtr();
+
+    SourceFileKey expected;
+
+    if (!getSourceFileKey(sourcePath, expected))
+    {
+        return IAasFilePtr();
+    }
+
+    std::ifstream stream(getCacheFilePath(sourcePath), std::ios::binary);
+
+    if (!stream || !stream::cache::readHeader(stream, CACHE_FILE_MAGIC, CACHE_FILE_VERSION))
+    {
+        return IAasFilePtr();
+    }
+
+    SourceFileKey key;
+    stream.read(reinterpret_cast<char*>(&key), sizeof(key));
+
+    if (!stream ||
+        key.sourceSize != expected.sourceSize ||
+        key.sourceModificationTime != expected.sourceModificationTime)
+    {
+        return IAasFilePtr(); // stale cache file
+    }
+
+    try
+    {
+        auto aasFile = std::make_shared<Doom3AasFile>();
+        aasFile->readFromBinaryStream(stream);
+
+        ++_numHits;
+        return aasFile;
+    }
+    catch (const std::runtime_error& ex)
+    {
+        rWarning() << "Discarding cached AAS data for " << sourcePath << ": " << ex.what() << std::endl;
+        return IAasFilePtr();
+    }
+}
+
+void AasFileCache::save(const std::string& sourcePath, const IAasFilePtr& aasFile) const
+{
+    auto doom3AasFile = std::dynamic_pointer_cast<Doom3AasFile>(aasFile);
+
+    if (_cachePath.empty() || !doom3AasFile) return;
+
+    SourceFileKey key;
+
+    if (!getSourceFileKey(sourcePath, key) || !os::makeDirectory(_cachePath))
+    {
+        return;
+    }
+
+    auto cacheFilePath = getCacheFilePath(sourcePath);
+    stream::cache::Writer writer(cacheFilePath);
+
+    if (!writer.isOpen())
+    {
+        rWarning() << "Cannot write AAS cache file " << cacheFilePath << std::endl;
+        return;
+    }
+
+    stream::cache::writeHeader(writer.getStream(), CACHE_FILE_MAGIC, CACHE_FILE_VERSION);
+    writer.getStream().write(reinterpret_cast<const char*>(&key), sizeof(key));
+    doom3AasFile->writeToBinaryStream(writer.getStream());
+
+    writer.commit();
+}
+
+std::size_t AasFileCache::getNumHits() const
+{
+    return _numHits;
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "iaasfile.h"
+#include <atomic>
+#include <string>
+
+namespace map
+{
+
+/**
+ * Binary cache for parsed AAS files, storing the finished area, face and
+ * geometry arrays of an AAS file in a compact format that can be read
+ * back without tokenising the text file again.
+ *
+ * Each cache entry is keyed on the source file's size and modification time,
+ * entries not matching the current state of their source file are ignored.
+ */
+class AasFileCache
+{
+private:
+    std::string _cachePath;
+
+    // Files are loaded on worker threads
+    mutable std::atomic<std::size_t> _numHits;
+
+public:
+    AasFileCache();
+
+    // Set the folder the cache files are stored in
+    void setCachePath(const std::string& cachePath);
+
+    // Returns the cached AAS file for the given source path, or an empty
+    // reference if there is no up-to-date cache entry for it
+    IAasFilePtr load(const std::string& sourcePath) const;
+
+    // Writes the given AAS file contents to the cache entry of the given source path.
+    // Only AAS files produced by the Doom 3 loader are supported, others are ignored.
+    void save(const std::string& sourcePath, const IAasFilePtr& aasFile) const;
+
+    // The number of files served by load()
+    std::size_t getNumHits() const;
+
+private:
+    std::string getCacheFilePath(const std::string& sourcePath) const;
+};
+
+}
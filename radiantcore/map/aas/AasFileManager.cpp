@@ -6,6 +6,7 @@
 #include "ieclass.h"
 #include "ifilesystem.h"
 #include "eclass.h"
+#include "time/ScopeTimer.h"
 
 #include "module/StaticModule.h"
 
@@ -136,6 +137,50 @@ std::list<AasFileInfo> AasFileManager::getAasFilesForMap(const std::string& mapP
     return list;
 }
 
+IAasFilePtr AasFileManager::loadAasFile(const AasFileInfo& info)
+{
+    util::ScopeTimer timer("AAS file " + info.absolutePath + " loaded");
+
+    auto cached = _cache.load(info.absolutePath);
+
+    if (cached)
+    {
+        return cached;
+    }
+
+    ArchiveTextFilePtr file = GlobalFileSystem().openTextFileInAbsolutePath(info.absolutePath);
+
+    if (!file)
+    {
+        return IAasFilePtr();
+    }
+
+    std::istream stream(&file->getInputStream());
+    auto loader = getLoaderForStream(stream);
+
+    if (!loader || !loader->canLoad(stream))
+    {
+        rWarning() << "No loader capable of loading the AAS file " << info.absolutePath << std::endl;
+        return IAasFilePtr();
+    }
+
+    stream.seekg(0, std::ios_base::beg);
+
+    auto aasFile = loader->loadFromStream(stream);
+
+    if (aasFile)
+    {
+        _cache.save(info.absolutePath, aasFile);
+    }
+
+    return aasFile;
+}
+
+std::size_t AasFileManager::getNumCacheHits() const
+{
+    return _cache.getNumHits();
+}
+
 const std::string& AasFileManager::getName() const
 {
 	static std::string _name(MODULE_AASFILEMANAGER);
@@ -157,6 +202,7 @@ const StringSet& AasFileManager::getDependencies() const
 
 void AasFileManager::initialiseModule(const IApplicationContext& ctx)
 {
+    _cache.setCachePath(ctx.getCacheDataPath() + "aas/");
 }
 
 // Define the static AasFileManager module
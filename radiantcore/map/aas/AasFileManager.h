@@ -2,6 +2,7 @@
 
 #include "iaasfile.h"
 #include <set>
+#include "AasFileCache.h"
 
 namespace map
 {
@@ -18,6 +19,8 @@ private:
     AasTypeList _typeList;
     bool _typesLoaded;
 
+    AasFileCache _cache;
+
 public:
     AasFileManager();
 
@@ -28,6 +31,8 @@ public:
     AasTypeList getAasTypes() override;
     AasType getAasTypeByName(const std::string& typeName) override;
     std::list<AasFileInfo> getAasFilesForMap(const std::string& mapPath) override;
+    IAasFilePtr loadAasFile(const AasFileInfo& info) override;
+    std::size_t getNumCacheHits() const override;
 
     // RegisterableModule implementation
 	const std::string& getName() const override;
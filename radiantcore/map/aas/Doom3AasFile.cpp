@@ -1,5 +1,10 @@
 #include "Doom3AasFile.h"
 
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
 #include "itextstream.h"
 #include "string/convert.h"
 #include "Util.h"
@@ -25,6 +30,74 @@ namespace map
 #define FACE_LIQUID					(1 << 3)		// face seperating two areas with liquid
 #define FACE_LIQUIDSURFACE			(1 << 4)		// face seperating liquid and air
 
+namespace
+{
+    // Area layout used in the binary stream, the bounds and the center
+    // are stored too, such that finishAreas() can be skipped.
+    // The padding is spelled out, such that no uninitialised bytes end up in the file.
+    struct BinaryArea
+    {
+        double          bounds[6]; // origin and extents
+        double          center[3];
+        std::int32_t    numFaces;
+        std::int32_t    firstFace;
+        std::int32_t    travelFlags;
+        std::uint16_t   flags;
+        std::uint16_t   contents;
+        std::int16_t    cluster;
+        std::int16_t    clusterAreaNum;
+        std::uint32_t   padding;
+    };
+
+    // Face layout used in the binary stream, IAasFile::Face has implicit padding
+    struct BinaryFace
+    {
+        std::int32_t    planeNum;
+        std::uint16_t   flags;
+        std::uint16_t   padding;
+        std::int32_t    numEdges;
+        std::int32_t    firstEdge;
+        std::int16_t    areas[2];
+    };
+
+    static_assert(sizeof(BinaryArea) == 96 && sizeof(BinaryFace) == 20, "Binary AAS layout must not contain implicit padding");
+
+    // Writes the element count followed by the raw contents of the array
+    template<typename Element>
+    void writeArray(std::ostream& stream, const std::vector<Element>& elements)
+    {
+        static_assert(std::is_trivially_copyable<Element>::value, "Element must be trivially copyable");
+
+        auto count = static_cast<std::uint64_t>(elements.size());
+        stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        stream.write(reinterpret_cast<const char*>(elements.data()), sizeof(Element) * elements.size());
+    }
+
+    // Reads an array written by writeArray() straight into the target vector
+    template<typename Element>
+    void readArray(std::istream& stream, std::vector<Element>& elements)
+    {
+        static_assert(std::is_trivially_copyable<Element>::value, "Element must be trivially copyable");
+
+        std::uint64_t count = 0;
+        stream.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+        // Guard against resizing to nonsense in case of a corrupt file
+        if (!stream || count > (1u << 28))
+        {
+            throw std::runtime_error("Invalid array size in AAS binary stream");
+        }
+
+        elements.resize(static_cast<std::size_t>(count));
+        stream.read(reinterpret_cast<char*>(elements.data()), sizeof(Element) * elements.size());
+
+        if (!stream)
+        {
+            throw std::runtime_error("Unexpected end of AAS binary stream");
+        }
+    }
+}
+
 std::size_t Doom3AasFile::getNumPlanes() const
 {
     return _planes.size();
@@ -276,6 +349,137 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
     finishAreas();
 }
 
+void Doom3AasFile::writeToBinaryStream(std::ostream& stream) const
+{
+    // Planes and vertices are flattened to double arrays
+    std::vector<double> planes;
+    planes.reserve(_planes.size() * 4);
+
+    for (const auto& plane : _planes)
+    {
+        planes.insert(planes.end(), { plane.normal().x(), plane.normal().y(), plane.normal().z(), plane.dist() });
+    }
+
+    std::vector<double> vertices;
+    vertices.reserve(_vertices.size() * 3);
+
+    for (const auto& vertex : _vertices)
+    {
+        vertices.insert(vertices.end(), { vertex.x(), vertex.y(), vertex.z() });
+    }
+
+    std::vector<BinaryArea> areas;
+    areas.reserve(_areas.size());
+
+    for (const auto& area : _areas)
+    {
+        const auto& origin = area.bounds.getOrigin();
+        const auto& extents = area.bounds.getExtents();
+
+        BinaryArea binary =
+        {
+            { origin.x(), origin.y(), origin.z(), extents.x(), extents.y(), extents.z() },
+            { area.center.x(), area.center.y(), area.center.z() },
+            area.numFaces, area.firstFace, area.travelFlags,
+            area.flags, area.contents, area.cluster, area.clusterAreaNum,
+            0
+        };
+
+        areas.push_back(binary);
+    }
+
+    std::vector<BinaryFace> faces;
+    faces.reserve(_faces.size());
+
+    for (const auto& face : _faces)
+    {
+        faces.push_back(BinaryFace
+        {
+            face.planeNum, face.flags, 0, face.numEdges, face.firstEdge,
+            { face.areas[0], face.areas[1] }
+        });
+    }
+
+    writeArray(stream, planes);
+    writeArray(stream, vertices);
+    writeArray(stream, _edges);
+    writeArray(stream, _edgeIndex);
+    writeArray(stream, faces);
+    writeArray(stream, _faceIndex);
+    writeArray(stream, areas);
+}
+
+void Doom3AasFile::readFromBinaryStream(std::istream& stream)
+{
+    std::vector<double> planes;
+    std::vector<double> vertices;
+    std::vector<BinaryFace> faces;
+    std::vector<BinaryArea> areas;
+
+    readArray(stream, planes);
+    readArray(stream, vertices);
+    readArray(stream, _edges);
+    readArray(stream, _edgeIndex);
+    readArray(stream, faces);
+    readArray(stream, _faceIndex);
+    readArray(stream, areas);
+
+    _planes.clear();
+    _planes.reserve(planes.size() / 4);
+
+    for (std::size_t i = 0; i + 3 < planes.size(); i += 4)
+    {
+        _planes.emplace_back(planes[i], planes[i + 1], planes[i + 2], planes[i + 3]);
+    }
+
+    _vertices.clear();
+    _vertices.reserve(vertices.size() / 3);
+
+    for (std::size_t i = 0; i + 2 < vertices.size(); i += 3)
+    {
+        _vertices.emplace_back(vertices[i], vertices[i + 1], vertices[i + 2]);
+    }
+
+    _faces.clear();
+    _faces.reserve(faces.size());
+
+    for (const auto& binary : faces)
+    {
+        Face face;
+
+        face.planeNum = binary.planeNum;
+        face.flags = binary.flags;
+        face.numEdges = binary.numEdges;
+        face.firstEdge = binary.firstEdge;
+        face.areas[0] = binary.areas[0];
+        face.areas[1] = binary.areas[1];
+
+        _faces.push_back(face);
+    }
+
+    _areas.clear();
+    _areas.reserve(areas.size());
+
+    for (const auto& binary : areas)
+    {
+        Area area;
+
+        area.bounds = AABB(
+            Vector3(binary.bounds[0], binary.bounds[1], binary.bounds[2]),
+            Vector3(binary.bounds[3], binary.bounds[4], binary.bounds[5]));
+        area.center = Vector3(binary.center[0], binary.center[1], binary.center[2]);
+        area.numFaces = binary.numFaces;
+        area.firstFace = binary.firstFace;
+        area.travelFlags = binary.travelFlags;
+        area.flags = binary.flags;
+        area.contents = binary.contents;
+        area.cluster = binary.cluster;
+        area.clusterAreaNum = binary.clusterAreaNum;
+
+        _areas.push_back(area);
+    }
+}
+
 void Doom3AasFile::finishAreas()
 {
     for (Area& area : _areas)
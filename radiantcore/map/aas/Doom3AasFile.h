@@ -51,6 +51,12 @@ public:
 
     void parseFromTokens(parser::DefTokeniser& tok);
 
+    // Binary representation as used by the AasFileCache, containing
+    // the parsed and finished data in native byte order.
+    // readFromBinaryStream() throws std::runtime_error on failure.
+    void writeToBinaryStream(std::ostream& stream) const;
+    void readFromBinaryStream(std::istream& stream);
+
 private:
     void parseIndex(parser::DefTokeniser& tok, Index& index);
     void finishAreas();
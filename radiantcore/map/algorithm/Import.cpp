@@ -14,6 +14,7 @@
 #include "iscenegraph.h"
 #include "scene/BasicRootNode.h"
 #include "scene/ChildPrimitives.h"
+#include "scene/NodeArena.h"
 #include "map/Map.h"
 #include "scenelib.h"
 #include "entitylib.h"
@@ -342,6 +343,10 @@ void importFromStream(std::istream& stream)
     // Instantiate the default import filter
     SimpleMapImportFilter importFilter;
 
+    // The imported nodes end up in the active map, allocate them from its arena
+    auto mapRoot = GlobalMap().getRoot();
+    scene::NodeArena::Scope arenaScope(mapRoot ? mapRoot->getNodeArena() : scene::NodeArena::Ptr());
+
     try
     {
         auto format = determineMapFormat(stream);
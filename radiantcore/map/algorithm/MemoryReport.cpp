@@ -0,0 +1,139 @@
+#include "MemoryReport.h"
+
+#include <set>
+#include <chrono>
+#include <iomanip>
+
+#include "imap.h"
+#include "imodel.h"
+#include "itextstream.h"
+#include "render/MeshVertex.h"
+#include "scene/NodeArena.h"
+
+#include "brush/BrushNode.h"
+#include "patch/PatchNode.h"
+#include "entity/EntityNode.h"
+
+namespace map
+{
+
+namespace algorithm
+{
+
+namespace
+{
+    struct NodeTypeUsage
+    {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+
+        void add(std::size_t size)
+        {
+            ++count;
+            bytes += size;
+        }
+    };
+
+    std::size_t getStringSize(const std::string& str)
+    {
+        return sizeof(std::string) + (str.capacity() > std::string().capacity() ? str.capacity() + 1 : 0);
+    }
+
+    void printUsage(const std::string& label, const NodeTypeUsage& usage)
+    {
+        rMessage() << "  " << std::left << std::setw(10) << label << std::right
+            << std::setw(10) << usage.count << std::setw(14) << usage.bytes << " bytes" << std::endl;
+    }
+}
+
+void printMemoryReportCmd(const cmd::ArgumentList& args)
+{
+    auto root = GlobalMapModule().getRoot();
+
+    if (!root)
+    {
+        rWarning() << "No map loaded" << std::endl;
+        return;
+    }
+
+    NodeTypeUsage brushes;
+    NodeTypeUsage faces;
+    NodeTypeUsage patches;
+    NodeTypeUsage entities;
+    NodeTypeUsage models;
+
+    // Model geometry is shared between nodes, count every model once
+    std::set<const model::IModel*> visitedModels;
+
+    root->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (auto brushNode = std::dynamic_pointer_cast<BrushNode>(node); brushNode)
+        {
+            brushes.add(brushNode->getMemoryUsage());
+
+            brushNode->getBrush().forEachFace([&](Face& face)
+            {
+                faces.add(face.getMemoryUsage());
+            });
+        }
+        else if (auto patchNode = std::dynamic_pointer_cast<PatchNode>(node); patchNode)
+        {
+            patches.add(patchNode->getMemoryUsage());
+        }
+        else if (auto entityNode = std::dynamic_pointer_cast<entity::EntityNode>(node); entityNode)
+        {
+            auto size = sizeof(entity::EntityNode);
+
+            entityNode->getEntity().forEachKeyValue([&](const std::string& key, const std::string& value)
+            {
+                size += getStringSize(key) + getStringSize(value);
+            });
+
+            entities.add(size);
+        }
+        else if (auto modelNode = Node_getModel(node); modelNode)
+        {
+            const auto& model = modelNode->getIModel();
+            std::size_t size = 0;
+
+            if (visitedModels.insert(&model).second)
+            {
+                size += model.getVertexCount() * sizeof(MeshVertex) +
+                    model.getPolyCount() * 3 * sizeof(unsigned int);
+            }
+
+            models.add(size);
+        }
+
+        return true;
+    });
+
+    rMessage() << "Map memory usage (estimated):" << std::endl;
+    printUsage("Brushes", brushes);
+    printUsage("Faces", faces);
+    printUsage("Patches", patches);
+    printUsage("Entities", entities);
+    printUsage("Models", models);
+
+    auto total = brushes.bytes + faces.bytes + patches.bytes + entities.bytes + models.bytes;
+    rMessage() << "  Total: " << total << " bytes" << std::endl;
+
+    printNodeArenaStatistics(root);
+}
+
+void printNodeArenaStatistics(const scene::IMapRootNodePtr& root)
+{
+    if (!root || !root->getNodeArena()) return;
+
+    auto stats = root->getNodeArena()->getStatistics();
+    auto heapMsecs = std::chrono::duration_cast<std::chrono::milliseconds>(stats.heapTime).count();
+
+    rMessage() << stats.allocations << " node allocations (" << stats.largeAllocations << " unpooled), "
+        << stats.allocations - stats.deallocations << " alive, "
+        << stats.getReservedBytes() / 1024 << " KiB reserved in " << stats.blocks << " blocks, "
+        << heapMsecs << " ms in the system heap" << std::endl;
+}
+
+}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "icommandsystem.h"
+#include "imap.h"
+
+namespace map
+{
+
+namespace algorithm
+{
+
+// Logs the estimated memory used by the brushes, faces, patches, entities and models
+// of the current map, broken down by node type
+void printMemoryReportCmd(const cmd::ArgumentList& args);
+
+// Logs the number of allocations made from the node arena of the given map root,
+// together with the reserved memory and the time spent in the system heap
+void printNodeArenaStatistics(const scene::IMapRootNodePtr& root);
+
+}
+
+}
@@ -10,6 +10,7 @@
 #include "module/StaticModule.h"
 
 #include "import/FbxModelLoader.h"
+#include "import/ModelImporterBase.h"
 #include "export/AseExporter.h"
 #include "export/Lwo2Exporter.h"
 #include "export/WavefrontExporter.h"
@@ -35,6 +36,9 @@ void ModelFormatManager::initialiseModule(const IApplicationContext& ctx)
 {
 	_nullModelLoader.reset(new NullModelLoader);
 
+	_modelCache = std::make_shared<StaticModelCache>();
+	_modelCache->setCachePath(ctx.getCacheDataPath() + "models/");
+
 	module::GlobalModuleRegistry().signal_allModulesInitialised().connect(
 		sigc::mem_fun(this, &ModelFormatManager::postModuleInitialisation)
 	);
@@ -94,6 +98,12 @@ void ModelFormatManager::registerImporter(const IModelImporterPtr& importer)
 	}
 
 	_importers[extension] = importer;
+
+	// Static model importers are sharing the binary model cache
+	if (auto importerBase = std::dynamic_pointer_cast<ModelImporterBase>(importer); importerBase)
+	{
+		importerBase->setModelCache(_modelCache);
+	}
 }
 
 void ModelFormatManager::unregisterImporter(const IModelImporterPtr& importer)
@@ -4,6 +4,7 @@
 #include "imodel.h"
 #include "icommandsystem.h"
 #include "NullModelLoader.h"
+#include "StaticModelCache.h"
 
 namespace model
 {
@@ -22,6 +23,9 @@ private:
 
 	NullModelLoaderPtr _nullModelLoader;
 
+	// Binary cache shared by all static model importers
+	std::shared_ptr<StaticModelCache> _modelCache;
+
 public:
 	const std::string& getName() const override;
 	const StringSet& getDependencies() const override;
@@ -1,10 +1,13 @@
 #include "ModelNodeBase.h"
 
+#include "imap.h"
+
 namespace model
 {
 
 ModelNodeBase::ModelNodeBase() :
-    _attachedToShaders(false)
+    _attachedToShaders(false),
+    _materialUsageIndex(nullptr)
 {}
 
 scene::INode::Type ModelNodeBase::getNodeType() const
@@ -40,6 +43,9 @@ void ModelNodeBase::onInsertIntoScene(scene::IMapRootNode& root)
     // Renderables will acquire their shaders in onPreRender
     createRenderableSurfaces();
 
+    _materialUsageIndex = &root.getMaterialUsageIndex();
+    updateMaterialUsage();
+
     Node::onInsertIntoScene(root);
 }
 
@@ -47,9 +53,43 @@ void ModelNodeBase::onRemoveFromScene(scene::IMapRootNode& root)
 {
     destroyRenderableSurfaces();
 
+    for (const auto& material : _registeredMaterials)
+    {
+        _materialUsageIndex->removeUsage(material, scene::MaterialUsageType::Model, *this);
+    }
+
+    _registeredMaterials.clear();
+    _materialUsageIndex = nullptr;
+
     Node::onRemoveFromScene(root);
 }
 
+void ModelNodeBase::updateMaterialUsage()
+{
+    if (!_materialUsageIndex) return;
+
+    // Each material is counted once per model, regardless of the number of surfaces using it
+    std::set<std::string> activeMaterials(getActiveModelMaterials().begin(), getActiveModelMaterials().end());
+
+    for (const auto& material : _registeredMaterials)
+    {
+        if (activeMaterials.count(material) == 0)
+        {
+            _materialUsageIndex->removeUsage(material, scene::MaterialUsageType::Model, *this);
+        }
+    }
+
+    for (const auto& material : activeMaterials)
+    {
+        if (_registeredMaterials.count(material) == 0)
+        {
+            _materialUsageIndex->addUsage(material, scene::MaterialUsageType::Model, *this);
+        }
+    }
+
+    _registeredMaterials.swap(activeMaterials);
+}
+
 void ModelNodeBase::emplaceRenderableSurface(RenderableModelSurface::Ptr&& surface)
 {
     _renderableSurfaces.emplace_back(std::move(surface));
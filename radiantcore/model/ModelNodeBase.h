@@ -1,6 +1,8 @@
 #pragma once
 
+#include <set>
 #include <vector>
+#include "imaterialusageindex.h"
 #include "scene/Node.h"
 #include "RenderableModelSurface.h"
 
@@ -21,6 +23,10 @@ private:
 
     ShaderPtr _inactiveShader;
 
+    // The index the active materials are registered in while this node is in the scene
+    scene::IMaterialUsageIndex* _materialUsageIndex;
+    std::set<std::string> _registeredMaterials;
+
 protected:
     ModelNodeBase();
 
@@ -49,6 +55,13 @@ protected:
     // Detaches all surfaces from their shaders and clears the _renderableSurfaces collection
     virtual void destroyRenderableSurfaces();
 
+    // To be implemented by subclasses, returns the materials used by the model's surfaces
+    virtual const std::vector<std::string>& getActiveModelMaterials() const = 0;
+
+    // Synchronises the material usage index with the currently active materials,
+    // to be called by subclasses whenever the model's materials have been changed
+    void updateMaterialUsage();
+
     void onVisibilityChanged(bool isVisibleNow) override;
     void onRenderStateChanged() override;
 
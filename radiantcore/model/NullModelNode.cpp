@@ -59,6 +59,11 @@ void NullModelNode::createRenderableSurfaces()
     emplaceRenderableSurface(std::make_shared<NullModelBoxSurface>(_boxSurface, _renderEntity, localToWorld()));
 }
 
+const std::vector<std::string>& NullModelNode::getActiveModelMaterials() const
+{
+    return _nullModel->getActiveMaterials();
+}
+
 void NullModelNode::setRenderSystem(const RenderSystemPtr& renderSystem)
 {
     ModelNodeBase::setRenderSystem(renderSystem);
@@ -45,6 +45,7 @@ public:
 
 protected:
     void createRenderableSurfaces() override;
+    const std::vector<std::string>& getActiveModelMaterials() const override;
 };
 
 } // namespace model
@@ -65,6 +65,11 @@ public:
         return _surface.getIndexArray();
     }
 
+    std::uint64_t getGeometryId() override
+    {
+        return _surface.getGeometryId();
+    }
+
     bool isOriented() override
     {
         return true;
@@ -153,10 +153,11 @@ void StaticModel::applySkin(const decl::ISkin::Ptr& skin)
         }
     }
 
-    captureShaders();
-
-    // greebo: Update the active material list after applying this skin
+    // greebo: Update the active material list after applying this skin,
+    // before notifying the listeners through captureShaders()
     updateMaterialList();
+
+    captureShaders();
 }
 
 void StaticModel::captureShaders()
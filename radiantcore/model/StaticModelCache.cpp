@@ -0,0 +1,325 @@
+#include "StaticModelCache.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <fmt/format.h>
+#include "ifilesystem.h"
+#include "itextstream.h"
+#include "os/dir.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "stream/BinaryCacheFile.h"
+#include "stream/ScopedArchiveBuffer.h"
+#include "string/hash.h"
+#include "StaticModel.h"
+#include "StaticModelSurface.h"
+
+namespace model
+{
+
+namespace
+{
+    const char CACHE_FILE_MAGIC[4] = { 'D', 'R', 'M', 'C' };
+    const std::uint32_t CACHE_FILE_VERSION = 1;
+
+    // Vertices are stored as packed doubles:
+    // texcoord (2), normal (3), vertex (3), tangent (3), bitangent (3), colour (4)
+    constexpr std::size_t NUM_VERTEX_COMPONENTS = 18;
+
+    // Follows the magic and version
+    struct CacheFileHeader
+    {
+        std::uint32_t numSurfaces;
+        std::uint32_t padding;
+        std::uint64_t sourceSize;
+        std::int64_t archiveModificationTime;
+        std::uint64_t contentHash;
+    };
+
+    struct SurfaceHeader
+    {
+        std::uint32_t numVertices;
+        std::uint32_t numIndices;
+        std::uint32_t materialLength;
+        std::uint32_t padding;
+        double bounds[6]; // origin and extents
+    };
+
+    std::int64_t getModificationTime(const std::string& path)
+    {
+        std::error_code ec;
+        auto time = fs::last_write_time(path, ec);
+
+        return ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+    }
+
+    // Reads the material name following a surface header
+    std::string readString(std::istream& stream, std::uint32_t length)
+    {
+        // Guard against allocating nonsense in case of a corrupt file
+        if (length > (1u << 16))
+        {
+            throw std::runtime_error("Invalid string length");
+        }
+
+        std::string value(length, '\0');
+        stream.read(value.data(), length);
+
+        if (!stream)
+        {
+            throw std::runtime_error("Unexpected end of file");
+        }
+
+        return value;
+    }
+
+    void packVertices(const std::vector<MeshVertex>& vertices, std::vector<double>& packed)
+    {
+        packed.resize(vertices.size() * NUM_VERTEX_COMPONENTS);
+        auto* out = packed.data();
+
+        for (const auto& v : vertices)
+        {
+            *out++ = v.texcoord.x(); *out++ = v.texcoord.y();
+            *out++ = v.normal.x(); *out++ = v.normal.y(); *out++ = v.normal.z();
+            *out++ = v.vertex.x(); *out++ = v.vertex.y(); *out++ = v.vertex.z();
+            *out++ = v.tangent.x(); *out++ = v.tangent.y(); *out++ = v.tangent.z();
+            *out++ = v.bitangent.x(); *out++ = v.bitangent.y(); *out++ = v.bitangent.z();
+            *out++ = v.colour.x(); *out++ = v.colour.y(); *out++ = v.colour.z(); *out++ = v.colour.w();
+        }
+    }
+
+    void unpackVertices(const std::vector<double>& packed, std::vector<MeshVertex>& vertices)
+    {
+        vertices.resize(packed.size() / NUM_VERTEX_COMPONENTS);
+        const auto* in = packed.data();
+
+        for (auto& v : vertices)
+        {
+            v.texcoord = TexCoord2f(in[0], in[1]);
+            v.normal = Normal3(in[2], in[3], in[4]);
+            v.vertex = Vertex3(in[5], in[6], in[7]);
+            v.tangent = Normal3(in[8], in[9], in[10]);
+            v.bitangent = Normal3(in[11], in[12], in[13]);
+            v.colour = Vector4(in[14], in[15], in[16], in[17]);
+            in += NUM_VERTEX_COMPONENTS;
+        }
+    }
+
+    template<typename ElementType>
+    void readArray(std::istream& stream, std::vector<ElementType>& array, std::uint32_t count)
+    {
+        // Guard against allocating nonsense in case of a corrupt file
+        if (count > (1u << 26))
+        {
+            throw std::runtime_error("Invalid array size");
+        }
+
+        array.resize(count);
+        stream.read(reinterpret_cast<char*>(array.data()), count * sizeof(ElementType));
+
+        if (!stream)
+        {
+            throw std::runtime_error("Unexpected end of file");
+        }
+    }
+}
+
+void StaticModelCache::setCachePath(const std::string& cachePath)
+{
+    _cachePath = os::standardPathWithSlash(cachePath);
+}
+
+std::string StaticModelCache::getCacheFilePath(const std::string& path) const
+{
+    // Models of the same name are common, include a hash of the full path
+    auto standardPath = os::standardPath(path);
+    auto pathHash = string::fnv1a64(standardPath);
+
+    return fmt::format("{0}{1}.{2:016x}.bin", _cachePath, os::getFilename(path), pathHash);
+}
+
+bool StaticModelCache::getSourceKey(const std::string& path, SourceKey& key) const
+{
+    if (_cachePath.empty()) return false;
+
+    auto isAbsolute = path_is_absolute(path.c_str());
+
+    if (!isAbsolute)
+    {
+        auto fileInfo = GlobalFileSystem().getFileInfo(path);
+
+        if (fileInfo.isEmpty()) return false;
+
+        key.archivePath = fileInfo.getArchivePath();
+
+        if (!fileInfo.getIsPhysicalFile())
+        {
+            // Files in archives are considered unchanged as long as the archive is
+            key.size = fileInfo.getSize();
+            key.archiveModificationTime = getModificationTime(key.archivePath);
+            return true;
+        }
+    }
+
+    // Loose files are often edited, don't rely on their timestamps
+    auto file = isAbsolute ?
+        GlobalFileSystem().openFileInAbsolutePath(path) :
+        GlobalFileSystem().openFile(path);
+
+    if (!file) return false;
+
+    archive::ScopedArchiveBuffer buffer(*file);
+
+    key.size = buffer.length;
+    key.contentHash = string::fnv1a64(buffer.buffer, buffer.length);
+
+    return true;
+}
+
+StaticModelPtr StaticModelCache::load(const std::string& path, const SourceKey& key) const
+{
+    std::ifstream stream(getCacheFilePath(path), std::ios::binary);
+
+    if (!stream || !stream::cache::readHeader(stream, CACHE_FILE_MAGIC, CACHE_FILE_VERSION))
+    {
+        return StaticModelPtr();
+    }
+
+    try
+    {
+        CacheFileHeader header;
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!stream ||
+            header.numSurfaces > (1u << 16) ||
+            header.sourceSize != key.size ||
+            header.archiveModificationTime != key.archiveModificationTime ||
+            header.contentHash != key.contentHash)
+        {
+            return StaticModelPtr(); // stale cache file
+        }
+
+        if (stream::cache::readString(stream, 1u << 16) != key.archivePath)
+        {
+            return StaticModelPtr(); // the file is now served by a different archive
+        }
+
+        std::vector<StaticModelSurfacePtr> surfaces;
+        surfaces.reserve(header.numSurfaces);
+
+        std::vector<double> packedVertices;
+
+        for (std::uint32_t i = 0; i < header.numSurfaces; ++i)
+        {
+            SurfaceHeader surfaceHeader;
+            stream.read(reinterpret_cast<char*>(&surfaceHeader), sizeof(surfaceHeader));
+
+            auto material = readString(stream, surfaceHeader.materialLength);
+
+            if (surfaceHeader.numVertices > (1u << 22))
+            {
+                throw std::runtime_error("Invalid vertex count");
+            }
+
+            readArray(stream, packedVertices, surfaceHeader.numVertices * static_cast<std::uint32_t>(NUM_VERTEX_COMPONENTS));
+
+            std::vector<MeshVertex> vertices;
+            unpackVertices(packedVertices, vertices);
+
+            std::vector<unsigned int> indices;
+            readArray(stream, indices, surfaceHeader.numIndices);
+
+            for (auto index : indices)
+            {
+                if (index >= surfaceHeader.numVertices) throw std::runtime_error("Invalid vertex index");
+            }
+
+            const auto* bounds = surfaceHeader.bounds;
+
+            auto& surface = surfaces.emplace_back(std::make_shared<StaticModelSurface>(
+                std::move(vertices), std::move(indices),
+                AABB(Vector3(bounds[0], bounds[1], bounds[2]), Vector3(bounds[3], bounds[4], bounds[5]))));
+
+            surface->setDefaultMaterial(material);
+        }
+
+        auto model = std::make_shared<StaticModel>(surfaces);
+
+        model->setFilename(os::getFilename(path));
+        model->setModelPath(path);
+
+        return model;
+    }
+    catch (const std::runtime_error& ex)
+    {
+        rWarning() << "Discarding cached model data for " << path << ": " << ex.what() << std::endl;
+        return StaticModelPtr();
+    }
+}
+
+void StaticModelCache::save(const std::string& path, const SourceKey& key, const StaticModel& model) const
+{
+    if (_cachePath.empty() || !os::makeDirectory(_cachePath))
+    {
+        return;
+    }
+
+    // Models are loaded on several threads, other threads must never see a half-written file
+    auto cacheFilePath = getCacheFilePath(path);
+    stream::cache::Writer writer(cacheFilePath);
+
+    if (!writer.isOpen())
+    {
+        rWarning() << "Cannot write model cache file " << cacheFilePath << std::endl;
+        return;
+    }
+
+    auto& stream = writer.getStream();
+
+    CacheFileHeader header;
+    header.numSurfaces = static_cast<std::uint32_t>(model.getSurfaceCount());
+    header.padding = 0;
+    header.sourceSize = key.size;
+    header.archiveModificationTime = key.archiveModificationTime;
+    header.contentHash = key.contentHash;
+
+    stream::cache::writeHeader(stream, CACHE_FILE_MAGIC, CACHE_FILE_VERSION);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream::cache::writeString(stream, key.archivePath);
+
+    std::vector<double> packedVertices;
+
+    for (std::uint32_t i = 0; i < header.numSurfaces; ++i)
+    {
+        const auto& surface = static_cast<const StaticModelSurface&>(model.getSurface(i));
+
+        const auto& vertices = surface.getVertexArray();
+        const auto& indices = surface.getIndexArray();
+        const auto& material = surface.getDefaultMaterial();
+        const auto& bounds = surface.getAABB();
+
+        SurfaceHeader surfaceHeader =
+        {
+            static_cast<std::uint32_t>(vertices.size()),
+            static_cast<std::uint32_t>(indices.size()),
+            static_cast<std::uint32_t>(material.size()),
+            0,
+            {
+                bounds.origin.x(), bounds.origin.y(), bounds.origin.z(),
+                bounds.extents.x(), bounds.extents.y(), bounds.extents.z()
+            }
+        };
+
+        stream.write(reinterpret_cast<const char*>(&surfaceHeader), sizeof(surfaceHeader));
+        stream.write(material.data(), material.size());
+
+        packVertices(vertices, packedVertices);
+        stream.write(reinterpret_cast<const char*>(packedVertices.data()), packedVertices.size() * sizeof(double));
+        stream.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(unsigned int));
+    }
+
+    writer.commit();
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace model
+{
+
+class StaticModel;
+typedef std::shared_ptr<StaticModel> StaticModelPtr;
+
+/**
+ * Binary cache for static models (ASE, LWO, OBJ, FBX), storing the finished
+ * surfaces of a model (vertices including normals and tangents, indices,
+ * bounds and default materials), such that a model can be read back without
+ * running the format parser and the tangent calculation again.
+ *
+ * Each source file gets its own cache file. The entries are keyed on the
+ * state of the source: files in archives are identified by their size and
+ * the modification time of the archive, physical files by their size and
+ * a hash of their contents.
+ */
+class StaticModelCache
+{
+public:
+    struct SourceKey
+    {
+        std::string archivePath;
+        std::uint64_t size = 0;
+        std::int64_t archiveModificationTime = 0; // archived files only
+        std::uint64_t contentHash = 0;            // physical files only
+    };
+
+private:
+    std::string _cachePath;
+
+public:
+    // Set the folder the cache files are stored in
+    void setCachePath(const std::string& cachePath);
+
+    // Determines the key of the given model file (VFS or absolute path),
+    // returns false if the file cannot be found or the cache is disabled
+    bool getSourceKey(const std::string& path, SourceKey& key) const;
+
+    // Returns the cached model for the given path, or an empty reference
+    // if there is no cache entry matching the given source key
+    StaticModelPtr load(const std::string& path, const SourceKey& key) const;
+
+    // Writes the surfaces of the given model to the cache entry of the given path
+    void save(const std::string& path, const SourceKey& key, const StaticModel& model) const;
+
+private:
+    std::string getCacheFilePath(const std::string& path) const;
+};
+
+}
@@ -32,6 +32,11 @@ void StaticModelNode::createRenderableSurfaces()
     });
 }
 
+const std::vector<std::string>& StaticModelNode::getActiveModelMaterials() const
+{
+    return _model->getActiveMaterials();
+}
+
 void StaticModelNode::onInsertIntoScene(scene::IMapRootNode& root)
 {
     _model->connectUndoSystem(root.getUndoSystem());
@@ -100,6 +105,8 @@ void StaticModelNode::onModelShadersChanged()
     // Detach renderables on model shader change,
     // they will be refreshed next time things are rendered
     detachFromShaders();
+
+    updateMaterialUsage();
 }
 
 // Traceable implementation
@@ -82,6 +82,7 @@ public:
 
 protected:
     void createRenderableSurfaces() override;
+    const std::vector<std::string>& getActiveModelMaterials() const override;
 
 	void _onTransformationChanged() override;
 	void _applyTransformation() override;
@@ -35,14 +35,19 @@ private:
 	std::string _activeMaterial;
 
 	// Vector of MeshVertex structures, containing the coordinates,
-	// normals, tangents and texture coordinates of the component vertices
+	// normals, tangents and texture coordinates of the component vertices.
+	// Copies of this surface share the same arrays until they are scaled,
+	// such that the renderer can draw all copies from the same storage.
 	typedef std::vector<MeshVertex> VertexVector;
-	VertexVector _vertices;
+	std::shared_ptr<VertexVector> _vertices;
 
 	// Vector of render indices, representing the groups of vertices to be
-	// used to create triangles
+	// used to create triangles. These never change and are shared by all copies.
 	typedef std::vector<unsigned int> Indices;
-	Indices _indices;
+	std::shared_ptr<const Indices> _indices;
+
+	// Identifies the arrays above, a new id is assigned whenever a new vertex array is created
+	std::uint64_t _geometryId;
 
 	// The AABB containing this surface, in local object space.
 	AABB _localAABB;
@@ -55,7 +60,11 @@ public:
     // Move-construct this static model surface from the given vertex- and index array
 	StaticModelSurface(std::vector<MeshVertex>&& vertices, std::vector<unsigned int>&& indices);
 
-	// Copy-constructor. All vertices and indices will be copied from 'other'.
+	// Move-construct this surface from finished vertex data (including the tangent vectors)
+	// and its bounds, as produced by the other constructor. No further calculations are done.
+	StaticModelSurface(std::vector<MeshVertex>&& vertices, std::vector<unsigned int>&& indices, const AABB& localAABB);
+
+	// Copy-constructor. The vertex and index arrays are shared with 'other'.
 	StaticModelSurface(const StaticModelSurface& other);
 
 	/** Get the containing AABB for this surface.
@@ -79,6 +88,7 @@ public:
 
 	const std::vector<MeshVertex>& getVertexArray() const override;
 	const std::vector<unsigned int>& getIndexArray() const override;
+	std::uint64_t getGeometryId() const override;
 
 	const std::string& getDefaultMaterial() const override;
 	void setDefaultMaterial(const std::string& defaultMaterial);
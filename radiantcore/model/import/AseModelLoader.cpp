@@ -17,7 +17,7 @@ AseModelLoader::AseModelLoader() :
     ModelImporterBase("ASE")
 {}
 
-IModelPtr AseModelLoader::loadModelFromPath(const std::string& path)
+IModelPtr AseModelLoader::loadModelFromFile(const std::string& path)
 {
     // Open an ArchiveFile to load
     auto file = path_is_absolute(path.c_str()) ?
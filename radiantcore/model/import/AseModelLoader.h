@@ -11,8 +11,9 @@ class AseModelLoader :
 public:
     AseModelLoader();
 
+protected:
     // Load the given model from the path, VFS or absolute
-    IModelPtr loadModelFromPath(const std::string& name) override;
+    IModelPtr loadModelFromFile(const std::string& name) override;
 };
 
 } // namespace model
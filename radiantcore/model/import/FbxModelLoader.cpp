@@ -39,7 +39,7 @@ inline MeshVertex ConstructMeshVertex(const ofbx::Geometry& geometry, int index)
 
 }
 
-IModelPtr FbxModelLoader::loadModelFromPath(const std::string& path)
+IModelPtr FbxModelLoader::loadModelFromFile(const std::string& path)
 {
     // Open an ArchiveFile to load
     auto file = path_is_absolute(path.c_str()) ?
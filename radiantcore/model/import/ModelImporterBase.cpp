@@ -7,6 +7,7 @@
 #include "os/path.h"
 #include "../StaticModelNode.h"
 #include "../StaticModel.h"
+#include "../StaticModelCache.h"
 
 namespace model
 {
@@ -33,6 +34,35 @@ const std::string& ModelImporterBase::getExtension() const
     return _extension;
 }
 
+void ModelImporterBase::setModelCache(const std::shared_ptr<StaticModelCache>& modelCache)
+{
+    _modelCache = modelCache;
+}
+
+IModelPtr ModelImporterBase::loadModelFromPath(const std::string& path)
+{
+    StaticModelCache::SourceKey key;
+
+    if (!_modelCache || !_modelCache->getSourceKey(path, key))
+    {
+        return loadModelFromFile(path);
+    }
+
+    if (auto cached = _modelCache->load(path, key); cached)
+    {
+        return cached;
+    }
+
+    auto model = loadModelFromFile(path);
+
+    if (auto staticModel = std::dynamic_pointer_cast<StaticModel>(model); staticModel)
+    {
+        _modelCache->save(path, key, *staticModel);
+    }
+
+    return model;
+}
+
 scene::INodePtr ModelImporterBase::loadModel(const std::string& modelName)
 {
     // Initialise the paths, this is all needed for realisation
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "imodel.h"
+#include <memory>
 
 namespace model
 {
 
+class StaticModelCache;
+
 class ModelImporterBase :
     public IModelImporter
 {
@@ -12,6 +15,9 @@ private:
     // Supported file extension in UPPERCASE (ASE, LWO, whatever)
     std::string _extension;
 
+    // Binary cache of previously loaded models, can be empty
+    std::shared_ptr<StaticModelCache> _modelCache;
+
 public:
     ModelImporterBase(const std::string& extension);
 
@@ -19,6 +25,17 @@ public:
 
     // Returns a new ModelNode for the given model name
     scene::INodePtr loadModel(const std::string& modelName) override;
+
+    // Returns the model from the binary cache if it is up to date,
+    // otherwise the file is parsed and the result is written to the cache
+    IModelPtr loadModelFromPath(const std::string& path) override;
+
+    // Set the binary model cache to use, this is done by the ModelFormatManager
+    void setModelCache(const std::shared_ptr<StaticModelCache>& modelCache);
+
+protected:
+    // Parse the given model file, VFS or absolute path
+    virtual IModelPtr loadModelFromFile(const std::string& path) = 0;
 };
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
 #include "math/Vector3.h"
 #include "math/Quaternion.h"
 
@@ -77,6 +78,72 @@ struct MD5Weight
 
 typedef std::vector<MD5Weight> MD5Weights;
 
+/**
+ * Single-precision pose of a joint, used as entry of the skinning palette.
+ * Stored as 3x4 matrix in column-major order (with each column padded to
+ * four floats), the last column holds the joint translation.
+ */
+struct MD5JointMatrix
+{
+	alignas(16) float columns[4][4];
+
+	MD5JointMatrix()
+	{}
+
+	MD5JointMatrix(const Quaternion& orientation, const Vector3& origin)
+	{
+		const auto x = orientation.x();
+		const auto y = orientation.y();
+		const auto z = orientation.z();
+		const auto w = orientation.w();
+
+		// Same terms as used by Quaternion::transformPoint()
+		columns[0][0] = static_cast<float>(w*w + x*x - y*y - z*z);
+		columns[0][1] = static_cast<float>(2*(x*y + z*w));
+		columns[0][2] = static_cast<float>(2*(x*z - y*w));
+		columns[0][3] = 0;
+
+		columns[1][0] = static_cast<float>(2*(x*y - z*w));
+		columns[1][1] = static_cast<float>(w*w - x*x + y*y - z*z);
+		columns[1][2] = static_cast<float>(2*(y*z + x*w));
+		columns[1][3] = 0;
+
+		columns[2][0] = static_cast<float>(2*(x*z + y*w));
+		columns[2][1] = static_cast<float>(2*(y*z - x*w));
+		columns[2][2] = static_cast<float>(w*w - x*x - y*y + z*z);
+		columns[2][3] = 0;
+
+		columns[3][0] = static_cast<float>(origin.x());
+		columns[3][1] = static_cast<float>(origin.y());
+		columns[3][2] = static_cast<float>(origin.z());
+		columns[3][3] = 0;
+	}
+};
+
+typedef std::vector<MD5JointMatrix> MD5JointPalette;
+
+/**
+ * The weights of an MD5Mesh, rearranged for skinning: single-precision
+ * structure-of-arrays layout, with the weights of each vertex stored
+ * contiguously. The weight offsets are pre-multiplied by the weight factor.
+ * The weights of vertex i are found in the range
+ * [vertexWeightStart[i]..vertexWeightStart[i+1]).
+ */
+struct MD5SkinningData
+{
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> t;
+	std::vector<std::uint32_t> joint;
+
+	// One entry per vertex, plus one terminating entry
+	std::vector<std::uint32_t> vertexWeightStart;
+
+	// The number of joints referenced by the weights (highest index + 1)
+	std::size_t numJoints = 0;
+};
+
 // The combination of vertices, triangles and weighting information
 // represents our MD5 mesh - using this info it's possible to create
 // the actual rendered geometry (position, normals, etc.)
@@ -85,6 +152,9 @@ struct MD5Mesh
 	MD5Verts	vertices;
 	MD5Tris		triangles;
 	MD5Weights	weights;
+
+	// Generated from the above after parsing
+	MD5SkinningData skinning;
 };
 typedef std::shared_ptr<MD5Mesh> MD5MeshPtr;
 
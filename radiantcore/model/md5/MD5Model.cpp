@@ -6,11 +6,18 @@
 #include "string/convert.h"
 #include "math/Quaternion.h"
 #include "math/Ray.h"
+#include "util/ParallelFor.h"
 #include "MD5DataStructures.h"
 
 namespace md5
 {
 
+namespace
+{
+	// Models with fewer vertices are skinned in the calling thread
+	constexpr std::size_t PARALLEL_SKINNING_MIN_VERTICES = 8192;
+}
+
 MD5Model::MD5Model() :
 	_polyCount(0),
 	_vertexCount(0)
@@ -303,6 +310,9 @@ void MD5Model::setAnim(const IMD5AnimPtr& anim)
 {
 	_anim = anim;
 
+	// Force the next updateAnim() call to re-evaluate the skeleton
+	_skeleton.clear();
+
 	if (!_anim)
 	{
         for (const auto& surface : _surfaces)
@@ -321,14 +331,22 @@ void MD5Model::updateAnim(std::size_t time)
 {
 	if (!_anim) return; // nothing to do
 
-	// Update our joint hierarchy first
-	_skeleton.update(_anim, time);
-
-    for (const auto& surface : _surfaces)
+	// Update our joint hierarchy first, the surfaces don't need
+	// to be touched if the skeleton is still in the requested pose
+	if (!_skeleton.update(_anim, time))
 	{
-		surface->updateToSkeleton(_skeleton);
+		return;
 	}
 
+	// Surfaces are independent of each other, skin them in parallel
+	// if the model is large enough to outweigh the threading overhead
+	auto minSurfacesPerThread = _vertexCount < PARALLEL_SKINNING_MIN_VERTICES ? _surfaces.size() : 1;
+
+	util::parallelFor(_surfaces.size(), minSurfacesPerThread, [&](std::size_t i)
+	{
+		_surfaces[i]->updateToSkeleton(_skeleton);
+	});
+
     updateAABB();
 
     signal_ModelAnimationUpdated().emit();
@@ -82,6 +82,11 @@ void MD5ModelNode::createRenderableSurfaces()
     });
 }
 
+const std::vector<std::string>& MD5ModelNode::getActiveModelMaterials() const
+{
+    return _model->getActiveMaterials();
+}
+
 void MD5ModelNode::testSelect(Selector& selector, SelectionTest& test)
 {
     _model->testSelect(selector, test, localToWorld());
@@ -129,6 +134,8 @@ void MD5ModelNode::onModelShadersChanged()
 {
     // Detach from existing shaders, re-acquire them in onPreRender
     detachFromShaders();
+
+    updateMaterialUsage();
 }
 
 void MD5ModelNode::onModelAnimationUpdated()
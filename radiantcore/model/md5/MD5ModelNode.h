@@ -68,6 +68,7 @@ public:
 
 protected:
     void createRenderableSurfaces() override;
+    const std::vector<std::string>& getActiveModelMaterials() const override;
 
 private:
     void onModelAnimationUpdated();
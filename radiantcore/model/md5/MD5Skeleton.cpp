@@ -65,9 +65,15 @@ namespace
 	}
 }
 
-void MD5Skeleton::update(const IMD5AnimPtr& anim, std::size_t time)
+bool MD5Skeleton::update(const IMD5AnimPtr& anim, std::size_t time)
 {
+	if (_anim && _anim == anim && _time == time)
+	{
+		return false; // skeleton is up to date
+	}
+
 	_anim = anim;
+	_time = time;
 
 	// Update the joint positions, recursively, starting from the first
 	// Only root nodes need to be processed, the children are reached through them
@@ -77,6 +83,12 @@ void MD5Skeleton::update(const IMD5AnimPtr& anim, std::size_t time)
 	if (_skeleton.size() != numJoints)
 	{
 		_skeleton.resize(numJoints);
+		_palette.resize(numJoints);
+	}
+
+	if (numJoints == 0)
+	{
+		return true;
 	}
 
 	// Calculate the current frame number
@@ -178,6 +190,22 @@ void MD5Skeleton::update(const IMD5AnimPtr& anim, std::size_t time)
 			updateJointRecursively(i);
 		}
 	}
+
+	// Convert the final joint poses into the skinning palette
+	for (std::size_t i = 0; i < numJoints; ++i)
+	{
+		_palette[i] = MD5JointMatrix(_skeleton[i].orientation, _skeleton[i].origin);
+	}
+
+	return true;
+}
+
+void MD5Skeleton::clear()
+{
+	_anim.reset();
+	_time = 0;
+	_skeleton.clear();
+	_palette.clear();
 }
 
 void MD5Skeleton::updateJointRecursively(std::size_t jointId)
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include "imd5anim.h"
+#include "MD5DataStructures.h"
 
 namespace md5
 {
@@ -17,12 +18,22 @@ protected:
 	// The position and orientation of the animated joints at the current time
 	std::vector<IMD5Anim::Key> _skeleton;
 
+	// The joint poses above as single-precision matrices, used for skinning
+	MD5JointPalette _palette;
+
 	// The current animation, needed to get joint information etc.
 	IMD5AnimPtr _anim;
 
+	// The time passed to the last update() call
+	std::size_t _time = 0;
+
 public:
-	// Update the skeleton to match the given animation at the given time
-	void update(const IMD5AnimPtr& anim, std::size_t time);
+	// Update the skeleton to match the given animation at the given time.
+	// Returns false if the skeleton is already in this state and nothing changed.
+	bool update(const IMD5AnimPtr& anim, std::size_t time);
+
+	// Discards the current state, the next update() call will re-evaluate all joints
+	void clear();
 
 	std::size_t size() const
 	{
@@ -34,6 +45,12 @@ public:
 		return _skeleton[jointIndex];
 	}
 
+	// The current joint poses, calculated once per update()
+	const MD5JointPalette& getJointPalette() const
+	{
+		return _palette;
+	}
+
 	const Joint& getJoint(std::size_t index) const
 	{
 		return _anim->getJoint(index);
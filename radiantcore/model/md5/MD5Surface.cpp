@@ -1,10 +1,16 @@
 #include "MD5Surface.h"
 
+#include <cmath>
 #include "ivolumetest.h"
 #include "string/convert.h"
 #include "MD5Model.h"
 #include "math/Ray.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MD5_SKINNING_SSE
+#endif
+
 namespace md5
 {
 
@@ -182,29 +188,40 @@ const AABB& MD5Surface::getSurfaceBounds() const
 
 void MD5Surface::updateToDefaultPose(const MD5Joints& joints)
 {
-	if (_vertices.size() != _mesh->vertices.size())
+	MD5JointPalette palette;
+	palette.reserve(joints.size());
+
+	for (const auto& joint : joints)
 	{
-		_vertices.resize(_mesh->vertices.size());
+		palette.emplace_back(joint.rotation, joint.position);
 	}
 
-	for (std::size_t j = 0; j < _mesh->vertices.size(); ++j)
+	updateToPalette(palette);
+}
+
+void MD5Surface::updateToSkeleton(const MD5Skeleton& skeleton)
+{
+	updateToPalette(skeleton.getJointPalette());
+}
+
+void MD5Surface::updateToPalette(const MD5JointPalette& palette)
+{
+	const auto& skinning = _mesh->skinning;
+
+	if (palette.size() < skinning.numJoints)
 	{
-		MD5Vert& vert = _mesh->vertices[j];
+		return; // palette doesn't match this mesh, leave the vertices alone
+	}
 
-		Vector3 skinned(0, 0, 0);
+	// Ensure we have all vertices allocated, the texcoords never change
+	if (_vertices.size() != _mesh->vertices.size())
+	{
+		_vertices.resize(_mesh->vertices.size());
 
-		for (std::size_t k = 0; k != vert.weight_count; ++k)
+		for (std::size_t j = 0; j < _mesh->vertices.size(); ++j)
 		{
-			MD5Weight& weight = _mesh->weights[vert.weight_index + k];
-			const MD5Joint& joint = joints[weight.joint];
-
-			Vector3 rotatedPoint = joint.rotation.transformPoint(weight.v);
-			skinned += (rotatedPoint + joint.position) * weight.t;
+			_vertices[j].texcoord = TexCoord2f(_mesh->vertices[j].u, _mesh->vertices[j].v);
 		}
-
-		_vertices[j].vertex = skinned;
-		_vertices[j].texcoord = TexCoord2f(vert.u, vert.v);
-		_vertices[j].normal = Normal3(0,0,0);
 	}
 
 	// Ensure the index array is ok
@@ -213,74 +230,151 @@ void MD5Surface::updateToDefaultPose(const MD5Joints& joints)
 		buildIndexArray();
 	}
 
+	skinVertices(palette);
 	buildVertexNormals();
 
+	// Copy the results over to the render vertices
+	for (std::size_t j = 0; j < _vertices.size(); ++j)
+	{
+		auto& vertex = _vertices[j];
+
+		vertex.vertex = Vertex3(_skinned.x[j], _skinned.y[j], _skinned.z[j]);
+		vertex.normal = Normal3(_skinned.normalX[j], _skinned.normalY[j], _skinned.normalZ[j]);
+		vertex.tangent = Normal3(0, 0, 0);
+		vertex.bitangent = Normal3(0, 0, 0);
+	}
+
 	updateGeometry();
 }
 
-void MD5Surface::updateToSkeleton(const MD5Skeleton& skeleton)
+void MD5Surface::skinVertices(const MD5JointPalette& palette)
 {
-	// Ensure we have all vertices allocated
-	if (_vertices.size() != _mesh->vertices.size())
-	{
-		_vertices.resize(_mesh->vertices.size());
-	}
+	const auto& skinning = _mesh->skinning;
+	auto numVertices = _vertices.size();
+
+	_skinned.resize(numVertices);
 
-	// Deform vertices to fit the skeleton
-	for (std::size_t j = 0; j < _mesh->vertices.size(); ++j)
+	// Deform vertices to fit the skeleton, each vertex is the sum
+	// of its (pre-weighted) weight positions transformed by their joint
+	for (std::size_t j = 0; j < numVertices; ++j)
 	{
-		MD5Vert& vert = _mesh->vertices[j];
+		auto firstWeight = skinning.vertexWeightStart[j];
+		auto endWeight = skinning.vertexWeightStart[j + 1];
 
-		Vector3 skinned(0, 0, 0);
+#ifdef MD5_SKINNING_SSE
+		auto sum = _mm_setzero_ps();
 
-		for (std::size_t k = 0; k != vert.weight_count; ++k)
+		for (auto w = firstWeight; w < endWeight; ++w)
 		{
-			MD5Weight& weight = _mesh->weights[vert.weight_index + k];
-			const IMD5Anim::Key& key = skeleton.getKey(weight.joint);
-			//const Joint& joint = skeleton.getJoint(weight.joint);
+			const auto& columns = palette[skinning.joint[w]].columns;
 
-			Vector3 rotatedPoint = key.orientation.transformPoint(weight.v);
-			skinned += (rotatedPoint + key.origin) * weight.t;
+			auto point = _mm_mul_ps(_mm_load_ps(columns[0]), _mm_set1_ps(skinning.x[w]));
+			point = _mm_add_ps(point, _mm_mul_ps(_mm_load_ps(columns[1]), _mm_set1_ps(skinning.y[w])));
+			point = _mm_add_ps(point, _mm_mul_ps(_mm_load_ps(columns[2]), _mm_set1_ps(skinning.z[w])));
+			point = _mm_add_ps(point, _mm_mul_ps(_mm_load_ps(columns[3]), _mm_set1_ps(skinning.t[w])));
+
+			sum = _mm_add_ps(sum, point);
 		}
 
-		_vertices[j].vertex = skinned;
-		_vertices[j].texcoord = TexCoord2f(vert.u, vert.v);
-		_vertices[j].normal = Normal3(0,0,0);
-	}
+		alignas(16) float result[4];
+		_mm_store_ps(result, sum);
 
-	// Ensure the index array is ok
-	if (_indices.empty())
-	{
-		buildIndexArray();
-	}
+		_skinned.x[j] = result[0];
+		_skinned.y[j] = result[1];
+		_skinned.z[j] = result[2];
+#else
+		float x = 0, y = 0, z = 0;
 
-	buildVertexNormals();
+		for (auto w = firstWeight; w < endWeight; ++w)
+		{
+			const auto& columns = palette[skinning.joint[w]].columns;
 
-	updateGeometry();
+			x += columns[0][0] * skinning.x[w] + columns[1][0] * skinning.y[w] + columns[2][0] * skinning.z[w] + columns[3][0] * skinning.t[w];
+			y += columns[0][1] * skinning.x[w] + columns[1][1] * skinning.y[w] + columns[2][1] * skinning.z[w] + columns[3][1] * skinning.t[w];
+			z += columns[0][2] * skinning.x[w] + columns[1][2] * skinning.y[w] + columns[2][2] * skinning.z[w] + columns[3][2] * skinning.t[w];
+		}
+
+		_skinned.x[j] = x;
+		_skinned.y[j] = y;
+		_skinned.z[j] = z;
+#endif
+	}
 }
 
 void MD5Surface::buildVertexNormals()
 {
-	for (Indices::iterator j = _indices.begin(); j != _indices.end(); j += 3)
+	auto& normalX = _skinned.normalX;
+	auto& normalY = _skinned.normalY;
+	auto& normalZ = _skinned.normalZ;
+
+	std::fill(normalX.begin(), normalX.end(), 0.0f);
+	std::fill(normalY.begin(), normalY.end(), 0.0f);
+	std::fill(normalZ.begin(), normalZ.end(), 0.0f);
+
+	const auto& x = _skinned.x;
+	const auto& y = _skinned.y;
+	const auto& z = _skinned.z;
+
+	for (auto j = _indices.begin(); j != _indices.end(); j += 3)
 	{
-		auto& a = _vertices[*(j + 0)];
-		auto& b = _vertices[*(j + 1)];
-		auto& c = _vertices[*(j + 2)];
+		auto a = *(j + 0);
+		auto b = *(j + 1);
+		auto c = *(j + 2);
+
+		// weightedNormal = (c - a).cross(b - a)
+		auto e1x = x[c] - x[a], e1y = y[c] - y[a], e1z = z[c] - z[a];
+		auto e2x = x[b] - x[a], e2y = y[b] - y[a], e2z = z[b] - z[a];
 
-		Vector3 weightedNormal((c.vertex - a.vertex).cross(b.vertex - a.vertex));
+		auto nx = e1y * e2z - e1z * e2y;
+		auto ny = e1z * e2x - e1x * e2z;
+		auto nz = e1x * e2y - e1y * e2x;
 
-		a.normal += weightedNormal;
-		b.normal += weightedNormal;
-		c.normal += weightedNormal;
+		normalX[a] += nx; normalY[a] += ny; normalZ[a] += nz;
+		normalX[b] += nx; normalY[b] += ny; normalZ[b] += nz;
+		normalX[c] += nx; normalY[c] += ny; normalZ[c] += nz;
 	}
 
-	// Normalise all normal vectors
-	for (auto& vertex : _vertices)
+	// Normalise all normal vectors, this loop is straight enough to be vectorised
+	for (std::size_t j = 0; j < normalX.size(); ++j)
 	{
-        vertex.normal.normalise();
+		auto lengthSquared = normalX[j] * normalX[j] + normalY[j] * normalY[j] + normalZ[j] * normalZ[j];
+		auto inverseLength = lengthSquared > 0 ? 1.0f / std::sqrt(lengthSquared) : 0.0f;
+
+		normalX[j] *= inverseLength;
+		normalY[j] *= inverseLength;
+		normalZ[j] *= inverseLength;
 	}
 }
 
+void MD5Surface::buildSkinningData()
+{
+	auto& mesh = *_mesh;
+	auto& skinning = mesh.skinning;
+
+	skinning = MD5SkinningData();
+	skinning.vertexWeightStart.reserve(mesh.vertices.size() + 1);
+
+	for (const auto& vert : mesh.vertices)
+	{
+		skinning.vertexWeightStart.push_back(static_cast<std::uint32_t>(skinning.t.size()));
+
+		for (std::size_t k = 0; k < vert.weight_count; ++k)
+		{
+			const auto& weight = mesh.weights.at(vert.weight_index + k);
+
+			skinning.x.push_back(static_cast<float>(weight.v.x() * weight.t));
+			skinning.y.push_back(static_cast<float>(weight.v.y() * weight.t));
+			skinning.z.push_back(static_cast<float>(weight.v.z() * weight.t));
+			skinning.t.push_back(weight.t);
+			skinning.joint.push_back(static_cast<std::uint32_t>(weight.joint));
+
+			skinning.numJoints = std::max(skinning.numJoints, static_cast<std::size_t>(weight.joint + 1));
+		}
+	}
+
+	skinning.vertexWeightStart.push_back(static_cast<std::uint32_t>(skinning.t.size()));
+}
+
 void MD5Surface::buildIndexArray()
 {
 	_indices.clear();
@@ -388,6 +482,8 @@ void MD5Surface::parseFromTokens(parser::DefTokeniser& tok)
 	// ----- END OF MESH DECL -----
 
 	tok.assertNextToken("}");
+
+	buildSkinningData();
 }
 
 } // namespace
@@ -42,6 +42,28 @@ private:
 	Vertices _vertices;
 	Indices _indices;
 
+	// Skinned positions and normals in single precision, one entry per vertex
+	struct SkinnedVertices
+	{
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> z;
+		std::vector<float> normalX;
+		std::vector<float> normalY;
+		std::vector<float> normalZ;
+
+		void resize(std::size_t size)
+		{
+			x.resize(size);
+			y.resize(size);
+			z.resize(size);
+			normalX.resize(size);
+			normalY.resize(size);
+			normalZ.resize(size);
+		}
+	};
+	SkinnedVertices _skinned;
+
 public:
 
 	MD5Surface();
@@ -95,8 +117,17 @@ public:
 	void buildIndexArray();
 
 private:
-    // Re-calculate the normal vectors
+	// Deforms the mesh using the given joint poses and updates the render vertices
+	void updateToPalette(const MD5JointPalette& palette);
+
+	// Calculates the skinned vertex positions
+	void skinVertices(const MD5JointPalette& palette);
+
+    // Re-calculate the normal vectors of the skinned vertices
     void buildVertexNormals();
+
+	// Generates the skinning data of the mesh, needs to be called after parsing
+	void buildSkinningData();
 };
 typedef std::shared_ptr<MD5Surface> MD5SurfacePtr;
 
@@ -42,7 +42,7 @@ PicoModelLoader::PicoModelLoader(const picoModule_t* module, const std::string&
 {}
 
 // Load the given model from the VFS path
-IModelPtr PicoModelLoader::loadModelFromPath(const std::string& path)
+IModelPtr PicoModelLoader::loadModelFromFile(const std::string& path)
 {
 	// Open an ArchiveFile to load
 	auto file = path_is_absolute(path.c_str()) ?
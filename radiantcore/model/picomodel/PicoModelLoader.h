@@ -19,8 +19,9 @@ private:
 public:
 	PicoModelLoader(const picoModule_t* module, const std::string& extension);
 
+protected:
   	// Load the given model from the path, VFS or absolute
-	IModelPtr loadModelFromPath(const std::string& name) override;
+	IModelPtr loadModelFromFile(const std::string& name) override;
 
 public:
     static std::vector<StaticModelSurfacePtr> CreateSurfaces(picoModel_t* picoModel, const std::string& extension);
@@ -99,6 +99,13 @@ void ParticleNode::update(const VolumeTest& viewVolume) const
 	_renderableParticle->setEntityColour(Vector3(
 		_renderEntity->getShaderParm(0), _renderEntity->getShaderParm(1), _renderEntity->getShaderParm(2)));
 
+	// Don't simulate particle systems which can't be seen in this view
+	if (_renderableParticle->isOutsideVolume(viewVolume, localToWorld()))
+	{
+		_renderableParticle->clearRenderables();
+		return;
+	}
+
 	_renderableParticle->update(viewRotation, localToWorld(), _renderEntity);
 }
 
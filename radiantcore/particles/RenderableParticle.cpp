@@ -1,5 +1,8 @@
 #include "RenderableParticle.h"
 
+#include <algorithm>
+#include "ivolumetest.h"
+
 namespace particles
 {
 
@@ -7,7 +10,10 @@ RenderableParticle::RenderableParticle(const IParticleDef::Ptr& particleDef) :
 	_particleDef(), // don't initialise the ptr yet
 	_random(rand()), // use a random seed
 	_direction(0,0,1), // default direction
-	_entityColour(1,1,1) // default entity colour
+	_entityColour(1,1,1), // default entity colour
+	_simulatedBoundsStartTime(0),
+	_simulatedBoundsStarted(false),
+	_simulatedBoundsComplete(false)
 {
 	// Use this method, for observer handling
 	setParticleDef(particleDef);
@@ -66,6 +72,57 @@ void RenderableParticle::update(const Matrix4& viewRotation, const Matrix4& loca
             stage->attachToEntity(entity);
 		}
 	}
+
+	accumulateSimulatedBounds(time);
+}
+
+bool RenderableParticle::isOutsideVolume(const VolumeTest& volume, const Matrix4& localToWorld) const
+{
+	if (!_simulatedBoundsComplete || !_simulatedBounds.isValid())
+	{
+		return false;
+	}
+
+	return volume.TestAABB(_simulatedBounds, localToWorld) == VOLUME_OUTSIDE;
+}
+
+void RenderableParticle::accumulateSimulatedBounds(std::size_t time)
+{
+	if (!_simulatedBoundsStarted || time < _simulatedBoundsStartTime)
+	{
+		_simulatedBounds = AABB();
+		_simulatedBoundsStartTime = time;
+		_simulatedBoundsStarted = true;
+		_simulatedBoundsComplete = false;
+	}
+
+	_simulatedBounds.includeAABB(getBounds());
+
+	if (_simulatedBoundsComplete) return;
+
+	// The particles are moving during their lifetime, the bounds of a single
+	// update are not enough to tell whether the system is visible at all
+	std::size_t fullCycleMsec = 0;
+
+	for (const auto& pair : _shaderMap)
+	{
+		for (const auto& stage : pair.second.stages)
+		{
+			const auto& def = stage->getDef();
+
+			fullCycleMsec = std::max(fullCycleMsec,
+				static_cast<std::size_t>(SEC2MS(def.getTimeOffset())) + static_cast<std::size_t>(def.getCycleMsec()));
+		}
+	}
+
+	_simulatedBoundsComplete = time - _simulatedBoundsStartTime >= fullCycleMsec;
+}
+
+void RenderableParticle::resetSimulatedBounds()
+{
+	_simulatedBounds = AABB();
+	_simulatedBoundsStarted = false;
+	_simulatedBoundsComplete = false;
 }
 
 void RenderableParticle::clearRenderables()
@@ -120,6 +177,11 @@ void RenderableParticle::setParticleDef(const IParticleDef::Ptr& def)
 
 void RenderableParticle::setMainDirection(const Vector3& direction)
 {
+	if (_direction != direction)
+	{
+		resetSimulatedBounds();
+	}
+
 	_direction = direction;
 
 	// The particle stages hold a const-reference to _direction
@@ -160,6 +222,7 @@ void RenderableParticle::calculateBounds()
 void RenderableParticle::setupStages()
 {
 	_shaderMap.clear();
+	resetSimulatedBounds();
 
 	if (!_particleDef) return; // nothing to do.
 
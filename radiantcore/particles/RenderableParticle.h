@@ -54,6 +54,15 @@ class RenderableParticle : public IRenderableParticle,
 	// The associated rendersystem, needed to get time an shaders
 	RenderSystemWeakPtr _renderSystem;
 
+	// The bounds of all updates since the stages or the direction changed,
+	// used to cull the whole particle system against the view
+	AABB _simulatedBounds;
+	// Render time of the first update covered by _simulatedBounds
+	std::size_t _simulatedBoundsStartTime;
+	bool _simulatedBoundsStarted;
+	// True if the updates have been spanning a full cycle of all stages
+	bool _simulatedBoundsComplete;
+
 public:
 	RenderableParticle(const IParticleDef::Ptr& particleDef);
 
@@ -83,6 +92,11 @@ public:
 	// Updates bounds from stages and returns the value
 	const AABB& getBounds() override;
 
+	// Returns true if none of the particles can be visible in the given volume,
+	// such that the update can be skipped. This is only known after the particles
+	// have been updated for a whole cycle, before that false is returned.
+	bool isOutsideVolume(const VolumeTest& volume, const Matrix4& localToWorld) const;
+
 private:
 	void calculateBounds();
 
@@ -91,6 +105,10 @@ private:
 
 	// Capture all shaders, if necessary
 	void ensureShaders(RenderSystem& renderSystem);
+
+	// Include the current stage bounds into the simulated bounds
+	void accumulateSimulatedBounds(std::size_t time);
+	void resetSimulatedBounds();
 };
 typedef std::shared_ptr<RenderableParticle> RenderableParticlePtr;
 
@@ -4,10 +4,47 @@
 #include "math/pi.h"
 
 #include "string/string.h"
+#include "util/ParallelFor.h"
 
 namespace particles
 {
 
+namespace
+{
+    // Particles handed to each worker. Stages with fewer than two chunks
+    // of live particles are not worth spreading across threads.
+    constexpr std::size_t PARALLEL_PARTICLES_PER_CHUNK = 256;
+}
+
+void RenderableParticleBunch::ParticleStates::clear()
+{
+    index.clear();
+    timeSecs.clear();
+    timeFraction.clear();
+    angle.clear();
+    quadSize.clear();
+    aspect.clear();
+
+    for (auto& values : rand)
+    {
+        values.clear();
+    }
+}
+
+void RenderableParticleBunch::ParticleStates::add(std::size_t particleIndex, float secs, float fraction,
+    float initialAngle, const float randoms[5])
+{
+    index.push_back(particleIndex);
+    timeSecs.push_back(secs);
+    timeFraction.push_back(fraction);
+    angle.push_back(initialAngle);
+
+    for (std::size_t r = 0; r < 5; ++r)
+    {
+        rand[r].push_back(randoms[r]);
+    }
+}
+
 RenderableParticleBunch::RenderableParticleBunch(std::size_t index,
 	Rand48::result_type randSeed, const IStageDef& stage, const Matrix4& viewRotation,
     const Vector3& direction, const Vector3& entityColour) :
@@ -19,7 +56,9 @@ RenderableParticleBunch::RenderableParticleBunch(std::size_t index,
     _offset(_stage.getOffset()),
     _viewRotation(viewRotation),
     _direction(direction),
-    _entityColour(entityColour)
+    _entityColour(entityColour),
+    _pathRotation(Matrix4::getIdentity()),
+    _quadsPerParticle(1)
 {
     // Geometry is written in update(), just reserve the space
 }
@@ -28,6 +67,7 @@ void RenderableParticleBunch::update(std::size_t time)
 {
     _bounds = AABB();
     _quads.clear();
+    _particles.clear();
 
     // Length of one cycle (duration + deadtime)
     std::size_t cycleMsec = static_cast<std::size_t>(_stage.getCycleMsec());
@@ -37,9 +77,6 @@ void RenderableParticleBunch::update(std::size_t time)
         return;
     }
 
-    // Reserve enough space for all the particles (non-animated case)
-    _quads.reserve(_stage.getCount() * 4);
-
     // Normalise the global input time into local cycle time
     // The cycleTime may be larger than the _stage.cycleMsec argument if bunching is turned off
     std::size_t cycleTime = time - cycleMsec * _index;
@@ -56,8 +93,11 @@ void RenderableParticleBunch::update(std::size_t time)
     // This is the spacing between each particle
     std::size_t spawnSpacingMsec = static_cast<std::size_t>(spawnSpacing);
 
-    // Generate all particle quads, regardless of their visibility
-    // Visibility is considered by not rendering particles that haven't been spawned yet
+    float initialAngle = _stage.getInitialAngle();
+    Rand48::result_type maxRandom = _random.max();
+
+    // Spawn all particles that are visible at the given time, drawing their random numbers.
+    // This needs to happen sequentially, since each particle advances the random number generator.
     for (std::size_t i = 0; i < static_cast<std::size_t>(_stage.getCount()); ++i)
     {
         // Consider bunching parameter
@@ -74,25 +114,21 @@ void RenderableParticleBunch::update(std::size_t time)
         // Get the "local particle time" in msecs
         std::size_t particleTime = cycleTime - particleStartTimeMsec;
 
-        // Generate the particle renderinfo structure (our working set)
-        ParticleRenderInfo particle(i, _random);
-
-        // Calculate the time fraction [0..1]
-        particle.timeFraction = static_cast<float>(particleTime) / stageDurationMsec;
-
-        // We need the particle time in seconds for the location/angle integrations
-        particle.timeSecs = MS2SEC(particleTime);
+        // Generate five random numbers for path calcs, this is needed in calculateOrigin
+        float randoms[5];
 
-        // Calculate particle origin at time t
-        calculateOrigin(particle);
+        for (auto& value : randoms)
+        {
+            value = static_cast<float>(_random()) / maxRandom;
+        }
 
         // Get the initial angle value
-        particle.angle = _stage.getInitialAngle();
+        float angle = initialAngle;
 
-        if (particle.angle == 0)
+        if (angle == 0)
         {
             // Use random angle
-            particle.angle = 360 * static_cast<float>(_random()) / _random.max();
+            angle = 360 * static_cast<float>(_random()) / maxRandom;
         }
 
         // Past this point, no more "randomness" is required, so let's check if we still need
@@ -106,88 +142,173 @@ void RenderableParticleBunch::update(std::size_t time)
             continue; // particle has expired
         }
 
-        // Calculate the time-dependent angle
-        // according to docs, half the quads have negative rotation speed
-        int rotFactor = i % 2 == 0 ? -1 : 1;
-        particle.angle += rotFactor * integrate(_stage.getRotationSpeed(), particle.timeSecs);
+        // Store the time fraction [0..1] and the particle time in seconds for the location/angle integrations
+        _particles.add(i, MS2SEC(particleTime), static_cast<float>(particleTime) / stageDurationMsec, angle, randoms);
+    }
 
-        // Calculate render colour for this particle
-        calculateColour(particle);
+    auto numParticles = _particles.count();
 
-        // Consider quad size
-        particle.size = _stage.getSize().evaluate(particle.timeFraction);
+    if (numParticles == 0)
+    {
+        return;
+    }
 
-        // Consider aspect ratio
-        particle.aspect = _stage.getAspect().evaluate(particle.timeFraction);
+    prepareSimulation();
 
-        // Consider animation frames
-        particle.animFrames = static_cast<std::size_t>(_stage.getAnimationFrames());
+    // Calculate the time-dependent angle
+    // according to docs, half the quads have negative rotation speed
+    const auto& rotationSpeed = _stage.getRotationSpeed();
+    float rotationFrom = rotationSpeed.getFrom();
+    float rotationSlope = (rotationSpeed.getTo() - rotationFrom) / _stage.getDuration();
 
-        if (particle.animFrames > 0)
-        {
-            // Calculate the s coordinates and the resulting particle colour
-            calculateAnim(particle);
-        }
+    for (std::size_t p = 0; p < numParticles; ++p)
+    {
+        float t = _particles.timeSecs[p];
+        int rotFactor = _particles.index[p] % 2 == 0 ? -1 : 1;
 
-        // For aimed orientation, we need to override particle height and aspect
-        if (_stage.getOrientationType() == IStageDef::ORIENTATION_AIMED)
-        {
-            pushAimedParticles(particle, stageDurationMsec);
-        }
-        else
-        {
-            if (particle.animFrames > 0)
-            {
-                // Animated, push two crossfaded quads
-                pushQuad(particle, particle.curColour, particle.sWidth * particle.curFrame, particle.sWidth);
-                pushQuad(particle, particle.nextColour, particle.sWidth * particle.nextFrame, particle.sWidth);
-            }
-            else
-            {
-                // Non-animated quad
-                pushQuad(particle, particle.colour);
-            }
-        }
+        _particles.angle[p] += rotFactor * (rotationSlope * t * t * 0.5f + rotationFrom * t);
     }
+
+    // Consider quad size and aspect ratio
+    float sizeFrom = _stage.getSize().getFrom();
+    float sizeDelta = _stage.getSize().getTo() - sizeFrom;
+    float aspectFrom = _stage.getAspect().getFrom();
+    float aspectDelta = _stage.getAspect().getTo() - aspectFrom;
+
+    _particles.quadSize.resize(numParticles);
+    _particles.aspect.resize(numParticles);
+
+    for (std::size_t p = 0; p < numParticles; ++p)
+    {
+        _particles.quadSize[p] = sizeFrom + _particles.timeFraction[p] * sizeDelta;
+        _particles.aspect[p] = aspectFrom + _particles.timeFraction[p] * aspectDelta;
+    }
+
+    // The remaining calculations of each particle only touch its own quads
+    _quads.resize(numParticles * _quadsPerParticle);
+
+    util::parallelFor(numParticles, PARALLEL_PARTICLES_PER_CHUNK, [&](std::size_t p)
+    {
+        simulateParticle(p, stageDurationMsec);
+    });
 }
 
-void RenderableParticleBunch::addVertexData(std::vector<render::RenderVertex>& vertices, 
-    std::vector<unsigned int>& indices, const Matrix4& localToWorld)
+void RenderableParticleBunch::prepareSimulation()
 {
-    if (_quads.empty()) return;
+    // Check if the main direction is different to the z axis
+    Vector3 dir = _direction.getNormalised();
+    Vector3 zDir(0,0,1);
+
+    double deviation = dir.angle(zDir);
+
+    _pathRotation = deviation != 0 ? Matrix4::getRotation(zDir, dir) : Matrix4::getIdentity();
+
+    // Consider gravity
+    // if "world" is set, use -z as gravity direction, otherwise use the reverse emitter direction
+    Vector3 gravity = _stage.getWorldGravityFlag() ? Vector3(0,0,-1) : -dir;
+    _gravity = gravity * _stage.getGravity();
 
-    auto firstIndex = static_cast<unsigned int>(vertices.size());
+    _mainColour = !_stage.getUseEntityColour() ?
+        _stage.getColour() : Vector4(_entityColour.x(), _entityColour.y(), _entityColour.z(), 1);
 
-    auto quadIndex = 0;
+    auto quadsPerParticle = _stage.getAnimationFrames() > 0 ? 2 : 1;
 
-    for (const auto& quad : _quads)
+    if (_stage.getOrientationType() == IStageDef::ORIENTATION_AIMED)
     {
-        for (auto i = 0; i < 4; ++i)
-        {
-            auto worldVertex = localToWorld * quad.verts[i].vertex;
-
-            vertices.push_back(render::RenderVertex(
-                worldVertex,
-                quad.verts[i].normal, 
-                quad.verts[i].texcoord, 
-                quad.verts[i].colour)
-            );
-        }
+        // One quad per trail
+        quadsPerParticle *= std::max(static_cast<int>(_stage.getOrientationParm(0)), 0) + 1;
+    }
+
+    _quadsPerParticle = static_cast<std::size_t>(quadsPerParticle);
+
+    auto pathType = _stage.getCustomPathType();
 
-        auto index = firstIndex + quadIndex * 4;
+    if (pathType == IStageDef::PATH_ORBIT || pathType == IStageDef::PATH_DRIP)
+    {
+        // These are actually unsupported by the engine ("bad path type")
+        rWarning() << "Unsupported path type (drip/orbit)." << std::endl;
+    }
+}
 
-        indices.push_back(index + 0);
-        indices.push_back(index + 1);
-        indices.push_back(index + 2);
+void RenderableParticleBunch::simulateParticle(std::size_t slot, std::size_t stageDurationMsec)
+{
+    // Generate the particle renderinfo structure (our working set)
+    ParticleRenderInfo particle;
 
-        indices.push_back(index + 0);
-        indices.push_back(index + 2);
-        indices.push_back(index + 3);
+    particle.index = _particles.index[slot];
+    particle.timeSecs = _particles.timeSecs[slot];
+    particle.timeFraction = _particles.timeFraction[slot];
+    particle.angle = _particles.angle[slot];
+    particle.size = _particles.quadSize[slot];
+    particle.aspect = _particles.aspect[slot];
 
-        quadIndex++;
+    for (std::size_t r = 0; r < 5; ++r)
+    {
+        particle.rand[r] = _particles.rand[r][slot];
+    }
+
+    // Calculate particle origin at time t
+    calculateOrigin(particle);
+
+    // Calculate render colour for this particle
+    calculateColour(particle);
+
+    // Consider animation frames
+    particle.animFrames = static_cast<std::size_t>(_stage.getAnimationFrames());
+
+    if (particle.animFrames > 0)
+    {
+        // Calculate the s coordinates and the resulting particle colour
+        calculateAnim(particle);
+    }
+
+    auto* quads = &_quads[slot * _quadsPerParticle];
+
+    // For aimed orientation, we need to override particle height and aspect
+    if (_stage.getOrientationType() == IStageDef::ORIENTATION_AIMED)
+    {
+        writeAimedQuads(quads, particle, stageDurationMsec);
+    }
+    else
+    {
+        if (particle.animFrames > 0)
+        {
+            // Animated, write two crossfaded quads
+            writeQuad(quads[0], particle, particle.curColour, particle.sWidth * particle.curFrame, particle.sWidth);
+            writeQuad(quads[1], particle, particle.nextColour, particle.sWidth * particle.nextFrame, particle.sWidth);
+        }
+        else
+        {
+            // Non-animated quad
+            writeQuad(quads[0], particle, particle.colour);
+        }
     }
 }
 
+void RenderableParticleBunch::writeVertexData(render::RenderVertex* vertices, const Matrix4& localToWorld) const
+{
+    util::parallelForChunks(_quads.size(), PARALLEL_PARTICLES_PER_CHUNK, [&](std::size_t begin, std::size_t end)
+    {
+        for (auto q = begin; q < end; ++q)
+        {
+            const auto& quad = _quads[q];
+            auto* quadVertices = vertices + q * 4;
+
+            for (auto i = 0; i < 4; ++i)
+            {
+                auto worldVertex = localToWorld * quad.verts[i].vertex;
+
+                quadVertices[i] = render::RenderVertex(
+                    worldVertex,
+                    quad.verts[i].normal,
+                    quad.verts[i].texcoord,
+                    quad.verts[i].colour
+                );
+            }
+        }
+    });
+}
+
 const AABB& RenderableParticleBunch::getBounds()
 {
     if (!_bounds.isValid())
@@ -198,7 +319,7 @@ const AABB& RenderableParticleBunch::getBounds()
     return _bounds;
 }
 
-Matrix4 RenderableParticleBunch::getAimedMatrix(const Vector3& particleVelocity)
+Matrix4 RenderableParticleBunch::getAimedMatrix(const Vector3& particleVelocity) const
 {
     // Get the velocity direction in object space, use the same velocity for all trailing quads
     Vector3 vel = particleVelocity.getNormalised();
@@ -234,7 +355,7 @@ Matrix4 RenderableParticleBunch::getAimedMatrix(const Vector3& particleVelocity)
     return vel2aimed.getMultipliedBy(object2Vel);
 }
 
-void RenderableParticleBunch::calculateAnim(ParticleRenderInfo& particle)
+void RenderableParticleBunch::calculateAnim(ParticleRenderInfo& particle) const
 {
     // At a given time, two particles can be visible at most
     float frameRate = _stage.getAnimationRate();
@@ -263,10 +384,9 @@ void RenderableParticleBunch::calculateAnim(ParticleRenderInfo& particle)
     particle.sWidth = 1.0f / particle.animFrames;
 }
 
-void RenderableParticleBunch::calculateColour(ParticleRenderInfo& particle)
+void RenderableParticleBunch::calculateColour(ParticleRenderInfo& particle) const
 {
-    Vector4 mainColour = !_stage.getUseEntityColour() ?
-        _stage.getColour() : Vector4(_entityColour.x(), _entityColour.y(), _entityColour.z(), 1);
+    const Vector4& mainColour = _mainColour;
 
     // We start with the stage's standard colour
     particle.colour = mainColour;
@@ -312,15 +432,10 @@ void RenderableParticleBunch::calculateColour(ParticleRenderInfo& particle)
     }
 }
 
-void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle)
+void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle) const
 {
-    // Check if the main direction is different to the z axis
-    Vector3 dir = _direction.getNormalised();
-    Vector3 zDir(0,0,1);
-
-    double deviation = dir.angle(zDir);
-
-    Matrix4 rotation = deviation != 0 ? Matrix4::getRotation(zDir, dir) : Matrix4::getIdentity();
+    // The rotation of the z axis into the main direction is calculated in prepareSimulation()
+    const Matrix4& rotation = _pathRotation;
 
     // Consider offset as starting point
     particle.origin = rotation.transformPoint(_offset);
@@ -413,8 +528,7 @@ void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle)
 
     case IStageDef::PATH_ORBIT:
     case IStageDef::PATH_DRIP:
-        // These are actually unsupported by the engine ("bad path type")
-        rWarning() << "Unsupported path type (drip/orbit)." << std::endl;
+        // These are actually unsupported by the engine, a warning is emitted in prepareSimulation()
         break;
 
     default:
@@ -422,14 +536,11 @@ void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle)
         break;
     };
 
-    // Consider gravity
-    // if "world" is set, use -z as gravity direction, otherwise use the reverse emitter direction
-    Vector3 gravity = _stage.getWorldGravityFlag() ? Vector3(0,0,-1) : -_direction.getNormalised();
-
-    particle.origin += gravity * _stage.getGravity() * particle.timeSecs * particle.timeSecs * 0.5f;
+    // Consider gravity, the direction has been determined in prepareSimulation()
+    particle.origin += _gravity * particle.timeSecs * particle.timeSecs * 0.5f;
 }
 
-Vector3 RenderableParticleBunch::getDirection(ParticleRenderInfo& particle, const Matrix4& rotation, const Vector3& distributionOffset)
+Vector3 RenderableParticleBunch::getDirection(ParticleRenderInfo& particle, const Matrix4& rotation, const Vector3& distributionOffset) const
 {
     switch (_stage.getDirectionType())
     {
@@ -470,7 +581,7 @@ Vector3 RenderableParticleBunch::getDirection(ParticleRenderInfo& particle, cons
     };
 }
 
-Vector3 RenderableParticleBunch::getDistributionOffset(ParticleRenderInfo& particle, bool distributeParticlesRandomly)
+Vector3 RenderableParticleBunch::getDistributionOffset(ParticleRenderInfo& particle, bool distributeParticlesRandomly) const
 {
     switch (_stage.getDistributionType())
     {
@@ -577,19 +688,19 @@ Vector3 RenderableParticleBunch::getDistributionOffset(ParticleRenderInfo& parti
     };
 }
 
-void RenderableParticleBunch::pushQuad(ParticleRenderInfo& particle, const Vector4& colour, float s0, float sWidth)
+void RenderableParticleBunch::writeQuad(ParticleQuad& quad, ParticleRenderInfo& particle, const Vector4& colour, float s0, float sWidth) const
 {
     // greebo: Create a (rotated) quad facing the z axis
     // then rotate it to fit the requested orientation
     // finally translate it to its position.
     const Vector3 normal = _viewRotation.zCol3();
 
-    _quads.push_back(ParticleQuad(particle.size, particle.aspect, particle.angle, colour, normal, s0, sWidth));
-    _quads.back().transform(_viewRotation);
-    _quads.back().translate(particle.origin);
+    quad = ParticleQuad(particle.size, particle.aspect, particle.angle, colour, normal, s0, sWidth);
+    quad.transform(_viewRotation);
+    quad.translate(particle.origin);
 }
 
-void RenderableParticleBunch::pushAimedParticles(ParticleRenderInfo& particle, std::size_t stageDurationMsec)
+void RenderableParticleBunch::writeAimedQuads(ParticleQuad* quads, ParticleRenderInfo& particle, std::size_t stageDurationMsec) const
 {
     int trails = static_cast<int>(_stage.getOrientationParm(0)); // trails
     float aimedTime = _stage.getOrientationParm(1); // time
@@ -613,6 +724,9 @@ void RenderableParticleBunch::pushAimedParticles(ParticleRenderInfo& particle, s
 
     Vector3 lastOrigin = particle.origin;
 
+    // The number of quads written so far
+    std::size_t numWritten = 0;
+
     for (int i = 1; i <= numQuads; ++i)
     {
         // Copy over the info of the incoming particle (contains anim info, colour, etc.)
@@ -667,10 +781,10 @@ void RenderableParticleBunch::pushAimedParticles(ParticleRenderInfo& particle, s
                 // Glue the first row of vertices to the last quad, if applicable
                 if (i > 1)
                 {
-                    snapQuads(curQuad, *(_quads.end()-2));
+                    snapQuads(curQuad, quads[numWritten - 2]);
                 }
 
-                _quads.push_back(curQuad);
+                quads[numWritten++] = curQuad;
 
                 // "Next" quad, re-use the curQuad structure
                 curQuad.assignColour(aimedParticle.nextColour);
@@ -680,20 +794,20 @@ void RenderableParticleBunch::pushAimedParticles(ParticleRenderInfo& particle, s
 
                 if (i > 1)
                 {
-                    snapQuads(curQuad, *(_quads.end()-2));
+                    snapQuads(curQuad, quads[numWritten - 2]);
                 }
 
-                _quads.push_back(curQuad);
+                quads[numWritten++] = curQuad;
             }
             else
             {
                 if (i > 1)
                 {
-                    snapQuads(curQuad, _quads.back());
+                    snapQuads(curQuad, quads[numWritten - 1]);
                 }
 
                 // Non-animated case
-                _quads.push_back(curQuad);
+                quads[numWritten++] = curQuad;
             }
         }
 
@@ -27,7 +27,7 @@ class RenderableParticleBunch
 	// The stage this bunch is part of
 	const IStageDef& _stage;
 
-	// The quads of this particle bunch
+	// The quads of this particle bunch, each live particle owns _quadsPerParticle consecutive quads
 	typedef std::vector<ParticleQuad> Quads;
 	Quads _quads;
 
@@ -55,6 +55,34 @@ class RenderableParticleBunch
 	// The entity colour (instance owned by RenderableParticle)
 	const Vector3& _entityColour;
 
+	// The state of the live particles, stored as structure of arrays such that
+	// the per-stage calculations are running over contiguous values
+	struct ParticleStates
+	{
+		std::vector<std::size_t> index;
+		std::vector<float> timeSecs;
+		std::vector<float> timeFraction;
+		std::vector<float> angle;
+		std::vector<float> quadSize;
+		std::vector<float> aspect;
+		std::vector<float> rand[5];
+
+		std::size_t count() const
+		{
+			return index.size();
+		}
+
+		void clear();
+		void add(std::size_t particleIndex, float secs, float fraction, float initialAngle, const float randoms[5]);
+	};
+	ParticleStates _particles;
+
+	// Values shared by all particles of an update
+	Matrix4 _pathRotation;			// rotates the z axis into the particle direction
+	Vector3 _gravity;				// gravity vector, scaled by the stage gravity
+	Vector4 _mainColour;			// stage or entity colour
+	std::size_t _quadsPerParticle;
+
 public:
 	// Each bunch has a defined zero-based index
 	RenderableParticleBunch(std::size_t index,
@@ -73,9 +101,9 @@ public:
 	// Time is specified in stage time without offset,in msecs.
 	void update(std::size_t time);
 
-    // Add the renderable geometry to the given arrays
-    void addVertexData(std::vector<render::RenderVertex>& vertices,
-        std::vector<unsigned int>& indices, const Matrix4& localToWorld);
+    // Write the world space vertices of all quads to the given array, which
+    // must have room for 4 vertices per quad
+    void writeVertexData(render::RenderVertex* vertices, const Matrix4& localToWorld) const;
 
 	const AABB& getBounds();
 
@@ -86,41 +114,48 @@ public:
 
 private:
 	// Time is measured in seconds!
-	float integrate(const IParticleParameter& param, float time)
+	float integrate(const IParticleParameter& param, float time) const
 	{
 		return (param.getTo() - param.getFrom()) / _stage.getDuration() * time*time * 0.5f + param.getFrom() * time;
 	}
 
-	Vector4 lerpColour(const Vector4& startColour, const Vector4& endColour, float fraction)
+	Vector4 lerpColour(const Vector4& startColour, const Vector4& endColour, float fraction) const
 	{
 		return startColour * (1.0f - fraction) + endColour * fraction;
 	}
 
-	void calculateColour(ParticleRenderInfo& particle);
+	// Calculates the values shared by all particles of the current update
+	void prepareSimulation();
+
+	// Calculates origin, colour and animation of the particle in the given slot
+	// and writes its quads. Only touches the slot's quads, safe to call from worker threads.
+	void simulateParticle(std::size_t slot, std::size_t stageDurationMsec);
+
+	void calculateColour(ParticleRenderInfo& particle) const;
 
 	// Calculates origin at the given time, write result back to the given struct
-	void calculateOrigin(ParticleRenderInfo& particle);
+	void calculateOrigin(ParticleRenderInfo& particle) const;
 
 	// Handles animFrame stuff, may only be called if animFrames > 0
-	void calculateAnim(ParticleRenderInfo& particle);
+	void calculateAnim(ParticleRenderInfo& particle) const;
 
 	// The rotation is used to deviate the offsets should be normalised and not degenerate
-	Vector3 getDirection(ParticleRenderInfo& particle, const Matrix4& rotation, const Vector3& distributionOffset);
+	Vector3 getDirection(ParticleRenderInfo& particle, const Matrix4& rotation, const Vector3& distributionOffset) const;
 
-	Vector3 getDistributionOffset(ParticleRenderInfo& particle, bool distributeParticlesRandomly);
+	Vector3 getDistributionOffset(ParticleRenderInfo& particle, bool distributeParticlesRandomly) const;
 
 	// Calculates the matrix which rotates faces towards the viewer (used for "aimed" orientation)
-	Matrix4 getAimedMatrix(const Vector3& particleVelocity);
+	Matrix4 getAimedMatrix(const Vector3& particleVelocity) const;
 
-	// Handles aimed particles
-	void pushAimedParticles(ParticleRenderInfo& particle, std::size_t stageDurationMsec);
+	// Handles aimed particles, writing _quadsPerParticle quads to the given array
+	void writeAimedQuads(ParticleQuad* quads, ParticleRenderInfo& particle, std::size_t stageDurationMsec) const;
 
 	// Generates a new quad using the given struct as data source.
 	// colour, s0 and sWidth override the values in info
-	void pushQuad(ParticleRenderInfo& particle, const Vector4& colour, float s0 = 0.0f, float sWidth = 1.0f);
+	void writeQuad(ParticleQuad& quad, ParticleRenderInfo& particle, const Vector4& colour, float s0 = 0.0f, float sWidth = 1.0f) const;
 
 	// Makes the quad transition seamless by snapping the adjacent vertices at the midpoint
-	void snapQuads(ParticleQuad& curQuad, ParticleQuad& prevQuad);
+	static void snapQuads(ParticleQuad& curQuad, ParticleQuad& prevQuad);
 
 	void calculateBounds();
 };
@@ -83,32 +83,42 @@ std::size_t RenderableParticleStage::getNumQuads() const
 
 void RenderableParticleStage::updateGeometry()
 {
-    std::vector<render::RenderVertex> vertices;
-    std::vector<unsigned int> indices;
-
     auto numQuads = getNumQuads();
 
-    if (numQuads == 0)
+    _vertices.resize(numQuads * 4);
+
+    // The index layout only depends on the number of quads
+    if (_indices.size() != numQuads * 6)
     {
-        updateGeometryWithData(render::GeometryType::Triangles, vertices,
-                                                   indices);
-        return;
-    }
+        _indices.resize(numQuads * 6);
 
-    vertices.reserve(numQuads * 4);
-    indices.reserve(numQuads * 6);
+        for (std::size_t quad = 0; quad < numQuads; ++quad)
+        {
+            auto index = static_cast<unsigned int>(quad * 4);
+            auto* quadIndices = &_indices[quad * 6];
+
+            quadIndices[0] = index + 0;
+            quadIndices[1] = index + 1;
+            quadIndices[2] = index + 2;
+
+            quadIndices[3] = index + 0;
+            quadIndices[4] = index + 2;
+            quadIndices[5] = index + 3;
+        }
+    }
 
     if (_bunches[0])
     {
-        _bunches[0]->addVertexData(vertices, indices, _localToWorld);
+        _bunches[0]->writeVertexData(_vertices.data(), _localToWorld);
     }
 
     if (_bunches[1])
     {
-        _bunches[1]->addVertexData(vertices, indices, _localToWorld);
+        auto firstQuad = _bunches[0] ? _bunches[0]->getNumQuads() : 0;
+        _bunches[1]->writeVertexData(_vertices.data() + firstQuad * 4, _localToWorld);
     }
 
-    updateGeometryWithData(render::GeometryType::Triangles, vertices, indices);
+    updateGeometryWithData(render::GeometryType::Triangles, _vertices, _indices);
 }
 
 const AABB& RenderableParticleStage::getBounds()
@@ -44,6 +44,10 @@ class RenderableParticleStage :
 	// The entity colour (instance owned by RenderableParticle)
 	const Vector3& _entityColour;
 
+	// Vertex and index buffers, kept between updates to avoid re-allocating them each frame
+	std::vector<render::RenderVertex> _vertices;
+	std::vector<unsigned int> _indices;
+
 public:
 	RenderableParticleStage(const IStageDef& stage, 
 							Rand48& random, 
@@ -17,9 +17,15 @@
 #include "selection/algorithm/Shader.h"
 #include "selection/algorithm/Texturing.h"
 
+#include "util/ParallelFor.h"
+
 #include "PatchSavedState.h"
 #include "PatchNode.h"
 
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
 // ====== Helper Functions ==================================================================
 
 inline VertexPointer vertexpointer_Meshvertex(const MeshVertex* array) {
@@ -42,12 +48,82 @@ inline bool double_valid(double f) {
   return f == f;
 }
 
+namespace
+{
+    // Patches handed to each worker. Batches smaller than two chunks
+    // are not worth spreading across threads and stay in the calling thread.
+    constexpr std::size_t PARALLEL_TESSELATION_PATCHES_PER_CHUNK = 16;
+
+    // Everything the tesselation of a patch depends on, apart from its position:
+    // the control points are stored relative to the first one. Patches of the same
+    // shape have the same tesselation, translated by the offset of their first vertex.
+    struct PatchShape
+    {
+        std::size_t width;
+        std::size_t height;
+        bool subdivisionsFixed;
+        Subdivisions subdivisions;
+        std::vector<double> controlPoints;
+        std::size_t hash;
+
+        PatchShape(const Patch& patch) :
+            width(patch.getWidth()),
+            height(patch.getHeight()),
+            subdivisionsFixed(patch.subdivisionsFixed()),
+            subdivisions(subdivisionsFixed ? patch.getSubdivisions() : Subdivisions(0, 0))
+        {
+            const auto& ctrl = patch.getControlPointsTransformed();
+            const auto& origin = ctrl.front().vertex;
+
+            controlPoints.reserve(ctrl.size() * 5);
+
+            for (const auto& point : ctrl)
+            {
+                auto relative = point.vertex - origin;
+                controlPoints.insert(controlPoints.end(), {
+                    relative.x(), relative.y(), relative.z(), point.texcoord.x(), point.texcoord.y()
+                });
+            }
+
+            hash = std::hash<std::size_t>()(width * 31 + height);
+            combineHash(subdivisionsFixed ? subdivisions.x() * 31 + subdivisions.y() + 1 : 0);
+
+            for (auto value : controlPoints)
+            {
+                combineHash(std::hash<double>()(value));
+            }
+        }
+
+        bool operator==(const PatchShape& other) const
+        {
+            return hash == other.hash && width == other.width && height == other.height &&
+                subdivisionsFixed == other.subdivisionsFixed && subdivisions == other.subdivisions &&
+                controlPoints == other.controlPoints;
+        }
+
+    private:
+        void combineHash(std::size_t value)
+        {
+            hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+    };
+
+    struct PatchShapeHash
+    {
+        std::size_t operator()(const PatchShape& shape) const
+        {
+            return shape.hash;
+        }
+    };
+}
+
 // ====== Patch Implementation =========================================================================
 
 // Constructor
 Patch::Patch(PatchNode& node) :
     _node(node),
     _undoStateSaver(nullptr),
+    _pendingEvaluationQueue(nullptr),
     _transformChanged(false),
     _tesselationChanged(true),
     _shader(texdef_name_default())
@@ -63,9 +139,10 @@ Patch::Patch(const Patch& other, PatchNode& node) :
     IUndoable(other),
     _node(node),
     _undoStateSaver(nullptr),
+    _pendingEvaluationQueue(nullptr),
     _transformChanged(false),
     _tesselationChanged(true),
-    _shader(other._shader.getMaterialName())
+    _shader(other._shader.getMaterialHandle())
 {
     // Initalise the default values
     construct();
@@ -75,7 +152,7 @@ Patch::Patch(const Patch& other, PatchNode& node) :
     _subDivisions = other._subDivisions;
     setDims(other._width, other._height);
     copy_ctrl(_ctrl.begin(), other._ctrl.begin(), other._ctrl.begin()+(_width*_height));
-    _shader.setMaterialName(other._shader.getMaterialName());
+    _shader.setMaterialName(other._shader.getMaterialHandle());
     controlPointsChanged();
 }
 
@@ -168,6 +245,26 @@ void Patch::disconnectUndoSystem(IUndoSystem& undoSystem)
     undoSystem.releaseStateSaver(*this);
 }
 
+void Patch::connectPendingEvaluationQueue(scene::IPendingEvaluationQueue& queue)
+{
+    assert(_pendingEvaluationQueue == nullptr);
+
+    _pendingEvaluationQueue = &queue;
+
+    if (_tesselationChanged)
+    {
+        queue.add(scene::PendingEvaluationType::PatchTesselation, *this);
+    }
+}
+
+void Patch::disconnectPendingEvaluationQueue()
+{
+    assert(_pendingEvaluationQueue != nullptr);
+
+    _pendingEvaluationQueue->remove(scene::PendingEvaluationType::PatchTesselation, *this);
+    _pendingEvaluationQueue = nullptr;
+}
+
 // Return the interally stored AABB
 const AABB& Patch::localAABB() const
 {
@@ -233,7 +330,7 @@ void Patch::transform(const Matrix4& matrix)
 void Patch::transformChanged()
 {
     _transformChanged = true;
-    _tesselationChanged = true;
+    queueTesselationUpdate();
 }
 
 // Called to evaluate the transform
@@ -265,7 +362,13 @@ void Patch::freezeTransform()
     // Don't call controlPointsChanged() here since that one will re-apply the
     // current transformation matrix, possible the second time.
     transformChanged();
-    updateTesselation();
+
+    // The tesselation is deferred until it is needed, such that it can be
+    // batched with other patches, the bounds only depend on the control points
+    if (isValid())
+    {
+        updateAABB();
+    }
 
     for (Observers::iterator i = _observers.begin(); i != _observers.end();)
     {
@@ -278,7 +381,12 @@ void Patch::controlPointsChanged()
 {
     transformChanged();
     evaluateTransform();
-    updateTesselation();
+
+    // Tesselation is deferred, see freezeTransform()
+    if (isValid())
+    {
+        updateAABB();
+    }
     _node.onControlPointsChanged();
 
     for (Observers::iterator i = _observers.begin(); i != _observers.end();)
@@ -429,6 +537,11 @@ Patch::~Patch()
     {
         (*i++)->onPatchDestruction();
     }
+
+    if (_pendingEvaluationQueue != nullptr)
+    {
+        _pendingEvaluationQueue->remove(scene::PendingEvaluationType::PatchTesselation, *this);
+    }
 }
 
 bool Patch::isValid() const
@@ -484,6 +597,17 @@ void Patch::updateTesselation(bool force)
     // Only do something if the tesselation has actually changed
     if (!_tesselationChanged && !force) return;
 
+    if (_tesselationChanged)
+    {
+        // Process all patches of this scene waiting for tesselation in one go, this one included
+        if (_pendingEvaluationQueue != nullptr)
+        {
+            updatePendingTesselations(*_pendingEvaluationQueue);
+        }
+
+        if (!_tesselationChanged && !force) return;
+    }
+
     _tesselationChanged = false;
 
     if (!isValid())
@@ -501,6 +625,93 @@ void Patch::updateTesselation(bool force)
     _node.onTesselationChanged();
 }
 
+void Patch::updatePendingTesselations(scene::IPendingEvaluationQueue& queue)
+{
+    std::vector<Patch*> batch;
+
+    for (auto* element : queue.takeAll(scene::PendingEvaluationType::PatchTesselation))
+    {
+        batch.push_back(static_cast<Patch*>(element));
+    }
+
+    if (batch.empty()) return;
+
+    // Transforms need to be applied to the control points first,
+    // this involves the patch nodes and is not safe to do in parallel
+    for (auto* patch : batch)
+    {
+        patch->evaluateTransform();
+    }
+
+    // Applying the transforms re-queued some of the patches, they're all handled here
+    for (auto* element : queue.takeAll(scene::PendingEvaluationType::PatchTesselation))
+    {
+        batch.push_back(static_cast<Patch*>(element));
+    }
+
+    std::sort(batch.begin(), batch.end());
+    batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+
+    // Assign each patch to its shape, the first patch of each shape is tesselated,
+    // the others are copying its mesh. Invalid patches are left to updateTesselation().
+    constexpr auto NO_SHAPE = std::numeric_limits<std::size_t>::max();
+
+    std::unordered_map<PatchShape, std::size_t, PatchShapeHash> shapeIndices;
+    std::vector<Patch*> tesselatedPatches;
+    std::vector<Vector4> colours;
+    std::vector<std::size_t> patchShapes(batch.size(), NO_SHAPE);
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        auto* patch = batch[i];
+
+        if (!patch->_tesselationChanged || !patch->isValid()) continue;
+
+        auto renderEntity = patch->_node.getRenderEntity();
+        auto colour = renderEntity ? renderEntity->getEntityColour() : Vector4(1, 1, 1, 1);
+
+        auto [shape, inserted] = shapeIndices.emplace(PatchShape(*patch), tesselatedPatches.size());
+
+        if (inserted)
+        {
+            tesselatedPatches.push_back(patch);
+            colours.push_back(colour);
+        }
+
+        patchShapes[i] = shape->second;
+    }
+
+    // The tesselation only touches the mesh of each patch
+    util::parallelFor(tesselatedPatches.size(), PARALLEL_TESSELATION_PATCHES_PER_CHUNK, [&](std::size_t i)
+    {
+        auto& patch = *tesselatedPatches[i];
+        patch._mesh.generate(patch._width, patch._height, patch._ctrlTransformed,
+            patch.subdivisionsFixed(), patch.getSubdivisions(), colours[i]);
+    });
+
+    // Bounds and node updates are running in this thread
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        if (patchShapes[i] == NO_SHAPE) continue;
+
+        auto* patch = batch[i];
+        const auto* tesselated = tesselatedPatches[patchShapes[i]];
+
+        if (tesselated != patch)
+        {
+            patch->_mesh = tesselated->_mesh;
+            patch->_mesh.translate(patch->_ctrlTransformed.front().vertex - tesselated->_ctrlTransformed.front().vertex);
+
+            auto renderEntity = patch->_node.getRenderEntity();
+            patch->_mesh.setColour(renderEntity ? renderEntity->getEntityColour() : Vector4(1, 1, 1, 1));
+        }
+
+        patch->_tesselationChanged = false;
+        patch->updateAABB();
+        patch->_node.onTesselationChanged();
+    }
+}
+
 void Patch::invertMatrix()
 {
   undoSave();
@@ -1716,6 +1927,13 @@ PatchTesselation& Patch::getTesselation()
     return _mesh;
 }
 
+std::size_t Patch::getMemoryUsage() const
+{
+    return (_ctrl.capacity() + _ctrlTransformed.capacity()) * sizeof(PatchControl) +
+        _mesh.vertices.capacity() * sizeof(MeshVertex) +
+        _mesh.indices.capacity() * sizeof(RenderIndex);
+}
+
 PatchRenderIndices Patch::getRenderIndices() const
 {
 	// Ensure the tesselation is up to date
@@ -2560,6 +2778,9 @@ bool Patch::subdivisionsFixed() const
 
 bool Patch::getIntersection(const Ray& ray, Vector3& intersection)
 {
+    // Ensure the tesselation is up to date
+    updateTesselation();
+
     std::vector<RenderIndex>::const_iterator stripStartIndex = _mesh.indices.begin();
 
     // Go over each quad strip and intersect the ray with its triangles
@@ -2633,5 +2854,10 @@ sigc::signal<void>& Patch::signal_patchTextureChanged()
 
 void Patch::queueTesselationUpdate()
 {
+    if (_pendingEvaluationQueue != nullptr)
+    {
+        _pendingEvaluationQueue->add(scene::PendingEvaluationType::PatchTesselation, *this);
+    }
+
     _tesselationChanged = true;
 }
@@ -6,6 +6,7 @@
 #include "editable.h"
 #include "iundo.h"
 #include "irender.h"
+#include "ipendingevaluation.h"
 #include "SurfaceShader.h"
 
 #include "PatchConstants.h"
@@ -29,7 +30,8 @@ class Patch :
 	public IPatch,
 	public Bounded,
 	public Snappable,
-	public IUndoable
+	public IUndoable,
+	public scene::IPendingEvaluation
 {
     friend class PatchNode;
 	PatchNode& _node;
@@ -45,6 +47,9 @@ class Patch :
 
 	IUndoStateSaver* _undoStateSaver;
 
+	// The queue this patch is registered in while it's in the scene and waiting for its tesselation
+	scene::IPendingEvaluationQueue* _pendingEvaluationQueue;
+
 	// dynamically allocated array of control points, size is _width*_height
 	PatchControlArray _ctrl;			// the true control array
 	PatchControlArray _ctrlTransformed;	// a temporary control array used during transformations, so that the
@@ -90,6 +95,10 @@ public:
 	void connectUndoSystem(IUndoSystem& undoSystem);
     void disconnectUndoSystem(IUndoSystem& undoSystem);
 
+	// Tesselation updates are registered with the given queue, to be processed along with the other pending patches
+	void connectPendingEvaluationQueue(scene::IPendingEvaluationQueue& queue);
+	void disconnectPendingEvaluationQueue();
+
 	const AABB& localAABB() const override;
 
     RenderSystemPtr getRenderSystem() const;
@@ -159,6 +168,9 @@ public:
 
 	PatchTesselation& getTesselation();
 
+	// Returns the estimated memory of the control points and the tesselation, not including this object
+	std::size_t getMemoryUsage() const;
+
 	PatchRenderIndices getRenderIndices() const override;
 
 	// Returns a copy of the tesselated geometry
@@ -329,6 +341,16 @@ public:
     void updateTesselation(bool force = false) override;
     void queueTesselationUpdate();
 
+	/**
+	 * Tesselates all patches of the given queue with pending changes in one batch. Patches sharing
+	 * the same control grid shape (up to a translation) and subdivision settings
+	 * are tesselated only once. The tesselation itself runs in parallel, the
+	 * remaining steps are run sequentially in the calling thread, which must be
+	 * the main thread. This is invoked by updateTesselation() as soon as any
+	 * dirty patch of the scene is requested.
+	 */
+	static void updatePendingTesselations(scene::IPendingEvaluationQueue& queue);
+
 private:
 	// This notifies the surfaceinspector/patchinspector about the texture change
 	void textureChanged();
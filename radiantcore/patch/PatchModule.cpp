@@ -8,6 +8,7 @@
 #include "i18n.h"
 
 #include "PatchNode.h"
+#include "scene/NodeArena.h"
 
 #include "patch/algorithm/Prefab.h"
 #include "patch/algorithm/General.h"
@@ -27,7 +28,7 @@ namespace
 
 scene::INodePtr PatchModule::createPatch(PatchDefType type)
 {
-	scene::INodePtr node = std::make_shared<PatchNode>(type);
+	scene::INodePtr node = scene::makeArenaShared<PatchNode>(type);
 
 	if (GlobalMapModule().getRoot())
 	{
@@ -12,8 +12,8 @@ PatchNode::PatchNode(patch::PatchDefType type) :
 	m_dragPlanes(std::bind(&PatchNode::selectedChangedComponent, this, std::placeholders::_1)),
 	m_patch(*this),
     _untransformedOriginChanged(true),
-    _renderableSurfaceSolid(m_patch.getTesselation(), true),
-    _renderableSurfaceWireframe(m_patch.getTesselation(), false),
+    _renderableSurfaceSolid(m_patch._mesh, true),
+    _renderableSurfaceWireframe(m_patch._mesh, false),
     _renderableCtrlLattice(m_patch, m_ctrl_instances),
     _renderableCtrlPoints(m_patch, m_ctrl_instances)
 {
@@ -34,8 +34,8 @@ PatchNode::PatchNode(const PatchNode& other) :
 	m_dragPlanes(std::bind(&PatchNode::selectedChangedComponent, this, std::placeholders::_1)),
 	m_patch(other.m_patch, *this), // create the patch out of the <other> one
     _untransformedOriginChanged(true),
-    _renderableSurfaceSolid(m_patch.getTesselation(), true),
-    _renderableSurfaceWireframe(m_patch.getTesselation(), false),
+    _renderableSurfaceSolid(m_patch._mesh, true),
+    _renderableSurfaceWireframe(m_patch._mesh, false),
     _renderableCtrlLattice(m_patch, m_ctrl_instances),
     _renderableCtrlPoints(m_patch, m_ctrl_instances)
 {
@@ -118,6 +118,12 @@ IPatch& PatchNode::getPatch() {
 	return m_patch;
 }
 
+std::size_t PatchNode::getMemoryUsage() const
+{
+    return sizeof(PatchNode) + m_patch.getMemoryUsage() +
+        m_ctrl_instances.capacity() * sizeof(PatchControlInstance);
+}
+
 // Snappable implementation
 void PatchNode::snapto(float snap) {
 	m_patch.snapto(snap);
@@ -156,16 +162,27 @@ void PatchNode::snapComponents(float snap)
 // Test the Patch instance for selection
 void PatchNode::testSelect(Selector& selector, SelectionTest& test)
 {
-    // Check if this patch has a twosided material
-    const auto& shader = m_patch.getSurfaceShader().getGLShader();
-    bool isTwosided = shader && shader->getMaterial()->getCullType() == Material::CULL_NONE;
-
-    test.BeginMesh(localToWorld(), isTwosided);
+    test.BeginMesh(localToWorld(), hasTwosidedMaterial());
 
     // Pass the selection test call to the patch
     m_patch.testSelect(selector, test);
 }
 
+bool PatchNode::hasTwosidedMaterial() const
+{
+    const auto& shader = m_patch.getSurfaceShader().getGLShader();
+    return shader && shader->getMaterial()->getCullType() == Material::CULL_NONE;
+}
+
+void PatchNode::prepareConcurrentSelectionTest()
+{
+    localToWorld();
+    m_patch.updateTesselation();
+
+    // The material definition is parsed on first access
+    hasTwosidedMaterial();
+}
+
 void PatchNode::selectPlanes(Selector& selector, SelectionTest& test, const PlaneCallback& selectedPlaneCallback) {
 	test.BeginMesh(localToWorld());
 
@@ -314,6 +331,9 @@ void PatchNode::onInsertIntoScene(scene::IMapRootNode& root)
     updateAllRenderables();
 
 	m_patch.connectUndoSystem(root.getUndoSystem());
+    m_patch.connectPendingEvaluationQueue(root.getPendingEvaluationQueue());
+    m_patch.getSurfaceShader().attachToUsageIndex(root.getMaterialUsageIndex(),
+        scene::MaterialUsageType::Patch, *this);
 	GlobalCounters().getCounter(counterPatches).increment();
 
     // Update the origin information needed for transformations
@@ -332,6 +352,8 @@ void PatchNode::onRemoveFromScene(scene::IMapRootNode& root)
 
 	GlobalCounters().getCounter(counterPatches).decrement();
 
+    m_patch.getSurfaceShader().detachFromUsageIndex();
+    m_patch.disconnectPendingEvaluationQueue();
 	m_patch.disconnectUndoSystem(root.getUndoSystem());
 
     clearAllRenderables();
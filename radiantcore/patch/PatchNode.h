@@ -19,6 +19,7 @@ class PatchNode final :
 	public IPatchNode,
 	public SelectionTestable,
 	public ComponentSelectionTestable,
+	public ConcurrentSelectionTestable,
 	public ComponentEditable,
 	public ComponentSnappable,
 	public PlaneSelectable,
@@ -70,6 +71,9 @@ public:
 	Patch& getPatchInternal() override;
 	IPatch& getPatch() override;
 
+	// Returns the estimated memory occupied by this node and its patch
+	std::size_t getMemoryUsage() const;
+
 	// Snappable implementation
 	virtual void snapto(float snap) override;
 
@@ -89,6 +93,9 @@ public:
 	// Tests the patch components on selection using the passed SelectionTest
 	void testSelectComponents(Selector& selector, SelectionTest& test, selection::ComponentSelectionMode mode) override;
 
+	// ConcurrentSelectionTestable
+	void prepareConcurrentSelectionTest() override;
+
 	// override scene::Inode::onRemoveFromScene to deselect the child components
     void onInsertIntoScene(scene::IMapRootNode& root) override;
     void onRemoveFromScene(scene::IMapRootNode& root) override;
@@ -156,6 +163,9 @@ private:
 	// Transforms the patch components with the given transformation matrix
 	void transformComponents(const Matrix4& matrix);
 
+	// True if the patch material is not culling any faces
+	bool hasTwosidedMaterial() const;
+
     void updateAllRenderables();
     void hideAllRenderables();
     void clearAllRenderables();
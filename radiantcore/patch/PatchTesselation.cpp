@@ -197,66 +197,17 @@ void PatchTesselation::generateNormals()
 	}
 }
 
-void PatchTesselation::sampleSinglePatchPoint(const MeshVertex ctrl[3][3], float u, float v, MeshVertex& out) const
+namespace
 {
-	double vCtrl[3][8];
-
-	// find the control points for the v coordinate
-	for (std::size_t vPoint = 0; vPoint < 3; vPoint++)
-	{
-		for (std::size_t axis = 0; axis < 8; axis++)
-		{
-			double a, b, c;
-
-			if (axis < 3)
-			{
-				a = ctrl[0][vPoint].vertex[axis];
-				b = ctrl[1][vPoint].vertex[axis];
-				c = ctrl[2][vPoint].vertex[axis];
-			}
-			else if (axis < 6)
-			{
-				a = ctrl[0][vPoint].normal[axis - 3];
-				b = ctrl[1][vPoint].normal[axis - 3];
-				c = ctrl[2][vPoint].normal[axis - 3];
-			}
-			else
-			{
-				a = ctrl[0][vPoint].texcoord[axis - 6];
-				b = ctrl[1][vPoint].texcoord[axis - 6];
-				c = ctrl[2][vPoint].texcoord[axis - 6];
-			}
-
-			double qA = a - 2.0 * b + c;
-			double qB = 2.0 * b - 2.0 * a;
-			double qC = a;
-
-			vCtrl[vPoint][axis] = qA * u * u + qB * u + qC;
-		}
-	}
+	// Position, normal and texcoord are interpolated
+	constexpr std::size_t NUM_SAMPLED_ATTRIBUTES = 8;
 
-	// interpolate the v value
-	for (std::size_t axis = 0; axis < 8; axis++)
+	// Bernstein weights of a quadratic bezier curve at the given parameter
+	inline void getQuadraticWeights(double t, double weights[3])
 	{
-		double a = vCtrl[0][axis];
-		double b = vCtrl[1][axis];
-		double c = vCtrl[2][axis];
-		double qA = a - 2.0 * b + c;
-		double qB = 2.0 * b - 2.0 * a;
-		double qC = a;
-
-		if (axis < 3)
-		{
-			out.vertex[axis] = qA * v * v + qB * v + qC;
-		}
-		else if (axis < 6)
-		{
-			out.normal[axis - 3] = qA * v * v + qB * v + qC;
-		}
-		else
-		{
-			out.texcoord[axis - 6] = qA * v * v + qB * v + qC;
-		}
+		weights[0] = (1.0 - t) * (1.0 - t);
+		weights[1] = 2.0 * t * (1.0 - t);
+		weights[2] = t * t;
 	}
 }
 
@@ -268,14 +219,68 @@ void PatchTesselation::sampleSinglePatch(const MeshVertex ctrl[3][3],
 	horzSub++;
 	vertSub++;
 
+	// Gather the control point attributes into a flat array, such that every
+	// sample is a weighted sum over contiguous rows, which the compiler can vectorise
+	double attributes[3][3][NUM_SAMPLED_ATTRIBUTES];
+
+	for (std::size_t k = 0; k < 3; k++)
+	{
+		for (std::size_t l = 0; l < 3; l++)
+		{
+			auto* attr = attributes[k][l];
+			const auto& vertex = ctrl[k][l];
+
+			attr[0] = vertex.vertex[0];
+			attr[1] = vertex.vertex[1];
+			attr[2] = vertex.vertex[2];
+			attr[3] = vertex.normal[0];
+			attr[4] = vertex.normal[1];
+			attr[5] = vertex.normal[2];
+			attr[6] = vertex.texcoord[0];
+			attr[7] = vertex.texcoord[1];
+		}
+	}
+
+	// The weights in v direction are the same for every column
+	std::vector<double> vWeights(vertSub * 3);
+
+	for (std::size_t j = 0; j < vertSub; j++)
+	{
+		getQuadraticWeights(static_cast<float>(j) / (vertSub - 1), &vWeights[j * 3]);
+	}
+
 	for (std::size_t i = 0; i < horzSub; i++)
 	{
+		double uWeights[3];
+		getQuadraticWeights(static_cast<float>(i) / (horzSub - 1), uWeights);
+
+		// Evaluate the u direction once per column, leaving the control points of the curve in v direction
+		double vCtrl[3][NUM_SAMPLED_ATTRIBUTES];
+
+		for (std::size_t l = 0; l < 3; l++)
+		{
+			for (std::size_t a = 0; a < NUM_SAMPLED_ATTRIBUTES; a++)
+			{
+				vCtrl[l][a] = uWeights[0] * attributes[0][l][a] + uWeights[1] * attributes[1][l][a] +
+					uWeights[2] * attributes[2][l][a];
+			}
+		}
+
 		for (std::size_t j = 0; j < vertSub; j++)
 		{
-			float u = static_cast<float>(i) / (horzSub - 1);
-			float v = static_cast<float>(j) / (vertSub - 1);
+			const double* weights = &vWeights[j * 3];
+			double sample[NUM_SAMPLED_ATTRIBUTES];
 
-			sampleSinglePatchPoint(ctrl, u, v, outVerts[((baseRow + j) * w) + i + baseCol]);
+			for (std::size_t a = 0; a < NUM_SAMPLED_ATTRIBUTES; a++)
+			{
+				sample[a] = weights[0] * vCtrl[0][a] + weights[1] * vCtrl[1][a] + weights[2] * vCtrl[2][a];
+			}
+
+			auto& out = outVerts[((baseRow + j) * w) + i + baseCol];
+
+			out.vertex = Vertex3(sample[0], sample[1], sample[2]);
+			out.normal = Normal3(sample[3], sample[4], sample[5]);
+			out.texcoord = TexCoord2f(sample[6], sample[7]);
 		}
 	}
 }
@@ -838,6 +843,14 @@ void PatchTesselation::generateIndices()
 void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
 	const PatchControlArray& controlPoints, bool subdivionsFixed, const Subdivisions& subdivs,
     IRenderEntity* renderEntity)
+{
+	generate(patchWidth, patchHeight, controlPoints, subdivionsFixed, subdivs,
+		renderEntity ? renderEntity->getEntityColour() : Vector4(1, 1, 1, 1));
+}
+
+void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
+	const PatchControlArray& controlPoints, bool subdivionsFixed, const Subdivisions& subdivs,
+	const Vector4& colour)
 {
 	width = patchWidth;
 	height = patchHeight;
@@ -870,8 +883,6 @@ void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
 	}
 
     // Final update: assign colours and normalise normals
-    auto colour = renderEntity ? renderEntity->getEntityColour() : Vector4(1, 1, 1, 1);
-
 	for (MeshVertex& vertex : vertices)
 	{
 	    // normalize all the lerped normals
@@ -890,3 +901,19 @@ void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
 	// With indices in place we can derive the tangent/bitangent vectors
 	deriveTangents();
 }
+
+void PatchTesselation::translate(const Vector3& offset)
+{
+	for (auto& vertex : vertices)
+	{
+		vertex.vertex += offset;
+	}
+}
+
+void PatchTesselation::setColour(const Vector4& colour)
+{
+	for (auto& vertex : vertices)
+	{
+		vertex.colour = colour;
+	}
+}
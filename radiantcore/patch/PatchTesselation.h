@@ -48,6 +48,17 @@ public:
 	void generate(std::size_t width, std::size_t height, const PatchControlArray& controlPoints, 
 		bool subdivionsFixed, const Subdivisions& subdivs, IRenderEntity* renderEntity);
 
+	// Same as above, with the vertex colour given explicitly. This overload
+	// doesn't touch anything but this instance and is safe to call from worker threads.
+	void generate(std::size_t width, std::size_t height, const PatchControlArray& controlPoints,
+		bool subdivionsFixed, const Subdivisions& subdivs, const Vector4& colour);
+
+	// Moves all vertices by the given offset, normals and tangents are unaffected
+	void translate(const Vector3& offset);
+
+	// Assigns the given colour to all vertices
+	void setColour(const Vector4& colour);
+
 private:
 	// Private methods used for tesselation, modeled after the patch subdivision code found in idTech4
 	void generateIndices();
@@ -66,7 +77,6 @@ private:
 	void sampleSinglePatch(const MeshVertex ctrl[3][3], std::size_t baseCol, std::size_t baseRow, 
 		std::size_t width, std::size_t horzSub, std::size_t vertSub, 
 		std::vector<MeshVertex>& outVerts) const;
-	void sampleSinglePatchPoint(const MeshVertex ctrl[3][3], float u, float v, MeshVertex& out) const;
 	void deriveTangents();
 	void deriveFaceTangents(std::vector<FaceTangents>& faceTangents);
 };
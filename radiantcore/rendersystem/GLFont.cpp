@@ -47,6 +47,16 @@ float GLFont::getLineHeight() const
     return _lineHeight;
 }
 
+float GLFont::getDescender() const
+{
+    return _ftglFont ? FTGL::ftglGetFontDescender(_ftglFont) : 0;
+}
+
+float GLFont::getAdvance(const std::string& string) const
+{
+    return _ftglFont ? FTGL::ftglGetFontAdvance(_ftglFont, string.c_str()) : 0;
+}
+
 void GLFont::drawString(const std::string& string)
 {
     FTGL::ftglRenderFont(_ftglFont, string.c_str(), FTGL::RENDER_ALL);
@@ -22,6 +22,8 @@ public:
 	~GLFont();
 
     float getLineHeight() const override;
+    float getDescender() const override;
+    float getAdvance(const std::string& string) const override;
 
     void drawString(const std::string& string) override;
 };
@@ -172,7 +172,7 @@ IRenderResult::Ptr OpenGLRenderSystem::render(SceneRenderer& renderer, RenderSta
 
     auto result = renderer.render(globalFlagsMask, view, _time);
 
-    renderText();
+    renderText(view);
 
     return result;
 }
@@ -188,14 +188,14 @@ void OpenGLRenderSystem::endFrame()
     _geometryStore.onFrameFinished();
 }
 
-void OpenGLRenderSystem::renderText()
+void OpenGLRenderSystem::renderText(const IRenderView& view)
 {
     // Render all text
     glDisable(GL_DEPTH_TEST);
 
     for (const auto& [_, textRenderer] : _textRenderers)
     {
-        textRenderer->render();
+        textRenderer->render(view);
     }
 }
 
@@ -142,7 +142,7 @@ public:
 private:
     IRenderResult::Ptr render(SceneRenderer& renderer, RenderStateFlags globalFlagsMask, const IRenderView& view);
 
-    void renderText();
+    void renderText(const IRenderView& view);
 
     ShaderPtr capture(const std::string& name, const std::function<OpenGLShaderPtr()>& createShader);
 
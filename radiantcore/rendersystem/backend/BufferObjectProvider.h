@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <cstring>
 #include "igl.h"
 #include "igeometrystore.h"
 
@@ -20,23 +21,22 @@ private:
         GLenum _target;
         std::size_t _allocatedSize;
 
+        // Client address of the persistently mapped storage, if available
+        unsigned char* _mappedData;
+
     public:
         BufferObject(IBufferObject::Type type) :
             _type(type),
             _buffer(0),
             _target(_type == Type::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER),
-            _allocatedSize(0)
+            _allocatedSize(0),
+            _mappedData(nullptr)
         {}
 
         ~BufferObject() override
         {
-            if (_buffer != 0)
-            {
-                glDeleteBuffers(1, &_buffer);
-            }
-
+            releaseBuffer();
             _allocatedSize = 0;
-            _buffer = 0;
         }
 
         void bind() override
@@ -56,6 +56,14 @@ private:
                 throw std::runtime_error("Buffer is too small, resize first");
             }
 
+            // Coherent persistent mappings don't need any GL call, the geometry store
+            // makes sure that the GPU is done with this buffer before it's written to
+            if (_mappedData != nullptr)
+            {
+                std::memcpy(_mappedData + offset, firstElement, numBytes);
+                return;
+            }
+
             glBufferSubData(_target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(numBytes), firstElement);
             debug::assertNoGlErrors();
         }
@@ -74,6 +82,12 @@ private:
         // from the old internal buffer to the new one.
         void resize(std::size_t newSize) override
         {
+            // Buffer storage is immutable, it needs a new buffer name to be resized
+            if (GLEW_ARB_buffer_storage)
+            {
+                releaseBuffer();
+            }
+
             if (_buffer == 0)
             {
                 glGenBuffers(1, &_buffer);
@@ -89,13 +103,62 @@ private:
             }
 #endif
 
-            glBufferData(_target, static_cast<GLsizeiptr>(newSize), nullptr, GL_DYNAMIC_DRAW);
-            debug::assertNoGlErrors();
+            if (GLEW_ARB_buffer_storage && newSize > 0)
+            {
+                constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+                // Failing to allocate or map the storage is not fatal, the errors are
+                // consumed here instead of being reported by the next error check
+                glBufferStorage(_target, static_cast<GLsizeiptr>(newSize), nullptr, flags);
+
+                if (glGetError() == GL_NO_ERROR)
+                {
+                    _mappedData = static_cast<unsigned char*>(
+                        glMapBufferRange(_target, 0, static_cast<GLsizeiptr>(newSize), flags));
+
+                    if (glGetError() != GL_NO_ERROR)
+                    {
+                        _mappedData = nullptr;
+                    }
+                }
+
+                // Fall back to a regular buffer object if no mapping could be acquired
+                if (_mappedData == nullptr)
+                {
+                    glDeleteBuffers(1, &_buffer);
+                    glGenBuffers(1, &_buffer);
+                    glBindBuffer(_target, _buffer);
+                }
+            }
+
+            if (_mappedData == nullptr)
+            {
+                glBufferData(_target, static_cast<GLsizeiptr>(newSize), nullptr, GL_DYNAMIC_DRAW);
+                debug::assertNoGlErrors();
+            }
 
             _allocatedSize = newSize;
 
             glBindBuffer(_target, 0);
         }
+
+    private:
+        void releaseBuffer()
+        {
+            if (_buffer == 0) return;
+
+            if (_mappedData != nullptr)
+            {
+                glBindBuffer(_target, _buffer);
+                glUnmapBuffer(_target);
+                glBindBuffer(_target, 0);
+
+                _mappedData = nullptr;
+            }
+
+            glDeleteBuffers(1, &_buffer);
+            _buffer = 0;
+        }
     };
 
 public:
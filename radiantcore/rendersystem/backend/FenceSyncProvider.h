@@ -15,6 +15,8 @@ class FenceSyncProvider final :
         public ISyncObject
     {
     private:
+        static constexpr GLuint64 WaitTimeoutNanoseconds = 1000000; // 1 msec
+
         GLsync _syncObject;
 
     public:
@@ -26,16 +28,19 @@ class FenceSyncProvider final :
         {
             if (_syncObject == nullptr) return;
 
-            auto result = glClientWaitSync(_syncObject, 0, GL_TIMEOUT_IGNORED);
+            // Flush the command queue on the first attempt, otherwise the fence
+            // might never be signaled. GL_TIMEOUT_IGNORED is not a valid value
+            // for glClientWaitSync, the timeout is given in nanoseconds.
+            auto result = glClientWaitSync(_syncObject, GL_SYNC_FLUSH_COMMANDS_BIT, WaitTimeoutNanoseconds);
 
-            while (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            while (result == GL_TIMEOUT_EXPIRED)
             {
-                result = glClientWaitSync(_syncObject, 0, GL_TIMEOUT_IGNORED);
+                result = glClientWaitSync(_syncObject, 0, WaitTimeoutNanoseconds);
+            }
 
-                if (result == GL_WAIT_FAILED)
-                {
-                    throw std::runtime_error("Could not acquire frame buffer lock");
-                }
+            if (result == GL_WAIT_FAILED)
+            {
+                throw std::runtime_error("Could not acquire frame buffer lock");
             }
         }
 
@@ -2,6 +2,7 @@
 
 #include "OpenGLShaderPass.h"
 #include "OpenGLShader.h"
+#include "fmt/format.h"
 
 namespace render
 {
@@ -30,6 +31,8 @@ public:
 
 IRenderResult::Ptr FullBrightRenderer::render(RenderStateFlags globalstate, const IRenderView& view, std::size_t time)
 {
+    auto drawCallsBefore = _objectRenderer.getDrawCallCount();
+
     // Make sure all the data is uploaded
     _geometryStore.syncToBufferObjects();
 
@@ -83,7 +86,10 @@ IRenderResult::Ptr FullBrightRenderer::render(RenderStateFlags globalstate, cons
 
     cleanupState();
 
-    return std::make_shared<FullBrightRenderResult>(view.getCullStats());
+    // Windings and selection overlays are not submitted through the object renderer
+    auto drawCalls = _objectRenderer.getDrawCallCount() - drawCallsBefore;
+
+    return std::make_shared<FullBrightRenderResult>(fmt::format("{0} | Draws: {1}", view.getCullStats(), drawCalls));
 }
 
 }
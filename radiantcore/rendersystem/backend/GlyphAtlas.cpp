@@ -0,0 +1,186 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "itextstream.h"
+#include "debugging/gl.h"
+
+namespace render
+{
+
+namespace
+{
+    constexpr int GlyphsPerRow = 16;
+
+    // Space around each glyph, some glyphs extend a bit beyond their advance
+    constexpr float CellPadding = 2;
+}
+
+GlyphAtlas::GlyphAtlas(IGLFont& font) :
+    _font(font),
+    _textureNumber(0),
+    _realised(false),
+    _glyphs(),
+    _cellWidth(0),
+    _cellHeight(0),
+    _penOffsetX(0),
+    _penOffsetY(0)
+{}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    if (_textureNumber != 0)
+    {
+        glDeleteTextures(1, &_textureNumber);
+        _textureNumber = 0;
+    }
+}
+
+bool GlyphAtlas::ensureRealised()
+{
+    if (!_realised)
+    {
+        _realised = true;
+        createTexture();
+    }
+
+    return _textureNumber != 0;
+}
+
+void GlyphAtlas::createTexture()
+{
+    float maxAdvance = 0;
+
+    for (auto c = FirstGlyph; c <= LastGlyph; ++c)
+    {
+        auto& glyph = _glyphs[c - FirstGlyph];
+        glyph.advance = _font.getAdvance(std::string(1, c));
+
+        maxAdvance = std::max(maxAdvance, glyph.advance);
+    }
+
+    if (maxAdvance <= 0 || _font.getLineHeight() <= 0)
+    {
+        rWarning() << "Cannot create glyph atlas, the font has no metrics" << std::endl;
+        return;
+    }
+
+    _cellWidth = std::ceil(maxAdvance) + 2 * CellPadding;
+    _cellHeight = std::ceil(_font.getLineHeight()) + 2 * CellPadding;
+
+    // The pen is placed on the baseline, leaving room for the descender below
+    _penOffsetX = CellPadding;
+    _penOffsetY = CellPadding + std::ceil(-_font.getDescender());
+
+    constexpr int numGlyphs = LastGlyph - FirstGlyph + 1;
+    constexpr int numRows = (numGlyphs + GlyphsPerRow - 1) / GlyphsPerRow;
+
+    auto width = static_cast<GLsizei>(_cellWidth) * GlyphsPerRow;
+    auto height = static_cast<GLsizei>(_cellHeight) * numRows;
+
+    // Render the glyphs in white to an offscreen colour buffer
+    GLuint fbo = 0;
+    GLuint colourBuffer = 0;
+
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &colourBuffer);
+
+    glBindTexture(GL_TEXTURE_2D, colourBuffer);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colourBuffer, 0);
+
+    std::vector<unsigned char> coverage;
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE)
+    {
+        glPushAttrib(GL_ENABLE_BIT | GL_VIEWPORT_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
+        glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_SCISSOR_TEST);
+        glDisable(GL_TEXTURE_2D);
+
+        glViewport(0, 0, width, height);
+        glClearColor(0, 0, 0, 0);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        glOrtho(0, width, 0, height, -1, 1);
+
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadIdentity();
+
+        // The font blends its glyphs onto the black background, the red channel
+        // ends up containing the exact coverage value of each pixel
+        glColor4f(1, 1, 1, 1);
+
+        for (auto c = FirstGlyph; c <= LastGlyph; ++c)
+        {
+            auto index = c - FirstGlyph;
+            auto cellX = static_cast<float>(index % GlyphsPerRow) * _cellWidth;
+            auto cellY = static_cast<float>(index / GlyphsPerRow) * _cellHeight;
+
+            glRasterPos2f(cellX + _penOffsetX, cellY + _penOffsetY);
+            _font.drawString(std::string(1, c));
+
+            auto& glyph = _glyphs[index];
+            glyph.s0 = cellX / width;
+            glyph.t0 = cellY / height;
+            glyph.s1 = (cellX + _cellWidth) / width;
+            glyph.t1 = (cellY + _cellHeight) / height;
+        }
+
+        coverage.resize(static_cast<std::size_t>(width) * height);
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RED, GL_UNSIGNED_BYTE, coverage.data());
+
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glPopMatrix();
+
+        glPopClientAttrib();
+        glPopAttrib();
+    }
+    else
+    {
+        rWarning() << "Cannot create glyph atlas, the frame buffer is incomplete" << std::endl;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &colourBuffer);
+
+    if (coverage.empty())
+    {
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return;
+    }
+
+    // Upload the coverage as alpha texture, the text colour is coming from the vertices
+    glGenTextures(1, &_textureNumber);
+    glBindTexture(GL_TEXTURE_2D, _textureNumber);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, coverage.data());
+    glPopClientAttrib();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    debug::assertNoGlErrors();
+}
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include "igl.h"
+
+namespace render
+{
+
+/**
+ * Texture containing the printable ASCII glyphs of a font, arranged in a grid
+ * of equally sized cells. The glyphs are rasterised once by the font itself
+ * (into a frame buffer), such that text can be drawn as textured quads
+ * instead of one font call per string.
+ *
+ * The texture is created on first use and requires a valid GL context.
+ */
+class GlyphAtlas final
+{
+public:
+    // Texture coordinates and advance of a single glyph
+    struct Glyph
+    {
+        float s0, t0, s1, t1;
+        float advance;
+    };
+
+    static constexpr char FirstGlyph = 32;
+    static constexpr char LastGlyph = 126;
+
+private:
+    IGLFont& _font;
+
+    GLuint _textureNumber;
+    bool _realised;
+
+    std::array<Glyph, LastGlyph - FirstGlyph + 1> _glyphs;
+
+    // Size of a glyph cell in pixels
+    float _cellWidth;
+    float _cellHeight;
+
+    // Offset from the bottom left corner of a cell to the pen position
+    float _penOffsetX;
+    float _penOffsetY;
+
+public:
+    GlyphAtlas(IGLFont& font);
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas& other) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas& other) = delete;
+
+    // Returns true if the atlas could be set up, creating the texture if necessary
+    bool ensureRealised();
+
+    GLuint getTextureNumber() const
+    {
+        return _textureNumber;
+    }
+
+    // Returns true if all characters of the given string are part of the atlas
+    static bool ContainsAllGlyphs(const std::string& text)
+    {
+        for (auto c : text)
+        {
+            if (c < FirstGlyph || c > LastGlyph) return false;
+        }
+
+        return true;
+    }
+
+    // The given character needs to be in the range [FirstGlyph..LastGlyph]
+    const Glyph& getGlyph(char c) const
+    {
+        return _glyphs[c - FirstGlyph];
+    }
+
+    float getCellWidth() const
+    {
+        return _cellWidth;
+    }
+
+    float getCellHeight() const
+    {
+        return _cellHeight;
+    }
+
+    float getPenOffsetX() const
+    {
+        return _penOffsetX;
+    }
+
+    float getPenOffsetY() const
+    {
+        return _penOffsetY;
+    }
+
+private:
+    void createTexture();
+};
+
+}
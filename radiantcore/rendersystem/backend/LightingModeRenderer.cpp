@@ -370,7 +370,8 @@ void LightingModeRenderer::drawDepthFillPass(OpenGLState& current, RenderStateFl
 
     for (auto& interactionList : _regularLights)
     {
-        interactionList.fillDepthBuffer(current, *depthFillProgram, renderTime, _untransformedObjectsWithoutAlphaTest);
+        interactionList.fillDepthBuffer(current, *depthFillProgram, renderTime,
+            _untransformedObjectsWithoutAlphaTest, _orientedObjectsWithoutAlphaTest);
         _result->depthDrawCalls += interactionList.getDepthDrawCalls();
     }
 
@@ -388,6 +389,42 @@ void LightingModeRenderer::drawDepthFillPass(OpenGLState& current, RenderStateFl
 
         _untransformedObjectsWithoutAlphaTest.clear();
     }
+
+    drawOrientedObjectsWithoutAlphaTest(*depthFillProgram);
+}
+
+void LightingModeRenderer::drawOrientedObjectsWithoutAlphaTest(DepthFillAlphaProgram& program)
+{
+    if (_orientedObjectsWithoutAlphaTest.empty()) return;
+
+    program.setAlphaTest(-1);
+
+    // Per-instance attributes are set up using the core glVertexAttribDivisor, which requires GL 3.3
+    auto supportsInstancing = GLEW_VERSION_3_3;
+
+    // Objects sharing their geometry (like many copies of the same model) are drawn as instances
+    _orientedObjectsWithoutAlphaTest.foreachSlot([&](IGeometryStore::Slot slot, const std::vector<Matrix4>& transforms)
+    {
+        if (supportsInstancing && transforms.size() > 1)
+        {
+            program.setObjectTransform(Matrix4::getIdentity());
+
+            _objectRenderer.submitInstancedGeometry(slot, transforms, GL_TRIANGLES);
+            _result->depthDrawCalls++;
+            _result->instancedObjects += transforms.size();
+            return;
+        }
+
+        for (const auto& transform : transforms)
+        {
+            program.setObjectTransform(transform);
+
+            _objectRenderer.submitGeometry(slot, GL_TRIANGLES);
+            _result->depthDrawCalls++;
+        }
+    });
+
+    _orientedObjectsWithoutAlphaTest.clear();
 }
 
 void LightingModeRenderer::drawNonInteractionPasses(OpenGLState& current, RenderStateFlags globalFlagsMask, 
@@ -35,6 +35,7 @@ private:
     const std::set<IRenderEntityPtr>& _entities;
 
     std::vector<IGeometryStore::Slot> _untransformedObjectsWithoutAlphaTest;
+    InstancedObjectCollection _orientedObjectsWithoutAlphaTest;
 
     FrameBuffer::Ptr _shadowMapFbo;
     std::vector<Rectangle> _shadowMapAtlas;
@@ -76,6 +77,8 @@ private:
     void drawDepthFillPass(OpenGLState& current, RenderStateFlags globalFlagsMask,
         const IRenderView& view, std::size_t renderTime);
 
+    void drawOrientedObjectsWithoutAlphaTest(DepthFillAlphaProgram& program);
+
     void drawNonInteractionPasses(OpenGLState& current, RenderStateFlags globalFlagsMask, 
         const IRenderView& view, std::size_t time);
 
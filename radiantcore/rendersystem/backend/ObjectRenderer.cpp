@@ -9,7 +9,8 @@ namespace render
 {
 
 ObjectRenderer::ObjectRenderer(IGeometryStore& store) :
-    _store(store)
+    _store(store),
+    _drawCalls(0)
 {}
 
 void ObjectRenderer::submitObject(IRenderableObject& object)
@@ -40,6 +41,18 @@ void ObjectRenderer::initAttributePointers()
     glVertexAttribPointer(GLProgramAttribute::Tangent, 3, GL_FLOAT, 0, sizeof(RenderVertex), &bufferStart->tangent);
     glVertexAttribPointer(GLProgramAttribute::Bitangent, 3, GL_FLOAT, 0, sizeof(RenderVertex), &bufferStart->bitangent);
     glVertexAttribPointer(GLProgramAttribute::Colour, 4, GL_FLOAT, 0, sizeof(RenderVertex), &bufferStart->colour);
+
+    resetInstanceTransform();
+}
+
+void ObjectRenderer::resetInstanceTransform()
+{
+    // Programs reading the instance transform attribute multiply it with their object transform,
+    // the attribute needs to be identity when no per-instance array is active
+    glVertexAttrib4f(GLProgramAttribute::InstanceTransform + 0, 1, 0, 0, 0);
+    glVertexAttrib4f(GLProgramAttribute::InstanceTransform + 1, 0, 1, 0, 0);
+    glVertexAttrib4f(GLProgramAttribute::InstanceTransform + 2, 0, 0, 1, 0);
+    glVertexAttrib4f(GLProgramAttribute::InstanceTransform + 3, 0, 0, 0, 1);
 }
 
 void ObjectRenderer::submitGeometry(IGeometryStore::Slot slot, GLenum primitiveMode)
@@ -48,6 +61,7 @@ void ObjectRenderer::submitGeometry(IGeometryStore::Slot slot, GLenum primitiveM
 
     glDrawElementsBaseVertex(primitiveMode, static_cast<GLsizei>(renderParams.indexCount),
         GL_UNSIGNED_INT, const_cast<unsigned int*>(renderParams.firstIndex), static_cast<GLint>(renderParams.firstVertex));
+    ++_drawCalls;
 }
 
 void ObjectRenderer::submitInstancedGeometry(IGeometryStore::Slot slot, int numInstances, GLenum primitiveMode)
@@ -56,6 +70,56 @@ void ObjectRenderer::submitInstancedGeometry(IGeometryStore::Slot slot, int numI
 
     glDrawElementsInstancedBaseVertex(primitiveMode, static_cast<GLsizei>(renderParams.indexCount),
         GL_UNSIGNED_INT, renderParams.firstIndex, static_cast<GLint>(numInstances), static_cast<GLint>(renderParams.firstVertex));
+    ++_drawCalls;
+}
+
+void ObjectRenderer::submitInstancedGeometry(IGeometryStore::Slot slot, const std::vector<Matrix4>& transforms, GLenum primitiveMode)
+{
+    if (transforms.empty()) return;
+
+    // Convert the column-major transforms to single precision
+    _instanceTransforms.clear();
+    _instanceTransforms.reserve(transforms.size() * 16);
+
+    for (const auto& transform : transforms)
+    {
+        const double* elements = transform;
+
+        for (int i = 0; i < 16; ++i)
+        {
+            _instanceTransforms.push_back(static_cast<float>(elements[i]));
+        }
+    }
+
+    // The transforms are read from client memory, the vertex buffer must not be bound
+    // while setting up the attribute pointers (it stays in use for the other attributes)
+    auto [vertexBuffer, _] = _store.getBufferObjects();
+    vertexBuffer->unbind();
+
+    // A mat4 attribute occupies four consecutive locations, one per column
+    for (int column = 0; column < 4; ++column)
+    {
+        auto location = GLProgramAttribute::InstanceTransform + column;
+
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(float), _instanceTransforms.data() + column * 4);
+        glVertexAttribDivisor(location, 1);
+    }
+
+    vertexBuffer->bind();
+
+    submitInstancedGeometry(slot, static_cast<int>(transforms.size()), primitiveMode);
+
+    for (int column = 0; column < 4; ++column)
+    {
+        auto location = GLProgramAttribute::InstanceTransform + column;
+
+        glVertexAttribDivisor(location, 0);
+        glDisableVertexAttribArray(location);
+    }
+
+    // The current attribute value is undefined after drawing from an array
+    resetInstanceTransform();
 }
 
 void ObjectRenderer::submitGeometryWithCustomIndices(IGeometryStore::Slot slot, GLenum primitiveMode,
@@ -69,16 +133,17 @@ void ObjectRenderer::submitGeometryWithCustomIndices(IGeometryStore::Slot slot,
 
     glDrawElementsBaseVertex(primitiveMode, static_cast<GLsizei>(indices.size()),
         GL_UNSIGNED_INT, const_cast<unsigned int*>(indices.data()), static_cast<GLint>(renderParams.firstVertex));
+    ++_drawCalls;
 
     indexBuffer->bind();
 }
 
 template<typename ContainerT>
-void SubmitGeometryInternal(const ContainerT& slots, GLenum primitiveMode, IGeometryStore& store)
+std::size_t SubmitGeometryInternal(const ContainerT& slots, GLenum primitiveMode, IGeometryStore& store)
 {
     auto surfaceCount = slots.size();
 
-    if (surfaceCount == 0) return;
+    if (surfaceCount == 0) return 0;
 
     // Build the indices and offsets used for the glMulti draw call
     std::vector<GLsizei> sizes;
@@ -100,16 +165,18 @@ void SubmitGeometryInternal(const ContainerT& slots, GLenum primitiveMode, IGeom
 
     glMultiDrawElementsBaseVertex(primitiveMode, sizes.data(), GL_UNSIGNED_INT,
         firstIndices.data(), static_cast<GLsizei>(sizes.size()), firstVertices.data());
+
+    return 1;
 }
 
 void ObjectRenderer::submitGeometry(const std::set<IGeometryStore::Slot>& slots, GLenum primitiveMode)
 {
-    SubmitGeometryInternal(slots, primitiveMode, _store);
+    _drawCalls += SubmitGeometryInternal(slots, primitiveMode, _store);
 }
 
 void ObjectRenderer::submitGeometry(const std::vector<IGeometryStore::Slot>& slots, GLenum primitiveMode)
 {
-    SubmitGeometryInternal(slots, primitiveMode, _store);
+    _drawCalls += SubmitGeometryInternal(slots, primitiveMode, _store);
 }
 
 void ObjectRenderer::submitInstancedGeometry(const std::vector<IGeometryStore::Slot>& slots, int numInstances, GLenum primitiveMode)
@@ -120,4 +187,9 @@ void ObjectRenderer::submitInstancedGeometry(const std::vector<IGeometryStore::S
     }
 }
 
+std::size_t ObjectRenderer::getDrawCallCount() const
+{
+    return _drawCalls;
+}
+
 }
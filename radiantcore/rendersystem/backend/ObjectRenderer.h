@@ -17,6 +17,11 @@ class ObjectRenderer :
 private:
     IGeometryStore& _store;
 
+    std::size_t _drawCalls;
+
+    // Single-precision copy of the transforms of the current instanced draw call
+    std::vector<float> _instanceTransforms;
+
 public:
     ObjectRenderer(IGeometryStore& store);
 
@@ -43,6 +48,15 @@ public:
 
     // Draws all geometry as defined by their store IDs in the given mode, no transforms (std::vector variant)
     void submitInstancedGeometry(const std::vector<IGeometryStore::Slot>& slots, int numInstances, GLenum primitiveMode) override;
+
+    // Draws one instance of the given slot per transform, passed as per-instance vertex attribute
+    void submitInstancedGeometry(IGeometryStore::Slot slot, const std::vector<Matrix4>& transforms, GLenum primitiveMode) override;
+
+    std::size_t getDrawCallCount() const override;
+
+private:
+    // Sets the value of the instance transform attribute used by non-instanced draw calls
+    void resetInstanceTransform();
 };
 
 }
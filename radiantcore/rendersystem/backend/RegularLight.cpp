@@ -100,7 +100,8 @@ void RegularLight::collectSurfaces(const IRenderView& view, const std::set<IRend
 }
 
 void RegularLight::fillDepthBuffer(OpenGLState& state, DepthFillAlphaProgram& program, 
-    std::size_t renderTime, std::vector<IGeometryStore::Slot>& untransformedObjectsWithoutAlphaTest)
+    std::size_t renderTime, std::vector<IGeometryStore::Slot>& untransformedObjectsWithoutAlphaTest,
+    InstancedObjectCollection& orientedObjectsWithoutAlphaTest)
 {
     std::vector<IGeometryStore::Slot> untransformedObjects;
     untransformedObjects.reserve(1000);
@@ -115,12 +116,14 @@ void RegularLight::fillDepthBuffer(OpenGLState& state, DepthFillAlphaProgram& pr
 
             setupAlphaTest(state, shader, depthFillPass, program, renderTime, entity);
 
+            auto isPerforated = shader->getMaterial()->getCoverage() == Material::MC_PERFORATED;
+
             for (const auto& object : objects)
             {
                 // We submit all objects with an identity matrix in a single multi draw call
                 if (!object.get().isOriented())
                 {
-                    if (shader->getMaterial()->getCoverage() == Material::MC_PERFORATED)
+                    if (isPerforated)
                     {
                         untransformedObjects.push_back(object.get().getStorageLocation());
                     }
@@ -133,6 +136,13 @@ void RegularLight::fillDepthBuffer(OpenGLState& state, DepthFillAlphaProgram& pr
                     continue;
                 }
 
+                // Oriented objects sharing the same geometry are drawn as instances later on
+                if (!isPerforated)
+                {
+                    orientedObjectsWithoutAlphaTest.add(object.get());
+                    continue;
+                }
+
                 program.setObjectTransform(object.get().getObjectTransform());
 
                 _objectRenderer.submitGeometry(object.get().getStorageLocation(), GL_TRIANGLES);
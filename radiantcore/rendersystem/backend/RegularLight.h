@@ -7,6 +7,7 @@
 #include "irenderableobject.h"
 #include "iobjectrenderer.h"
 #include "irenderview.h"
+#include "render/InstancedObjectCollection.h"
 #include "render/Rectangle.h"
 #include "InteractionPass.h"
 
@@ -176,8 +177,11 @@ public:
 
     void collectSurfaces(const IRenderView& view, const std::set<IRenderEntityPtr>& entities);
 
+    // Objects without alpha test are not drawn right away, they are added to the given
+    // collections to be submitted in a few draw calls after all lights have been processed
     void fillDepthBuffer(OpenGLState& state, DepthFillAlphaProgram& program, 
-        std::size_t renderTime, std::vector<IGeometryStore::Slot>& untransformedObjectsWithoutAlphaTest);
+        std::size_t renderTime, std::vector<IGeometryStore::Slot>& untransformedObjectsWithoutAlphaTest,
+        InstancedObjectCollection& orientedObjectsWithoutAlphaTest);
 
     void drawShadowMap(OpenGLState& state, const Rectangle& rectangle, ShadowMapProgram& program, std::size_t renderTime);
 
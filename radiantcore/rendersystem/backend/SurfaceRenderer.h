@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <stdexcept>
 #include "irender.h"
 #include "isurfacerenderer.h"
@@ -17,15 +18,29 @@ private:
     IGeometryStore& _store;
     IObjectRenderer& _renderer;
 
+    // Surfaces referencing the same vertex and index arrays (like the surfaces
+    // of several model nodes using the same model) share their storage.
+    // The key is the geometry id of the surface, zero means not shared.
+    using GeometryKey = std::uint64_t;
+
+    struct SharedStorage
+    {
+        IGeometryStore::Slot storageHandle;
+        std::size_t refCount;
+    };
+    std::map<GeometryKey, SharedStorage> _sharedStorage;
+
     struct SurfaceInfo
     {
         std::reference_wrapper<IRenderableSurface> surface;
         bool surfaceDataChanged;
+        GeometryKey geometryKey;
         IGeometryStore::Slot storageHandle;
 
-        SurfaceInfo(IRenderableSurface& surface_, IGeometryStore::Slot slot) :
+        SurfaceInfo(IRenderableSurface& surface_, const GeometryKey& key, IGeometryStore::Slot slot) :
             surface(surface_),
             surfaceDataChanged(false),
+            geometryKey(key),
             storageHandle(slot)
         {}
     };
@@ -54,15 +69,17 @@ public:
         // Find a free slot
         auto newSlotIndex = getNextFreeSlotIndex();
 
-        const auto& vertices = surface.getVertices();
-        const auto& indices = surface.getIndices();
+        auto key = surface.getGeometryId();
+        bool isNewStorage = false;
+        auto storageHandle = acquireStorage(surface, key, isNewStorage);
 
-        auto slot = _store.allocateSlot(vertices.size(), indices.size());
-
-        // Transform the vertices to single precision
-        _store.updateData(slot, ConvertToRenderVertices(vertices), indices);
+        if (isNewStorage)
+        {
+            // Transform the vertices to single precision
+            _store.updateData(storageHandle, ConvertToRenderVertices(surface.getVertices()), surface.getIndices());
+        }
 
-        _surfaces.emplace(newSlotIndex, SurfaceInfo(surface, slot));
+        _surfaces.emplace(newSlotIndex, SurfaceInfo(surface, key, storageHandle));
 
         return newSlotIndex;
     }
@@ -72,8 +89,8 @@ public:
         auto surface = _surfaces.find(slot);
         assert(surface != _surfaces.end());
 
-        // Deallocate the storage
-        _store.deallocateSlot(surface->second.storageHandle);
+        // Deallocate the storage if no other surface is using it
+        releaseStorage(surface->second.geometryKey, surface->second.storageHandle);
         _surfaces.erase(surface);
 
         if (slot < _freeSlotMappingHint)
@@ -84,7 +101,22 @@ public:
 
     void updateSurface(Slot slot) override
     {
-        _surfaces.at(slot).surfaceDataChanged = true;
+        auto& surfaceInfo = _surfaces.at(slot);
+
+        // The surface might have switched to different arrays (e.g. when a model is scaled)
+        auto& surface = surfaceInfo.surface.get();
+        auto key = surface.getGeometryId();
+
+        if (key != surfaceInfo.geometryKey)
+        {
+            releaseStorage(surfaceInfo.geometryKey, surfaceInfo.storageHandle);
+
+            bool isNewStorage = false;
+            surfaceInfo.storageHandle = acquireStorage(surface, key, isNewStorage);
+            surfaceInfo.geometryKey = key;
+        }
+
+        surfaceInfo.surfaceDataChanged = true;
         _surfacesNeedingUpdate.push_back(slot);
         _surfacesNeedUpdate = true;
     }
@@ -114,6 +146,9 @@ public:
 
         _surfacesNeedUpdate = false;
 
+        // Shared storage needs to be uploaded only once
+        std::set<IGeometryStore::Slot> updatedStorage;
+
         for (auto slotIndex : _surfacesNeedingUpdate)
         {
             auto info = _surfaces.find(slotIndex);
@@ -126,6 +161,8 @@ public:
             {
                 surfaceInfo.surfaceDataChanged = false;
 
+                if (!updatedStorage.insert(surfaceInfo.storageHandle).second) continue;
+
                 auto& surface = surfaceInfo.surface.get();
                 _store.updateData(surfaceInfo.storageHandle, ConvertToRenderVertices(surface.getVertices()), surface.getIndices());
             }
@@ -135,6 +172,49 @@ public:
     }
 
 private:
+    // Returns the storage for the arrays of the given surface, allocating a new slot if no other surface is using them
+    IGeometryStore::Slot acquireStorage(IRenderableSurface& surface, GeometryKey key, bool& isNewStorage)
+    {
+        isNewStorage = true;
+
+        if (key == 0)
+        {
+            return _store.allocateSlot(surface.getVertices().size(), surface.getIndices().size());
+        }
+
+        auto existing = _sharedStorage.find(key);
+
+        if (existing != _sharedStorage.end())
+        {
+            ++existing->second.refCount;
+            isNewStorage = false;
+            return existing->second.storageHandle;
+        }
+
+        auto storageHandle = _store.allocateSlot(surface.getVertices().size(), surface.getIndices().size());
+        _sharedStorage.emplace(key, SharedStorage{ storageHandle, 1 });
+
+        return storageHandle;
+    }
+
+    void releaseStorage(GeometryKey key, IGeometryStore::Slot storageHandle)
+    {
+        if (key == 0)
+        {
+            _store.deallocateSlot(storageHandle);
+            return;
+        }
+
+        auto existing = _sharedStorage.find(key);
+        assert(existing != _sharedStorage.end());
+
+        if (--existing->second.refCount == 0)
+        {
+            _store.deallocateSlot(existing->second.storageHandle);
+            _sharedStorage.erase(existing);
+        }
+    }
+
     static std::vector<RenderVertex> ConvertToRenderVertices(const std::vector<MeshVertex>& vertices)
     {
         std::vector<RenderVertex> transformedVertices;
@@ -0,0 +1,217 @@
+#include "TextRenderer.h"
+
+#include <cmath>
+#include <stdexcept>
+#include "math/Matrix4.h"
+#include "math/Vector4.h"
+
+namespace render
+{
+
+TextRenderer::TextRenderer(const IGLFont::Ptr& font) :
+    _freeSlotMappingHint(0),
+    _font(font),
+    _atlas(*font)
+{
+    assert(_font);
+}
+
+ITextRenderer::Slot TextRenderer::addText(IRenderableText& text)
+{
+    // Find a free slot
+    auto newSlotIndex = getNextFreeSlotIndex();
+
+    if (newSlotIndex == _slots.size())
+    {
+        _slots.push_back(&text);
+    }
+    else
+    {
+        _slots[newSlotIndex] = &text;
+    }
+
+    return newSlotIndex;
+}
+
+void TextRenderer::removeText(Slot slot)
+{
+    if (slot >= _slots.size()) return;
+
+    // Free the slot
+    _slots[slot] = nullptr;
+
+    if (slot < _freeSlotMappingHint)
+    {
+        _freeSlotMappingHint = slot;
+    }
+}
+
+void TextRenderer::render(const VolumeTest& view)
+{
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    const auto& viewProjection = view.GetViewProjection();
+    auto useAtlas = _atlas.ensureRealised();
+
+    _vertices.clear();
+    _fallbackTexts.clear();
+
+    for (auto renderable : _slots)
+    {
+        if (renderable == nullptr) continue;
+
+        const auto& text = renderable->getText();
+
+        if (text.empty()) continue;
+
+        // Project the position to clip space, texts outside the view volume are not drawn
+        // (this is the same condition that invalidates the GL raster position)
+        auto clip = viewProjection.transform(Vector4(renderable->getWorldPosition(), 1));
+
+        if (clip.w() <= 0 ||
+            std::abs(clip.x()) > clip.w() || std::abs(clip.y()) > clip.w() || std::abs(clip.z()) > clip.w())
+        {
+            continue;
+        }
+
+        if (!useAtlas || !GlyphAtlas::ContainsAllGlyphs(text))
+        {
+            _fallbackTexts.push_back(renderable);
+            continue;
+        }
+
+        // Window position of the pen, snapped to pixels like the raster position
+        auto penX = std::floor(viewport[0] + (clip.x() / clip.w() + 1) * 0.5 * viewport[2] + 0.5);
+        auto penY = std::floor(viewport[1] + (clip.y() / clip.w() + 1) * 0.5 * viewport[3] + 0.5);
+
+        addTextToBatch(text, renderable->getColour(), static_cast<float>(penX), static_cast<float>(penY));
+    }
+
+    if (!_vertices.empty())
+    {
+        drawBatch(viewport);
+    }
+
+    for (auto renderable : _fallbackTexts)
+    {
+        glColor4dv(renderable->getColour());
+        glRasterPos3dv(renderable->getWorldPosition());
+
+        _font->drawString(renderable->getText());
+    }
+}
+
+void TextRenderer::addTextToBatch(const std::string& text, const Vector4& colour, float penX, float penY)
+{
+    auto r = static_cast<float>(colour.x());
+    auto g = static_cast<float>(colour.y());
+    auto b = static_cast<float>(colour.z());
+    auto a = static_cast<float>(colour.w());
+
+    for (auto c : text)
+    {
+        const auto& glyph = _atlas.getGlyph(c);
+
+        auto x0 = penX - _atlas.getPenOffsetX();
+        auto y0 = penY - _atlas.getPenOffsetY();
+        auto x1 = x0 + _atlas.getCellWidth();
+        auto y1 = y0 + _atlas.getCellHeight();
+
+        // Two triangles per glyph
+        _vertices.push_back(TextVertex{ x0, y0, glyph.s0, glyph.t0, r, g, b, a });
+        _vertices.push_back(TextVertex{ x1, y0, glyph.s1, glyph.t0, r, g, b, a });
+        _vertices.push_back(TextVertex{ x1, y1, glyph.s1, glyph.t1, r, g, b, a });
+
+        _vertices.push_back(TextVertex{ x0, y0, glyph.s0, glyph.t0, r, g, b, a });
+        _vertices.push_back(TextVertex{ x1, y1, glyph.s1, glyph.t1, r, g, b, a });
+        _vertices.push_back(TextVertex{ x0, y1, glyph.s0, glyph.t1, r, g, b, a });
+
+        penX += glyph.advance;
+    }
+}
+
+void TextRenderer::drawBatch(const GLint* viewport)
+{
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT | GL_POLYGON_BIT | GL_TRANSFORM_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+    // Draw in window coordinates
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(viewport[0], viewport[0] + viewport[2], viewport[1], viewport[1] + viewport[3], -1, 1);
+
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    // Use the fixed function pipeline
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(0);
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_LIGHTING);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glActiveTexture(GL_TEXTURE0);
+    glClientActiveTexture(GL_TEXTURE0);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, _atlas.getTextureNumber());
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    // The vertices are read from client memory
+    GLint previousArrayBuffer = 0;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousArrayBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+
+    glVertexPointer(2, GL_FLOAT, sizeof(TextVertex), &_vertices.front().x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(TextVertex), &_vertices.front().s);
+    glColorPointer(4, GL_FLOAT, sizeof(TextVertex), &_vertices.front().r);
+
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(_vertices.size()));
+
+    glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(previousArrayBuffer));
+    glUseProgram(static_cast<GLuint>(previousProgram));
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+
+    glPopClientAttrib();
+    glPopAttrib();
+}
+
+ITextRenderer::Slot TextRenderer::getNextFreeSlotIndex()
+{
+    for (auto i = _freeSlotMappingHint; i < _slots.size(); ++i)
+    {
+        if (_slots[i] == nullptr)
+        {
+            _freeSlotMappingHint = i + 1; // start searching here next time
+            return i;
+        }
+    }
+
+    if (_slots.size() >= InvalidSlot)
+    {
+        throw std::runtime_error("TextRenderer ran out of slot numbers");
+    }
+
+    // Append a new slot at the end
+    _freeSlotMappingHint = _slots.size() + 1;
+    return _slots.size();
+}
+
+}
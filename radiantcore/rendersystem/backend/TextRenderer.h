@@ -1,8 +1,10 @@
 #pragma once
 
-#include <map>
+#include <vector>
 #include "igl.h"
 #include "irender.h"
+#include "ivolumetest.h"
+#include "GlyphAtlas.h"
 
 namespace render
 {
@@ -10,78 +12,58 @@ namespace render
 /**
  * Text renderer implementation drawing the attached IRenderableText
  * instances to the scene. Does not change any GL state/matrices.
- * 
+ *
+ * Texts positioned outside the view are skipped. All visible texts are
+ * assembled from the glyph atlas of the font into a single vertex batch
+ * and submitted in one draw call. Texts containing characters not present
+ * in the atlas are drawn by the font itself.
+ *
  * Requires a valid IGLFont reference at construction time.
  */
 class TextRenderer final :
     public ITextRenderer
 {
 private:
-    std::map<Slot, std::reference_wrapper<IRenderableText>> _slots;
+    // Dense slot storage, unused slots are set to nullptr
+    std::vector<IRenderableText*> _slots;
 
     Slot _freeSlotMappingHint;
 
     IGLFont::Ptr _font;
 
-public:
-    TextRenderer(const IGLFont::Ptr& font) :
-        _font(font),
-        _freeSlotMappingHint(0)
-    {
-        assert(_font);
-    }
+    GlyphAtlas _atlas;
 
-    Slot addText(IRenderableText& text) override
+    struct TextVertex
     {
-        // Find a free slot
-        auto newSlotIndex = getNextFreeSlotIndex();
+        float x, y;
+        float s, t;
+        float r, g, b, a;
+    };
 
-        _slots.emplace(newSlotIndex, text);
+    // Vertex batch assembled during rendering, kept to reuse its memory
+    std::vector<TextVertex> _vertices;
 
-        return newSlotIndex;
-    }
+    // Visible texts that cannot be drawn using the atlas
+    std::vector<IRenderableText*> _fallbackTexts;
 
-    void removeText(Slot slot) override
-    {
-        // Remove the slot
-        _slots.erase(slot);
+public:
+    TextRenderer(const IGLFont::Ptr& font);
 
-        if (slot < _freeSlotMappingHint)
-        {
-            _freeSlotMappingHint = slot;
-        }
-    }
+    Slot addText(IRenderableText& text) override;
 
-    void render()
-    {
-        for (const auto& [_, ref] : _slots)
-        {
-            auto& renderable = ref.get();
-            const auto& text = renderable.getText();
+    void removeText(Slot slot) override;
 
-            if (text.empty()) continue;
+    // Draws all texts whose position is inside the given view
+    void render(const VolumeTest& view);
 
-            glColor4dv(renderable.getColour());
-            glRasterPos3dv(renderable.getWorldPosition());
+private:
+    // Adds the glyph quads of the given text to the vertex batch, with the pen
+    // starting at the given window position
+    void addTextToBatch(const std::string& text, const Vector4& colour, float penX, float penY);
 
-            _font->drawString(text);
-        }
-    }
+    void drawBatch(const GLint* viewport);
 
-private:
-    Slot getNextFreeSlotIndex()
-    {
-        for (auto i = _freeSlotMappingHint; i < std::numeric_limits<Slot>::max(); ++i)
-        {
-            if (_slots.count(i) == 0)
-            {
-                _freeSlotMappingHint = i + 1; // start searching here next time
-                return i;
-            }
-        }
-
-        throw std::runtime_error("TextRenderer ran out of slot numbers");
-    }
+    Slot getNextFreeSlotIndex();
 };
 
 }
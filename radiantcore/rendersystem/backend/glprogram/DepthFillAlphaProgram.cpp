@@ -26,6 +26,7 @@ void DepthFillAlphaProgram::create()
 
     glBindAttribLocation(_programObj, GLProgramAttribute::Position, "attr_Position");
     glBindAttribLocation(_programObj, GLProgramAttribute::TexCoord, "attr_TexCoord");
+    glBindAttribLocation(_programObj, GLProgramAttribute::InstanceTransform, "attr_InstanceTransform");
 
     glLinkProgram(_programObj);
 
@@ -1,13 +1,86 @@
 #include "SceneSelectionTesters.h"
 
+#include <atomic>
+
 #include "iscenegraph.h"
 #include "SelectionTestWalkers.h"
 #include "selection/EntitiesFirstSelector.h"
 #include "selection/SelectionPool.h"
+#include "util/ParallelFor.h"
 
 namespace selection
 {
 
+namespace
+{
+    // Below this number of concurrently testable candidates, all nodes are tested in the calling thread
+    constexpr std::size_t PARALLEL_SELECTION_TEST_MIN_NODES = 64;
+
+    // Candidates handed to each worker, every chunk clones the selection test
+    constexpr std::size_t PARALLEL_SELECTION_TEST_NODES_PER_CHUNK = 32;
+
+    struct SelectionRecord
+    {
+        ISelectable* selectable;
+        SelectionIntersection intersection;
+    };
+
+    /**
+     * Selector keeping the best intersection of each pushed selectable in the
+     * record list of the candidate node being tested. The records are replayed
+     * into the actual Selector afterwards, in the order of the candidates.
+     */
+    class SelectionRecorder :
+        public Selector
+    {
+    private:
+        std::vector<SelectionRecord>* _records;
+        SelectionIntersection _curIntersection;
+        ISelectable* _curSelectable;
+
+    public:
+        SelectionRecorder() :
+            _records(nullptr),
+            _curSelectable(nullptr)
+        {}
+
+        void setRecords(std::vector<SelectionRecord>& records)
+        {
+            _records = &records;
+        }
+
+        void pushSelectable(ISelectable& selectable) override
+        {
+            _curIntersection = SelectionIntersection();
+            _curSelectable = &selectable;
+        }
+
+        void popSelectable() override
+        {
+            _records->emplace_back(SelectionRecord{ _curSelectable, _curIntersection });
+            _curIntersection = SelectionIntersection();
+        }
+
+        void addIntersection(const SelectionIntersection& intersection) override
+        {
+            _curIntersection.assignIfCloser(intersection);
+        }
+
+        bool empty() const override
+        {
+            return _records->empty();
+        }
+
+        void foreachSelectable(const std::function<void(ISelectable*)>& functor) override
+        {
+            for (const auto& record : *_records)
+            {
+                functor(record.selectable);
+            }
+        }
+    };
+}
+
 SelectionTesterBase::SelectionTesterBase(const NodePredicate& nodePredicate) :
     _nodePredicate(nodePredicate)
 {}
@@ -17,11 +90,101 @@ bool SelectionTesterBase::nodeIsEligible(const scene::INodePtr& node) const
     return _nodePredicate ? _nodePredicate(node) : true;
 }
 
-void SelectionTesterBase::testNode(const scene::INodePtr& node, SelectionTestWalker& tester)
+std::vector<scene::INodePtr> SelectionTesterBase::collectVisibleCandidates(const VolumeTest& view)
+{
+    std::vector<scene::INodePtr> candidates;
+
+    GlobalSceneGraph().foreachVisibleNodeInVolume(view, [&](const scene::INodePtr& node)
+    {
+        if (nodeIsEligible(node))
+        {
+            candidates.push_back(node);
+        }
+        return true;
+    });
+
+    return candidates;
+}
+
+void SelectionTesterBase::testCandidates(const std::vector<scene::INodePtr>& candidates,
+    Selector& selector, SelectionTest& test, const WalkerFactory& createWalker)
 {
-    if (nodeIsEligible(node))
+    std::vector<bool> isConcurrent(candidates.size(), false);
+    std::size_t numConcurrent = 0;
+
+    // Tests that can't be cloned are run sequentially, a successful probe is used by the first chunk
+    auto firstChunkTest = candidates.size() >= PARALLEL_SELECTION_TEST_MIN_NODES ? test.clone() : SelectionTestPtr();
+
+    if (firstChunkTest)
+    {
+        // Evaluate the lazy state of the concurrently testable nodes in this thread
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+        {
+            auto testable = Node_getConcurrentSelectionTestable(candidates[i]);
+
+            if (testable)
+            {
+                testable->prepareConcurrentSelectionTest();
+                isConcurrent[i] = true;
+                ++numConcurrent;
+            }
+        }
+    }
+
+    if (numConcurrent < PARALLEL_SELECTION_TEST_MIN_NODES)
+    {
+        auto walker = createWalker(selector, test);
+
+        for (const auto& node : candidates)
+        {
+            walker->testNode(node);
+        }
+        return;
+    }
+
+    std::vector<std::vector<SelectionRecord>> records(candidates.size());
+
+    // All other nodes are tested in this thread
+    SelectionRecorder recorder;
+    auto walker = createWalker(recorder, test);
+
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        if (isConcurrent[i]) continue;
+
+        recorder.setRecords(records[i]);
+        walker->testNode(candidates[i]);
+    }
+
+    std::atomic<bool> firstChunkTestTaken = false;
+
+    util::parallelForChunks(candidates.size(), PARALLEL_SELECTION_TEST_NODES_PER_CHUNK,
+        [&](std::size_t begin, std::size_t end)
+    {
+        // The tests are stateful, each thread needs its own copy
+        auto chunkTest = firstChunkTestTaken.exchange(true) ? test.clone() : firstChunkTest;
+
+        SelectionRecorder chunkRecorder;
+        auto chunkWalker = createWalker(chunkRecorder, *chunkTest);
+
+        for (auto i = begin; i < end; ++i)
+        {
+            if (!isConcurrent[i]) continue;
+
+            chunkRecorder.setRecords(records[i]);
+            chunkWalker->testNode(candidates[i]);
+        }
+    });
+
+    // Replay the results in candidate order
+    for (const auto& candidateRecords : records)
     {
-        tester.testNode(node);
+        for (const auto& record : candidateRecords)
+        {
+            selector.pushSelectable(*record.selectable);
+            selector.addIntersection(record.intersection);
+            selector.popSelectable();
+        }
     }
 }
 
@@ -75,11 +238,9 @@ void PrimitiveSelectionTester::testSelectSceneWithFilter(const VolumeTest& view,
     auto& targetPool = !view.fill() && higherEntitySelectionPriority() ?
         static_cast<Selector&>(sortedPool) : simplePool;
 
-    AnySelector anyTester(targetPool, test);
-    GlobalSceneGraph().foreachVisibleNodeInVolume(view, [&](const scene::INodePtr& node)
+    testCandidates(collectVisibleCandidates(view), targetPool, test, [](Selector& selector, SelectionTest& test)
     {
-        testNode(node, anyTester);
-        return true;
+        return std::make_unique<AnySelector>(selector, test);
     });
 
     storeSelectablesInPool(targetPool, predicate);
@@ -99,11 +260,9 @@ void EntitySelectionTester::testSelectSceneWithFilter(const VolumeTest& view, Se
 {
     SelectionPool selector;
 
-    EntitySelector tester(selector, test);
-    GlobalSceneGraph().foreachVisibleNodeInVolume(view, [&](const scene::INodePtr& node)
+    testCandidates(collectVisibleCandidates(view), selector, test, [](Selector& selector, SelectionTest& test)
     {
-        testNode(node, tester);
-        return true;
+        return std::make_unique<EntitySelector>(selector, test);
     });
 
     storeSelectablesInPool(selector, predicate);
@@ -118,11 +277,9 @@ void GroupChildPrimitiveSelectionTester::testSelectSceneWithFilter(const VolumeT
 {
     SelectionPool selector;
 
-    GroupChildPrimitiveSelector tester(selector, test);
-    GlobalSceneGraph().foreachVisibleNodeInVolume(view, [&](const scene::INodePtr& node)
+    testCandidates(collectVisibleCandidates(view), selector, test, [](Selector& selector, SelectionTest& test)
     {
-        testNode(node, tester);
-        return true;
+        return std::make_unique<GroupChildPrimitiveSelector>(selector, test);
     });
 
     storeSelectablesInPool(selector, predicate);
@@ -137,11 +294,9 @@ void MergeActionSelectionTester::testSelectSceneWithFilter(const VolumeTest& vie
 {
     SelectionPool selector;
 
-    MergeActionSelector tester(selector, test);
-    GlobalSceneGraph().foreachVisibleNodeInVolume(view, [&](const scene::INodePtr& node)
+    testCandidates(collectVisibleCandidates(view), selector, test, [](Selector& selector, SelectionTest& test)
     {
-        testNode(node, tester);
-        return true;
+        return std::make_unique<MergeActionSelector>(selector, test);
     });
 
     storeSelectablesInPool(selector, predicate);
@@ -157,10 +312,20 @@ void ComponentSelectionTester::testSelectSceneWithFilter(const VolumeTest& view,
 {
     SelectionPool selector;
 
-    ComponentSelector tester(selector, test, _selectionSystem.ComponentMode());
+    std::vector<scene::INodePtr> candidates;
     _selectionSystem.foreachSelected([&](const scene::INodePtr& node)
     {
-        testNode(node, tester);
+        if (nodeIsEligible(node))
+        {
+            candidates.push_back(node);
+        }
+    });
+
+    auto mode = _selectionSystem.ComponentMode();
+
+    testCandidates(candidates, selector, test, [mode](Selector& selector, SelectionTest& test)
+    {
+        return std::make_unique<ComponentSelector>(selector, test, mode);
     });
 
     storeSelectablesInPool(selector, predicate);
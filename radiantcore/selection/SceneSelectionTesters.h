@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "iselectiontest.h"
 
@@ -30,9 +31,17 @@ public:
     void testSelectScene(const VolumeTest& view, SelectionTest& test) override;
 
 protected:
-    // Test the given node using the given tester. The node will be forwarded to the
-    // tester only if it passed the predicate passed to the constructor
-    void testNode(const scene::INodePtr& node, SelectionTestWalker& tester);
+    using WalkerFactory = std::function<std::unique_ptr<SelectionTestWalker>(Selector&, SelectionTest&)>;
+
+    // Returns the nodes in the given volume which passed the predicate
+    std::vector<scene::INodePtr> collectVisibleCandidates(const VolumeTest& view);
+
+    // Tests all candidates with walkers created by the given factory. Nodes supporting
+    // concurrent selection tests are processed in parallel, using one walker and
+    // one copy of the test per thread. The results are submitted to the selector
+    // in candidate order, such that they are the same as in a serial run.
+    void testCandidates(const std::vector<scene::INodePtr>& candidates, Selector& selector,
+        SelectionTest& test, const WalkerFactory& createWalker);
 
     bool nodeIsEligible(const scene::INodePtr& node) const;
 
@@ -3,6 +3,8 @@
 #include "i18n.h"
 #include "iselection.h"
 #include "iscenegraph.h"
+#include "imap.h"
+#include "imaterialusageindex.h"
 #include "itextstream.h"
 #include "iselectiontest.h"
 #include "igroupnode.h"
@@ -766,60 +768,48 @@ void normaliseTexture(const cmd::ArgumentList& args)
 	radiant::TextureChangedMessage::Send();
 }
 
-class ByShaderSelector :
-	public scene::NodeVisitor
+namespace
 {
-private:
-	std::string _shaderName;
 
-	bool _select;
+void setSelectionStatusByShader(const std::string& shaderName, bool select)
+{
+	auto root = GlobalMapModule().getRoot();
 
-public:
-	ByShaderSelector(const std::string& shaderName, bool select = true) :
-		_shaderName(shaderName),
-		_select(select)
-	{}
+	if (!root) return;
 
-	bool pre(const scene::INodePtr& node)
+	// The index matches material names case-insensitively,
+	// so check each candidate the same way the brushes and patches do
+	root->getMaterialUsageIndex().foreachNodeUsingMaterial(shaderName, [&](const scene::INodePtr& node)
 	{
-		Brush* brush = Node_getBrush(node);
-
-		if (brush != NULL)
+		if (auto brush = Node_getBrush(node); brush != nullptr)
 		{
-			if (brush->hasShader(_shaderName))
+			if (brush->hasShader(shaderName))
 			{
-				Node_setSelected(node, _select);
+				Node_setSelected(node, select);
 			}
-
-			return false; // don't traverse primitives
+			return;
 		}
 
-		Patch* patch = Node_getPatch(node);
-
-		if (patch != NULL)
+		if (auto patch = Node_getPatch(node); patch != nullptr)
 		{
-			if (patch->getShader() == _shaderName)
+			if (patch->getShader() == shaderName)
 			{
-				Node_setSelected(node, _select);
+				Node_setSelected(node, select);
 			}
-
-			return false; // don't traverse primitives
 		}
+	});
+}
 
-		return true;
-	}
-};
+}
 
 void selectItemsByShader(const std::string& shaderName)
 {
-	ByShaderSelector selector(shaderName, true);
-	GlobalSceneGraph().root()->traverseChildren(selector);
+	setSelectionStatusByShader(shaderName, true);
 }
 
 void deselectItemsByShader(const std::string& shaderName)
 {
-	ByShaderSelector selector(shaderName, false);
-	GlobalSceneGraph().root()->traverseChildren(selector);
+	setSelectionStatusByShader(shaderName, false);
 }
 
 void selectItemsByShaderCmd(const cmd::ArgumentList& args)
@@ -19,11 +19,9 @@ NamedBindablePtr CameraCubeMapDecl::createForPrefix(const std::string& prefix)
 }
 
 // Bind directional image
-void CameraCubeMapDecl::bindDirection(const std::string& dir,
+void CameraCubeMapDecl::bindDirection(const ImagePtr& img, const std::string& dir,
                                       GLuint glDir) const
 {
-    // Load the image
-    ImagePtr img = GlobalImageLoader().imageFromVFS(_prefix + dir);
     if (!img)
     {
         throw std::runtime_error(
@@ -81,13 +79,30 @@ TexturePtr CameraCubeMapDecl::bindTexture(const std::string& name,
             GL_TEXTURE_CUBE_MAP, GL_GENERATE_MIPMAP, GL_TRUE
         );
 
-        // Bind the images
-        bindDirection("_right", GL_TEXTURE_CUBE_MAP_POSITIVE_X);
-        bindDirection("_left", GL_TEXTURE_CUBE_MAP_NEGATIVE_X);
-        bindDirection("_up", GL_TEXTURE_CUBE_MAP_POSITIVE_Y);
-        bindDirection("_down", GL_TEXTURE_CUBE_MAP_NEGATIVE_Y);
-        bindDirection("_forward", GL_TEXTURE_CUBE_MAP_POSITIVE_Z);
-        bindDirection("_back", GL_TEXTURE_CUBE_MAP_NEGATIVE_Z);
+        // Decode the six images in one go, then bind them
+        const std::pair<std::string, GLuint> directions[] =
+        {
+            { "_right", GL_TEXTURE_CUBE_MAP_POSITIVE_X },
+            { "_left", GL_TEXTURE_CUBE_MAP_NEGATIVE_X },
+            { "_up", GL_TEXTURE_CUBE_MAP_POSITIVE_Y },
+            { "_down", GL_TEXTURE_CUBE_MAP_NEGATIVE_Y },
+            { "_forward", GL_TEXTURE_CUBE_MAP_POSITIVE_Z },
+            { "_back", GL_TEXTURE_CUBE_MAP_NEGATIVE_Z },
+        };
+
+        std::vector<std::string> paths;
+
+        for (const auto& [dir, _] : directions)
+        {
+            paths.push_back(_prefix + dir);
+        }
+
+        auto images = GlobalImageLoader().imagesFromVFS(paths);
+
+        for (std::size_t i = 0; i < images.size(); ++i)
+        {
+            bindDirection(images[i], directions[i].first, directions[i].second);
+        }
 
         rMessage() << "[shaders] bound cubemap texture " << texnum << std::endl;
 
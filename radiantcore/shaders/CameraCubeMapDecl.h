@@ -34,8 +34,8 @@ private:
         return true;
     }
 
-    // Load and bind the given image with the given cube-map direction
-    void bindDirection(const std::string& dir, GLuint glDir) const;
+    // Bind the image loaded for the given direction suffix to the given cube-map direction
+    void bindDirection(const ImagePtr& img, const std::string& dir, GLuint glDir) const;
 
 public:
 
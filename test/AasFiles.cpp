@@ -0,0 +1,140 @@
+#include "RadiantTest.h"
+
+#include "iaasfile.h"
+#include "ifilesystem.h"
+#include "os/fs.h"
+#include "string/predicate.h"
+
+namespace test
+{
+
+using AasFileTest = RadiantTest;
+
+namespace
+{
+
+map::IAasFilePtr parseAasFile(const std::string& path)
+{
+    auto file = GlobalFileSystem().openTextFileInAbsolutePath(path);
+
+    if (!file) return map::IAasFilePtr();
+
+    std::istream stream(&file->getInputStream());
+    auto loader = GlobalAasFileManager().getLoaderForStream(stream);
+
+    if (!loader) return map::IAasFilePtr();
+
+    stream.seekg(0, std::ios_base::beg);
+    return loader->loadFromStream(stream);
+}
+
+void expectEqualAasFiles(const map::IAasFile& expected, const map::IAasFile& actual)
+{
+    ASSERT_EQ(actual.getNumPlanes(), expected.getNumPlanes());
+    for (std::size_t i = 0; i < expected.getNumPlanes(); ++i)
+    {
+        EXPECT_EQ(actual.getPlane(i).normal(), expected.getPlane(i).normal());
+        EXPECT_EQ(actual.getPlane(i).dist(), expected.getPlane(i).dist());
+    }
+
+    ASSERT_EQ(actual.getNumVertices(), expected.getNumVertices());
+    for (std::size_t i = 0; i < expected.getNumVertices(); ++i)
+    {
+        EXPECT_EQ(actual.getVertex(i), expected.getVertex(i));
+    }
+
+    ASSERT_EQ(actual.getNumEdges(), expected.getNumEdges());
+    for (std::size_t i = 0; i < expected.getNumEdges(); ++i)
+    {
+        EXPECT_EQ(actual.getEdge(i).vertexNumber[0], expected.getEdge(i).vertexNumber[0]);
+        EXPECT_EQ(actual.getEdge(i).vertexNumber[1], expected.getEdge(i).vertexNumber[1]);
+    }
+
+    ASSERT_EQ(actual.getNumEdgeIndexes(), expected.getNumEdgeIndexes());
+    for (int i = 0; i < static_cast<int>(expected.getNumEdgeIndexes()); ++i)
+    {
+        EXPECT_EQ(actual.getEdgeByIndex(i), expected.getEdgeByIndex(i));
+    }
+
+    ASSERT_EQ(actual.getNumFaces(), expected.getNumFaces());
+    for (int i = 0; i < static_cast<int>(expected.getNumFaces()); ++i)
+    {
+        const auto& expectedFace = expected.getFace(i);
+        const auto& actualFace = actual.getFace(i);
+
+        EXPECT_EQ(actualFace.planeNum, expectedFace.planeNum);
+        EXPECT_EQ(actualFace.flags, expectedFace.flags);
+        EXPECT_EQ(actualFace.numEdges, expectedFace.numEdges);
+        EXPECT_EQ(actualFace.firstEdge, expectedFace.firstEdge);
+        EXPECT_EQ(actualFace.areas[0], expectedFace.areas[0]);
+        EXPECT_EQ(actualFace.areas[1], expectedFace.areas[1]);
+    }
+
+    ASSERT_EQ(actual.getNumFaceIndexes(), expected.getNumFaceIndexes());
+    for (int i = 0; i < static_cast<int>(expected.getNumFaceIndexes()); ++i)
+    {
+        EXPECT_EQ(actual.getFaceByIndex(i), expected.getFaceByIndex(i));
+    }
+
+    ASSERT_EQ(actual.getNumAreas(), expected.getNumAreas());
+    for (int i = 0; i < static_cast<int>(expected.getNumAreas()); ++i)
+    {
+        const auto& expectedArea = expected.getArea(i);
+        const auto& actualArea = actual.getArea(i);
+
+        EXPECT_EQ(actualArea.numFaces, expectedArea.numFaces);
+        EXPECT_EQ(actualArea.firstFace, expectedArea.firstFace);
+        EXPECT_EQ(actualArea.bounds.getOrigin(), expectedArea.bounds.getOrigin());
+        EXPECT_EQ(actualArea.bounds.getExtents(), expectedArea.bounds.getExtents());
+        EXPECT_EQ(actualArea.center, expectedArea.center);
+        EXPECT_EQ(actualArea.flags, expectedArea.flags);
+        EXPECT_EQ(actualArea.contents, expectedArea.contents);
+        EXPECT_EQ(actualArea.cluster, expectedArea.cluster);
+        EXPECT_EQ(actualArea.clusterAreaNum, expectedArea.clusterAreaNum);
+        EXPECT_EQ(actualArea.travelFlags, expectedArea.travelFlags);
+    }
+}
+
+}
+
+// The second load is served by the binary cache, which needs to reproduce the parsed data
+TEST_F(AasFileTest, CachedAasFileMatchesParsedFile)
+{
+    map::AasFileInfo info;
+    info.absolutePath = _context.getTestProjectPath() + "maps/aas_cache_test.aas48";
+
+    auto parsed = parseAasFile(info.absolutePath);
+    ASSERT_TRUE(parsed) << "Failed to parse " << info.absolutePath;
+
+    // The test file has an area with reachabilities and a portal area (negative cluster number)
+    ASSERT_EQ(parsed->getNumAreas(), 3);
+    EXPECT_EQ(parsed->getArea(2).cluster, -1);
+
+    auto numHits = GlobalAasFileManager().getNumCacheHits();
+
+    // First load through the manager writes the cache entry
+    auto firstLoad = GlobalAasFileManager().loadAasFile(info);
+    ASSERT_TRUE(firstLoad);
+    EXPECT_EQ(GlobalAasFileManager().getNumCacheHits(), numHits) << "There should be no cache entry yet";
+
+    auto cacheFolder = _context.getCacheDataPath() + "aas/";
+    std::size_t numCacheFiles = 0;
+
+    for (const auto& entry : fs::directory_iterator(cacheFolder))
+    {
+        if (string::starts_with(entry.path().filename().string(), "aas_cache_test.aas48."))
+        {
+            ++numCacheFiles;
+        }
+    }
+    EXPECT_EQ(numCacheFiles, 1) << "Expected exactly one cache file";
+
+    auto cached = GlobalAasFileManager().loadAasFile(info);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(GlobalAasFileManager().getNumCacheHits(), numHits + 1) << "Second load should be served by the cache";
+
+    expectEqualAasFiles(*parsed, *firstLoad);
+    expectEqualAasFiles(*parsed, *cached);
+}
+
+}
@@ -1,15 +1,21 @@
 #include "RadiantTest.h"
 
 #include "ibrush.h"
+#include "icommandsystem.h"
+#include "ieclass.h"
+#include "ientity.h"
 #include "imap.h"
+#include "iscenegraphfactory.h"
 #include "iselection.h"
 #include "itransformable.h"
+#include "iundo.h"
 #include "scenelib.h"
 #include "math/Quaternion.h"
 #include "algorithm/Scene.h"
 #include "algorithm/Primitives.h"
 #include "math/Vector3.h"
 #include "os/path.h"
+#include "scene/BasicRootNode.h"
 #include "testutil/FileSelectionHelper.h"
 
 namespace test
@@ -446,4 +452,167 @@ TEST_F(BrushTest, LoadBrushWithDuplicatePlanes)
     }
 }
 
+// Evaluating a single brush processes all other brushes with pending plane changes too
+TEST_F(BrushTest, BatchedBRepEvaluation)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    std::vector<scene::INodePtr> brushes;
+
+    // Use enough brushes to have the windings clipped in parallel
+    for (int i = 0; i < 200; ++i)
+    {
+        AABB bounds(Vector3(i * 64, 0, 0), Vector3(16, 16, 16));
+        brushes.emplace_back(algorithm::createCuboidBrush(worldspawn, bounds, "textures/numbers/1"));
+    }
+
+    // Move all brushes, leaving them with pending plane changes
+    for (const auto& node : brushes)
+    {
+        scene::node_cast<ITransformable>(node)->setTranslation(Vector3(0, 128, 0));
+        scene::node_cast<ITransformable>(node)->freezeTransform();
+    }
+
+    Node_getIBrush(brushes.front())->evaluateBRep();
+
+    for (int i = 0; i < brushes.size(); ++i)
+    {
+        const auto& brush = *Node_getIBrush(brushes[i]);
+        AABB expectedBounds(Vector3(i * 64, 128, 0), Vector3(16, 16, 16));
+
+        EXPECT_EQ(brush.getNumFaces(), 6);
+
+        for (std::size_t f = 0; f < brush.getNumFaces(); ++f)
+        {
+            const auto& winding = brush.getFace(f).getWinding();
+
+            EXPECT_EQ(winding.size(), 4) << "Brush " << i << " face " << f << " has not been evaluated";
+
+            for (const auto& vertex : winding)
+            {
+                EXPECT_NEAR((vertex.vertex - expectedBounds.getOrigin()).getLength(), 
+                    expectedBounds.getExtents().getLength(), 0.01) << "Brush " << i << " has a stale winding";
+            }
+        }
+    }
+}
+
+// Faces using the same material share a single copy of its name, comparisons are case-insensitive
+TEST_F(BrushTest, FacesShareMaterialNames)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    auto firstNode = algorithm::createCubicBrush(worldspawn, Vector3(0, 0, 0), "textures/numbers/1");
+    auto secondNode = algorithm::createCubicBrush(worldspawn, Vector3(256, 0, 0), "textures/numbers/1");
+
+    auto& first = *Node_getIBrush(firstNode);
+    auto& second = *Node_getIBrush(secondNode);
+
+    // All faces are referencing the same string
+    for (std::size_t i = 0; i < first.getNumFaces(); ++i)
+    {
+        EXPECT_EQ(&first.getFace(i).getShader(), &second.getFace(0).getShader()) << "Face " << i << " holds a copy";
+    }
+
+    EXPECT_TRUE(first.hasShader("textures/numbers/1"));
+    EXPECT_TRUE(first.hasShader("TEXTURES/numbers/1"));
+    EXPECT_FALSE(first.hasShader("textures/numbers/2"));
+    EXPECT_FALSE(first.hasShader("textures/never/used/in/any/spelling"));
+
+    // A different spelling doesn't change the material
+    {
+        UndoableCommand cmd("setShader");
+        first.getFace(0).setShader("Textures/Numbers/1");
+    }
+    EXPECT_EQ(first.getFace(0).getShader(), "textures/numbers/1");
+
+    {
+        UndoableCommand cmd("setShader");
+        second.getFace(0).setShader("textures/numbers/2");
+    }
+    EXPECT_EQ(second.getFace(0).getShader(), "textures/numbers/2");
+    EXPECT_TRUE(second.hasShader("textures/Numbers/2"));
+    EXPECT_TRUE(second.hasShader("textures/numbers/1"));
+    EXPECT_FALSE(first.hasShader("textures/numbers/2"));
+
+    // Undo restores the shared name
+    GlobalUndoSystem().undo();
+    EXPECT_EQ(&second.getFace(0).getShader(), &first.getFace(0).getShader());
+
+    EXPECT_NO_THROW(GlobalCommandSystem().executeCommand("PrintMaterialNameStats"));
+}
+
+// Transformations are kept separate from the face plane until frozen
+TEST_F(BrushTest, RevertAndFreezeFaceTransform)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brushNode = algorithm::createCubicBrush(worldspawn, Vector3(0, 0, 0), "textures/numbers/1");
+    auto& brush = *Node_getIBrush(brushNode);
+    auto transformable = scene::node_cast<ITransformable>(brushNode);
+
+    auto originalBounds = brushNode->worldAABB();
+    auto originalPlane = brush.getFace(0).getPlane3();
+
+    transformable->setTranslation(Vector3(0, 0, 128));
+
+    EXPECT_TRUE(math::isNear(brushNode->worldAABB().getOrigin(), originalBounds.getOrigin() + Vector3(0, 0, 128), 0.01));
+    EXPECT_EQ(brush.getFace(0).getPlane3(), originalPlane) << "Plane should be unchanged until frozen";
+
+    transformable->revertTransform();
+
+    EXPECT_TRUE(math::isNear(brushNode->worldAABB().getOrigin(), originalBounds.getOrigin(), 0.01));
+    EXPECT_EQ(brush.getFace(0).getPlane3(), originalPlane);
+
+    transformable->setTranslation(Vector3(0, 0, 128));
+    transformable->freezeTransform();
+
+    EXPECT_TRUE(math::isNear(brushNode->worldAABB().getOrigin(), originalBounds.getOrigin() + Vector3(0, 0, 128), 0.01));
+    EXPECT_NE(brush.getFace(0).getPlane3(), originalPlane) << "Plane should have been moved";
+
+    EXPECT_NO_THROW(GlobalCommandSystem().executeCommand("PrintMapMemoryReport"));
+}
+
+// Pending brushes are collected per scene, evaluating a map brush doesn't touch other scenes
+TEST_F(BrushTest, BatchedBRepEvaluationIsPerScene)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto mapBrush = algorithm::createCuboidBrush(worldspawn, AABB(Vector3(0, 0, 0), Vector3(16, 16, 16)));
+
+    // Set up a second scene, like the ones used by the preview widgets
+    auto sceneGraph = GlobalSceneGraphFactory().createSceneGraph();
+    auto previewRoot = std::make_shared<scene::BasicRootNode>();
+    sceneGraph->setRoot(previewRoot);
+
+    auto entity = GlobalEntityModule().createEntity(GlobalEntityClassManager().findClass("func_static"));
+    scene::addNodeToContainer(entity, previewRoot);
+
+    auto previewBrush = algorithm::createCuboidBrush(entity, AABB(Vector3(0, 0, 0), Vector3(16, 16, 16)));
+
+    // Move both brushes, leaving them with pending plane changes
+    for (const auto& node : { mapBrush, previewBrush })
+    {
+        scene::node_cast<ITransformable>(node)->setTranslation(Vector3(0, 128, 0));
+        scene::node_cast<ITransformable>(node)->freezeTransform();
+    }
+
+    auto getFirstVertex = [](const scene::INodePtr& node)
+    {
+        return Node_getIBrush(node)->getFace(0).getWinding().front().vertex;
+    };
+
+    auto previewVertex = getFirstVertex(previewBrush);
+
+    Node_getIBrush(mapBrush)->evaluateBRep();
+
+    EXPECT_NEAR(getFirstVertex(mapBrush).y(), previewVertex.y() + 128, 0.01) << "Map brush has not been evaluated";
+    EXPECT_TRUE(math::isNear(getFirstVertex(previewBrush), previewVertex, 0.01)) << "Preview brush should still be pending";
+
+    Node_getIBrush(previewBrush)->evaluateBRep();
+
+    EXPECT_NEAR(getFirstVertex(previewBrush).y(), previewVertex.y() + 128, 0.01) << "Preview brush has not been evaluated";
+
+    scene::removeNodeFromParent(previewBrush);
+    scene::removeNodeFromParent(entity);
+}
+
 }
@@ -290,4 +290,37 @@ TEST_F(GuiTokeniser, PreprocessorDirectives)
     });
 }
 
+TEST_F(GuiTokeniser, SharedIncludeCache)
+{
+    auto includeCache = std::make_shared<parser::CodeIncludeCache>();
+
+    // Parse the same file twice, the second run is served by the cache
+    for (auto i = 0; i < 2; ++i)
+    {
+        auto file = GlobalFileSystem().openTextFile("guis/parse_test2.gui");
+        parser::GuiTokeniser tokeniser(file, includeCache);
+
+        expectTokenSequence(tokeniser,
+        {
+            "windowDef", "Contents",
+            "{",
+                "forceaspectwidth", "633",
+                "forceaspectheight", "211",
+                "windowDef", "IncludedWindow",
+                "{",
+                    "rect", "0",",","0",",","640",",","480",
+                "}",
+            "}",
+            "windowDef", "ThisShouldAppear", "{", "}",
+            "windowDef", "ThisShouldAppearAsWell", "{", "}"
+        });
+    }
+
+    auto includeFile = includeCache->get("guis/parse_test_include2.guicode", "", "", {});
+
+    ASSERT_TRUE(includeFile) << "Include file should have been cached";
+    EXPECT_EQ(includeFile->name, "guis/parse_test_include2.guicode");
+    EXPECT_FALSE(includeFile->tokens->empty());
+}
+
 }
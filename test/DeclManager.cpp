@@ -1,5 +1,9 @@
 #include "RadiantTest.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "igame.h"
 #include "ideclmanager.h"
 #include "testutil/TemporaryFile.h"
@@ -443,6 +447,73 @@ TEST_F(DeclManagerTest, FindOrCreateDeclaration)
         << "We expect the created declaration to be persistent";
 }
 
+// Many threads looking up declarations while another thread keeps creating,
+// renaming and removing decls. Lookups must never see a half-updated index.
+TEST_F(DeclManagerTest, ConcurrentDeclarationLookups)
+{
+    GlobalDeclarationManager().registerDeclType("testdecl", std::make_shared<TestDeclarationCreator>());
+    GlobalDeclarationManager().registerDeclFolder(decl::Type::TestDecl, TEST_DECL_FOLDER, ".decl");
+
+    auto expectedDecl = GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/exporttest/guisurf1");
+    ASSERT_TRUE(expectedDecl);
+
+    constexpr auto NumReaders = 8;
+    constexpr auto NumWriterRounds = 200;
+
+    std::atomic<bool> stopReaders = false;
+    std::atomic<std::size_t> numLookups = 0;
+    std::atomic<std::size_t> numFailedLookups = 0;
+
+    std::vector<std::thread> readers;
+
+    for (auto i = 0; i < NumReaders; ++i)
+    {
+        readers.emplace_back([&]()
+        {
+            std::size_t lookups = 0;
+
+            while (!stopReaders)
+            {
+                if (GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "Decl/ExportTest/GuiSurf1") != expectedDecl)
+                {
+                    ++numFailedLookups;
+                }
+
+                if (GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/nonexistent"))
+                {
+                    ++numFailedLookups;
+                }
+
+                lookups += 2;
+            }
+
+            numLookups += lookups;
+        });
+    }
+
+    for (auto round = 0; round < NumWriterRounds; ++round)
+    {
+        auto name = "decl/concurrent/" + std::to_string(round);
+        auto created = GlobalDeclarationManager().findOrCreateDeclaration(decl::Type::TestDecl, name);
+
+        EXPECT_TRUE(GlobalDeclarationManager().renameDeclaration(decl::Type::TestDecl, name, name + "_renamed"));
+        EXPECT_EQ(GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, name + "_renamed"), created);
+
+        GlobalDeclarationManager().removeDeclaration(decl::Type::TestDecl, name + "_renamed");
+        EXPECT_FALSE(GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, name + "_renamed"));
+    }
+
+    stopReaders = true;
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(numFailedLookups, 0) << "Concurrent lookups should always find the existing declaration, and only that";
+    EXPECT_GT(numLookups, 0) << "Readers didn't perform any lookups";
+}
+
 TEST_F(DeclManagerTest, FindOrCreateUnknownDeclarationType)
 {
     // Unknown types should yield an exception
@@ -463,6 +534,40 @@ TEST_F(DeclManagerTest, DeclarationMetadata)
     EXPECT_EQ(decl->getModName(), RadiantTest::DEFAULT_GAME_TYPE);
 }
 
+TEST_F(DeclManagerTest, ParseResultsAreCached)
+{
+    GlobalDeclarationManager().registerDeclType("testdecl", std::make_shared<TestDeclarationCreator>());
+    GlobalDeclarationManager().registerDeclFolder(decl::Type::TestDecl, TEST_DECL_FOLDER, ".decl");
+
+    auto decl = GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/exporttest/guisurf1");
+    ASSERT_TRUE(decl);
+
+    auto originalSyntax = decl->getBlockSyntax();
+
+    // The initial parse run should have written a cache file
+    auto cacheFolder = _context.getCacheDataPath() + "decls/";
+    ASSERT_TRUE(fs::is_directory(cacheFolder)) << "Cache folder has not been created";
+
+    auto numCacheFiles = std::distance(fs::directory_iterator(cacheFolder), fs::directory_iterator());
+    EXPECT_GT(numCacheFiles, 0) << "No cache file has been written";
+
+    auto numHits = GlobalDeclarationManager().getNumCacheHits();
+    auto numMisses = GlobalDeclarationManager().getNumCacheMisses();
+
+    // Reloading the unchanged files needs to produce the same blocks
+    GlobalDeclarationManager().reloadDeclarations();
+
+    EXPECT_GT(GlobalDeclarationManager().getNumCacheHits(), numHits) << "Nothing has been loaded from the cache";
+    EXPECT_EQ(GlobalDeclarationManager().getNumCacheMisses(), numMisses) << "Unchanged files have been parsed again";
+
+    const auto& reloadedSyntax = decl->getBlockSyntax();
+    EXPECT_EQ(reloadedSyntax.name, originalSyntax.name);
+    EXPECT_EQ(reloadedSyntax.typeName, originalSyntax.typeName);
+    EXPECT_EQ(reloadedSyntax.contents, originalSyntax.contents);
+    EXPECT_EQ(reloadedSyntax.modName, originalSyntax.modName);
+    EXPECT_EQ(reloadedSyntax.fileInfo.fullPath(), originalSyntax.fileInfo.fullPath());
+}
+
 inline void expectDeclIsPresent(decl::Type type, const std::string& declName)
 {
     EXPECT_TRUE(GlobalDeclarationManager().findDeclaration(type, declName))
@@ -549,6 +654,38 @@ testdecl decl/temporary/13
     expectDeclDoesNotContain(decl::Type::TestDecl, "decl/temporary/11", "diffusemap textures/temporary/11");
 }
 
+TEST_F(DeclManagerTest, CachedParseResultsAreInvalidated)
+{
+    TemporaryFile tempFile(_context.getTestProjectPath() + "testdecls/temp_file.decl");
+    tempFile.setContents("decl/temporary/11 { diffusemap textures/temporary/11 }");
+
+    GlobalDeclarationManager().registerDeclType("testdecl", std::make_shared<TestDeclarationCreator>());
+    GlobalDeclarationManager().registerDeclFolder(decl::Type::TestDecl, TEST_DECL_FOLDER, ".decl");
+
+    expectDeclContains(decl::Type::TestDecl, "decl/temporary/11", "diffusemap textures/temporary/11");
+
+    // The initial parse run has cached the current file state
+    auto numMisses = GlobalDeclarationManager().getNumCacheMisses();
+
+    // A newer timestamp alone is not invalidating the cached blocks, the contents are compared
+    auto tempFilePath = _context.getTestProjectPath() + "testdecls/temp_file.decl";
+    fs::last_write_time(tempFilePath, fs::last_write_time(tempFilePath) + std::chrono::seconds(2));
+
+    GlobalDeclarationManager().reloadDeclarations();
+
+    EXPECT_EQ(GlobalDeclarationManager().getNumCacheMisses(), numMisses) << "Touched file should be served from the cache";
+
+    // Same file size, only the contents are different. Move the timestamp further
+    // ahead, in case the file system is not resolving the time of the write
+    tempFile.setContents("decl/temporary/11 { diffusemap textures/temporary/12 }");
+    fs::last_write_time(tempFilePath, fs::last_write_time(tempFilePath) + std::chrono::seconds(4));
+
+    GlobalDeclarationManager().reloadDeclarations();
+
+    EXPECT_EQ(GlobalDeclarationManager().getNumCacheMisses(), numMisses + 1) << "The changed file should have been parsed again";
+    expectDeclContains(decl::Type::TestDecl, "decl/temporary/11", "diffusemap textures/temporary/12");
+}
+
 TEST_F(DeclManagerTest, ReloadDeclarationDetectsNewFile)
 {
     TemporaryFile tempFile(_context.getTestProjectPath() + "testdecls/temp_file.decl");
@@ -0,0 +1,61 @@
+#include "RadiantTest.h"
+
+#include "imap.h"
+#include "scenelib.h"
+#include "algorithm/Scene.h"
+
+#include "GraphTreeModel.h"
+
+namespace test
+{
+
+using EntityListTest = RadiantTest;
+
+namespace
+{
+
+scene::INode* getNodeOfRow(ui::GraphTreeModel& model, const scene::INodePtr& node)
+{
+    const auto& gtNode = model.find(node);
+
+    if (!gtNode || !gtNode->getIter().IsOk()) return nullptr;
+
+    wxutil::TreeModel::Row row(gtNode->getIter(), *model.getModel());
+    return static_cast<scene::INode*>(row[model.getColumns().node].getPointer());
+}
+
+}
+
+TEST_F(EntityListTest, EntityErasedAndInsertedBeforeFlushKeepsItsRow)
+{
+    loadMap("entityinspector.map");
+
+    ui::GraphTreeModel model;
+    model.connectToSceneGraph();
+    model.refresh();
+    model.setEntityBranchExpanded(true);
+
+    auto entity = algorithm::getEntityByName(GlobalMapModule().getRoot(), "speaker_1");
+    ASSERT_TRUE(entity);
+    EXPECT_EQ(getNodeOfRow(model, entity), entity.get());
+
+    // Take the entity out of the scene and put it back, without flushing in between
+    auto parent = entity->getParent();
+    scene::removeNodeFromParent(entity);
+
+    EXPECT_EQ(getNodeOfRow(model, entity), nullptr) << "Erased rows must not point to the node";
+
+    scene::addNodeToContainer(entity, parent);
+
+    EXPECT_TRUE(model.flushPendingChanges());
+
+    ASSERT_TRUE(model.find(entity)) << "Re-inserted entity should still be in the model";
+    EXPECT_EQ(getNodeOfRow(model, entity), entity.get()) << "Row should point to the re-inserted node";
+
+    wxutil::TreeModel::Row row(model.find(entity)->getIter(), *model.getModel());
+    EXPECT_EQ(row[model.getColumns().name].getString().ToStdString(), entity->name());
+
+    model.disconnectFromSceneGraph();
+}
+
+}
@@ -0,0 +1,232 @@
+#include "RadiantTest.h"
+
+#include <chrono>
+#include <thread>
+#include <fmt/format.h>
+#include "imap.h"
+#include "ientity.h"
+#include "algorithm/Scene.h"
+
+#include "AutomationEngine.h"
+#include "MessageTcp.h"
+#include "MapObserver.h"
+#include "MapUpdater.h"
+#include "clsocket/PassiveSocket.h"
+
+namespace test
+{
+
+using GameConnectionTest = RadiantTest;
+
+namespace
+{
+
+// Same tag GameConnection is using for map updates
+constexpr int TAG_UPDATEMAP = 8;
+
+// Stands in for the game: accepts a single automation connection on a local port
+// and lets the test answer the received requests
+class LoopbackGame
+{
+private:
+    CPassiveSocket _listener;
+    gameconn::MessageTcp _connection;
+
+public:
+    LoopbackGame()
+    {
+        _listener.Initialize();
+
+        // Let the system pick a free port, a game might be running on the default one
+        _listener.Listen("127.0.0.1", 0);
+    }
+
+    // The port assigned to the listening socket, 0 if listening failed
+    int getPort()
+    {
+        sockaddr_in address;
+        socklen_t length = sizeof(address);
+
+        if (getsockname(_listener.GetSocketDescriptor(), reinterpret_cast<sockaddr*>(&address), &length) != 0)
+        {
+            return 0;
+        }
+
+        return ntohs(address.sin_port);
+    }
+
+    bool accept()
+    {
+        std::unique_ptr<CActiveSocket> socket(_listener.Accept());
+
+        if (!socket || !socket->SetNonblocking()) return false;
+
+        _connection.init(std::move(socket));
+        return _connection.isAlive();
+    }
+
+    // Waits for the next request, returns false on timeout
+    bool receiveRequest(int& seqno, std::string& content)
+    {
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        std::vector<char> message;
+
+        while (!_connection.readMessage(message))
+        {
+            if (std::chrono::steady_clock::now() > timeout) return false;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        int lineLength = 0;
+        if (sscanf(message.data(), "seqno %d\n%n", &seqno, &lineLength) != 1) return false;
+
+        content.assign(message.begin() + lineLength, message.end());
+        return true;
+    }
+
+    void respond(int seqno, const std::string& content)
+    {
+        auto message = fmt::format("response {0}\n", seqno) + content;
+        _connection.writeMessage(message.data(), static_cast<int>(message.size()));
+    }
+
+    // Returns true if a request arrived within a short time
+    bool hasRequest()
+    {
+        _connection.think();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        std::vector<char> message;
+        return _connection.readMessage(message);
+    }
+};
+
+// Lets the engine process the responses until no map update is in flight anymore
+bool waitForUpdate(gameconn::AutomationEngine& engine)
+{
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (engine.areTagsInProgress(1 << TAG_UPDATEMAP))
+    {
+        if (std::chrono::steady_clock::now() > timeout) return false;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        engine.think();
+    }
+
+    return true;
+}
+
+// Writes one line per changed entity instead of the actual map diff
+std::string writeEntityList(const gameconn::DiffEntityStatuses& changes)
+{
+    std::string request;
+
+    for (const auto& pair : changes)
+    {
+        request += pair.first + "\n";
+    }
+
+    return request;
+}
+
+std::size_t countOccurrences(const std::string& text, const std::string& substring)
+{
+    std::size_t count = 0;
+
+    for (auto pos = text.find(substring); pos != std::string::npos; pos = text.find(substring, pos + 1))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+void setKeyValue(const std::string& entityName, const std::string& key, const std::string& value)
+{
+    auto node = algorithm::getEntityByName(GlobalMapModule().getRoot(), entityName);
+    ASSERT_TRUE(node);
+
+    Node_getEntity(node)->setKeyValue(key, value);
+}
+
+}
+
+TEST_F(GameConnectionTest, MapUpdatesAreBatchedAndRetried)
+{
+    loadMap("entityinspector.map");
+
+    LoopbackGame game;
+    ASSERT_NE(game.getPort(), 0) << "Failed to set up the loopback server";
+
+    gameconn::AutomationEngine engine;
+    ASSERT_TRUE(engine.connect(game.getPort())) << "Failed to connect to the loopback server";
+    ASSERT_TRUE(game.accept());
+
+    gameconn::MapObserver observer;
+    observer.setEnabled(true);
+
+    gameconn::MapUpdater updater(engine, observer, TAG_UPDATEMAP, writeEntityList);
+
+    // Repeated edits of the same entity are coalesced into one entry
+    setKeyValue("speaker_1", "s_volume", "1");
+    setKeyValue("speaker_1", "s_volume", "2");
+    setKeyValue("speaker_1", "s_shader", "test/jorge");
+
+    EXPECT_TRUE(updater.sendPendingAsync());
+    EXPECT_TRUE(observer.isUpdateInProgress());
+    EXPECT_FALSE(observer.hasPendingChanges());
+
+    int seqno = 0;
+    std::string request;
+    ASSERT_TRUE(game.receiveRequest(seqno, request));
+    EXPECT_EQ(request, "speaker_1\n") << "Edits of the same entity should be sent once";
+
+    // No second update is sent while the first one is in flight
+    setKeyValue("speaker_2", "s_volume", "3");
+
+    EXPECT_TRUE(observer.hasPendingChanges());
+    EXPECT_FALSE(updater.sendPendingAsync());
+    EXPECT_FALSE(game.hasRequest()) << "Only one update should be in flight";
+
+    // The game fails to apply the diff
+    game.respond(seqno, "HotReload: FAILED\n");
+    ASSERT_TRUE(waitForUpdate(engine));
+
+    EXPECT_FALSE(observer.isUpdateInProgress());
+    EXPECT_EQ(observer.getChanges().count("speaker_1"), 1) << "Failed changes should be merged back";
+    EXPECT_EQ(observer.getChanges().count("speaker_2"), 1);
+
+    const auto& stats = updater.getStatistics();
+    EXPECT_EQ(stats.numUpdates, 1);
+    EXPECT_EQ(stats.numFailedUpdates, 1);
+    EXPECT_EQ(stats.lastNumEntities, 1);
+    EXPECT_EQ(stats.lastBytes, std::string("speaker_1\n").size());
+    EXPECT_EQ(stats.totalBytes, stats.lastBytes);
+
+    // The next update retries the failed changes along with the new ones
+    EXPECT_TRUE(updater.sendPendingAsync());
+    ASSERT_TRUE(game.receiveRequest(seqno, request));
+    EXPECT_EQ(countOccurrences(request, "speaker_1\n"), 1);
+    EXPECT_EQ(countOccurrences(request, "speaker_2\n"), 1);
+
+    game.respond(seqno, "HotReload: SUCCESS\n");
+    ASSERT_TRUE(waitForUpdate(engine));
+
+    EXPECT_FALSE(observer.isUpdateInProgress());
+    EXPECT_FALSE(observer.hasPendingChanges()) << "Applied changes should not be sent again";
+    EXPECT_FALSE(updater.sendPendingAsync());
+
+    EXPECT_EQ(stats.numUpdates, 2);
+    EXPECT_EQ(stats.numFailedUpdates, 1);
+    EXPECT_EQ(stats.lastNumEntities, 2);
+    EXPECT_EQ(stats.lastBytes, request.size());
+    EXPECT_EQ(stats.totalBytes, std::string("speaker_1\n").size() + request.size());
+    EXPECT_GE(stats.totalRoundTripMs, stats.lastRoundTripMs);
+
+    observer.setEnabled(false);
+    engine.disconnect(true);
+}
+
+}
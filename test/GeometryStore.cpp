@@ -3,6 +3,7 @@
 #include <limits>
 #include <numeric>
 #include <random>
+#include <set>
 #include "render/GeometryStore.h"
 #include "testutil/TestBufferObjectProvider.h"
 #include "testutil/TestSyncObjectProvider.h"
@@ -414,6 +415,145 @@ TEST(GeometryStore, SyncObjectAcquisition)
         "GeometryStore should have performed 5 frame buffer switches";
 }
 
+// Every frame buffer needs to receive the data uploaded in the previous frames
+TEST(GeometryStore, FrameBufferObjectsReceiveReplayedData)
+{
+    render::GeometryStore store(TestSyncObjectProvider::Instance(), _testBufferObjectProvider);
+
+    store.onFrameStart();
+
+    auto vertices = generateVertices(3, 80);
+    auto indices = generateIndices(vertices);
+
+    auto slot = store.allocateSlot(vertices.size(), indices.size());
+    store.updateData(slot, vertices, indices);
+    store.syncToBufferObjects();
+
+    store.onFrameFinished();
+
+    std::set<render::IBufferObject::Ptr> usedVertexBuffers;
+
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        store.onFrameStart();
+        store.syncToBufferObjects();
+
+        auto vertexBuffer = std::static_pointer_cast<TestBufferObject>(store.getBufferObjects().first);
+        usedVertexBuffers.insert(vertexBuffer);
+
+        // Compare the uploaded bytes against the vertices
+        auto renderParms = store.getBufferAddresses(slot);
+        auto firstVertex = reinterpret_cast<const unsigned char*>(renderParms.clientBufferStart + renderParms.firstVertex);
+        auto byteOffset = renderParms.firstVertex * sizeof(render::RenderVertex);
+        auto numBytes = vertices.size() * sizeof(render::RenderVertex);
+
+        ASSERT_GE(vertexBuffer->buffer.size(), byteOffset + numBytes) << "Buffer object has not been resized";
+        EXPECT_EQ(memcmp(vertexBuffer->buffer.data() + byteOffset, firstVertex, numBytes), 0) << "Buffer object data mismatch";
+
+        verifyAllocation(store, slot, vertices, indices);
+
+        store.onFrameFinished();
+    }
+
+    EXPECT_GT(usedVertexBuffers.size(), 1) << "Store should rotate through multiple buffer objects";
+}
+
+TEST(GeometryStore, FrameStatistics)
+{
+    render::GeometryStore store(TestSyncObjectProvider::Instance(), _testBufferObjectProvider);
+
+    store.onFrameStart();
+
+    auto vertices = generateVertices(5, 100);
+    auto indices = generateIndices(vertices);
+
+    auto slot = store.allocateSlot(vertices.size(), indices.size());
+    store.updateData(slot, vertices, indices);
+    store.syncToBufferObjects();
+
+    store.onFrameFinished();
+
+    EXPECT_GE(store.getLastFrameStatistics().uploadedBytes,
+        vertices.size() * sizeof(render::RenderVertex) + indices.size() * sizeof(unsigned int)) << "Upload not counted";
+
+    // Run a few idle frames, once all buffers have caught up there's nothing left to upload
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        store.onFrameStart();
+        store.syncToBufferObjects();
+        store.onFrameFinished();
+    }
+
+    EXPECT_EQ(store.getLastFrameStatistics().uploadedBytes, 0) << "Idle frame should not upload anything";
+    EXPECT_EQ(store.getLastFrameStatistics().numSyncWaits, 0) << "Test sync provider hands out no sync objects to wait on";
+}
+
+namespace
+{
+
+class CountingSyncObjectProvider final :
+    public render::ISyncObjectProvider
+{
+private:
+    class SyncObject final :
+        public render::ISyncObject
+    {
+    private:
+        std::size_t& _numWaits;
+
+    public:
+        SyncObject(std::size_t& numWaits) :
+            _numWaits(numWaits)
+        {}
+
+        void wait() override
+        {
+            ++_numWaits;
+        }
+    };
+
+public:
+    std::size_t numWaits = 0;
+
+    render::ISyncObject::Ptr createSyncObject() override
+    {
+        return std::make_shared<SyncObject>(numWaits);
+    }
+};
+
+}
+
+TEST(GeometryStore, FrameWaitsForItsBufferToBeReleased)
+{
+    CountingSyncObjectProvider syncObjectProvider;
+    render::GeometryStore store(syncObjectProvider, _testBufferObjectProvider);
+
+    // The store cycles through three frame buffers
+    constexpr std::size_t NumFrameBuffers = 3;
+
+    // The first round through the frame buffers finds none of them in use
+    for (std::size_t frame = 0; frame < NumFrameBuffers; ++frame)
+    {
+        store.onFrameStart();
+        store.onFrameFinished();
+
+        EXPECT_EQ(store.getLastFrameStatistics().numSyncWaits, 0) << "Frame " << frame << " should not wait";
+    }
+
+    EXPECT_EQ(syncObjectProvider.numWaits, 0);
+
+    // From then on every frame needs to wait for the buffer it is going to write to
+    for (std::size_t frame = 0; frame < NumFrameBuffers; ++frame)
+    {
+        store.onFrameStart();
+        store.onFrameFinished();
+
+        EXPECT_EQ(store.getLastFrameStatistics().numSyncWaits, 1) << "Frame should wait for its buffer";
+    }
+
+    EXPECT_EQ(syncObjectProvider.numWaits, NumFrameBuffers);
+}
+
 TEST(GeometryStore, AllocateIndexRemap)
 {
     render::GeometryStore store(TestSyncObjectProvider::Instance(), _testBufferObjectProvider);
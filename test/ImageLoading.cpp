@@ -1,5 +1,8 @@
 #include "RadiantTest.h"
 
+#include <cstring>
+#include <map>
+
 #include "iimage.h"
 #include "RGBAImage.h"
 
@@ -49,6 +52,12 @@ protected:
         auto filePath = _context.getTestProjectPath() + path;
         return GlobalImageLoader().imageFromFile(filePath);
     }
+
+    ImageThumbnail loadThumbnail(const std::string& path, std::size_t minSize)
+    {
+        auto filePath = _context.getTestProjectPath() + path;
+        return GlobalImageLoader().thumbnailFromFile(filePath, minSize);
+    }
 };
 
 TEST_F(ImageLoadingTest, LoadPng8Bit)
@@ -239,4 +248,201 @@ TEST_F(ImageLoadingTest, LoadDDSCompressedBC5MipMaps)
     EXPECT_EQ(img->getGLFormat(), GL_COMPRESSED_RG_RGTC2);
 }
 
-}
\ No newline at end of file
+TEST_F(ImageLoadingTest, ThumbnailFromVFS)
+{
+    auto thumbnail = GlobalImageLoader().thumbnailFromVFS("textures/a_1024x512", 128);
+    ASSERT_TRUE(thumbnail.image);
+
+    // Reduced by a power of two, the larger side not dropping below the requested size
+    EXPECT_EQ(thumbnail.image->getWidth(), 128);
+    EXPECT_EQ(thumbnail.image->getHeight(), 64);
+    EXPECT_EQ(thumbnail.image->getGLFormat(), GL_RGBA);
+    EXPECT_EQ(thumbnail.sourceWidth, 1024);
+    EXPECT_EQ(thumbnail.sourceHeight, 512);
+    EXPECT_EQ(thumbnail.sourceFile, "textures/a_1024x512.tga");
+}
+
+TEST_F(ImageLoadingTest, ThumbnailOfSmallImage)
+{
+    auto thumbnail = loadThumbnail("textures/pngs/twentyone_8bit.png", 128);
+    ASSERT_TRUE(thumbnail.image);
+
+    // Images below the requested size are not enlarged
+    EXPECT_EQ(thumbnail.image->getWidth(), 32);
+    EXPECT_EQ(thumbnail.image->getHeight(), 32);
+}
+
+TEST_F(ImageLoadingTest, ThumbnailFromDDSMipMap)
+{
+    auto thumbnail = loadThumbnail("textures/dds/test_16x16_uncomp_mips.dds", 8);
+    ASSERT_TRUE(thumbnail.image);
+
+    // The 8x8 mipmap is used as it is
+    EXPECT_EQ(thumbnail.image->getWidth(), 8);
+    EXPECT_EQ(thumbnail.image->getHeight(), 8);
+    EXPECT_FALSE(thumbnail.image->isPrecompressed());
+    EXPECT_EQ(thumbnail.sourceWidth, 16);
+    EXPECT_EQ(thumbnail.sourceHeight, 16);
+}
+
+TEST_F(ImageLoadingTest, ThumbnailFromDDSUncompressed)
+{
+    auto thumbnail = loadThumbnail("textures/dds/test_16x16_uncomp.dds", 16);
+    ASSERT_TRUE(thumbnail.image);
+
+    // The BGR source pixels end up in RGBA order
+    Pixelator<image::RGBAPixel> pixels(*thumbnail.image);
+    EXPECT_EQ(pixels(8, 8).red, 255);   // red centre
+    EXPECT_EQ(pixels(8, 8).green, 0);
+    EXPECT_EQ(pixels(8, 8).blue, 0);
+    EXPECT_EQ(pixels(8, 8).alpha, 255);
+    EXPECT_EQ(pixels(6, 7).green, 255); // green band
+    EXPECT_EQ(pixels(6, 7).red, 0);
+}
+
+TEST_F(ImageLoadingTest, ThumbnailFromDDSCompressed)
+{
+    auto thumbnail = loadThumbnail("textures/dds/test_128x128_dxt1.dds", 32);
+    ASSERT_TRUE(thumbnail.image);
+
+    EXPECT_EQ(thumbnail.image->getWidth(), 32);
+    EXPECT_EQ(thumbnail.image->getHeight(), 32);
+    EXPECT_EQ(thumbnail.image->getGLFormat(), GL_RGBA);
+    EXPECT_EQ(thumbnail.sourceWidth, 128);
+
+    // The mipmaps of odd sizes cannot be decoded, the top level is reduced instead
+    thumbnail = loadThumbnail("textures/dds/test_60x128_dxt5_mips.dds", 32);
+    ASSERT_TRUE(thumbnail.image);
+
+    EXPECT_EQ(thumbnail.image->getWidth(), 15);
+    EXPECT_EQ(thumbnail.image->getHeight(), 32);
+    EXPECT_EQ(thumbnail.sourceWidth, 60);
+    EXPECT_EQ(thumbnail.sourceHeight, 128);
+}
+
+TEST_F(ImageLoadingTest, DecompressDXTBlocks)
+{
+    // Requesting the full size decodes the top level as it is
+    auto thumbnail = loadThumbnail("textures/dds/test_128x128_dxt1.dds", 128);
+    ASSERT_TRUE(thumbnail.image);
+    ASSERT_EQ(thumbnail.image->getWidth(), 128);
+
+    Pixelator<image::RGBAPixel> pixels(*thumbnail.image);
+    EXPECT_EQ(pixels(0, 0).red, 0);
+    EXPECT_EQ(pixels(0, 0).alpha, 255);
+    EXPECT_EQ(pixels(8, 8).red, 255);   // red
+    EXPECT_EQ(pixels(8, 8).green, 0);
+    EXPECT_EQ(pixels(8, 56).green, 255); // green
+    EXPECT_EQ(pixels(8, 56).red, 0);
+    EXPECT_EQ(pixels(72, 56).blue, 255); // blue
+    EXPECT_EQ(pixels(72, 56).green, 0);
+    EXPECT_EQ(pixels(16, 8).red, 255);  // white
+    EXPECT_EQ(pixels(16, 8).green, 255);
+    EXPECT_EQ(pixels(16, 8).blue, 255);
+
+    thumbnail = loadThumbnail("textures/dds/test_60x128_dxt5.dds", 128);
+    ASSERT_TRUE(thumbnail.image);
+    ASSERT_EQ(thumbnail.image->getWidth(), 60);
+
+    Pixelator<image::RGBAPixel> dxt5(*thumbnail.image);
+    EXPECT_EQ(dxt5(56, 8).red, 255);    // magenta
+    EXPECT_EQ(dxt5(56, 8).green, 0);
+    EXPECT_EQ(dxt5(56, 8).blue, 255);
+    EXPECT_EQ(dxt5(56, 72).red, 0);     // cyan
+    EXPECT_EQ(dxt5(56, 72).green, 255);
+    EXPECT_EQ(dxt5(56, 72).blue, 255);
+    EXPECT_EQ(dxt5(56, 72).alpha, 255);
+}
+
+TEST_F(ImageLoadingTest, ImagesFromVFSInBatch)
+{
+    std::vector<std::string> paths = { "textures/a_1024x512", "textures/numbers/1", "textures/nonexistent", "textures/numbers/2" };
+
+    auto images = GlobalImageLoader().imagesFromVFS(paths);
+    ASSERT_EQ(images.size(), paths.size());
+
+    // Same order, and the same results as loading one by one
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        auto single = GlobalImageLoader().imageFromVFS(paths[i]);
+
+        ASSERT_EQ(static_cast<bool>(images[i]), static_cast<bool>(single)) << paths[i];
+        if (!single) continue;
+
+        ASSERT_EQ(images[i]->getWidth(), single->getWidth()) << paths[i];
+        ASSERT_EQ(images[i]->getHeight(), single->getHeight()) << paths[i];
+        EXPECT_EQ(std::memcmp(images[i]->getPixels(), single->getPixels(),
+            single->getWidth() * single->getHeight() * 4), 0) << paths[i];
+    }
+
+    EXPECT_FALSE(images[2]) << "Missing image should yield an empty entry";
+    EXPECT_TRUE(GlobalImageLoader().imagesFromVFS({}).empty());
+}
+
+TEST_F(ImageLoadingTest, ThumbnailsFromVFSInBatch)
+{
+    std::vector<std::string> paths = { "textures/nonexistent", "textures/a_1024x512", "textures/numbers/3" };
+
+    auto thumbnails = GlobalImageLoader().thumbnailsFromVFS(paths, 128);
+    ASSERT_EQ(thumbnails.size(), paths.size());
+
+    EXPECT_FALSE(thumbnails[0].image);
+
+    ASSERT_TRUE(thumbnails[1].image);
+    EXPECT_EQ(thumbnails[1].image->getWidth(), 128);
+    EXPECT_EQ(thumbnails[1].sourceWidth, 1024);
+    EXPECT_EQ(thumbnails[1].sourceFile, "textures/a_1024x512.tga");
+
+    ASSERT_TRUE(thumbnails[2].image);
+    EXPECT_EQ(thumbnails[2].sourceFile, "textures/numbers/3.tga");
+}
+
+TEST_F(ImageLoadingTest, BatchDecodingWithRepeatedPaths)
+{
+    // A batch large enough to keep all workers busy, each image is requested several times
+    std::vector<std::string> paths;
+
+    for (int round = 0; round < 8; ++round)
+    {
+        paths.push_back("textures/a_1024x512");
+
+        for (int number = 0; number < 8; ++number)
+        {
+            paths.push_back("textures/numbers/" + std::to_string(number));
+        }
+    }
+
+    auto images = GlobalImageLoader().imagesFromVFS(paths);
+    ASSERT_EQ(images.size(), paths.size());
+
+    std::map<std::string, ImagePtr> singles;
+
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        auto& single = singles[paths[i]];
+
+        if (!single)
+        {
+            single = GlobalImageLoader().imageFromVFS(paths[i]);
+            ASSERT_TRUE(single) << paths[i];
+        }
+
+        ASSERT_TRUE(images[i]) << paths[i];
+        ASSERT_EQ(images[i]->getWidth(), single->getWidth()) << paths[i];
+        ASSERT_EQ(images[i]->getHeight(), single->getHeight()) << paths[i];
+        EXPECT_EQ(std::memcmp(images[i]->getPixels(), single->getPixels(),
+            single->getWidth() * single->getHeight() * 4), 0) << paths[i];
+    }
+}
+
+TEST_F(ImageLoadingTest, ThumbnailFromDDSNotDecodable)
+{
+    // BC5 is a two-channel normal map format, not decoded on the CPU
+    auto thumbnail = loadThumbnail("textures/dds/test_16x16_bc5.dds", 8);
+    EXPECT_FALSE(thumbnail.image);
+
+    thumbnail = loadThumbnail("textures/dds/not_a_dds.dds", 8);
+    EXPECT_FALSE(thumbnail.image);
+}
+
+}
@@ -469,6 +469,70 @@ TEST_F(LayerTest, SetLayerVisibilityWorksRecursively)
         "The parent layer visibility should have propagated down to the boards layer";
 }
 
+TEST_F(LayerTest, ForeachLayerMember)
+{
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto layerId = layerManager.createLayer("TestLayer");
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn);
+
+    auto layerContains = [&](int id, const scene::INodePtr& node)
+    {
+        bool found = false;
+        layerManager.foreachLayerMember(id, [&](scene::INode& member) { found |= &member == node.get(); });
+        return found;
+    };
+
+    EXPECT_TRUE(layerContains(0, brush)) << "New brush should be indexed in the default layer";
+    EXPECT_FALSE(layerContains(layerId, brush));
+
+    brush->addToLayer(layerId);
+    EXPECT_TRUE(layerContains(0, brush));
+    EXPECT_TRUE(layerContains(layerId, brush)) << "Index should have picked up the new membership";
+
+    brush->moveToLayer(layerId);
+    EXPECT_FALSE(layerContains(0, brush)) << "Index should have dropped the previous membership";
+    EXPECT_TRUE(layerContains(layerId, brush));
+
+    scene::removeNodeFromParent(brush);
+    EXPECT_FALSE(layerContains(layerId, brush)) << "Removed nodes should not be indexed anymore";
+}
+
+TEST_F(LayerTest, SetLayerVisibilityAffectsParentEntity)
+{
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto layerId = layerManager.createLayer("TestLayer");
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush1 = algorithm::createCubicBrush(worldspawn);
+    auto brush2 = algorithm::createCubicBrush(worldspawn);
+
+    // Move the worldspawn and one brush to the test layer
+    worldspawn->moveToLayer(layerId);
+    brush1->moveToLayer(layerId);
+
+    layerManager.setLayerVisibility(layerId, false);
+
+    EXPECT_FALSE(brush1->visible()) << "Brush 1 should be hidden";
+    EXPECT_TRUE(brush2->visible()) << "Brush 2 is in the default layer";
+    EXPECT_TRUE(worldspawn->visible()) << "Worldspawn has a visible child, it should not be hidden";
+
+    // Moving the last visible brush to the hidden layer should hide the worldspawn
+    Node_setSelected(brush2, true);
+    layerManager.moveSelectionToLayer(layerId);
+
+    EXPECT_FALSE(brush2->visible()) << "Brush 2 should be hidden now";
+    EXPECT_FALSE(Node_isSelected(brush2)) << "Hidden brush should have been de-selected";
+    EXPECT_FALSE(worldspawn->visible()) << "Worldspawn has no visible children left";
+
+    layerManager.setLayerVisibility(layerId, true);
+
+    EXPECT_TRUE(brush1->visible());
+    EXPECT_TRUE(brush2->visible());
+    EXPECT_TRUE(worldspawn->visible());
+}
+
 TEST_F(LayerTest, GetParentLayer)
 {
     auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
@@ -10,6 +10,7 @@
 #include "registry/registry.h"
 #include "scenelib.h"
 #include "scene/merge/GraphComparer.h"
+#include "scene/merge/MapTextComparer.h"
 #include "scene/merge/MergeOperation.h"
 #include "scene/merge/ThreeWayMergeOperation.h"
 #include "scene/merge/SelectionGroupMerger.h"
@@ -421,6 +422,117 @@ std::size_t countActions(const IMergeOperation::Ptr& operation, const std::funct
     return count;
 }
 
+TEST_F(MapMergeTest, TextComparerDetectsEntityChanges)
+{
+    std::istringstream base(R"(Version 2
+// entity 0
+{
+"classname" "worldspawn"
+// primitive 0
+{
+brushDef3
+{
+( 0 0 -1 -8 ) ( ( 0.0078125 0 0 ) ( 0 0.0078125 0 ) ) "textures/numbers/1" 0 0 0
+}
+}
+// primitive 1
+{
+brushDef3
+{
+( 0 0 1 -8 ) ( ( 0.0078125 0 0 ) ( 0 0.0078125 0 ) ) "textures/numbers/2" 0 0 0
+}
+}
+}
+// entity 1
+{
+"classname" "light"
+"name" "light_1"
+"origin" "0 0 0"
+}
+// entity 2
+{
+"classname" "info_player_start"
+"name" "info_player_start_1"
+}
+// entity 3
+{
+"classname" "func_static"
+"name" "func_static_1"
+"model" "func_static_1"
+}
+)");
+
+    // Primitives swapped and re-formatted, one brush changed, light moved,
+    // player start removed, func_static reordered and a new light added
+    std::istringstream source(R"(Version 2
+{
+"classname" "worldspawn"
+{
+brushDef3
+{
+( 0 0 1 -8 ) ( ( 0.0078125 0 0 ) ( 0 0.0078125 0 ) ) "textures/numbers/2" 0 0 0
+}
+}
+{ brushDef3 { ( 0 0 -1 -16 ) ( ( 0.0078125 0 0 ) ( 0 0.0078125 0 ) ) "textures/numbers/1" 0 0 0 } }
+}
+{
+"classname" "light"
+"name" "light_1"
+"origin" "0 0 64"
+}
+{
+"model" "func_static_1"
+"name" "func_static_1"
+"classname" "func_static"
+}
+{
+"classname" "light"
+"name" "light_2"
+}
+)");
+
+    auto result = MapTextComparer::Compare(source, base);
+
+    EXPECT_EQ(result.numBaseEntities, 4);
+    EXPECT_EQ(result.numSourceEntities, 4);
+
+    using Type = MapTextComparer::EntityDifference::Type;
+    EXPECT_EQ(result.countDifferences(Type::EntityAdded), 1);
+    EXPECT_EQ(result.countDifferences(Type::EntityRemoved), 1);
+    EXPECT_EQ(result.countDifferences(Type::EntityChanged), 2);
+
+    auto findDifference = [&](const std::string& name)
+    {
+        auto found = std::find_if(result.differences.begin(), result.differences.end(),
+            [&](const MapTextComparer::EntityDifference& diff) { return diff.entityName == name; });
+        EXPECT_NE(found, result.differences.end()) << "No difference reported for " << name;
+        return found != result.differences.end() ? *found : MapTextComparer::EntityDifference{};
+    };
+
+    EXPECT_EQ(findDifference("light_2").type, Type::EntityAdded);
+    EXPECT_EQ(findDifference("info_player_start_1").type, Type::EntityRemoved);
+
+    auto light = findDifference("light_1");
+    EXPECT_EQ(light.type, Type::EntityChanged);
+    EXPECT_TRUE(light.keyValuesChanged);
+    EXPECT_EQ(light.numPrimitivesAdded, 0);
+    EXPECT_EQ(light.numPrimitivesRemoved, 0);
+
+    auto worldspawn = findDifference("worldspawn");
+    EXPECT_EQ(worldspawn.type, Type::EntityChanged);
+    EXPECT_FALSE(worldspawn.keyValuesChanged);
+    EXPECT_EQ(worldspawn.numPrimitivesAdded, 1);
+    EXPECT_EQ(worldspawn.numPrimitivesRemoved, 1);
+}
+
+TEST_F(MapMergeTest, TextComparerRejectsXmlMaps)
+{
+    std::istringstream source(R"(<?xml version="1.0" encoding="utf-8"?><map format="portable" version="2"></map>)");
+    std::istringstream base(source.str());
+
+    EXPECT_THROW(MapTextComparer::Compare(source, base), parser::ParseException);
+}
+
 TEST_F(MapMergeTest, MergeActionsForMissingEntities)
 {
     auto result = performComparison("maps/fingerprinting.mapx", _context.getTestProjectPath() + "maps/fingerprinting_2.mapx");
@@ -1,8 +1,11 @@
 #include "RadiantTest.h"
 
+#include "algorithm/Entity.h"
 #include "algorithm/Scene.h"
 #include "iscenegraph.h"
+#include "imap.h"
 #include "imodel.h"
+#include "imodelsurface.h"
 #include "itransformable.h"
 #include "icommandsystem.h"
 #include "iselectable.h"
@@ -60,4 +63,64 @@ TEST_F(RadiantTest, DuplicateScaledModel)
     ASSERT_TRUE(duplicatedModel->getModelScale() == scale);
 }
 
+TEST_F(RadiantTest, ModelCopiesShareGeometryUntilScaled)
+{
+    auto first = algorithm::createEntityByClassName("func_static");
+    auto second = algorithm::createEntityByClassName("func_static");
+    first->getEntity().setKeyValue("model", "models/torch.lwo");
+    second->getEntity().setKeyValue("model", "models/torch.lwo");
+
+    GlobalMapModule().getRoot()->addChildNode(first);
+    GlobalMapModule().getRoot()->addChildNode(second);
+
+    auto firstModel = algorithm::findChildModel(first);
+    auto secondModel = algorithm::findChildModel(second);
+    ASSERT_TRUE(firstModel && secondModel);
+    ASSERT_NE(firstModel, secondModel);
+
+    auto getSurface = [](const model::ModelNodePtr& model, int index) -> const model::IIndexedModelSurface&
+    {
+        return static_cast<const model::IIndexedModelSurface&>(model->getIModel().getSurface(index));
+    };
+
+    auto surfaceCount = firstModel->getIModel().getSurfaceCount();
+    ASSERT_GT(surfaceCount, 0);
+    ASSERT_EQ(secondModel->getIModel().getSurfaceCount(), surfaceCount);
+
+    // Both models should draw their surfaces from the same arrays
+    for (int i = 0; i < surfaceCount; ++i)
+    {
+        EXPECT_EQ(&getSurface(firstModel, i).getVertexArray(), &getSurface(secondModel, i).getVertexArray());
+        EXPECT_EQ(&getSurface(firstModel, i).getIndexArray(), &getSurface(secondModel, i).getIndexArray());
+        EXPECT_NE(getSurface(firstModel, i).getGeometryId(), 0) << "Shared arrays need a geometry id";
+        EXPECT_EQ(getSurface(firstModel, i).getGeometryId(), getSurface(secondModel, i).getGeometryId());
+    }
+
+    auto unscaledVertex = getSurface(secondModel, 0).getVertexArray().front().vertex;
+
+    // Scale the first model
+    const Vector3 scale(2, 3, 4);
+    auto transformable = scene::node_cast<ITransformable>(algorithm::findChildModelNode(first));
+    ASSERT_TRUE(transformable);
+
+    transformable->setType(TRANSFORM_PRIMITIVE);
+    transformable->setScale(scale);
+    transformable->freezeTransform();
+
+    for (int i = 0; i < surfaceCount; ++i)
+    {
+        // The scaled model needs its own vertices, the indices are still the same
+        EXPECT_NE(&getSurface(firstModel, i).getVertexArray(), &getSurface(secondModel, i).getVertexArray());
+        EXPECT_EQ(&getSurface(firstModel, i).getIndexArray(), &getSurface(secondModel, i).getIndexArray());
+
+        // Renderers must not confuse the new arrays with the shared ones, even if an address is re-used
+        EXPECT_NE(getSurface(firstModel, i).getGeometryId(), getSurface(secondModel, i).getGeometryId());
+    }
+
+    // The other copy is unaffected
+    EXPECT_EQ(getSurface(secondModel, 0).getVertexArray().front().vertex, unscaledVertex);
+    EXPECT_TRUE(math::isNear(getSurface(firstModel, 0).getVertexArray().front().vertex,
+        unscaledVertex * scale, 1e-4));
+}
+
 }
@@ -1,5 +1,6 @@
 #include "RadiantTest.h"
 
+#include <fstream>
 #include <unordered_set>
 #include "imodelsurface.h"
 #include "imodelcache.h"
@@ -8,8 +9,11 @@
 #include "algorithm/FileUtils.h"
 #include "algorithm/Scene.h"
 #include "os/file.h"
+#include "math/Quaternion.h"
+#include "parser/DefTokeniser.h"
 
 #include "render/VertexHashing.h"
+#include "string/predicate.h"
 #include "string/replace.h"
 
 namespace test
@@ -460,6 +464,94 @@ TEST_F(ModelTest, LoadFbxModel)
     EXPECT_EQ(model->getPolyCount(), 12);
 }
 
+TEST_F(ModelTest, StaticModelsAreCached)
+{
+    auto importer = GlobalModelFormatManager().getImporter("ASE");
+    ASSERT_TRUE(importer);
+
+    // The first load is parsing the file and writes the cache entry
+    auto parsedModel = importer->loadModelFromPath("models/ase/tiles_two_materials.ase");
+    ASSERT_TRUE(parsedModel);
+
+    auto cacheFolder = _context.getCacheDataPath() + "models/";
+    ASSERT_TRUE(fs::is_directory(cacheFolder)) << "Cache folder has not been created";
+
+    // The second load is served from the cache and needs to produce the same surfaces
+    auto cachedModel = importer->loadModelFromPath("models/ase/tiles_two_materials.ase");
+    ASSERT_TRUE(cachedModel);
+    EXPECT_NE(cachedModel, parsedModel);
+
+    EXPECT_EQ(cachedModel->getModelPath(), parsedModel->getModelPath());
+    EXPECT_EQ(cachedModel->getFilename(), parsedModel->getFilename());
+    EXPECT_TRUE(math::isNear(cachedModel->localAABB().getOrigin(), parsedModel->localAABB().getOrigin(), 1e-6));
+    EXPECT_TRUE(math::isNear(cachedModel->localAABB().getExtents(), parsedModel->localAABB().getExtents(), 1e-6));
+    ASSERT_EQ(cachedModel->getSurfaceCount(), parsedModel->getSurfaceCount());
+
+    for (int s = 0; s < parsedModel->getSurfaceCount(); ++s)
+    {
+        const auto& parsed = static_cast<const model::IIndexedModelSurface&>(parsedModel->getSurface(s));
+        const auto& cached = static_cast<const model::IIndexedModelSurface&>(cachedModel->getSurface(s));
+
+        EXPECT_EQ(cached.getDefaultMaterial(), parsed.getDefaultMaterial());
+        EXPECT_EQ(cached.getIndexArray(), parsed.getIndexArray());
+        ASSERT_EQ(cached.getVertexArray().size(), parsed.getVertexArray().size());
+
+        for (std::size_t v = 0; v < parsed.getVertexArray().size(); ++v)
+        {
+            const auto& expected = parsed.getVertexArray()[v];
+            const auto& actual = cached.getVertexArray()[v];
+
+            EXPECT_EQ(actual.vertex, expected.vertex);
+            EXPECT_EQ(actual.normal, expected.normal);
+            EXPECT_EQ(actual.tangent, expected.tangent);
+            EXPECT_EQ(actual.bitangent, expected.bitangent);
+            EXPECT_EQ(actual.texcoord, expected.texcoord);
+            EXPECT_EQ(actual.colour, expected.colour);
+        }
+    }
+
+    // There's exactly one cache file for this model
+    fs::path cacheFile;
+    for (const auto& entry : fs::directory_iterator(cacheFolder))
+    {
+        auto filename = entry.path().filename().string();
+
+        if (string::starts_with(filename, "tiles_two_materials.ase.") && string::ends_with(filename, ".bin"))
+        {
+            EXPECT_TRUE(cacheFile.empty()) << "Found more than one cache file: " << filename;
+            cacheFile = entry.path();
+        }
+    }
+    ASSERT_FALSE(cacheFile.empty()) << "Cache file has not been written";
+
+    // Tamper with the material name stored in the cache file, the next load should pick it up
+    BackupCopy backup(cacheFile);
+
+    auto material = parsedModel->getSurface(0).getDefaultMaterial();
+    ASSERT_FALSE(material.empty());
+
+    std::string contents;
+    {
+        std::ifstream input(cacheFile, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    // Search from the back, the archive path at the beginning might contain the same word
+    auto materialPos = contents.rfind(material);
+    ASSERT_NE(materialPos, std::string::npos) << "Material name not found in the cache file";
+    contents[materialPos + material.size() - 1] = '#';
+
+    {
+        std::ofstream output(cacheFile, std::ios::binary | std::ios::trunc);
+        output.write(contents.data(), contents.size());
+    }
+
+    auto tamperedModel = importer->loadModelFromPath("models/ase/tiles_two_materials.ase");
+    ASSERT_TRUE(tamperedModel);
+    EXPECT_EQ(tamperedModel->getSurface(0).getDefaultMaterial(), material.substr(0, material.size() - 1) + "#")
+        << "The model has not been loaded from the cache file";
+}
+
 // #5964: Model nodes below a func_emitter didn't get rendered at the entity's origin after creating the entity
 TEST_F(ModelTest, NullModelTransformAfterSceneInsertion)
 {
@@ -515,6 +607,174 @@ TEST_F(ModelTest, ModelKeyReferencesMd5Model)
     performModelNodeTest(_context.getTestProjectPath(), "models/md5/flag01.md5mesh", 96);
 }
 
+namespace
+{
+
+// Reference data of an .md5mesh file, parsed independently from the model loader
+struct Md5ReferenceMesh
+{
+    struct Joint
+    {
+        Vector3 position;
+        Quaternion rotation;
+    };
+
+    struct Weight
+    {
+        std::size_t joint;
+        double bias;
+        Vector3 position;
+    };
+
+    struct Vertex
+    {
+        std::size_t firstWeight;
+        std::size_t numWeights;
+    };
+
+    struct Mesh
+    {
+        std::vector<Vertex> vertices;
+        std::vector<Weight> weights;
+    };
+
+    std::vector<Joint> joints;
+    std::vector<Mesh> meshes;
+
+    static Vector3 parseVector3(parser::DefTokeniser& tok)
+    {
+        tok.assertNextToken("(");
+        auto x = std::stod(tok.nextToken());
+        auto y = std::stod(tok.nextToken());
+        auto z = std::stod(tok.nextToken());
+        tok.assertNextToken(")");
+
+        return Vector3(x, y, z);
+    }
+
+    Md5ReferenceMesh(const std::string& path)
+    {
+        std::ifstream stream(path);
+        parser::BasicDefTokeniser<std::istream> tok(stream);
+
+        while (tok.hasMoreTokens())
+        {
+            auto token = tok.nextToken();
+
+            if (token == "joints")
+            {
+                tok.assertNextToken("{");
+
+                for (auto next = tok.nextToken(); next != "}"; next = tok.nextToken())
+                {
+                    tok.skipTokens(1); // parent index, next was the name
+
+                    Joint joint;
+                    joint.position = parseVector3(tok);
+
+                    auto rotation = parseVector3(tok);
+                    auto w = -std::sqrt(std::max(1.0 - rotation.getLengthSquared(), 0.0));
+                    joint.rotation = Quaternion(rotation, w);
+
+                    joints.push_back(joint);
+                }
+            }
+            else if (token == "mesh")
+            {
+                tok.assertNextToken("{");
+                meshes.emplace_back();
+
+                for (auto next = tok.nextToken(); next != "}"; next = tok.nextToken())
+                {
+                    if (next == "vert")
+                    {
+                        tok.skipTokens(1); // index
+                        parseVector3Pair(tok); // texcoords
+
+                        Vertex vertex;
+                        vertex.firstWeight = std::stoul(tok.nextToken());
+                        vertex.numWeights = std::stoul(tok.nextToken());
+                        meshes.back().vertices.push_back(vertex);
+                    }
+                    else if (next == "weight")
+                    {
+                        tok.skipTokens(1); // index
+
+                        Weight weight;
+                        weight.joint = std::stoul(tok.nextToken());
+                        weight.bias = std::stod(tok.nextToken());
+                        weight.position = parseVector3(tok);
+                        meshes.back().weights.push_back(weight);
+                    }
+                }
+            }
+        }
+    }
+
+    // Skins the given vertex of the given mesh to the default pose, in double precision
+    Vector3 getSkinnedVertex(std::size_t meshIndex, std::size_t vertexIndex) const
+    {
+        const auto& mesh = meshes[meshIndex];
+        const auto& vertex = mesh.vertices[vertexIndex];
+
+        Vector3 skinned(0, 0, 0);
+
+        for (auto w = vertex.firstWeight; w < vertex.firstWeight + vertex.numWeights; ++w)
+        {
+            const auto& weight = mesh.weights[w];
+            const auto& joint = joints[weight.joint];
+
+            skinned += (joint.rotation.transformPoint(weight.position) + joint.position) * weight.bias;
+        }
+
+        return skinned;
+    }
+
+private:
+    static void parseVector3Pair(parser::DefTokeniser& tok)
+    {
+        tok.assertNextToken("(");
+        tok.skipTokens(2);
+        tok.assertNextToken(")");
+    }
+};
+
+}
+
+TEST_F(ModelTest, Md5DefaultPoseSkinning)
+{
+    auto model = GlobalModelCache().getModel("models/md5/flag01.md5mesh");
+    EXPECT_TRUE(model);
+    EXPECT_EQ(model->getSurfaceCount(), 6);
+
+    // vert 1 ( 0.000003 0.000000 ) of the first mesh
+    EXPECT_NEAR(model->getSurface(0).getVertex(1).texcoord.x(), 0.000003, 1e-6);
+    EXPECT_NEAR(model->getSurface(0).getVertex(1).texcoord.y(), 0, 1e-6);
+
+    Md5ReferenceMesh reference(_context.getTestProjectPath() + "models/md5/flag01.md5mesh");
+    ASSERT_EQ(reference.joints.size(), 14) << "Reference parser failed";
+    ASSERT_EQ(reference.meshes.size(), model->getSurfaceCount()) << "Reference parser failed";
+
+    for (int s = 0; s < model->getSurfaceCount(); ++s)
+    {
+        const auto& surface = model->getSurface(s);
+        ASSERT_EQ(surface.getNumVertices(), reference.meshes[s].vertices.size());
+
+        for (int i = 0; i < surface.getNumVertices(); ++i)
+        {
+            const auto& vertex = surface.getVertex(i);
+            auto expected = reference.getSkinnedVertex(s, i);
+
+            // The skinning runs in single precision, allow for rounding errors
+            EXPECT_NEAR(vertex.vertex.x(), expected.x(), 1e-3) << "Surface " << s << ", vertex " << i;
+            EXPECT_NEAR(vertex.vertex.y(), expected.y(), 1e-3) << "Surface " << s << ", vertex " << i;
+            EXPECT_NEAR(vertex.vertex.z(), expected.z(), 1e-3) << "Surface " << s << ", vertex " << i;
+
+            EXPECT_NEAR(vertex.normal.getLength(), 1.0, 1e-4) << "Vertex normal not normalised";
+        }
+    }
+}
+
 TEST_F(ModelTest, ModelKeyReferencesModelDef)
 {
     auto funcStatic = algorithm::createEntityByClassName("func_static");
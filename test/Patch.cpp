@@ -1,13 +1,18 @@
 #include "RadiantTest.h"
 
+#include "ieclass.h"
+#include "ientity.h"
 #include "imap.h"
 #include "ipatch.h"
+#include "ipendingevaluation.h"
+#include "iscenegraphfactory.h"
 #include "igrid.h"
 #include "iselection.h"
 #include "scenelib.h"
 #include "algorithm/Primitives.h"
 #include "algorithm/View.h"
 #include "render/View.h"
+#include "scene/BasicRootNode.h"
 
 namespace test
 {
@@ -97,4 +102,109 @@ TEST_F(PatchTest, VertexSnappingIsUndoable)
     EXPECT_TRUE(math::isNear(ctrl.vertex, vertexBeforeSnapping, 0.01)) << "Vertex should be reverted and off-grid again";
 }
 
+// Requesting the tesselation of one patch processes all other dirty patches too,
+// translated copies of the same patch end up with the same mesh
+TEST_F(PatchTest, BatchedTesselationOfTranslatedCopies)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    std::vector<scene::INodePtr> patches;
+
+    // Use enough patches to have them tesselated in parallel
+    for (int i = 0; i < 100; ++i)
+    {
+        auto patchNode = algorithm::createPatchFromBounds(worldspawn, AABB({ i * 128.0, 0, 0 }, { 32, 32, 32 }));
+
+        // Bulge the center to get a curved surface, every second patch is shaped differently
+        auto patch = Node_getIPatch(patchNode);
+        patch->ctrlAt(1, 1).vertex.z() += i % 2 == 0 ? 48 : 16;
+        patch->controlPointsChanged();
+
+        patches.push_back(patchNode);
+    }
+
+    auto referenceMesh = Node_getIPatch(patches[0])->getTesselatedPatchMesh();
+    auto otherReferenceMesh = Node_getIPatch(patches[1])->getTesselatedPatchMesh();
+
+    EXPECT_GT(referenceMesh.vertices.size(), 9) << "Curved patch should have been subdivided";
+
+    for (int i = 2; i < patches.size(); ++i)
+    {
+        const auto& expectedMesh = i % 2 == 0 ? referenceMesh : otherReferenceMesh;
+        auto mesh = Node_getIPatch(patches[i])->getTesselatedPatchMesh();
+
+        EXPECT_EQ(mesh.width, expectedMesh.width);
+        EXPECT_EQ(mesh.height, expectedMesh.height);
+        ASSERT_EQ(mesh.vertices.size(), expectedMesh.vertices.size()) << "Patch " << i << " has a different mesh";
+
+        Vector3 offset((i - i % 2) * 128.0, 0, 0);
+
+        for (std::size_t v = 0; v < mesh.vertices.size(); ++v)
+        {
+            EXPECT_TRUE(math::isNear(mesh.vertices[v].vertex, expectedMesh.vertices[v].vertex + offset, 0.001))
+                << "Patch " << i << " vertex " << v << " has not been translated correctly";
+            EXPECT_TRUE(math::isNear(mesh.vertices[v].normal, expectedMesh.vertices[v].normal, 0.001));
+        }
+    }
+}
+
+// Fixed subdivisions are sampling the bezier surface at regular intervals
+TEST_F(PatchTest, FixedSubdivisionTesselation)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    auto patchNode = algorithm::createPatchFromBounds(worldspawn, AABB({ 0, 0, 0 }, { 32, 32, 32 }));
+    auto patch = Node_getIPatch(patchNode);
+
+    patch->ctrlAt(1, 1).vertex.z() += 64;
+    patch->setFixedSubdivisions(true, Subdivisions(4, 4));
+
+    auto mesh = patch->getTesselatedPatchMesh();
+
+    EXPECT_EQ(mesh.width, 5);
+    EXPECT_EQ(mesh.height, 5);
+    ASSERT_EQ(mesh.vertices.size(), 25);
+
+    // The center of the surface is at a quarter of the center control point's height (weight 0.5 * 0.5)
+    EXPECT_TRUE(math::isNear(mesh.vertices[12].vertex, Vector3(0, 0, -32 + 64 * 0.25), 0.001));
+
+    // Corners are interpolated
+    EXPECT_TRUE(math::isNear(mesh.vertices[0].vertex, patch->ctrlAt(0, 0).vertex, 0.001) ||
+        math::isNear(mesh.vertices[0].vertex, patch->ctrlAt(2, 0).vertex, 0.001));
+}
+
+// Pending patches are collected per scene, tesselating a map patch doesn't touch other scenes
+TEST_F(PatchTest, BatchedTesselationIsPerScene)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto mapPatch = algorithm::createPatchFromBounds(worldspawn, AABB({ 0, 0, 0 }, { 32, 32, 32 }));
+
+    // Set up a second scene, like the ones used by the preview widgets
+    auto sceneGraph = GlobalSceneGraphFactory().createSceneGraph();
+    auto previewRoot = std::make_shared<scene::BasicRootNode>();
+    sceneGraph->setRoot(previewRoot);
+
+    auto entity = GlobalEntityModule().createEntity(GlobalEntityClassManager().findClass("func_static"));
+    scene::addNodeToContainer(entity, previewRoot);
+
+    auto previewPatch = algorithm::createPatchFromBounds(entity, AABB({ 0, 0, 0 }, { 32, 32, 32 }));
+
+    for (const auto& node : { mapPatch, previewPatch })
+    {
+        Node_getIPatch(node)->ctrlAt(1, 1).vertex.z() += 48;
+        Node_getIPatch(node)->controlPointsChanged();
+    }
+
+    Node_getIPatch(mapPatch)->getTesselatedPatchMesh();
+
+    // The preview patch is still waiting in its own queue
+    auto pending = previewRoot->getPendingEvaluationQueue().takeAll(scene::PendingEvaluationType::PatchTesselation);
+    EXPECT_EQ(pending.size(), 1) << "Preview patch should still be pending";
+    EXPECT_TRUE(GlobalMapModule().getRoot()->getPendingEvaluationQueue().takeAll(
+        scene::PendingEvaluationType::PatchTesselation).empty()) << "Map patches should have been processed";
+
+    scene::removeNodeFromParent(previewPatch);
+    scene::removeNodeFromParent(entity);
+}
+
 }
@@ -5,6 +5,7 @@
 #include "irender.h"
 #include "ilightnode.h"
 #include "math/Matrix4.h"
+#include "render/InstancedObjectCollection.h"
 #include "scenelib.h"
 
 namespace test
@@ -490,4 +491,72 @@ TEST_F(RenderSystemTest, AttachmentIsRegisteredAsLight)
     EXPECT_EQ(getLightCount(renderSystem), 1) << "Rendersystem should know of 1 light after removing the torch";
 }
 
+namespace
+{
+
+class TestObject :
+    public render::IRenderableObject
+{
+private:
+    Matrix4 _transform;
+    AABB _bounds;
+    sigc::signal<void> _sigBoundsChanged;
+    render::IGeometryStore::Slot _slot;
+
+public:
+    TestObject(render::IGeometryStore::Slot slot, const Vector3& origin) :
+        _transform(Matrix4::getTranslation(origin)),
+        _slot(slot)
+    {}
+
+    bool isVisible() override { return true; }
+    bool isOriented() override { return true; }
+    const Matrix4& getObjectTransform() override { return _transform; }
+    const AABB& getObjectBounds() override { return _bounds; }
+    sigc::signal<void>& signal_boundsChanged() override { return _sigBoundsChanged; }
+    render::IGeometryStore::Slot getStorageLocation() override { return _slot; }
+    bool isShadowCasting() override { return true; }
+};
+
+}
+
+TEST(InstancedObjectCollectionTest, ObjectsOfOverlappingLightsAreCollectedOnce)
+{
+    TestObject a(1, Vector3(0, 0, 0));
+    TestObject b(1, Vector3(64, 0, 0));
+    TestObject c(1, Vector3(128, 0, 0));
+    TestObject d(2, Vector3(0, 64, 0));
+
+    render::InstancedObjectCollection collection;
+
+    // The first light touches a and b, the second one b, c and d
+    collection.add(a);
+    collection.add(b);
+
+    collection.add(b);
+    collection.add(c);
+    collection.add(d);
+
+    std::map<render::IGeometryStore::Slot, std::vector<Matrix4>> transformsBySlot;
+
+    collection.foreachSlot([&](render::IGeometryStore::Slot slot, const std::vector<Matrix4>& transforms)
+    {
+        EXPECT_EQ(transformsBySlot.count(slot), 0) << "Each slot should be visited once";
+        transformsBySlot[slot] = transforms;
+    });
+
+    ASSERT_EQ(transformsBySlot.size(), 2);
+    EXPECT_EQ(transformsBySlot[1].size(), 3) << "Object b is lit by two lights but should be drawn once";
+    EXPECT_EQ(transformsBySlot[2].size(), 1);
+
+    for (auto* object : { &a, &b, &c })
+    {
+        auto& transforms = transformsBySlot[1];
+        EXPECT_EQ(std::count(transforms.begin(), transforms.end(), object->getObjectTransform()), 1);
+    }
+
+    collection.clear();
+    EXPECT_TRUE(collection.empty());
+}
+
 }
@@ -1,7 +1,9 @@
 #include "RadiantTest.h"
 
+#include "imap.h"
 #include "scene/BasicRootNode.h"
 #include "scene/Node.h"
+#include "scene/NodeArena.h"
 #include "scenelib.h"
 #include "algorithm/Entity.h"
 
@@ -386,4 +388,86 @@ TEST_F(SceneNodeTest, SetRenderStateAffectsAttachments)
     });
 }
 
+TEST_F(SceneNodeTest, NodeArenaReusesFreedChunks)
+{
+    auto arena = std::make_shared<scene::NodeArena>();
+    scene::NodeArena::Scope scope(arena);
+
+    std::vector<std::shared_ptr<VisibilityTestNode>> nodes;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        nodes.emplace_back(scene::makeArenaShared<VisibilityTestNode>());
+    }
+
+    auto stats = arena->getStatistics();
+    EXPECT_GE(stats.allocations, 1000) << "Every node should have been allocated from the arena";
+    EXPECT_GT(stats.blocks, 0) << "Arena should have acquired blocks";
+
+    nodes.clear();
+
+    stats = arena->getStatistics();
+    EXPECT_EQ(stats.deallocations, stats.allocations) << "Every node should have been returned to the arena";
+    EXPECT_EQ(stats.bytesInUse, 0) << "Nothing should be in use anymore";
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        nodes.emplace_back(scene::makeArenaShared<VisibilityTestNode>());
+    }
+
+    EXPECT_EQ(arena->getStatistics().blocks, stats.blocks) << "Freed chunks should have been re-used";
+}
+
+TEST_F(SceneNodeTest, NodeArenaChildListsUseArena)
+{
+    auto arena = std::make_shared<scene::NodeArena>();
+    std::shared_ptr<VisibilityTestNode> parent;
+
+    {
+        scene::NodeArena::Scope scope(arena);
+        parent = scene::makeArenaShared<VisibilityTestNode>();
+    }
+
+    EXPECT_FALSE(scene::NodeArena::GetCurrent()) << "Scope should have been left";
+
+    auto allocationsBefore = arena->getStatistics().allocations;
+
+    // Children added outside the scope still end up in the parent's arena
+    parent->addChildNode(std::make_shared<VisibilityTestNode>());
+    parent->addChildNode(std::make_shared<VisibilityTestNode>());
+
+    EXPECT_EQ(arena->getStatistics().allocations, allocationsBefore + 2) << "List nodes should be allocated from the arena";
+}
+
+TEST_F(SceneNodeTest, NodeArenaIsReleasedWithLastNode)
+{
+    auto arena = std::make_shared<scene::NodeArena>();
+    std::weak_ptr<scene::NodeArena> weakArena = arena;
+
+    std::shared_ptr<VisibilityTestNode> node;
+
+    {
+        scene::NodeArena::Scope scope(arena);
+        node = scene::makeArenaShared<VisibilityTestNode>();
+    }
+
+    arena.reset();
+    EXPECT_FALSE(weakArena.expired()) << "Arena should be kept alive by the node allocated from it";
+
+    node.reset();
+    EXPECT_TRUE(weakArena.expired()) << "Arena should be released together with its last node";
+}
+
+TEST_F(SceneNodeTest, LoadedMapIsAllocatedFromRootArena)
+{
+    loadMap("entityinspector.map");
+
+    const auto& arena = GlobalMapModule().getRoot()->getNodeArena();
+    ASSERT_TRUE(arena) << "Map root should own an arena";
+
+    auto stats = arena->getStatistics();
+    EXPECT_GT(stats.allocations, 0) << "Loaded nodes should have been allocated from the map's arena";
+    EXPECT_GT(stats.allocations, stats.deallocations) << "The loaded nodes should still be alive";
+}
+
 }
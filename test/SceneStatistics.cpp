@@ -1,6 +1,16 @@
 #include "RadiantTest.h"
 
+#include "imap.h"
+#include "imaterialusageindex.h"
+#include "ibrush.h"
+#include "icommandsystem.h"
+#include "iselection.h"
+#include "iundo.h"
+#include "scenelib.h"
+#include "shaderlib.h"
+#include "scene/Node.h"
 #include "scene/ShaderBreakdown.h"
+#include "algorithm/Scene.h"
 
 namespace test
 {
@@ -26,4 +36,95 @@ TEST_F(SceneStatisticsTest, MaterialBreakDown)
     EXPECT_EQ(map.at("torch_shadowcasting"), (std::array<std::size_t, 4>({ 0, 0, 1, 0 })));
 }
 
+TEST_F(SceneStatisticsTest, MaterialUsageIndexFollowsFaceChanges)
+{
+    loadMap("material_usage.map");
+
+    const auto& index = GlobalMapModule().getRoot()->getMaterialUsageIndex();
+
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Face), 6);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Patch), 2);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/2", scene::MaterialUsageType::Face), 0);
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::findFirstBrushWithMaterial(worldspawn, "textures/numbers/0");
+    ASSERT_TRUE(brush);
+
+    {
+        UndoableCommand cmd("changeFaceMaterial");
+        Node_getIBrush(brush)->getFace(0).setShader("textures/numbers/2");
+    }
+
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Face), 5);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/2", scene::MaterialUsageType::Face), 1);
+
+    GlobalCommandSystem().executeCommand("Undo");
+
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Face), 6);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/2", scene::MaterialUsageType::Face), 0);
+
+    // Removing the brush from the scene removes its faces from the index
+    scene::removeNodeFromParent(brush);
+
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Face), 0);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Patch), 2);
+}
+
+TEST_F(SceneStatisticsTest, MaterialUsageIndexLookup)
+{
+    loadMap("material_usage.map");
+
+    const auto& index = GlobalMapModule().getRoot()->getMaterialUsageIndex();
+
+    std::size_t brushCount = 0;
+    std::size_t patchCount = 0;
+
+    // Lookups are case-insensitive, the brush is reported once despite using the material six times
+    index.foreachNodeUsingMaterial("TEXTURES/numbers/0", [&](const scene::INodePtr& node)
+    {
+        brushCount += Node_isBrush(node) ? 1 : 0;
+        patchCount += Node_isPatch(node) ? 1 : 0;
+    });
+
+    EXPECT_EQ(brushCount, 1);
+    EXPECT_EQ(patchCount, 2);
+
+    GlobalCommandSystem().executeCommand("SelectItemsByShader", cmd::Argument("textures/numbers/1"));
+
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), 1);
+    EXPECT_TRUE(Node_isBrush(GlobalSelectionSystem().ultimateSelected()));
+
+    GlobalCommandSystem().executeCommand("DeselectItemsByShader", cmd::Argument("textures/numbers/1"));
+
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), 0);
+}
+
+TEST_F(SceneStatisticsTest, FindAndReplaceShaderSkipsHiddenSubgraphs)
+{
+    loadMap("material_usage.map");
+
+    const auto& index = GlobalMapModule().getRoot()->getMaterialUsageIndex();
+
+    // The worldspawn brush and patch are visible themselves, their parent is not
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    worldspawn->enable(scene::Node::eHidden);
+
+    auto brush = algorithm::findFirstBrushWithMaterial(worldspawn, "textures/numbers/0");
+    ASSERT_TRUE(brush);
+    EXPECT_TRUE(brush->visible());
+
+    // Only the patch of the func_static is replaced
+    EXPECT_EQ(scene::findAndReplaceShader("textures/numbers/0", "textures/numbers/2", false), 1);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Face), 6);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Patch), 1);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/2", scene::MaterialUsageType::Patch), 1);
+
+    worldspawn->disable(scene::Node::eHidden);
+
+    EXPECT_EQ(scene::findAndReplaceShader("textures/numbers/0", "textures/numbers/2", false), 7);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Face), 0);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/0", scene::MaterialUsageType::Patch), 0);
+    EXPECT_EQ(index.getUsageCount("textures/numbers/2", scene::MaterialUsageType::Face), 6);
+}
+
 }
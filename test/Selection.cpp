@@ -794,6 +794,96 @@ TEST_F(OrthoViewSelectionTest, CycleSelectPointOnlyOneCandidate)
     EXPECT_TRUE(Node_isSelected(brush2)) << "brush 2 should remain selected";
 }
 
+// Cycle selection through a stack of brushes, large enough to have the nodes tested in parallel
+TEST_F(OrthoViewSelectionTest, CycleSelectPointInDenseStack)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    std::vector<scene::INodePtr> brushes;
+
+    for (auto i = 0; i < 200; ++i)
+    {
+        brushes.emplace_back(algorithm::createCuboidBrush(worldspawn,
+            AABB(Vector3(0, 0, i * 16), Vector3(4, 4, 4)), "textures/numbers/1"));
+    }
+
+    // The topmost brush is selected first, cycling is moving downwards in the stack
+    algorithm::performPointSelectionOnPosition(Vector3(0, 0, 0), selection::SelectionSystem::eReplace);
+    expectNodeSelectionStatus({ brushes[199] }, { brushes[198], brushes[197], brushes[0] });
+
+    algorithm::performPointSelectionOnPosition(Vector3(0, 0, 0), selection::SelectionSystem::eCycle);
+    expectNodeSelectionStatus({ brushes[198] }, { brushes[199], brushes[197], brushes[0] });
+
+    algorithm::performPointSelectionOnPosition(Vector3(0, 0, 0), selection::SelectionSystem::eCycle);
+    expectNodeSelectionStatus({ brushes[197] }, { brushes[199], brushes[198], brushes[0] });
+}
+
+// Dense scenes of brushes and patches are tested in parallel chunks,
+// the outcome needs to be the same as for a sequential test
+TEST_F(OrthoViewSelectionTest, SelectionInDenseScene)
+{
+    constexpr auto GridSize = 48;
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    std::vector<scene::INodePtr> primitives;
+
+    // The centered orthoview is covering the area [-320..320] in both directions
+    for (auto x = 0; x < GridSize; ++x)
+    {
+        for (auto y = 0; y < GridSize; ++y)
+        {
+            AABB bounds(Vector3((x - GridSize / 2) * 12 + 6, (y - GridSize / 2) * 12 + 6, 0), Vector3(4, 4, 4));
+
+            if ((x + y) % 4 == 0)
+            {
+                primitives.push_back(algorithm::createPatchFromBounds(worldspawn, bounds, "textures/numbers/1"));
+            }
+            else
+            {
+                primitives.push_back(algorithm::createCuboidBrush(worldspawn, bounds, "textures/numbers/1"));
+            }
+        }
+    }
+
+    render::View view(false);
+    algorithm::constructCenteredOrthoview(view, Vector3(0, 0, 0));
+
+    // Select the upper right quarter, which holds the primitives located in positive x and y
+    {
+        ConstructSelectionTest(view, selection::Rectangle::ConstructFromArea(Vector2(0, 0), Vector2(1, 1)));
+
+        SelectionVolume test(view);
+        GlobalSelectionSystem().selectArea(test, selection::SelectionSystem::eReplace, false);
+    }
+
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), (GridSize / 2) * (GridSize / 2)) << "A quarter of the primitives should be selected";
+
+    for (const auto& primitive : primitives)
+    {
+        const auto& origin = primitive->worldAABB().getOrigin();
+        auto expectSelected = origin.x() > 0 && origin.y() > 0;
+
+        EXPECT_EQ(Node_isSelected(primitive), expectSelected) << "Unexpected selection status at " << origin;
+    }
+
+    // Select everything
+    {
+        ConstructSelectionTest(view, selection::Rectangle::ConstructFromArea(Vector2(-1, -1), Vector2(2, 2)));
+
+        SelectionVolume test(view);
+        GlobalSelectionSystem().selectArea(test, selection::SelectionSystem::eReplace, false);
+    }
+
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), GridSize * GridSize) << "All primitives should be selected";
+
+    // The primitive right at (6,6) is the one in the middle of the grid
+    auto centerPrimitive = primitives.at((GridSize / 2) * GridSize + GridSize / 2);
+    algorithm::performPointSelectionOnPosition(Vector3(6, 6, 0), selection::SelectionSystem::eReplace);
+
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), 1) << "The primitive below the point should be selected";
+    EXPECT_TRUE(Node_isSelected(centerPrimitive)) << "The primitive at the point should be selected";
+}
+
 // Ortho: Toggle point selection in entity mode
 TEST_F(OrthoViewSelectionTest, ToggleSelectPointEntityMode)
 {
@@ -92,4 +92,46 @@ TEST_F(SoundManagerTest, GetSoundFileDurationWithoutExtension)
     EXPECT_NEAR(duration, oggDuration, 0.001) << "The OGG file should have been found, not the wav file";
 }
 
+TEST_F(SoundManagerTest, GetOggSoundFileInfo)
+{
+    auto info = GlobalSoundManager().getSoundFileInfo("sound/test/jorge.ogg");
+
+    EXPECT_NEAR(info.duration, 0.293, 0.001) << "OGG file duration incorrect";
+    EXPECT_EQ(info.channels, 1u);
+    EXPECT_EQ(info.sampleRate, 44100u);
+    EXPECT_EQ(info.bitsPerSample, 16u);
+
+    // A second query should return the same info
+    auto cachedInfo = GlobalSoundManager().getSoundFileInfo("sound/test/jorge.ogg");
+    EXPECT_EQ(cachedInfo.duration, info.duration);
+    EXPECT_EQ(cachedInfo.sampleRate, info.sampleRate);
+}
+
+// A chained file consists of several logical streams, the duration is the sum of all of them
+TEST_F(SoundManagerTest, GetChainedOggSoundFileInfo)
+{
+    // jorge.ogg followed by a copy of itself using a different stream serial number
+    auto info = GlobalSoundManager().getSoundFileInfo("sound/test/jorge_chained.ogg");
+
+    EXPECT_NEAR(info.duration, 2 * 0.293, 0.002) << "Chained OGG file duration incorrect";
+    EXPECT_EQ(info.channels, 1u);
+    EXPECT_EQ(info.sampleRate, 44100u);
+    EXPECT_EQ(info.bitsPerSample, 16u);
+}
+
+TEST_F(SoundManagerTest, GetWaveSoundFileInfo)
+{
+    auto info = GlobalSoundManager().getSoundFileInfo("sound/test/jorge.wav");
+
+    EXPECT_NEAR(info.duration, 0.096, 0.001) << "WAV file duration incorrect";
+    EXPECT_EQ(info.channels, 1u);
+    EXPECT_EQ(info.sampleRate, 44100u);
+    EXPECT_EQ(info.bitsPerSample, 16u);
+}
+
+TEST_F(SoundManagerTest, GetNonExistingSoundFileInfo)
+{
+    EXPECT_THROW(GlobalSoundManager().getSoundFileInfo("sound/test/nonexisting_sound_1242.ogg"), std::out_of_range);
+}
+
 }
@@ -31,9 +31,17 @@ public:
     void submitInstancedGeometry(const std::vector<render::IGeometryStore::Slot>& slots, int numInstances, GLenum primitiveMode) override
     {}
 
+    void submitInstancedGeometry(render::IGeometryStore::Slot slot, const std::vector<Matrix4>& transforms, GLenum primitiveMode) override
+    {}
+
     void submitGeometryWithCustomIndices(render::IGeometryStore::Slot slot, GLenum primitiveMode,
         const std::vector<unsigned int>& indices) override
     {}
+
+    std::size_t getDrawCallCount() const override
+    {
+        return 0;
+    }
 };
 
 }